@@ -26,6 +26,7 @@ bool equals(InputIt1 first1, InputIt1 last1,
 
 TextEditor::TextEditor()
 	: mLineSpacing(1.0f)
+	, mLines(std::make_shared<Lines>())
 	, mUndoIndex(0)
 	, mTabSize(4)
 	, mOverwrite(false)
@@ -52,13 +53,120 @@ TextEditor::TextEditor()
 {
 	SetPalette(GetDarkPalette());
 	SetLanguageDefinition(LanguageDefinition::HLSL());
-	mLines.push_back(Line());
+	mLines->push_back(Line());
+	mLineAnchors.Reset(1);
 }
 
 TextEditor::~TextEditor()
 {
 }
 
+void TextEditor::Line::reserve(size_t aSize)
+{
+	mChars.reserve(aSize);
+	mMetadata.reserve((aSize + GroupSize - 1) / GroupSize * GroupBytes);
+}
+
+void TextEditor::Line::SetColorIndex(size_t aIndex, PaletteIndex aValue)
+{
+	// Only the text colors are stored in a line, the others (cursor, selection, ...) do not fit in 4 bits
+	assert((int)aValue < 16);
+	auto& colors = Group(aIndex)[aIndex % GroupSize / 2];
+	auto shift = NibbleShift(aIndex);
+	colors = (uint8_t)((colors & ~(0xF << shift)) | ((int)aValue << shift));
+}
+
+void TextEditor::Line::SetFlag(size_t aIndex, int aBits, bool aValue)
+{
+	auto& bits = Group(aIndex)[aBits];
+	auto mask = (uint8_t)(1 << (aIndex % GroupSize));
+	bits = aValue ? (uint8_t)(bits | mask) : (uint8_t)(bits & ~mask);
+}
+
+uint8_t TextEditor::Line::GetPackedMetadata(size_t aIndex) const
+{
+	return (uint8_t)((int)GetColorIndex(aIndex)
+		| (IsComment(aIndex) ? 0x10 : 0)
+		| (IsMultiLineComment(aIndex) ? 0x20 : 0)
+		| (IsPreprocessor(aIndex) ? 0x40 : 0));
+}
+
+void TextEditor::Line::SetPackedMetadata(size_t aIndex, uint8_t aValue)
+{
+	SetColorIndex(aIndex, (PaletteIndex)(aValue & 0xF));
+	SetComment(aIndex, (aValue & 0x10) != 0);
+	SetMultiLineComment(aIndex, (aValue & 0x20) != 0);
+	SetPreprocessor(aIndex, (aValue & 0x40) != 0);
+}
+
+uint8_t TextEditor::Line::PackMetadata(const Glyph& aGlyph)
+{
+	return (uint8_t)((int)aGlyph.mColorIndex
+		| (aGlyph.mComment ? 0x10 : 0)
+		| (aGlyph.mMultiLineComment ? 0x20 : 0)
+		| (aGlyph.mPreprocessor ? 0x40 : 0));
+}
+
+void TextEditor::Line::Resize(size_t aSize)
+{
+	mChars.resize(aSize);
+	mMetadata.resize((aSize + GroupSize - 1) / GroupSize * GroupBytes);
+}
+
+void TextEditor::Line::push_back(const Glyph& aGlyph)
+{
+	insert(size(), aGlyph);
+}
+
+void TextEditor::Line::insert(size_t aIndex, const Glyph& aGlyph)
+{
+	assert(aIndex <= size());
+	auto oldSize = size();
+	Resize(oldSize + 1);
+	for (auto i = oldSize; i > aIndex; --i)
+	{
+		mChars[i] = mChars[i - 1];
+		SetPackedMetadata(i, GetPackedMetadata(i - 1));
+	}
+	mChars[aIndex] = aGlyph.mChar;
+	SetPackedMetadata(aIndex, PackMetadata(aGlyph));
+}
+
+void TextEditor::Line::insert(size_t aIndex, const Line& aFrom, size_t aBegin, size_t aEnd)
+{
+	assert(&aFrom != this);
+	assert(aIndex <= size() && aBegin <= aEnd && aEnd <= aFrom.size());
+	auto count = aEnd - aBegin;
+	if (count == 0)
+		return;
+	auto oldSize = size();
+	Resize(oldSize + count);
+	for (auto i = oldSize; i > aIndex; --i)
+	{
+		mChars[i - 1 + count] = mChars[i - 1];
+		SetPackedMetadata(i - 1 + count, GetPackedMetadata(i - 1));
+	}
+	for (size_t i = 0; i < count; ++i)
+	{
+		mChars[aIndex + i] = aFrom.mChars[aBegin + i];
+		SetPackedMetadata(aIndex + i, aFrom.GetPackedMetadata(aBegin + i));
+	}
+}
+
+void TextEditor::Line::erase(size_t aBegin, size_t aEnd)
+{
+	assert(aBegin <= aEnd && aEnd <= size());
+	auto count = aEnd - aBegin;
+	if (count == 0)
+		return;
+	for (auto i = aEnd; i < size(); ++i)
+	{
+		mChars[i - count] = mChars[i];
+		SetPackedMetadata(i - count, GetPackedMetadata(i));
+	}
+	Resize(size() - count);
+}
+
 void TextEditor::SetLanguageDefinition(const LanguageDefinition & aLanguageDef)
 {
 	mLanguageDefinition = aLanguageDef;
@@ -75,9 +183,10 @@ void TextEditor::SetPalette(const Palette & aValue)
 	mPaletteBase = aValue;
 }
 
-std::string TextEditor::GetText(const Coordinates & aStart, const Coordinates & aEnd) const
+template<typename TString>
+void TextEditor::GetTextInto(const Coordinates & aStart, const Coordinates & aEnd, TString& aText) const
 {
-	std::string result;
+	aText.clear();
 
 	auto lstart = aStart.mLine;
 	auto lend = aEnd.mLine;
@@ -86,29 +195,34 @@ std::string TextEditor::GetText(const Coordinates & aStart, const Coordinates &
 	size_t s = 0;
 
 	for (size_t i = lstart; i < lend; i++)
-		s += mLines[i].size();
+		s += (*mLines)[i].size();
 
-	result.reserve(s + s / 8);
+	aText.reserve(s + s / 8);
 
 	while (istart < iend || lstart < lend)
 	{
-		if (lstart >= (int)mLines.size())
+		if (lstart >= (int)mLines->size())
 			break;
 
-		auto& line = mLines[lstart];
+		auto& line = (*mLines)[lstart];
 		if (istart < (int)line.size())
 		{
-			result += line[istart].mChar;
+			aText += line[istart].mChar;
 			istart++;
 		}
 		else
 		{
 			istart = 0;
 			++lstart;
-			result += '\n';
+			aText += '\n';
 		}
 	}
+}
 
+std::string TextEditor::GetText(const Coordinates & aStart, const Coordinates & aEnd) const
+{
+	std::string result;
+	GetTextInto(aStart, aEnd, result);
 	return result;
 }
 
@@ -121,23 +235,23 @@ TextEditor::Coordinates TextEditor::SanitizeCoordinates(const Coordinates & aVal
 {
 	auto line = aValue.mLine;
 	auto column = aValue.mColumn;
-	if (line >= (int)mLines.size())
+	if (line >= (int)mLines->size())
 	{
-		if (mLines.empty())
+		if (mLines->empty())
 		{
 			line = 0;
 			column = 0;
 		}
 		else
 		{
-			line = (int)mLines.size() - 1;
+			line = (int)mLines->size() - 1;
 			column = GetLineMaxColumn(line);
 		}
 		return Coordinates(line, column);
 	}
 	else
 	{
-		column = mLines.empty() ? 0 : std::min(column, GetLineMaxColumn(line));
+		column = mLines->empty() ? 0 : std::min(column, GetLineMaxColumn(line));
 		return Coordinates(line, column);
 	}
 }
@@ -199,9 +313,9 @@ static inline int ImTextCharToUtf8(char* buf, int buf_size, unsigned int c)
 
 void TextEditor::Advance(Coordinates & aCoordinates) const
 {
-	if (aCoordinates.mLine < (int)mLines.size())
+	if (aCoordinates.mLine < (int)mLines->size())
 	{
-		auto& line = mLines[aCoordinates.mLine];
+		auto& line = (*mLines)[aCoordinates.mLine];
 		auto cindex = GetCharacterIndex(aCoordinates);
 
 		if (cindex + 1 < (int)line.size())
@@ -230,26 +344,27 @@ void TextEditor::DeleteRange(const Coordinates & aStart, const Coordinates & aEn
 
 	auto start = GetCharacterIndex(aStart);
 	auto end = GetCharacterIndex(aEnd);
+	OnLinesChanged(aStart.mLine, 1, 1);
 
 	if (aStart.mLine == aEnd.mLine)
 	{
-		auto& line = mLines[aStart.mLine];
+		auto& line = (*mLines)[aStart.mLine];
 		auto n = GetLineMaxColumn(aStart.mLine);
 		if (aEnd.mColumn >= n)
-			line.erase(line.begin() + start, line.end());
+			line.erase(start, line.size());
 		else
-			line.erase(line.begin() + start, line.begin() + end);
+			line.erase(start, end);
 	}
 	else
 	{
-		auto& firstLine = mLines[aStart.mLine];
-		auto& lastLine = mLines[aEnd.mLine];
+		auto& firstLine = (*mLines)[aStart.mLine];
+		auto& lastLine = (*mLines)[aEnd.mLine];
 
-		firstLine.erase(firstLine.begin() + start, firstLine.end());
-		lastLine.erase(lastLine.begin(), lastLine.begin() + end);
+		firstLine.erase(start, firstLine.size());
+		lastLine.erase(0, end);
 
 		if (aStart.mLine < aEnd.mLine)
-			firstLine.insert(firstLine.end(), lastLine.begin(), lastLine.end());
+			firstLine.insert(firstLine.size(), lastLine, 0, lastLine.size());
 
 		if (aStart.mLine < aEnd.mLine)
 			RemoveLine(aStart.mLine + 1, aEnd.mLine + 1);
@@ -266,7 +381,7 @@ int TextEditor::InsertTextAt(Coordinates& /* inout */ aWhere, const char * aValu
 	int totalLines = 0;
 	while (*aValue != '\0')
 	{
-		assert(!mLines.empty());
+		assert(!mLines->empty());
 
 		if (*aValue == '\r')
 		{
@@ -275,12 +390,13 @@ int TextEditor::InsertTextAt(Coordinates& /* inout */ aWhere, const char * aValu
 		}
 		else if (*aValue == '\n')
 		{
-			if (cindex < (int)mLines[aWhere.mLine].size())
+			if (cindex < (int)(*mLines)[aWhere.mLine].size())
 			{
 				auto& newLine = InsertLine(aWhere.mLine + 1);
-				auto& line = mLines[aWhere.mLine];
-				newLine.insert(newLine.begin(), line.begin() + cindex, line.end());
-				line.erase(line.begin() + cindex, line.end());
+				auto& line = (*mLines)[aWhere.mLine];
+				newLine.insert(0, line, cindex, line.size());
+				line.erase(cindex, line.size());
+				OnLinesChanged(aWhere.mLine, 1, 1);
 			}
 			else
 			{
@@ -294,10 +410,11 @@ int TextEditor::InsertTextAt(Coordinates& /* inout */ aWhere, const char * aValu
 		}
 		else
 		{
-			auto& line = mLines[aWhere.mLine];
+			auto& line = (*mLines)[aWhere.mLine];
 			auto d = UTF8CharLength(*aValue);
 			while (d-- > 0 && *aValue != '\0')
-				line.insert(line.begin() + cindex++, Glyph(*aValue++, PaletteIndex::Default));
+				line.insert(cindex++, Glyph(*aValue++, PaletteIndex::Default));
+			OnLinesChanged(aWhere.mLine, 1, 1);
 			++aWhere.mColumn;
 		}
 
@@ -317,9 +434,91 @@ void TextEditor::AddUndo(UndoRecord& aValue)
 	//	aValue.mAfter.mCursorPosition.mLine, aValue.mAfter.mCursorPosition.mColumn
 	//	);
 
-	mUndoBuffer.resize((size_t)(mUndoIndex + 1));
-	mUndoBuffer.back() = aValue;
-	++mUndoIndex;
+	// The edits which could be redone are dropped, with their texts (at the end of mUndoText)
+	if (mUndoIndex < (int)mUndoBuffer.size())
+	{
+		mUndoBuffer.resize((size_t)mUndoIndex);
+		mUndoText.resize((mUndoBuffer.empty() ? mUndoTextBase : mUndoBuffer.back().TextEnd()) - mUndoTextBase);
+	}
+
+	if (!CoalesceUndo(aValue))
+	{
+		UndoEntry entry;
+		entry.mText = mUndoTextBase + mUndoText.size();
+		entry.mAddedLength = (int)aValue.mAdded.size();
+		entry.mRemovedLength = (int)aValue.mRemoved.size();
+		entry.mAddedStart = aValue.mAddedStart;
+		entry.mAddedEnd = aValue.mAddedEnd;
+		entry.mRemovedStart = aValue.mRemovedStart;
+		entry.mRemovedEnd = aValue.mRemovedEnd;
+		entry.mBefore = aValue.mBefore;
+		entry.mAfter = aValue.mAfter;
+		mUndoText.append(aValue.mAdded).push_back('\0');
+		mUndoText.append(aValue.mRemoved).push_back('\0');
+		mUndoBuffer.push_back(entry);
+		++mUndoIndex;
+	}
+	TrimUndoBuffer();
+}
+
+bool TextEditor::CoalesceUndo(const UndoRecord& aValue)
+{
+	// Characters typed right after the previous ones, on the same line, extend the previous edit
+	if (mUndoBuffer.empty() || !aValue.mRemoved.empty() || aValue.mAdded.empty()
+		|| aValue.mAdded.find('\n') != std::string::npos)
+		return false;
+	auto& last = mUndoBuffer.back();
+	if (last.mRemovedLength != 0 || last.mAddedLength == 0
+		|| last.mAddedStart.mLine != last.mAddedEnd.mLine
+		|| last.mAddedEnd != aValue.mAddedStart
+		|| last.mAfter.mCursorPosition != aValue.mBefore.mCursorPosition)
+		return false;
+
+	// The added text of the last edit is at the end of mUndoText, followed by two '\0'
+	mUndoText.resize(mUndoText.size() - 2);
+	mUndoText.append(aValue.mAdded).append(2, '\0');
+	last.mAddedLength += (int)aValue.mAdded.size();
+	last.mAddedEnd = aValue.mAddedEnd;
+	last.mAfter = aValue.mAfter;
+	return true;
+}
+
+size_t TextEditor::GetUndoMemorySize() const
+{
+	size_t textSize = mUndoBuffer.empty() ? 0 : mUndoBuffer.back().TextEnd() - mUndoBuffer.front().mText;
+	return textSize + mUndoBuffer.size() * sizeof(UndoEntry);
+}
+
+void TextEditor::SetUndoMemoryBudget(size_t aBytes)
+{
+	mUndoMemoryBudget = aBytes;
+	TrimUndoBuffer();
+}
+
+void TextEditor::TrimUndoBuffer()
+{
+	// Drops the oldest edits (but never the last one done)
+	while (mUndoIndex > 1 && GetUndoMemorySize() > mUndoMemoryBudget)
+	{
+		mUndoBuffer.pop_front();
+		--mUndoIndex;
+	}
+
+	// Erases the texts of the dropped edits, once they take more room than the others
+	size_t deadSize = (mUndoBuffer.empty() ? mUndoTextBase + mUndoText.size() : mUndoBuffer.front().mText) - mUndoTextBase;
+	if (deadSize > 0 && deadSize >= mUndoText.size() - deadSize)
+	{
+		mUndoText.erase(0, deadSize);
+		mUndoTextBase += deadSize;
+	}
+}
+
+void TextEditor::ClearUndoBuffer()
+{
+	mUndoBuffer.clear();
+	mUndoIndex = 0;
+	mUndoTextBase += mUndoText.size();
+	mUndoText.clear();
 }
 
 TextEditor::Coordinates TextEditor::ScreenPosToCoordinates(const ImVec2& aPosition) const
@@ -331,9 +530,9 @@ TextEditor::Coordinates TextEditor::ScreenPosToCoordinates(const ImVec2& aPositi
 
 	int columnCoord = 0;
 
-	if (lineNo >= 0 && lineNo < (int)mLines.size())
+	if (lineNo >= 0 && lineNo < (int)mLines->size())
 	{
-		auto& line = mLines.at(lineNo);
+		auto& line = mLines->at(lineNo);
 
 		int columnIndex = 0;
 		float columnX = 0.0f;
@@ -344,7 +543,7 @@ TextEditor::Coordinates TextEditor::ScreenPosToCoordinates(const ImVec2& aPositi
 
 			if (line[columnIndex].mChar == '\t')
 			{
-				float spaceSize = ImGui::GetFont()->CalcTextSizeA(ImGui::GetFontSize(), FLT_MAX, -1.0f, " ").x;
+				float spaceSize = SpaceWidth();
 				float oldX = columnX;
 				float newColumnX = (1.0f + std::floor((1.0f + columnX) / (float(mTabSize) * spaceSize))) * (float(mTabSize) * spaceSize);
 				columnWidth = newColumnX - oldX;
@@ -356,15 +555,11 @@ TextEditor::Coordinates TextEditor::ScreenPosToCoordinates(const ImVec2& aPositi
 			}
 			else
 			{
-				char buf[7];
-				auto d = UTF8CharLength(line[columnIndex].mChar);
-				int i = 0;
-				while (i < 6 && d-- > 0)
-					buf[i++] = line[columnIndex++].mChar;
-				buf[i] = '\0';
-				columnWidth = ImGui::GetFont()->CalcTextSizeA(ImGui::GetFontSize(), FLT_MAX, -1.0f, buf).x;
+				int length;
+				columnWidth = CharacterWidth(line, columnIndex, length);
 				if (mTextStart + columnX + columnWidth * 0.5f > local.x)
 					break;
+				columnIndex += length;
 				columnX += columnWidth;
 				columnCoord++;
 			}
@@ -377,10 +572,10 @@ TextEditor::Coordinates TextEditor::ScreenPosToCoordinates(const ImVec2& aPositi
 TextEditor::Coordinates TextEditor::FindWordStart(const Coordinates & aFrom) const
 {
 	Coordinates at = aFrom;
-	if (at.mLine >= (int)mLines.size())
+	if (at.mLine >= (int)mLines->size())
 		return at;
 
-	auto& line = mLines[at.mLine];
+	auto& line = (*mLines)[at.mLine];
 	auto cindex = GetCharacterIndex(at);
 
 	if (cindex >= (int)line.size())
@@ -411,10 +606,10 @@ TextEditor::Coordinates TextEditor::FindWordStart(const Coordinates & aFrom) con
 TextEditor::Coordinates TextEditor::FindWordEnd(const Coordinates & aFrom) const
 {
 	Coordinates at = aFrom;
-	if (at.mLine >= (int)mLines.size())
+	if (at.mLine >= (int)mLines->size())
 		return at;
 
-	auto& line = mLines[at.mLine];
+	auto& line = (*mLines)[at.mLine];
 	auto cindex = GetCharacterIndex(at);
 
 	if (cindex >= (int)line.size())
@@ -444,29 +639,29 @@ TextEditor::Coordinates TextEditor::FindWordEnd(const Coordinates & aFrom) const
 TextEditor::Coordinates TextEditor::FindNextWord(const Coordinates & aFrom) const
 {
 	Coordinates at = aFrom;
-	if (at.mLine >= (int)mLines.size())
+	if (at.mLine >= (int)mLines->size())
 		return at;
 
 	// skip to the next non-word character
 	auto cindex = GetCharacterIndex(aFrom);
 	bool isword = false;
 	bool skip = false;
-	if (cindex < (int)mLines[at.mLine].size())
+	if (cindex < (int)(*mLines)[at.mLine].size())
 	{
-		auto& line = mLines[at.mLine];
+		auto& line = (*mLines)[at.mLine];
 		isword = isalnum(line[cindex].mChar);
 		skip = isword;
 	}
 
 	while (!isword || skip)
 	{
-		if (at.mLine >= mLines.size())
+		if (at.mLine >= mLines->size())
 		{
-			auto l = std::max(0, (int) mLines.size() - 1);
+			auto l = std::max(0, (int) mLines->size() - 1);
 			return Coordinates(l, GetLineMaxColumn(l));
 		}
 
-		auto& line = mLines[at.mLine];
+		auto& line = (*mLines)[at.mLine];
 		if (cindex < (int)line.size())
 		{
 			isword = isalnum(line[cindex].mChar);
@@ -493,9 +688,9 @@ TextEditor::Coordinates TextEditor::FindNextWord(const Coordinates & aFrom) cons
 
 int TextEditor::GetCharacterIndex(const Coordinates& aCoordinates) const
 {
-	if (aCoordinates.mLine >= mLines.size())
+	if (aCoordinates.mLine >= mLines->size())
 		return -1;
-	auto& line = mLines[aCoordinates.mLine];
+	auto& line = (*mLines)[aCoordinates.mLine];
 	int c = 0;
 	int i = 0;
 	for (; i < line.size() && c < aCoordinates.mColumn;)
@@ -511,9 +706,9 @@ int TextEditor::GetCharacterIndex(const Coordinates& aCoordinates) const
 
 int TextEditor::GetCharacterColumn(int aLine, int aIndex) const
 {
-	if (aLine >= mLines.size())
+	if (aLine >= mLines->size())
 		return 0;
-	auto& line = mLines[aLine];
+	auto& line = (*mLines)[aLine];
 	int col = 0;
 	int i = 0;
 	while (i < aIndex && i < (int)line.size())
@@ -530,9 +725,9 @@ int TextEditor::GetCharacterColumn(int aLine, int aIndex) const
 
 int TextEditor::GetLineCharacterCount(int aLine) const
 {
-	if (aLine >= mLines.size())
+	if (aLine >= mLines->size())
 		return 0;
-	auto& line = mLines[aLine];
+	auto& line = (*mLines)[aLine];
 	int c = 0;
 	for (unsigned i = 0; i < line.size(); c++)
 		i += UTF8CharLength(line[i].mChar);
@@ -541,9 +736,9 @@ int TextEditor::GetLineCharacterCount(int aLine) const
 
 int TextEditor::GetLineMaxColumn(int aLine) const
 {
-	if (aLine >= mLines.size())
+	if (aLine >= mLines->size())
 		return 0;
-	auto& line = mLines[aLine];
+	auto& line = (*mLines)[aLine];
 	int col = 0;
 	for (unsigned i = 0; i < line.size(); )
 	{
@@ -559,10 +754,10 @@ int TextEditor::GetLineMaxColumn(int aLine) const
 
 bool TextEditor::IsOnWordBoundary(const Coordinates & aAt) const
 {
-	if (aAt.mLine >= (int)mLines.size() || aAt.mColumn == 0)
+	if (aAt.mLine >= (int)mLines->size() || aAt.mColumn == 0)
 		return true;
 
-	auto& line = mLines[aAt.mLine];
+	auto& line = (*mLines)[aAt.mLine];
 	auto cindex = GetCharacterIndex(aAt);
 	if (cindex >= (int)line.size())
 		return true;
@@ -573,82 +768,198 @@ bool TextEditor::IsOnWordBoundary(const Coordinates & aAt) const
 	return isspace(line[cindex].mChar) != isspace(line[cindex - 1].mChar);
 }
 
-void TextEditor::RemoveLine(int aStart, int aEnd)
+void TextEditor::LineAnchors::Reset(int aLineCount)
 {
-	assert(!mReadOnly);
-	assert(aEnd >= aStart);
-	assert(mLines.size() > (size_t)(aEnd - aStart));
+	mLineCount = aLineCount;
+	mTree.clear();
+	mCounts.clear();
+	mRemoved.clear();
+}
 
-	ErrorMarkers etmp;
-	for (auto& i : mErrorMarkers)
+void TextEditor::LineAnchors::Build()
+{
+	mCounts.assign(mLineCount + 1, 1);
+	mCounts[0] = 0;
+	mRemoved.assign(mLineCount + 1, false);
+	mRemoved[0] = true;
+
+	// Linear time construction of the Fenwick tree (1-based: mTree[i + 1] is the node of slot i)
+	mTree.assign(mCounts.size() + 1, 0);
+	for (size_t i = 1; i < mTree.size(); ++i)
 	{
-		ErrorMarkers::value_type e(i.first >= aStart ? i.first - 1 : i.first, i.second);
-		if (e.first >= aStart && e.first <= aEnd)
-			continue;
-		etmp.insert(e);
+		mTree[i] += mCounts[i - 1];
+		size_t parent = i + (i & (~i + 1));
+		if (parent < mTree.size())
+			mTree[parent] += mTree[i];
 	}
-	mErrorMarkers = std::move(etmp);
+}
 
-	Breakpoints btmp;
-	for (auto i : mBreakpoints)
+void TextEditor::LineAnchors::Add(int aSlot, int aDelta)
+{
+	mCounts[aSlot] += aDelta;
+	for (size_t i = aSlot + 1; i < mTree.size(); i += i & (~i + 1))
+		mTree[i] += aDelta;
+}
+
+int TextEditor::LineAnchors::LinesBefore(int aSlot) const
+{
+	int r = 0;
+	for (size_t i = aSlot; i > 0; i -= i & (~i + 1))
+		r += mTree[i];
+	return r;
+}
+
+int TextEditor::LineAnchors::FindSlot(int aLine) const
+{
+	// Descend the tree to the last slot such that the lines before it are <= aLine
+	size_t pos = 0;
+	int remaining = aLine;
+	size_t step = 1;
+	while (step * 2 < mTree.size())
+		step *= 2;
+	for (; step > 0; step /= 2)
 	{
-		if (i >= aStart && i <= aEnd)
-			continue;
-		btmp.insert(i >= aStart ? i - 1 : i);
+		if (pos + step < mTree.size() && mTree[pos + step] <= remaining)
+		{
+			pos += step;
+			remaining -= mTree[pos];
+		}
 	}
-	mBreakpoints = std::move(btmp);
+	return pos < mCounts.size() ? (int)pos : -1;
+}
 
-	mLines.erase(mLines.begin() + aStart, mLines.begin() + aEnd);
-	assert(!mLines.empty());
+void TextEditor::LineAnchors::InsertLines(int aLine, int aCount)
+{
+	if (aCount <= 0)
+		return;
+	if (IsIdentity())
+		Build();
+	int slot = (aLine == 0) ? 0 : FindSlot(aLine - 1);
+	assert(slot >= 0);
+	Add(slot, aCount);
+}
 
-	mTextChanged = true;
+void TextEditor::LineAnchors::RemoveLines(int aLine, int aCount)
+{
+	if (aCount <= 0)
+		return;
+	if (IsIdentity())
+		Build();
+	// Each step removes the lines of one slot; the following lines then move up to aLine
+	while (aCount > 0)
+	{
+		int slot = FindSlot(aLine);
+		assert(slot >= 0);
+		int slotStart = LinesBefore(slot);
+		int removed = std::min(slotStart + mCounts[slot], aLine + aCount) - aLine;
+		if (slotStart >= aLine)
+			mRemoved[slot] = true;
+		Add(slot, -removed);
+		aCount -= removed;
+	}
 }
 
-void TextEditor::RemoveLine(int aIndex)
+int TextEditor::LineAnchors::GetAnchor(int aLine) const
 {
-	assert(!mReadOnly);
-	assert(mLines.size() > 1);
+	if (IsIdentity())
+		return aLine;
+	int slot = FindSlot(aLine);
+	if (slot < 0 || mRemoved[slot] || LinesBefore(slot) != aLine)
+		return -1;
+	return slot - 1;
+}
 
-	ErrorMarkers etmp;
+int TextEditor::LineAnchors::GetLine(int aAnchor) const
+{
+	if (IsIdentity())
+		return (aAnchor >= 0 && aAnchor < mLineCount) ? aAnchor : -1;
+	int slot = aAnchor + 1;
+	if (aAnchor < 0 || slot >= (int)mCounts.size() || mRemoved[slot])
+		return -1;
+	return LinesBefore(slot);
+}
+
+void TextEditor::SetErrorMarkers(const ErrorMarkers& aMarkers)
+{
+	RebaseLineAnchors();
+	mErrorMarkers = aMarkers;
+}
+
+void TextEditor::SetBreakpoints(const Breakpoints& aMarkers)
+{
+	RebaseLineAnchors();
+	mBreakpoints = aMarkers;
+}
+
+TextEditor::ErrorMarkers TextEditor::GetErrorMarkers() const
+{
+	ErrorMarkers r;
 	for (auto& i : mErrorMarkers)
 	{
-		ErrorMarkers::value_type e(i.first > aIndex ? i.first - 1 : i.first, i.second);
-		if (e.first - 1 == aIndex)
-			continue;
-		etmp.insert(e);
+		int line = mLineAnchors.GetLine(i.first - 1);
+		if (line >= 0)
+			r.insert(ErrorMarkers::value_type(line + 1, i.second));
 	}
-	mErrorMarkers = std::move(etmp);
+	return r;
+}
 
-	Breakpoints btmp;
+TextEditor::Breakpoints TextEditor::GetBreakpoints() const
+{
+	Breakpoints r;
 	for (auto i : mBreakpoints)
 	{
-		if (i == aIndex)
-			continue;
-		btmp.insert(i >= aIndex ? i - 1 : i);
+		int line = mLineAnchors.GetLine(i - 1);
+		if (line >= 0)
+			r.insert(line + 1);
 	}
-	mBreakpoints = std::move(btmp);
+	return r;
+}
 
-	mLines.erase(mLines.begin() + aIndex);
-	assert(!mLines.empty());
+void TextEditor::RebaseLineAnchors()
+{
+	// Renumbers the markers with the current lines: from now on, the anchors are the current lines
+	if (!mLineAnchors.IsIdentity())
+	{
+		mBreakpoints = GetBreakpoints();
+		mErrorMarkers = GetErrorMarkers();
+	}
+	mLineAnchors.Reset(GetTotalLines());
+}
+
+void TextEditor::RemoveLine(int aStart, int aEnd)
+{
+	assert(!mReadOnly);
+	assert(aEnd >= aStart);
+	assert(mLines->size() > (size_t)(aEnd - aStart));
+
+	mLines->erase(mLines->begin() + aStart, mLines->begin() + aEnd);
+	assert(!mLines->empty());
+	mLineAnchors.RemoveLines(aStart, aEnd - aStart);
+	OnLinesChanged(aStart, aEnd - aStart, 0);
 
 	mTextChanged = true;
 }
 
-TextEditor::Line& TextEditor::InsertLine(int aIndex)
+void TextEditor::RemoveLine(int aIndex)
 {
 	assert(!mReadOnly);
+	assert(mLines->size() > 1);
 
-	auto& result = *mLines.insert(mLines.begin() + aIndex, Line());
+	mLines->erase(mLines->begin() + aIndex);
+	assert(!mLines->empty());
+	mLineAnchors.RemoveLines(aIndex, 1);
+	OnLinesChanged(aIndex, 1, 0);
 
-	ErrorMarkers etmp;
-	for (auto& i : mErrorMarkers)
-		etmp.insert(ErrorMarkers::value_type(i.first >= aIndex ? i.first + 1 : i.first, i.second));
-	mErrorMarkers = std::move(etmp);
+	mTextChanged = true;
+}
 
-	Breakpoints btmp;
-	for (auto i : mBreakpoints)
-		btmp.insert(i >= aIndex ? i + 1 : i);
-	mBreakpoints = std::move(btmp);
+TextEditor::Line& TextEditor::InsertLine(int aIndex)
+{
+	assert(!mReadOnly);
+
+	auto& result = *mLines->insert(mLines->begin() + aIndex, Line());
+	mLineAnchors.InsertLines(aIndex, 1);
+	OnLinesChanged(aIndex, 0, 1);
 
 	return result;
 }
@@ -670,7 +981,7 @@ std::string TextEditor::GetWordAt(const Coordinates & aCoords) const
 	auto iend = GetCharacterIndex(end);
 
 	for (auto it = istart; it < iend; ++it)
-		r.push_back(mLines[aCoords.mLine][it].mChar);
+		r.push_back((*mLines)[aCoords.mLine][it].mChar);
 
 	return r;
 }
@@ -857,6 +1168,7 @@ void TextEditor::Render()
 	/* Compute mCharAdvance regarding to scaled font size (Ctrl + mouse wheel)*/
 	const float fontSize = ImGui::GetFont()->CalcTextSizeA(ImGui::GetFontSize(), FLT_MAX, -1.0f, "#", nullptr, nullptr).x;
 	mCharAdvance = ImVec2(fontSize, ImGui::GetTextLineHeightWithSpacing() * mLineSpacing);
+	UpdateMonospaceMetrics();
 
 	/* Update palette with the current alpha from style */
 	for (int i = 0; i < (int)PaletteIndex::Max; ++i)
@@ -883,24 +1195,24 @@ void TextEditor::Render()
 	auto scrollY = ImGui::GetScrollY();
 
 	auto lineNo = (int)floor(scrollY / mCharAdvance.y);
-	auto globalLineMax = (int)mLines.size();
-	auto lineMax = std::max(0, std::min((int)mLines.size() - 1, lineNo + (int)floor((scrollY + contentSize.y) / mCharAdvance.y)));
+	auto globalLineMax = (int)mLines->size();
+	auto lineMax = std::max(0, std::min((int)mLines->size() - 1, lineNo + (int)floor((scrollY + contentSize.y) / mCharAdvance.y)));
 
 	// Deduce mTextStart by evaluating mLines size (global lineMax) plus two spaces as text width
 	char buf[16];
 	snprintf(buf, 16, " %d ", globalLineMax);
 	mTextStart = ImGui::GetFont()->CalcTextSizeA(ImGui::GetFontSize(), FLT_MAX, -1.0f, buf, nullptr, nullptr).x + mLeftMargin;
 
-	if (!mLines.empty())
+	if (!mLines->empty())
 	{
-		float spaceSize = ImGui::GetFont()->CalcTextSizeA(ImGui::GetFontSize(), FLT_MAX, -1.0f, " ", nullptr, nullptr).x;
+		float spaceSize = SpaceWidth();
 
 		while (lineNo <= lineMax)
 		{
 			ImVec2 lineStartScreenPos = ImVec2(cursorScreenPos.x, cursorScreenPos.y + lineNo * mCharAdvance.y);
 			ImVec2 textScreenPos = ImVec2(lineStartScreenPos.x + mTextStart, lineStartScreenPos.y);
 
-			auto& line = mLines[lineNo];
+			auto& line = (*mLines)[lineNo];
 			longest = std::max(mTextStart + TextDistanceToLineStart(Coordinates(lineNo, GetLineMaxColumn(lineNo))), longest);
 			auto columnNo = 0;
 			Coordinates lineStartCoord(lineNo, 0);
@@ -929,14 +1241,15 @@ void TextEditor::Render()
 			// Draw breakpoints
 			auto start = ImVec2(lineStartScreenPos.x + scrollX, lineStartScreenPos.y);
 
-			if (mBreakpoints.count(lineNo + 1) != 0)
+			const int lineAnchor = mLineAnchors.GetAnchor(lineNo);
+			if (lineAnchor >= 0 && mBreakpoints.count(lineAnchor + 1) != 0)
 			{
 				auto end = ImVec2(lineStartScreenPos.x + contentSize.x + 2.0f * scrollX, lineStartScreenPos.y + mCharAdvance.y);
 				drawList->AddRectFilled(start, end, mPalette[(int)PaletteIndex::Breakpoint]);
 			}
 
 			// Draw error markers
-			auto errorIt = mErrorMarkers.find(lineNo + 1);
+			auto errorIt = (lineAnchor >= 0) ? mErrorMarkers.find(lineAnchor + 1) : mErrorMarkers.end();
 			if (errorIt != mErrorMarkers.end())
 			{
 				auto end = ImVec2(lineStartScreenPos.x + contentSize.x + 2.0f * scrollX, lineStartScreenPos.y + mCharAdvance.y);
@@ -946,7 +1259,7 @@ void TextEditor::Render()
 				{
 					ImGui::BeginTooltip();
 					ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.2f, 0.2f, 1.0f));
-					ImGui::Text("Error at line %d:", errorIt->first);
+					ImGui::Text("Error at line %d:", lineNo + 1);
 					ImGui::PopStyleColor();
 					ImGui::Separator();
 					ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 1.0f, 0.2f, 1.0f));
@@ -995,10 +1308,8 @@ void TextEditor::Render()
 							}
 							else
 							{
-								char buf2[2];
-								buf2[0] = line[cindex].mChar;
-								buf2[1] = '\0';
-								width = ImGui::GetFont()->CalcTextSizeA(ImGui::GetFontSize(), FLT_MAX, -1.0f, buf2).x;
+								int length;
+								width = CharacterWidth(line, cindex, length);
 							}
 						}
 						ImVec2 cstart(textScreenPos.x + cx, lineStartScreenPos.y);
@@ -1010,22 +1321,22 @@ void TextEditor::Render()
 				}
 			}
 
-			// Render colorized text
+			// Render colorized text: the color runs are gathered in mLineBuffer/mTextRuns, and drawn at once after the last line
 			auto prevColor = line.empty() ? mPalette[(int)PaletteIndex::Default] : GetGlyphColor(line[0]);
 			ImVec2 bufferOffset;
+			int runBegin = (int)mLineBuffer.size();
 
 			for (int i = 0; i < line.size();)
 			{
-				auto& glyph = line[i];
+				const auto glyph = line[i];
 				auto color = GetGlyphColor(glyph);
 
-				if ((color != prevColor || glyph.mChar == '\t' || glyph.mChar == ' ') && !mLineBuffer.empty())
+				if ((color != prevColor || glyph.mChar == '\t' || glyph.mChar == ' ') && runBegin < (int)mLineBuffer.size())
 				{
 					const ImVec2 newOffset(textScreenPos.x + bufferOffset.x, textScreenPos.y + bufferOffset.y);
-					drawList->AddText(newOffset, prevColor, mLineBuffer.c_str());
-					auto textSize = ImGui::GetFont()->CalcTextSizeA(ImGui::GetFontSize(), FLT_MAX, -1.0f, mLineBuffer.c_str(), nullptr, nullptr);
-					bufferOffset.x += textSize.x;
-					mLineBuffer.clear();
+					mTextRuns.push_back({ newOffset, prevColor, runBegin, (int)mLineBuffer.size() });
+					bufferOffset.x += TextRunWidth(runBegin, (int)mLineBuffer.size());
+					runBegin = (int)mLineBuffer.size();
 				}
 				prevColor = color;
 
@@ -1065,22 +1376,32 @@ void TextEditor::Render()
 				else
 				{
 					auto l = UTF8CharLength(glyph.mChar);
-					while (l-- > 0)
-						mLineBuffer.push_back(line[i++].mChar);
+					while (l-- > 0 && i < (int)line.size())
+						mLineBuffer.push_back(line.GetChar(i++));
 				}
 				++columnNo;
 			}
 
-			if (!mLineBuffer.empty())
+			if (runBegin < (int)mLineBuffer.size())
 			{
 				const ImVec2 newOffset(textScreenPos.x + bufferOffset.x, textScreenPos.y + bufferOffset.y);
-				drawList->AddText(newOffset, prevColor, mLineBuffer.c_str());
-				mLineBuffer.clear();
+				mTextRuns.push_back({ newOffset, prevColor, runBegin, (int)mLineBuffer.size() });
 			}
 
 			++lineNo;
 		}
 
+		// mLineBuffer does not grow anymore: the runs can now point into it
+		mDrawTextRuns.resize(mTextRuns.size());
+		for (size_t r = 0; r < mTextRuns.size(); ++r)
+		{
+			const auto& run = mTextRuns[r];
+			mDrawTextRuns[r] = { run.mPos, run.mColor, mLineBuffer.data() + run.mBegin, mLineBuffer.data() + run.mEnd };
+		}
+		drawList->AddTextRuns(ImGui::GetFont(), ImGui::GetFontSize(), mDrawTextRuns.data(), (int)mDrawTextRuns.size());
+		mTextRuns.clear();
+		mLineBuffer.clear();
+
 		// Draw a tooltip on known identifiers/preprocessor symbols
 		if (ImGui::IsMousePosValid())
 		{
@@ -1109,7 +1430,7 @@ void TextEditor::Render()
 	}
 
 
-	ImGui::Dummy(ImVec2((longest + 2), mLines.size() * mCharAdvance.y));
+	ImGui::Dummy(ImVec2((longest + 2), mLines->size() * mCharAdvance.y));
 
 	if (mScrollToCursor)
 	{
@@ -1156,8 +1477,9 @@ void TextEditor::Render(const char* aTitle, const ImVec2& aSize, bool aBorder)
 
 void TextEditor::SetText(const std::string & aText)
 {
-	mLines.clear();
-	mLines.emplace_back(Line());
+	const int previousLineCount = GetTotalLines();
+	mLines = std::make_shared<Lines>();
+	mLines->emplace_back(Line());
 	for (auto chr : aText)
 	{
 		if (chr == '\r')
@@ -1165,53 +1487,170 @@ void TextEditor::SetText(const std::string & aText)
 			// ignore the carriage return character
 		}
 		else if (chr == '\n')
-			mLines.emplace_back(Line());
+			mLines->emplace_back(Line());
 		else
 		{
-			mLines.back().emplace_back(Glyph(chr, PaletteIndex::Default));
+			mLines->back().push_back(Glyph(chr, PaletteIndex::Default));
 		}
 	}
+	OnLinesChanged(0, previousLineCount, GetTotalLines());
+	mLineAnchors.Reset(GetTotalLines());
 
 	mTextChanged = true;
 	mScrollToTop = true;
 
-	mUndoBuffer.clear();
-	mUndoIndex = 0;
+	ClearUndoBuffer();
 
 	Colorize();
 }
 
 void TextEditor::SetTextLines(const std::vector<std::string> & aLines)
 {
-	mLines.clear();
+	const int previousLineCount = GetTotalLines();
+	mLines = std::make_shared<Lines>();
 
 	if (aLines.empty())
 	{
-		mLines.emplace_back(Line());
+		mLines->emplace_back(Line());
 	}
 	else
 	{
-		mLines.resize(aLines.size());
+		mLines->resize(aLines.size());
 
 		for (size_t i = 0; i < aLines.size(); ++i)
 		{
 			const std::string & aLine = aLines[i];
 
-			mLines[i].reserve(aLine.size());
+			(*mLines)[i].reserve(aLine.size());
 			for (size_t j = 0; j < aLine.size(); ++j)
-				mLines[i].emplace_back(Glyph(aLine[j], PaletteIndex::Default));
+				(*mLines)[i].push_back(Glyph(aLine[j], PaletteIndex::Default));
 		}
 	}
+	OnLinesChanged(0, previousLineCount, GetTotalLines());
+	mLineAnchors.Reset(GetTotalLines());
 
 	mTextChanged = true;
 	mScrollToTop = true;
 
-	mUndoBuffer.clear();
-	mUndoIndex = 0;
+	ClearUndoBuffer();
+
+	Colorize();
+}
+
+TextEditor::TextSnapshot TextEditor::TakeTextSnapshot()
+{
+	TextSnapshot snapshot;
+	snapshot.mLines = std::move(mLines);
+	snapshot.mState = mState;
+	snapshot.mColorRangeMin = mColorRangeMin;
+	snapshot.mColorRangeMax = mColorRangeMax;
+	snapshot.mCheckComments = mCheckComments;
+
+	mLines = std::make_shared<Lines>();
+	mLines->emplace_back(Line());
+	OnLinesChanged(0, (int)snapshot.mLines->size(), 1);
+	mLineAnchors.Reset(1);
+	mState = EditorState();
+	ClearUndoBuffer();
+	mTextChanged = true;
+	Colorize();
+
+	return snapshot;
+}
+
+void TextEditor::RestoreTextSnapshot(TextSnapshot&& aSnapshot)
+{
+	const int previousLineCount = GetTotalLines();
+	mLines = std::move(aSnapshot.mLines);
+	if (mLines == nullptr)
+		mLines = std::make_shared<Lines>();
+	if (!mReadOnly)
+		UnshareLines();
+	if (mLines->empty())
+		mLines->emplace_back(Line());
+	OnLinesChanged(0, previousLineCount, GetTotalLines());
+	mLineAnchors.Reset(GetTotalLines());
+	mState = aSnapshot.mState;
+	mInteractiveStart = mState.mSelectionStart;
+	mInteractiveEnd = mState.mSelectionEnd;
+	mColorRangeMin = aSnapshot.mColorRangeMin;
+	mColorRangeMax = aSnapshot.mColorRangeMax;
+	mCheckComments = aSnapshot.mCheckComments;
+
+	ClearUndoBuffer();
+	mTextChanged = true;
+	EnsureCursorVisible();
+}
+
+size_t TextEditor::TextSnapshot::MemorySize() const
+{
+	size_t r = sizeof(TextSnapshot);
+	if (mLines == nullptr)
+		return r;
+	r += mLines->capacity() * sizeof(Line);
+	for (const auto& line : *mLines)
+		r += line.MemorySize();
+	return r;
+}
+
+void TextEditor::SetSharedLines(const SharedLines & aLines)
+{
+	ShareLines(aLines);
 
+	// The text may already be colorized by the editors which share it: this colorizes it again, in place
 	Colorize();
 }
 
+void TextEditor::SetSharedLines(const TextEditor & aOwner)
+{
+	ShareLines(aOwner.mLines);
+
+	// The text is already colorized (or being colorized) by aOwner: continue from where it is
+	mColorRangeMin = aOwner.mColorRangeMin;
+	mColorRangeMax = aOwner.mColorRangeMax;
+	mCheckComments = aOwner.mCheckComments;
+}
+
+void TextEditor::ShareLines(const SharedLines & aLines)
+{
+	assert(aLines != nullptr && !aLines->empty());
+	const int previousLineCount = GetTotalLines();
+	mLines = aLines;
+	OnLinesChanged(0, previousLineCount, GetTotalLines());
+	mLineAnchors.Reset(GetTotalLines());
+	if (!mReadOnly)
+		UnshareLines();
+
+	mTextChanged = true;
+	mScrollToTop = true;
+
+	ClearUndoBuffer();
+}
+
+void TextEditor::UnshareLines()
+{
+	// The editor always moves to a new text, so that the editors which could share the previous one
+	// from now on do not see the edits
+	if (mLines.use_count() > 1)
+		mLines = std::make_shared<Lines>(*mLines);
+	else
+		mLines = std::make_shared<Lines>(std::move(*mLines));
+}
+
+void TextEditor::OnLinesChanged(int aLine, int aLinesBefore, int aLinesAfter)
+{
+	if (!mTrackLinesChanges)
+		return;
+	// Typing on a line changes it once per character: report it once
+	if (aLinesBefore == 1 && aLinesAfter == 1 && !mLinesChanges.empty())
+	{
+		const auto& last = mLinesChanges.back();
+		if (aLine >= last.mLine && aLine < last.mLine + last.mLinesAfter)
+			return;
+	}
+	mLinesChanges.push_back({ aLine, aLinesBefore, aLinesAfter });
+}
+
 void TextEditor::EnterCharacter(ImWchar aChar, bool aShift)
 {
 	assert(!mReadOnly);
@@ -1232,11 +1671,11 @@ void TextEditor::EnterCharacter(ImWchar aChar, bool aShift)
 			if (start > end)
 				std::swap(start, end);
 			start.mColumn = 0;
-			//			end.mColumn = end.mLine < mLines.size() ? mLines[end.mLine].size() : 0;
+			//			end.mColumn = end.mLine < mLines->size() ? (*mLines)[end.mLine].size() : 0;
 			if (end.mColumn == 0 && end.mLine > 0)
 				--end.mLine;
-			if (end.mLine >= (int)mLines.size())
-				end.mLine = mLines.empty() ? 0 : (int)mLines.size() - 1;
+			if (end.mLine >= (int)mLines->size())
+				end.mLine = mLines->empty() ? 0 : (int)mLines->size() - 1;
 			end.mColumn = GetLineMaxColumn(end.mLine);
 
 			//if (end.mColumn >= GetLineMaxColumn(end.mLine))
@@ -1250,21 +1689,21 @@ void TextEditor::EnterCharacter(ImWchar aChar, bool aShift)
 
 			for (int i = start.mLine; i <= end.mLine; i++)
 			{
-				auto& line = mLines[i];
+				auto& line = (*mLines)[i];
 				if (aShift)
 				{
 					if (!line.empty())
 					{
-						if (line.front().mChar == '\t')
+						if (line.GetChar(0) == '\t')
 						{
-							line.erase(line.begin());
+							line.erase(0);
 							modified = true;
 						}
 						else
 						{
-							for (int j = 0; j < mTabSize && !line.empty() && line.front().mChar == ' '; j++)
+							for (int j = 0; j < mTabSize && !line.empty() && line.GetChar(0) == ' '; j++)
 							{
-								line.erase(line.begin());
+								line.erase(0);
 								modified = true;
 							}
 						}
@@ -1272,9 +1711,10 @@ void TextEditor::EnterCharacter(ImWchar aChar, bool aShift)
 				}
 				else
 				{
-					line.insert(line.begin(), Glyph('\t', TextEditor::PaletteIndex::Background));
+					line.insert(0, Glyph('\t', TextEditor::PaletteIndex::Background));
 					modified = true;
 				}
+				OnLinesChanged(i, 1, 1);
 			}
 
 			if (modified)
@@ -1321,13 +1761,13 @@ void TextEditor::EnterCharacter(ImWchar aChar, bool aShift)
 	auto coord = GetActualCursorCoordinates();
 	u.mAddedStart = coord;
 
-	assert(!mLines.empty());
+	assert(!mLines->empty());
 
 	if (aChar == '\n')
 	{
 		InsertLine(coord.mLine + 1);
-		auto& line = mLines[coord.mLine];
-		auto& newLine = mLines[coord.mLine + 1];
+		auto& line = (*mLines)[coord.mLine];
+		auto& newLine = (*mLines)[coord.mLine + 1];
 
 		if (mLanguageDefinition.mAutoIndentation)
 			for (size_t it = 0; it < line.size() && isascii(line[it].mChar) && isblank(line[it].mChar); ++it)
@@ -1335,8 +1775,9 @@ void TextEditor::EnterCharacter(ImWchar aChar, bool aShift)
 
 		const size_t whitespaceSize = newLine.size();
 		auto cindex = GetCharacterIndex(coord);
-		newLine.insert(newLine.end(), line.begin() + cindex, line.end());
-		line.erase(line.begin() + cindex, line.begin() + line.size());
+		newLine.insert(newLine.size(), line, cindex, line.size());
+		line.erase(cindex, line.size());
+		OnLinesChanged(coord.mLine, 1, 1);
 		SetCursorPosition(Coordinates(coord.mLine + 1, GetCharacterColumn(coord.mLine + 1, (int)whitespaceSize)));
 		u.mAdded = (char)aChar;
 	}
@@ -1347,7 +1788,7 @@ void TextEditor::EnterCharacter(ImWchar aChar, bool aShift)
 		if (e > 0)
 		{
 			buf[e] = '\0';
-			auto& line = mLines[coord.mLine];
+			auto& line = (*mLines)[coord.mLine];
 			auto cindex = GetCharacterIndex(coord);
 
 			if (mOverwrite && cindex < (int)line.size())
@@ -1360,12 +1801,13 @@ void TextEditor::EnterCharacter(ImWchar aChar, bool aShift)
 				while (d-- > 0 && cindex < (int)line.size())
 				{
 					u.mRemoved += line[cindex].mChar;
-					line.erase(line.begin() + cindex);
+					line.erase(cindex);
 				}
 			}
 
 			for (auto p = buf; *p != '\0'; p++, ++cindex)
-				line.insert(line.begin() + cindex, Glyph(*p, PaletteIndex::Default));
+				line.insert(cindex, Glyph(*p, PaletteIndex::Default));
+			OnLinesChanged(coord.mLine, 1, 1);
 			u.mAdded = buf;
 
 			SetCursorPosition(Coordinates(coord.mLine, GetCharacterColumn(coord.mLine, cindex)));
@@ -1387,6 +1829,8 @@ void TextEditor::EnterCharacter(ImWchar aChar, bool aShift)
 
 void TextEditor::SetReadOnly(bool aValue)
 {
+	if (mReadOnly && !aValue)
+		UnshareLines();
 	mReadOnly = aValue;
 }
 
@@ -1443,7 +1887,7 @@ void TextEditor::SetSelection(const Coordinates & aStart, const Coordinates & aE
 	case TextEditor::SelectionMode::Line:
 	{
 		const auto lineNo = mState.mSelectionEnd.mLine;
-		const auto lineSize = (size_t)lineNo < mLines.size() ? mLines[lineNo].size() : 0;
+		const auto lineSize = (size_t)lineNo < mLines->size() ? (*mLines)[lineNo].size() : 0;
 		mState.mSelectionStart = Coordinates(mState.mSelectionStart.mLine, 0);
 		mState.mSelectionEnd = Coordinates(lineNo, GetLineMaxColumn(lineNo));
 		break;
@@ -1527,7 +1971,7 @@ void TextEditor::MoveDown(int aAmount, bool aSelect)
 {
 	assert(mState.mCursorPosition.mColumn >= 0);
 	auto oldPos = mState.mCursorPosition;
-	mState.mCursorPosition.mLine = std::max(0, std::min((int)mLines.size() - 1, mState.mCursorPosition.mLine + aAmount));
+	mState.mCursorPosition.mLine = std::max(0, std::min((int)mLines->size() - 1, mState.mCursorPosition.mLine + aAmount));
 
 	if (mState.mCursorPosition != oldPos)
 	{
@@ -1558,7 +2002,7 @@ static bool IsUTFSequence(char c)
 
 void TextEditor::MoveLeft(int aAmount, bool aSelect, bool aWordMode)
 {
-	if (mLines.empty())
+	if (mLines->empty())
 		return;
 
 	auto oldPos = mState.mCursorPosition;
@@ -1573,8 +2017,8 @@ void TextEditor::MoveLeft(int aAmount, bool aSelect, bool aWordMode)
 			if (line > 0)
 			{
 				--line;
-				if ((int)mLines.size() > line)
-					cindex = (int)mLines[line].size();
+				if ((int)mLines->size() > line)
+					cindex = (int)(*mLines)[line].size();
 				else
 					cindex = 0;
 			}
@@ -1584,9 +2028,9 @@ void TextEditor::MoveLeft(int aAmount, bool aSelect, bool aWordMode)
 			--cindex;
 			if (cindex > 0)
 			{
-				if ((int)mLines.size() > line)
+				if ((int)mLines->size() > line)
 				{
-					while (cindex > 0 && IsUTFSequence(mLines[line][cindex].mChar))
+					while (cindex > 0 && IsUTFSequence((*mLines)[line][cindex].mChar))
 						--cindex;
 				}
 			}
@@ -1626,20 +2070,20 @@ void TextEditor::MoveRight(int aAmount, bool aSelect, bool aWordMode)
 {
 	auto oldPos = mState.mCursorPosition;
 
-	if (mLines.empty() || oldPos.mLine >= mLines.size())
+	if (mLines->empty() || oldPos.mLine >= mLines->size())
 		return;
 
 	auto cindex = GetCharacterIndex(mState.mCursorPosition);
 	while (aAmount-- > 0)
 	{
 		auto lindex = mState.mCursorPosition.mLine;
-		auto& line = mLines[lindex];
+		auto& line = (*mLines)[lindex];
 
 		if (cindex >= line.size())
 		{
-			if (mState.mCursorPosition.mLine < mLines.size() - 1)
+			if (mState.mCursorPosition.mLine < mLines->size() - 1)
 			{
-				mState.mCursorPosition.mLine = std::max(0, std::min((int)mLines.size() - 1, mState.mCursorPosition.mLine + 1));
+				mState.mCursorPosition.mLine = std::max(0, std::min((int)mLines->size() - 1, mState.mCursorPosition.mLine + 1));
 				mState.mCursorPosition.mColumn = 0;
 			}
 			else
@@ -1694,7 +2138,7 @@ void TextEditor::MoveTop(bool aSelect)
 void TextEditor::TextEditor::MoveBottom(bool aSelect)
 {
 	auto oldPos = GetCursorPosition();
-	auto newPos = Coordinates((int)mLines.size() - 1, 0);
+	auto newPos = Coordinates((int)mLines->size() - 1, 0);
 	SetCursorPosition(newPos);
 	if (aSelect)
 	{
@@ -1760,7 +2204,7 @@ void TextEditor::Delete()
 {
 	assert(!mReadOnly);
 
-	if (mLines.empty())
+	if (mLines->empty())
 		return;
 
 	UndoRecord u;
@@ -1778,19 +2222,20 @@ void TextEditor::Delete()
 	{
 		auto pos = GetActualCursorCoordinates();
 		SetCursorPosition(pos);
-		auto& line = mLines[pos.mLine];
+		auto& line = (*mLines)[pos.mLine];
 
 		if (pos.mColumn == GetLineMaxColumn(pos.mLine))
 		{
-			if (pos.mLine == (int)mLines.size() - 1)
+			if (pos.mLine == (int)mLines->size() - 1)
 				return;
 
 			u.mRemoved = '\n';
 			u.mRemovedStart = u.mRemovedEnd = GetActualCursorCoordinates();
 			Advance(u.mRemovedEnd);
 
-			auto& nextLine = mLines[pos.mLine + 1];
-			line.insert(line.end(), nextLine.begin(), nextLine.end());
+			auto& nextLine = (*mLines)[pos.mLine + 1];
+			line.insert(line.size(), nextLine, 0, nextLine.size());
+			OnLinesChanged(pos.mLine, 1, 1);
 			RemoveLine(pos.mLine + 1);
 		}
 		else
@@ -1802,7 +2247,8 @@ void TextEditor::Delete()
 
 			auto d = UTF8CharLength(line[cindex].mChar);
 			while (d-- > 0 && cindex < (int)line.size())
-				line.erase(line.begin() + cindex);
+				line.erase(cindex);
+			OnLinesChanged(pos.mLine, 1, 1);
 		}
 
 		mTextChanged = true;
@@ -1818,7 +2264,7 @@ void TextEditor::Backspace()
 {
 	assert(!mReadOnly);
 
-	if (mLines.empty())
+	if (mLines->empty())
 		return;
 
 	UndoRecord u;
@@ -1846,15 +2292,11 @@ void TextEditor::Backspace()
 			u.mRemovedStart = u.mRemovedEnd = Coordinates(pos.mLine - 1, GetLineMaxColumn(pos.mLine - 1));
 			Advance(u.mRemovedEnd);
 
-			auto& line = mLines[mState.mCursorPosition.mLine];
-			auto& prevLine = mLines[mState.mCursorPosition.mLine - 1];
+			auto& line = (*mLines)[mState.mCursorPosition.mLine];
+			auto& prevLine = (*mLines)[mState.mCursorPosition.mLine - 1];
 			auto prevSize = GetLineMaxColumn(mState.mCursorPosition.mLine - 1);
-			prevLine.insert(prevLine.end(), line.begin(), line.end());
-
-			ErrorMarkers etmp;
-			for (auto& i : mErrorMarkers)
-				etmp.insert(ErrorMarkers::value_type(i.first - 1 == mState.mCursorPosition.mLine ? i.first - 1 : i.first, i.second));
-			mErrorMarkers = std::move(etmp);
+			prevLine.insert(prevLine.size(), line, 0, line.size());
+			OnLinesChanged(mState.mCursorPosition.mLine - 1, 1, 1);
 
 			RemoveLine(mState.mCursorPosition.mLine);
 			--mState.mCursorPosition.mLine;
@@ -1862,7 +2304,7 @@ void TextEditor::Backspace()
 		}
 		else
 		{
-			auto& line = mLines[mState.mCursorPosition.mLine];
+			auto& line = (*mLines)[mState.mCursorPosition.mLine];
 			auto cindex = GetCharacterIndex(pos) - 1;
 			auto cend = cindex + 1;
 			while (cindex > 0 && IsUTFSequence(line[cindex].mChar))
@@ -1878,8 +2320,9 @@ void TextEditor::Backspace()
 			while (cindex < line.size() && cend-- > cindex)
 			{
 				u.mRemoved += line[cindex].mChar;
-				line.erase(line.begin() + cindex);
+				line.erase(cindex);
 			}
+			OnLinesChanged(mState.mCursorPosition.mLine, 1, 1);
 		}
 
 		mTextChanged = true;
@@ -1900,7 +2343,7 @@ void TextEditor::SelectWordUnderCursor()
 
 void TextEditor::SelectAll()
 {
-	SetSelection(Coordinates(0, 0), Coordinates((int)mLines.size(), 0));
+	SetSelection(Coordinates(0, 0), Coordinates((int)mLines->size(), 0));
 }
 
 bool TextEditor::HasSelection() const
@@ -1916,12 +2359,10 @@ void TextEditor::Copy()
 	}
 	else
 	{
-		if (!mLines.empty())
+		if (!mLines->empty())
 		{
-			std::string str;
-			auto& line = mLines[GetActualCursorCoordinates().mLine];
-			for (auto& g : line)
-				str.push_back(g.mChar);
+			auto& line = (*mLines)[GetActualCursorCoordinates().mLine];
+			std::string str((const char*)line.data(), line.size());
 			ImGui::SetClipboardText(str.c_str());
 		}
 	}
@@ -1995,13 +2436,13 @@ bool TextEditor::CanRedo() const
 void TextEditor::Undo(int aSteps)
 {
 	while (CanUndo() && aSteps-- > 0)
-		mUndoBuffer[--mUndoIndex].Undo(this);
+		UndoEdit(mUndoBuffer[--mUndoIndex]);
 }
 
 void TextEditor::Redo(int aSteps)
 {
 	while (CanRedo() && aSteps-- > 0)
-		mUndoBuffer[mUndoIndex++].Redo(this);
+		RedoEdit(mUndoBuffer[mUndoIndex++]);
 }
 
 const TextEditor::Palette & TextEditor::GetDarkPalette()
@@ -2091,25 +2532,18 @@ const TextEditor::Palette & TextEditor::GetRetroBluePalette()
 
 std::string TextEditor::GetText() const
 {
-	return GetText(Coordinates(), Coordinates((int)mLines.size(), 0));
+	return GetText(Coordinates(), Coordinates((int)mLines->size(), 0));
 }
 
 std::vector<std::string> TextEditor::GetTextLines() const
 {
 	std::vector<std::string> result;
 
-	result.reserve(mLines.size());
+	result.reserve(mLines->size());
 
-	for (auto & line : mLines)
+	for (auto & line : *mLines)
 	{
-		std::string text;
-
-		text.resize(line.size());
-
-		for (size_t i = 0; i < line.size(); ++i)
-			text[i] = line[i].mChar;
-
-		result.emplace_back(std::move(text));
+		result.emplace_back((const char*)line.data(), line.size());
 	}
 
 	return result;
@@ -2128,13 +2562,27 @@ std::string TextEditor::GetCurrentLineText()const
 		Coordinates(mState.mCursorPosition.mLine, lineLength));
 }
 
+void TextEditor::GetSelectedText(std::pmr::string& aText) const
+{
+	GetTextInto(mState.mSelectionStart, mState.mSelectionEnd, aText);
+}
+
+void TextEditor::GetLineText(int aLine, std::pmr::string& aText) const
+{
+	aText.clear();
+	if (aLine < 0 || aLine >= (int)mLines->size())
+		return;
+	auto& line = (*mLines)[aLine];
+	aText.assign((const char*)line.data(), line.size());
+}
+
 void TextEditor::ProcessInputs()
 {
 }
 
 void TextEditor::Colorize(int aFromLine, int aLines)
 {
-	int toLine = aLines == -1 ? (int)mLines.size() : std::min((int)mLines.size(), aFromLine + aLines);
+	int toLine = aLines == -1 ? (int)mLines->size() : std::min((int)mLines->size(), aFromLine + aLines);
 	mColorRangeMin = std::min(mColorRangeMin, aFromLine);
 	mColorRangeMax = std::max(mColorRangeMax, toLine);
 	mColorRangeMin = std::max(0, mColorRangeMin);
@@ -2144,31 +2592,26 @@ void TextEditor::Colorize(int aFromLine, int aLines)
 
 void TextEditor::ColorizeRange(int aFromLine, int aToLine)
 {
-	if (mLines.empty() || aFromLine >= aToLine)
+	if (mLines->empty() || aFromLine >= aToLine)
 		return;
 
-	std::string buffer;
 	std::cmatch results;
 	std::string id;
 
-	int endLine = std::max(0, std::min((int)mLines.size(), aToLine));
+	int endLine = std::max(0, std::min((int)mLines->size(), aToLine));
 	for (int i = aFromLine; i < endLine; ++i)
 	{
-		auto& line = mLines[i];
+		auto& line = (*mLines)[i];
 
 		if (line.empty())
 			continue;
 
-		buffer.resize(line.size());
 		for (size_t j = 0; j < line.size(); ++j)
-		{
-			auto& col = line[j];
-			buffer[j] = col.mChar;
-			col.mColorIndex = PaletteIndex::Default;
-		}
+			line.SetColorIndex(j, PaletteIndex::Default);
 
-		const char * bufferBegin = &buffer.front();
-		const char * bufferEnd = bufferBegin + buffer.size();
+		// The chars of a line are contiguous: they are tokenized in place
+		const char * bufferBegin = (const char*)line.data();
+		const char * bufferEnd = bufferBegin + line.size();
 
 		auto last = bufferEnd;
 
@@ -2222,7 +2665,7 @@ void TextEditor::ColorizeRange(int aFromLine, int aToLine)
 					if (!mLanguageDefinition.mCaseSensitive)
 						std::transform(id.begin(), id.end(), id.begin(), ::toupper);
 
-					if (!line[first - bufferBegin].mPreprocessor)
+					if (!line.IsPreprocessor(first - bufferBegin))
 					{
 						if (mLanguageDefinition.mKeywords.count(id) != 0)
 							token_color = PaletteIndex::Keyword;
@@ -2239,7 +2682,7 @@ void TextEditor::ColorizeRange(int aFromLine, int aToLine)
 				}
 
 				for (size_t j = 0; j < token_length; ++j)
-					line[(token_begin - bufferBegin) + j].mColorIndex = token_color;
+					line.SetColorIndex((token_begin - bufferBegin) + j, token_color);
 
 				first = token_end;
 			}
@@ -2249,12 +2692,12 @@ void TextEditor::ColorizeRange(int aFromLine, int aToLine)
 
 void TextEditor::ColorizeInternal()
 {
-	if (mLines.empty() || !mColorizerEnabled)
+	if (mLines->empty() || !mColorizerEnabled)
 		return;
 
 	if (mCheckComments)
 	{
-		auto endLine = mLines.size();
+		auto endLine = mLines->size();
 		auto endIndex = 0;
 		auto commentStartLine = endLine;
 		auto commentStartIndex = endIndex;
@@ -2267,7 +2710,7 @@ void TextEditor::ColorizeInternal()
 		auto currentIndex = 0;
 		while (currentLine < endLine || currentIndex < endIndex)
 		{
-			auto& line = mLines[currentLine];
+			auto& line = (*mLines)[currentLine];
 
 			if (currentIndex == 0 && !concatenate)
 			{
@@ -2280,28 +2723,27 @@ void TextEditor::ColorizeInternal()
 
 			if (!line.empty())
 			{
-				auto& g = line[currentIndex];
-				auto c = g.mChar;
+				auto c = line.GetChar(currentIndex);
 
 				if (c != mLanguageDefinition.mPreprocChar && !isspace(c))
 					firstChar = false;
 
-				if (currentIndex == (int)line.size() - 1 && line[line.size() - 1].mChar == '\\')
+				if (currentIndex == (int)line.size() - 1 && line.GetChar(line.size() - 1) == '\\')
 					concatenate = true;
 
 				bool inComment = (commentStartLine < currentLine || (commentStartLine == currentLine && commentStartIndex <= currentIndex));
 
 				if (withinString)
 				{
-					line[currentIndex].mMultiLineComment = inComment;
+					line.SetMultiLineComment(currentIndex, inComment);
 
 					if (c == '\"')
 					{
-						if (currentIndex + 1 < (int)line.size() && line[currentIndex + 1].mChar == '\"')
+						if (currentIndex + 1 < (int)line.size() && line.GetChar(currentIndex + 1) == '\"')
 						{
 							currentIndex += 1;
 							if (currentIndex < (int)line.size())
-								line[currentIndex].mMultiLineComment = inComment;
+								line.SetMultiLineComment(currentIndex, inComment);
 						}
 						else
 							withinString = false;
@@ -2310,7 +2752,7 @@ void TextEditor::ColorizeInternal()
 					{
 						currentIndex += 1;
 						if (currentIndex < (int)line.size())
-							line[currentIndex].mMultiLineComment = inComment;
+							line.SetMultiLineComment(currentIndex, inComment);
 					}
 				}
 				else
@@ -2321,12 +2763,12 @@ void TextEditor::ColorizeInternal()
 					if (c == '\"')
 					{
 						withinString = true;
-						line[currentIndex].mMultiLineComment = inComment;
+						line.SetMultiLineComment(currentIndex, inComment);
 					}
 					else
 					{
-						auto pred = [](const char& a, const Glyph& b) { return a == b.mChar; };
-						auto from = line.begin() + currentIndex;
+						auto pred = [](const char& a, const Char& b) { return a == b; };
+						auto from = line.data() + currentIndex;
 						auto& startStr = mLanguageDefinition.mCommentStart;
 						auto& singleStartStr = mLanguageDefinition.mSingleLineComment;
 
@@ -2345,8 +2787,8 @@ void TextEditor::ColorizeInternal()
 
 						inComment = inComment = (commentStartLine < currentLine || (commentStartLine == currentLine && commentStartIndex <= currentIndex));
 
-						line[currentIndex].mMultiLineComment = inComment;
-						line[currentIndex].mComment = withinSingleLineComment;
+						line.SetMultiLineComment(currentIndex, inComment);
+						line.SetComment(currentIndex, withinSingleLineComment);
 
 						auto& endStr = mLanguageDefinition.mCommentEnd;
 						if (currentIndex + 1 >= (int)endStr.size() &&
@@ -2357,7 +2799,7 @@ void TextEditor::ColorizeInternal()
 						}
 					}
 				}
-				line[currentIndex].mPreprocessor = withinPreproc;
+				line.SetPreprocessor(currentIndex, withinPreproc);
 				currentIndex += UTF8CharLength(c);
 				if (currentIndex >= (int)line.size())
 				{
@@ -2392,33 +2834,106 @@ void TextEditor::ColorizeInternal()
 
 float TextEditor::TextDistanceToLineStart(const Coordinates& aFrom) const
 {
-	auto& line = mLines[aFrom.mLine];
+	auto& line = (*mLines)[aFrom.mLine];
+	if (mUseMonospaceFastPath)
+	{
+		// Without tabs nor multi-byte characters before it, a column is a character of the monospace advance
+		int nbChars = std::max(std::min(aFrom.mColumn, (int)line.size()), 0);
+		if (std::none_of(line.data(), line.data() + nbChars, [](Char c) { return c == '\t' || (c & 0x80) != 0; }))
+			return (float)nbChars * mMonospace.mAdvance;
+	}
+
 	float distance = 0.0f;
-	float spaceSize = ImGui::GetFont()->CalcTextSizeA(ImGui::GetFontSize(), FLT_MAX, -1.0f, " ", nullptr, nullptr).x;
+	float spaceSize = SpaceWidth();
 	int colIndex = GetCharacterIndex(aFrom);
 	for (size_t it = 0u; it < line.size() && it < colIndex; )
 	{
-		if (line[it].mChar == '\t')
+		if (line.GetChar(it) == '\t')
 		{
 			distance = (1.0f + std::floor((1.0f + distance) / (float(mTabSize) * spaceSize))) * (float(mTabSize) * spaceSize);
 			++it;
 		}
 		else
 		{
-			auto d = UTF8CharLength(line[it].mChar);
-			char tempCString[7];
-			int i = 0;
-			for (; i < 6 && d-- > 0 && it < (int)line.size(); i++, it++)
-				tempCString[i] = line[it].mChar;
-
-			tempCString[i] = '\0';
-			distance += ImGui::GetFont()->CalcTextSizeA(ImGui::GetFontSize(), FLT_MAX, -1.0f, tempCString, nullptr, nullptr).x;
+			int length;
+			distance += CharacterWidth(line, (int)it, length);
+			it += length;
 		}
 	}
 
 	return distance;
 }
 
+// Width of the (UTF-8) character which starts at aLine[aIndex]; aLength receives its number of bytes
+float TextEditor::CharacterWidth(const Line& aLine, int aIndex, int& aLength) const
+{
+	auto d = UTF8CharLength(aLine.GetChar(aIndex));
+	if (mUseMonospaceFastPath && d == 1)
+	{
+		aLength = 1;
+		return mMonospace.mAdvance;
+	}
+
+	char tempCString[7];
+	int i = 0;
+	for (; i < 6 && d-- > 0 && aIndex + i < (int)aLine.size(); i++)
+		tempCString[i] = aLine.GetChar(aIndex + i);
+	tempCString[i] = '\0';
+	aLength = std::max(i, 1);
+	return ImGui::GetFont()->CalcTextSizeA(ImGui::GetFontSize(), FLT_MAX, -1.0f, tempCString, nullptr, nullptr).x;
+}
+
+float TextEditor::SpaceWidth() const
+{
+	if (mUseMonospaceFastPath)
+		return mMonospace.mAdvance;
+	return ImGui::GetFont()->CalcTextSizeA(ImGui::GetFontSize(), FLT_MAX, -1.0f, " ", nullptr, nullptr).x;
+}
+
+// Width of the text mLineBuffer[aBegin, aEnd)
+float TextEditor::TextRunWidth(int aBegin, int aEnd) const
+{
+	const char* text = mLineBuffer.data();
+	if (!mUseMonospaceFastPath)
+		return ImGui::GetFont()->CalcTextSizeA(ImGui::GetFontSize(), FLT_MAX, -1.0f, text + aBegin, text + aEnd, nullptr).x;
+
+	float width = 0.0f;
+	for (int i = aBegin; i < aEnd; )
+	{
+		int length = std::min(UTF8CharLength(text[i]), aEnd - i);
+		if (length == 1)
+			width += mMonospace.mAdvance;
+		else
+			width += ImGui::GetFont()->CalcTextSizeA(ImGui::GetFontSize(), FLT_MAX, -1.0f, text + i, text + i + length, nullptr).x;
+		i += length;
+	}
+	return width;
+}
+
+void TextEditor::UpdateMonospaceMetrics()
+{
+	const ImFont* font = ImGui::GetFont();
+	const float fontSize = ImGui::GetFontSize();
+	if (font != mMonospace.mFont || fontSize != mMonospace.mFontSize)
+	{
+		mMonospace.mFont = font;
+		mMonospace.mFontSize = fontSize;
+		mMonospace.mIsMonospace = true;
+		const float scale = fontSize / font->FontSize;
+		const float advance = font->GetCharAdvance((ImWchar)' ') * scale;
+		for (ImWchar c = 0x21; c < 0x7F; ++c)
+		{
+			if (font->FindGlyphNoFallback(c) == nullptr || font->GetCharAdvance(c) * scale != advance)
+			{
+				mMonospace.mIsMonospace = false;
+				break;
+			}
+		}
+		mMonospace.mAdvance = advance;
+	}
+	mUseMonospaceFastPath = mMonospaceMode && mMonospace.mIsMonospace;
+}
+
 void TextEditor::EnsureCursorVisible(int cursorLineOnPage)
 {
 	if (!mWithinRender)
@@ -2488,43 +3003,43 @@ TextEditor::UndoRecord::UndoRecord(
 	assert(mRemovedStart <= mRemovedEnd);
 }
 
-void TextEditor::UndoRecord::Undo(TextEditor * aEditor)
+void TextEditor::UndoEdit(const UndoEntry& aEntry)
 {
-	if (!mAdded.empty())
+	if (aEntry.mAddedLength > 0)
 	{
-		aEditor->DeleteRange(mAddedStart, mAddedEnd);
-		aEditor->Colorize(mAddedStart.mLine - 1, mAddedEnd.mLine - mAddedStart.mLine + 2);
+		DeleteRange(aEntry.mAddedStart, aEntry.mAddedEnd);
+		Colorize(aEntry.mAddedStart.mLine - 1, aEntry.mAddedEnd.mLine - aEntry.mAddedStart.mLine + 2);
 	}
 
-	if (!mRemoved.empty())
+	if (aEntry.mRemovedLength > 0)
 	{
-		auto start = mRemovedStart;
-		aEditor->InsertTextAt(start, mRemoved.c_str());
-		aEditor->Colorize(mRemovedStart.mLine - 1, mRemovedEnd.mLine - mRemovedStart.mLine + 2);
+		auto start = aEntry.mRemovedStart;
+		InsertTextAt(start, UndoText(aEntry.mText + aEntry.mAddedLength + 1));
+		Colorize(aEntry.mRemovedStart.mLine - 1, aEntry.mRemovedEnd.mLine - aEntry.mRemovedStart.mLine + 2);
 	}
 
-	aEditor->mState = mBefore;
-	aEditor->EnsureCursorVisible();
+	mState = aEntry.mBefore;
+	EnsureCursorVisible();
 
 }
 
-void TextEditor::UndoRecord::Redo(TextEditor * aEditor)
+void TextEditor::RedoEdit(const UndoEntry& aEntry)
 {
-	if (!mRemoved.empty())
+	if (aEntry.mRemovedLength > 0)
 	{
-		aEditor->DeleteRange(mRemovedStart, mRemovedEnd);
-		aEditor->Colorize(mRemovedStart.mLine - 1, mRemovedEnd.mLine - mRemovedStart.mLine + 1);
+		DeleteRange(aEntry.mRemovedStart, aEntry.mRemovedEnd);
+		Colorize(aEntry.mRemovedStart.mLine - 1, aEntry.mRemovedEnd.mLine - aEntry.mRemovedStart.mLine + 1);
 	}
 
-	if (!mAdded.empty())
+	if (aEntry.mAddedLength > 0)
 	{
-		auto start = mAddedStart;
-		aEditor->InsertTextAt(start, mAdded.c_str());
-		aEditor->Colorize(mAddedStart.mLine - 1, mAddedEnd.mLine - mAddedStart.mLine + 1);
+		auto start = aEntry.mAddedStart;
+		InsertTextAt(start, UndoText(aEntry.mText));
+		Colorize(aEntry.mAddedStart.mLine - 1, aEntry.mAddedEnd.mLine - aEntry.mAddedStart.mLine + 1);
 	}
 
-	aEditor->mState = mAfter;
-	aEditor->EnsureCursorVisible();
+	mState = aEntry.mAfter;
+	EnsureCursorVisible();
 }
 
 static bool TokenizeCStyleString(const char * in_begin, const char * in_end, const char *& out_begin, const char *& out_end)
@@ -3,7 +3,9 @@
 #include <string>
 #include <vector>
 #include <array>
+#include <deque>
 #include <memory>
+#include <memory_resource>
 #include <unordered_set>
 #include <unordered_map>
 #include <map>
@@ -145,7 +147,65 @@ public:
 			mComment(false), mMultiLineComment(false), mPreprocessor(false) {}
 	};
 
-	typedef std::vector<Glyph> Line;
+	// A line of text, stored as a structure of arrays: the chars in one array, and their colorization
+	// metadata in another one, packed per group of 8 glyphs: their 8 palette indices (4 bits each),
+	// then one bitset per flag (comment, multi-line comment, preprocessor).
+	// This takes 15 bits per glyph. operator[] returns an unpacked copy of a glyph:
+	// use the setters to modify its metadata.
+	class Line
+	{
+	public:
+		size_t size() const { return mChars.size(); }
+		bool empty() const { return mChars.empty(); }
+		void reserve(size_t aSize);
+		const Char* data() const { return mChars.data(); }
+		size_t MemorySize() const { return mChars.capacity() + mMetadata.capacity(); }
+
+		Glyph operator[](size_t aIndex) const
+		{
+			Glyph r(mChars[aIndex], GetColorIndex(aIndex));
+			r.mComment = IsComment(aIndex);
+			r.mMultiLineComment = IsMultiLineComment(aIndex);
+			r.mPreprocessor = IsPreprocessor(aIndex);
+			return r;
+		}
+		Char GetChar(size_t aIndex) const { return mChars[aIndex]; }
+		PaletteIndex GetColorIndex(size_t aIndex) const { return (PaletteIndex)((Group(aIndex)[aIndex % GroupSize / 2] >> NibbleShift(aIndex)) & 0xF); }
+		bool IsComment(size_t aIndex) const { return GetFlag(aIndex, CommentBits); }
+		bool IsMultiLineComment(size_t aIndex) const { return GetFlag(aIndex, MultiLineCommentBits); }
+		bool IsPreprocessor(size_t aIndex) const { return GetFlag(aIndex, PreprocessorBits); }
+
+		void SetColorIndex(size_t aIndex, PaletteIndex aValue);
+		void SetComment(size_t aIndex, bool aValue) { SetFlag(aIndex, CommentBits, aValue); }
+		void SetMultiLineComment(size_t aIndex, bool aValue) { SetFlag(aIndex, MultiLineCommentBits, aValue); }
+		void SetPreprocessor(size_t aIndex, bool aValue) { SetFlag(aIndex, PreprocessorBits, aValue); }
+
+		void push_back(const Glyph& aGlyph);
+		void insert(size_t aIndex, const Glyph& aGlyph);
+		void insert(size_t aIndex, const Line& aFrom, size_t aBegin, size_t aEnd);  // inserts aFrom[aBegin, aEnd)
+		void erase(size_t aBegin, size_t aEnd);
+		void erase(size_t aIndex) { erase(aIndex, aIndex + 1); }
+
+	private:
+		// Layout of a group: 4 bytes of palette indices, then the comment, multi-line comment & preprocessor bitsets
+		enum { GroupSize = 8, GroupBytes = 7, CommentBits = 4, MultiLineCommentBits = 5, PreprocessorBits = 6 };
+
+		const uint8_t* Group(size_t aIndex) const { return &mMetadata[aIndex / GroupSize * GroupBytes]; }
+		uint8_t* Group(size_t aIndex) { return &mMetadata[aIndex / GroupSize * GroupBytes]; }
+		static int NibbleShift(size_t aIndex) { return (int)(aIndex % 2) * 4; }
+		bool GetFlag(size_t aIndex, int aBits) const { return (Group(aIndex)[aBits] >> (aIndex % GroupSize)) & 1; }
+		void SetFlag(size_t aIndex, int aBits, bool aValue);
+
+		// All the metadata of a glyph in one byte (palette index in the low nibble, then the flags),
+		// used to move glyphs within the line
+		uint8_t GetPackedMetadata(size_t aIndex) const;
+		void SetPackedMetadata(size_t aIndex, uint8_t aValue);
+		static uint8_t PackMetadata(const Glyph& aGlyph);
+		void Resize(size_t aSize);  // the metadata of the added glyphs is left unset
+
+		std::vector<Char> mChars;
+		std::vector<uint8_t> mMetadata;
+	};
 	typedef std::vector<Line> Lines;
 
 	struct LanguageDefinition
@@ -191,8 +251,11 @@ public:
 	const Palette& GetPalette() const { return mPaletteBase; }
 	void SetPalette(const Palette& aValue);
 
-	void SetErrorMarkers(const ErrorMarkers& aMarkers) { mErrorMarkers = aMarkers; }
-	void SetBreakpoints(const Breakpoints& aMarkers) { mBreakpoints = aMarkers; }
+	// The markers follow their line when lines are inserted or removed above it
+	void SetErrorMarkers(const ErrorMarkers& aMarkers);
+	void SetBreakpoints(const Breakpoints& aMarkers);
+	ErrorMarkers GetErrorMarkers() const;
+	Breakpoints GetBreakpoints() const;
 
 	void Render(const char* aTitle, const ImVec2& aSize = ImVec2(), bool aBorder = false);
 	void SetText(const std::string& aText);
@@ -201,10 +264,32 @@ public:
 	void SetTextLines(const std::vector<std::string>& aLines);
 	std::vector<std::string> GetTextLines() const;
 
+	// The colorized text held by the editor (plus its cursor & selection).
+	// It can be moved out of the editor and restored later, so that switching between
+	// several files does not require to re-split and re-colorize them.
+	struct TextSnapshot;
+	TextSnapshot TakeTextSnapshot();
+	void RestoreTextSnapshot(TextSnapshot&& aSnapshot);
+
+	// Read-only editors which display the same text can share it, instead of each holding a copy:
+	// SetSharedLines() makes an editor display the text returned by GetSharedLines() on another one.
+	// An editor copies its text when it becomes writable (copy-on-write).
+	// The shared text is colorized in place: the editors which share it shall use the same language definition.
+	// SetSharedLines(aOwner) also takes over the colorizer progress of aOwner, instead of colorizing the text again.
+	typedef std::shared_ptr<Lines> SharedLines;
+	const SharedLines& GetSharedLines() const { return mLines; }
+	void SetSharedLines(const SharedLines& aLines);
+	void SetSharedLines(const TextEditor& aOwner);
+	bool IsColorizationPending() const { return mCheckComments || mColorRangeMin < mColorRangeMax; }
+	bool IsTextShared() const { return mLines.use_count() > 1; }
+
 	std::string GetSelectedText() const;
 	std::string GetCurrentLineText()const;
+	// Variants which write into aText, and keep its allocator (it may be a per-frame arena)
+	void GetSelectedText(std::pmr::string& aText) const;
+	void GetLineText(int aLine, std::pmr::string& aText) const;
 
-	int GetTotalLines() const { return (int)mLines.size(); }
+	int GetTotalLines() const { return (int)mLines->size(); }
 	bool IsOverwrite() const { return mOverwrite; }
 
 	void SetReadOnly(bool aValue);
@@ -230,6 +315,12 @@ public:
 	inline void SetShowWhitespaces(bool aValue) { mShowWhitespaces = aValue; }
 	inline bool IsShowingWhitespaces() const { return mShowWhitespaces; }
 
+	// Monospace mode: if the current font has the same advance for all printable ASCII characters,
+	// text positions are computed arithmetically, and glyphs are emitted directly into the draw list
+	// (this is checked once per font & size; other fonts use the generic text measurement)
+	inline void SetMonospaceMode(bool aValue) { mMonospaceMode = aValue; }
+	inline bool IsMonospaceMode() const { return mMonospaceMode; }
+
 	void SetTabSize(int aValue);
 	inline int GetTabSize() const { return mTabSize; }
 
@@ -262,6 +353,27 @@ public:
 	void Undo(int aSteps = 1);
 	void Redo(int aSteps = 1);
 
+	// The undo history is bounded by a memory budget (in bytes): the oldest edits are dropped first.
+	// Consecutive characters typed on a line are recorded as one edit.
+	void SetUndoMemoryBudget(size_t aBytes);
+	size_t GetUndoMemoryBudget() const { return mUndoMemoryBudget; }
+	size_t GetUndoMemorySize() const;
+
+	// The line ranges changed by the edits, for clients which index data by line number (e.g. a table of content).
+	// Tracking is off by default. Once enabled, each edit appends a LinesChange, in order;
+	// the client reads them, then clears them.
+	struct LinesChange
+	{
+		int mLine;          // the lines [mLine, mLine + mLinesBefore) were replaced
+		int mLinesBefore;   // by the lines [mLine, mLine + mLinesAfter)
+		int mLinesAfter;
+	};
+	typedef std::vector<LinesChange> LinesChanges;
+	void SetTrackLinesChanges(bool aValue) { mTrackLinesChanges = aValue; mLinesChanges.clear(); }
+	bool IsTrackingLinesChanges() const { return mTrackLinesChanges; }
+	const LinesChanges& GetLinesChanges() const { return mLinesChanges; }
+	void ClearLinesChanges() { mLinesChanges.clear(); }
+
 	static const Palette& GetDarkPalette();
 	static const Palette& GetLightPalette();
 	static const Palette& GetRetroBluePalette();
@@ -276,6 +388,7 @@ private:
 		Coordinates mCursorPosition;
 	};
 
+	// An edit being recorded (see AddUndo)
 	class UndoRecord
 	{
 	public:
@@ -294,9 +407,6 @@ private:
 			TextEditor::EditorState& aBefore,
 			TextEditor::EditorState& aAfter);
 
-		void Undo(TextEditor* aEditor);
-		void Redo(TextEditor* aEditor);
-
 		std::string mAdded;
 		Coordinates mAddedStart;
 		Coordinates mAddedEnd;
@@ -309,22 +419,91 @@ private:
 		EditorState mAfter;
 	};
 
-	typedef std::vector<UndoRecord> UndoBuffer;
+	// An edit of the undo history. Its texts are stored in mUndoText, at mText:
+	// the added text, then the removed one, each followed by '\0'
+	struct UndoEntry
+	{
+		size_t mText;  // offset since the creation of mUndoText (see mUndoTextBase)
+		int mAddedLength;
+		int mRemovedLength;
+		Coordinates mAddedStart;
+		Coordinates mAddedEnd;
+		Coordinates mRemovedStart;
+		Coordinates mRemovedEnd;
+		EditorState mBefore;
+		EditorState mAfter;
+
+		size_t TextEnd() const { return mText + mAddedLength + mRemovedLength + 2; }
+	};
+
+	typedef std::deque<UndoEntry> UndoBuffer;
+
+	// The breakpoints and error markers keep the line numbers they were set with (their "anchors"):
+	// LineAnchors maps the current lines to them, so that inserting or removing lines does not renumber them all.
+	// Each anchor owns its own line, plus the lines inserted after it (slot 0 owns the lines inserted before the first one);
+	// a Fenwick tree of these line counts gives a line <-> anchor lookup in O(log n).
+	// Until the first edit, the mapping is the identity, and nothing is allocated.
+	class LineAnchors
+	{
+	public:
+		void Reset(int aLineCount);
+		bool IsIdentity() const { return mTree.empty(); }
+		void InsertLines(int aLine, int aCount);  // before the current line aLine
+		void RemoveLines(int aLine, int aCount);
+		int GetAnchor(int aLine) const;  // -1 if the line was inserted since Reset()
+		int GetLine(int aAnchor) const;  // -1 if the anchor's line was removed
+
+	private:
+		void Build();
+		void Add(int aSlot, int aDelta);
+		int LinesBefore(int aSlot) const;
+		int FindSlot(int aLine) const;  // the slot which owns the current line aLine, -1 if beyond the last line
+
+		int mLineCount = 0;         // number of anchors
+		std::vector<int> mTree;     // Fenwick tree of mCounts
+		std::vector<int> mCounts;   // number of lines owned by each slot (slot i + 1 is the anchor i)
+		std::vector<bool> mRemoved; // the slot's own line was removed
+	};
+
+public:
+	struct TextSnapshot
+	{
+		SharedLines mLines;
+		EditorState mState;
+		int mColorRangeMin = 0, mColorRangeMax = 0;
+		bool mCheckComments = true;
+
+		// Approximate memory used by the text, in bytes
+		size_t MemorySize() const;
+	};
+
+private:
 
 	void ProcessInputs();
 	void Colorize(int aFromLine = 0, int aCount = -1);
 	void ColorizeRange(int aFromLine = 0, int aToLine = 0);
 	void ColorizeInternal();
 	float TextDistanceToLineStart(const Coordinates& aFrom) const;
+	float CharacterWidth(const Line& aLine, int aIndex, int& aLength) const;
+	float SpaceWidth() const;
+	void UpdateMonospaceMetrics();
+	float TextRunWidth(int aBegin, int aEnd) const;
 	void EnsureCursorVisible(int cursorLineOnPage = -1);
 	int GetPageSize() const;
 	std::string GetText(const Coordinates& aStart, const Coordinates& aEnd) const;
+	template<typename TString> void GetTextInto(const Coordinates& aStart, const Coordinates& aEnd, TString& aText) const;
 	Coordinates GetActualCursorCoordinates() const;
 	Coordinates SanitizeCoordinates(const Coordinates& aValue) const;
 	void Advance(Coordinates& aCoordinates) const;
 	void DeleteRange(const Coordinates& aStart, const Coordinates& aEnd);
 	int InsertTextAt(Coordinates& aWhere, const char* aValue);
 	void AddUndo(UndoRecord& aValue);
+	bool CoalesceUndo(const UndoRecord& aValue);
+	void TrimUndoBuffer();
+	void ClearUndoBuffer();
+	void UndoEdit(const UndoEntry& aEntry);
+	void RedoEdit(const UndoEntry& aEntry);
+	const char* UndoText(size_t aOffset) const { return mUndoText.c_str() + (aOffset - mUndoTextBase); }
 	Coordinates ScreenPosToCoordinates(const ImVec2& aPosition) const;
 	Coordinates FindWordStart(const Coordinates& aFrom) const;
 	Coordinates FindWordEnd(const Coordinates& aFrom) const;
@@ -340,6 +519,10 @@ private:
 	void EnterCharacter(ImWchar aChar, bool aShift);
 	void Backspace();
 	void DeleteSelection();
+	void ShareLines(const SharedLines& aLines);
+	void UnshareLines();
+	void OnLinesChanged(int aLine, int aLinesBefore, int aLinesAfter);
+	void RebaseLineAnchors();
 	std::string GetWordUnderCursor() const;
 	std::string GetWordAt(const Coordinates& aCoords) const;
 	ImU32 GetGlyphColor(const Glyph& aGlyph) const;
@@ -349,10 +532,15 @@ private:
 	void Render();
 
 	float mLineSpacing;
-	Lines mLines;
+	SharedLines mLines;  // may be shared with other read-only editors (see SetSharedLines)
 	EditorState mState;
 	UndoBuffer mUndoBuffer;
 	int mUndoIndex;
+	std::string mUndoText;  // append-only arena of the texts of mUndoBuffer
+	size_t mUndoTextBase = 0;  // offset of mUndoText[0]: the texts of the dropped oldest edits are erased from time to time
+	size_t mUndoMemoryBudget = 16 * 1024 * 1024;
+	bool mTrackLinesChanges = false;
+	LinesChanges mLinesChanges;
 
 	int mTabSize;
 	bool mOverwrite;
@@ -379,11 +567,32 @@ private:
 	RegexList mRegexList;
 
 	bool mCheckComments;
-	Breakpoints mBreakpoints;
-	ErrorMarkers mErrorMarkers;
+	Breakpoints mBreakpoints;   // by anchor (see LineAnchors)
+	ErrorMarkers mErrorMarkers; // by anchor
+	LineAnchors mLineAnchors;
 	ImVec2 mCharAdvance;
 	Coordinates mInteractiveStart, mInteractiveEnd;
-	std::string mLineBuffer;
+	std::string mLineBuffer;  // text of the visible lines, during Render()
+
+	struct TextRun
+	{
+		ImVec2 mPos;
+		ImU32 mColor;
+		int mBegin, mEnd;  // in mLineBuffer
+	};
+	std::vector<TextRun> mTextRuns;
+	std::vector<ImDrawTextRun> mDrawTextRuns;
+
+	struct MonospaceMetrics
+	{
+		const ImFont* mFont = nullptr;
+		float mFontSize = 0.0f;
+		bool mIsMonospace = false;
+		float mAdvance = 0.0f;  // advance of the ASCII characters, at mFontSize
+	};
+	bool mMonospaceMode = false;
+	MonospaceMetrics mMonospace;
+	bool mUseMonospaceFastPath = false;  // mMonospaceMode, and the current font is monospace
 	uint64_t mStartTime;
 
 	float mLastClick;
@@ -45,6 +45,7 @@ function(him_back_available_rendering_backends out_var)
         HELLOIMGUI_HAS_VULKAN
         HELLOIMGUI_HAS_DIRECTX11
         HELLOIMGUI_HAS_DIRECTX12
+        HELLOIMGUI_HAS_SOFTWARE
         HELLOIMGUI_HAS_NULL
         PARENT_SCOPE)
 endfunction()
@@ -1234,9 +1235,17 @@ function(him_main_add_hello_imgui_library)
     if (HELLOIMGUI_HAS_DIRECTX12)
         him_has_directx12(${HELLOIMGUI_TARGET})
     endif()
+    if (HELLOIMGUI_HAS_SOFTWARE)
+        target_compile_definitions(${HELLOIMGUI_TARGET} PUBLIC HELLOIMGUI_HAS_SOFTWARE)
+    endif()
     if (HELLOIMGUI_HAS_NULL)
         target_compile_definitions(${HELLOIMGUI_TARGET} PUBLIC HELLOIMGUI_HAS_NULL)
     endif()
+    if (NOT EMSCRIPTEN)
+        # SoftwareRasterizer renders its tiles on a thread pool
+        find_package(Threads REQUIRED)
+        target_link_libraries(${HELLOIMGUI_TARGET} PUBLIC Threads::Threads)
+    endif()
 
     if (HELLOIMGUI_WITH_NETIMGUI)
         him_with_netimgui()
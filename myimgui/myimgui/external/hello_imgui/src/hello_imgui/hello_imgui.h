@@ -112,6 +112,15 @@ ImGuiTestEngine* GetImGuiTestEngine();
 //     "Sdl - Vulkan"
 std::string GetBackendDescription();
 
+// `RequestRedraw()`: asks for a new frame as soon as possible, and wakes the application up
+//  if it is idling. Thread safe: a background job may call it when its results are ready.
+void RequestRedraw();
+
+// `RequestRedrawIn(double delaySeconds)`: asks for a new frame in delaySeconds at the latest.
+//  Thread safe. Useful for animations, when FpsIdling.eventDrivenIdling is true: a pending earlier redraw
+//  satisfies it, so that an animation shall request its next frame again at each frame.
+void RequestRedrawIn(double delaySeconds);
+
 // `ChangeWindowSize(const ScreenSize &windowSize)`: sets the window size
 // (useful if you want to change the window size during execution)
 void ChangeWindowSize(const ScreenSize &windowSize);
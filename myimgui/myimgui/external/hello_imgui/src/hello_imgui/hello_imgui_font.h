@@ -33,6 +33,12 @@ namespace HelloImGui
         //   when useFullGlyphRange is true (this is useful to save memory)
         bool reduceMemoryUsageIfFullGlyphRange = true;
 
+        // if true, the glyphs are rasterized into the font texture when first displayed, instead of
+        // when the atlas is built (sets fontConfig.RasterizeOnDemand). Only their metrics are computed
+        // at build time. Useful for large ranges of which few glyphs are displayed (icons, CJK).
+        // Ignored with freetype. Not supported by the DirectX11 & 12 renderers.
+        bool rasterizeOnDemand = false;
+
         // if true, the font will be merged to the last font
         bool mergeToLastFont = false;
 
@@ -5,7 +5,10 @@
 
 HelloImGui provides a simple Log utility that is able to collect message and display them with a specific widget.
 
-* __HelloImGui::Log(LogLevel level, char const* const format, ... )__ will log a message (printf like format)
+* __HelloImGui::Log(LogLevel level, char const* const format, ... )__ will log a message (printf like format).
+  It is thread safe and lock free: the message is formatted by the calling thread, and displayed at the next frame
+  (at most 4096 messages are queued between two frames; the next ones are dropped and counted).
+  Each message is displayed with the time of the call (in seconds since the start of the application).
 * __HelloImGui::LogClear()__ will clear the Log list
 * __HelloImGui::LogGui()__ will display the Log widget
 
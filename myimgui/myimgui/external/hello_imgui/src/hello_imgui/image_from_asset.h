@@ -1,13 +1,16 @@
 #pragma once
 #include "imgui.h"
 
+#include <functional>
+
 namespace HelloImGui
 {
 // @@md#HelloImGui::ImageFromAsset
 
 //
 //Images are loaded when first displayed, and then cached
-// (they will be freed just before the application exits).
+// (they will be freed just before the application exits, or when they are evicted from the cache:
+//  see RunnerParams.imageFromAssetParams, which also enables asynchronous decoding).
 //
 //For example, given this files structure:
 //```
@@ -73,5 +76,10 @@ ImVec2 ImageProportionalSize(const ImVec2& askedSize, const ImVec2& imageSize);
 namespace internal
 {
     void Free_ImageFromAssetMap();
+
+    // Called by the runner at the start of each frame: creates the textures of the images decoded
+    // asynchronously, and evicts images over the cache budget. beforeTextureChanges is called before
+    // the first texture change. Returns true if some textures were created or destroyed.
+    bool ImageFromAssetCache_OnFrameStart(const std::function<void()>& beforeTextureChanges);
 }
 }
@@ -2,8 +2,10 @@
 #include "hello_imgui/internal/backend_impls/runner_factory.h"
 #include "hello_imgui/internal/menu_statusbar.h"
 #include "hello_imgui/internal/docking_details.h"
+#include "hello_imgui/internal/clock_seconds.h"
+#include "hello_imgui/internal/redraw_requests.h"
 #include "imgui_internal.h"
-#include <deque>
+#include <array>
 #include <set>
 #include <chrono>
 #include <cstdio>
@@ -152,16 +154,34 @@ namespace ChronoShenanigans
 
 }
 
-static std::deque<float> gFrameTimes;
+// The times of the last 300 frames, in a ring buffer
+// (a std::deque would allocate a new block every 128 frames)
+struct FrameTimesRing
+{
+    static constexpr size_t Capacity = 300;
+    std::array<float, Capacity> times = {};
+    size_t start = 0, count = 0;
+
+    void push_back(float t)
+    {
+        if (count < Capacity)
+            times[(start + count++) % Capacity] = t;
+        else
+        {
+            times[start] = t;
+            start = (start + 1) % Capacity;
+        }
+    }
+    size_t size() const { return count; }
+    float operator[](size_t i) const { return times[(start + i) % Capacity]; }
+    float back() const { return (*this)[count - 1]; }
+};
+static FrameTimesRing gFrameTimes;
 
 void _UpdateFrameRateStats()
 {
     float now = ChronoShenanigans::ClockSeconds();
     gFrameTimes.push_back(now);
-
-    size_t maxFrameCount = 300;
-    while (gFrameTimes.size() > maxFrameCount)
-        gFrameTimes.pop_front();
 };
 
 float FrameRate(float durationForMean)
@@ -215,6 +235,8 @@ std::string RendererBackendTypeToString(RendererBackendType rendererBackendType)
         return "DirectX11";
     else if (rendererBackendType == RendererBackendType::DirectX12)
         return "DirectX12";
+    else if (rendererBackendType == RendererBackendType::Software)
+        return "Software";
     else if (rendererBackendType == RendererBackendType::Null)
         return "Null";
     else
@@ -241,6 +263,16 @@ ImGuiTestEngine* GetImGuiTestEngine() { return GHImGuiTestEngine; }
 ImGuiTestEngine* GetImGuiTestEngine() { return nullptr; }
 #endif
 
+void RequestRedraw()
+{
+    Internal::RequestRedrawAt(Internal::ClockSeconds());
+}
+
+void RequestRedrawIn(double delaySeconds)
+{
+    Internal::RequestRedrawAt(Internal::ClockSeconds() + delaySeconds);
+}
+
 void ChangeWindowSize(const ScreenSize &windowSize)
 {
     gLastRunner->ChangeWindowSize(windowSize);
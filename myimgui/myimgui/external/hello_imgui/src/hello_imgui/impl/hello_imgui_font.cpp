@@ -4,6 +4,7 @@
 #include "hello_imgui/hello_imgui_assets.h"
 #include "hello_imgui/hello_imgui_error.h"
 #include "hello_imgui/icons_font_awesome_4.h"
+#include "hello_imgui/internal/font_atlas_cache.h"
 
 #ifdef IMGUI_ENABLE_FREETYPE
 #include "imgui_freetype.h"
@@ -167,6 +168,8 @@ namespace HelloImGui
         }
 
         params.fontConfig.MergeMode = params.mergeToLastFont;
+        if (params.rasterizeOnDemand)
+            params.fontConfig.RasterizeOnDemand = true;
 
         ImFont* font = nullptr;
 
@@ -274,7 +277,7 @@ namespace HelloImGui
 			ImFont* newFont = _LoadFontImpl(fontFilename, fontSize, fontLoadingParams);
 			dpiResponsiveFont.font = newFont;
 		}
-		bool buildSuccess = imguiFonts->Build();
+		bool buildSuccess = HelloImGui::Internal::BuildImGuiFontAtlas(*GetRunnerParams());
 		IM_ASSERT(buildSuccess && "_reloadAllDpiResponsiveFonts: Failed to build fonts");
 		return true;
 	}
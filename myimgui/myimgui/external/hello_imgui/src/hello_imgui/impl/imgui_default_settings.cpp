@@ -50,6 +50,7 @@ void LoadDefaultFont_WithFontAwesomeIcons()
     HelloImGui::FontLoadingParams fontParams;
     fontParams.mergeToLastFont = true;
     fontParams.useFullGlyphRange = true;
+    fontParams.rasterizeOnDemand = runnerParams->callbacks.defaultIconFontRasterizeOnDemand;
 
 	if (useDpiResponsiveFonts)
     	LoadFontDpiResponsive(iconFontFile, fontSize, fontParams);
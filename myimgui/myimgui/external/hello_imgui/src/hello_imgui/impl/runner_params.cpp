@@ -1,4 +1,5 @@
 #include "hello_imgui/runner_params.h"
+#include "hello_imgui/internal/settings_store.h"
 
 #include <filesystem>
 
@@ -83,25 +84,35 @@ namespace HelloImGui
         return iniFullFilename;
     }
 
-    // DeleteIniSettings deletes the ini file for the application settings.
+    // DeleteIniSettings deletes the ini file (and the binary settings store) for the application settings.
     void DeleteIniSettings(const RunnerParams& runnerParams)
     {
         std::string iniFullFilename = IniSettingsLocation(runnerParams);
         if (iniFullFilename.empty())
             return;
+
+        std::string storeFilename = Internal::SettingsStoreLocation(iniFullFilename);
+        Internal::ForgetSettingsStore(storeFilename);
+        if (std::filesystem::exists(storeFilename))
+        {
+            bool success = std::filesystem::remove(storeFilename);
+            IM_ASSERT(success && "Failed to delete settings store file");
+        }
+
         if (!std::filesystem::exists(iniFullFilename))
             return;
         bool success = std::filesystem::remove(iniFullFilename);
         IM_ASSERT(success && "Failed to delete ini file %s");
     }
 
-    // HasIniSettings returns true if the ini file for the application settings exists.
+    // HasIniSettings returns true if the ini file (or the binary settings store) for the application settings exists.
     bool HasIniSettings(const RunnerParams& runnerParams)
     {
         std::string iniFullFilename = IniSettingsLocation(runnerParams);
         if (iniFullFilename.empty())
             return false;
-        return std::filesystem::exists(iniFullFilename);
+        return std::filesystem::exists(iniFullFilename)
+            || std::filesystem::exists(Internal::SettingsStoreLocation(iniFullFilename));
     }
 
 }  // namespace HelloImGui
\ No newline at end of file
@@ -3,12 +3,16 @@
 #include "hello_imgui/internal/borderless_movable.h"
 #include "hello_imgui/internal/clock_seconds.h"
 #include "hello_imgui/internal/docking_details.h"
+#include "hello_imgui/internal/draw_data_hash.h"
+#include "hello_imgui/internal/font_atlas_cache.h"
 #include "hello_imgui/internal/hello_imgui_ini_settings.h"
 #include "hello_imgui/internal/hello_imgui_ini_any_parent_folder.h"
 #include "hello_imgui/internal/menu_statusbar.h"
 #include "hello_imgui/internal/platform/ini_folder_locations.h"
 #include "hello_imgui/internal/inicpp.h"
+#include "hello_imgui/internal/log_ring_buffer.h"
 #include "hello_imgui/internal/poor_man_log.h"
+#include "hello_imgui/internal/redraw_requests.h"
 #include "imgui.h"
 
 #include "hello_imgui/internal/imgui_global_context.h" // must be included before imgui_internal.h
@@ -54,6 +58,7 @@
 #include "rendering_vulkan.h"
 #include "rendering_dx11.h"
 #include "rendering_dx12.h"
+#include "rendering_software.h"
 #include "rendering_null.h"
 
 //
@@ -647,6 +652,15 @@ void AbstractRunner::InitRenderBackendCallbacks()
             IM_ASSERT(false && "DirectX12 backend is not available!");
         #endif
     }
+    else if (params.rendererBackendType == RendererBackendType::Software)
+    {
+        #ifdef HELLOIMGUI_HAS_SOFTWARE
+            IM_ASSERT(params.platformBackendType == PlatformBackendType::Null && "The Software renderer needs the Null platform backend!");
+            mRenderingBackendCallbacks = CreateBackendCallbacks_Software();
+        #else
+            IM_ASSERT(false && "Software backend is not available!");
+        #endif
+    }
     else if (params.rendererBackendType == RendererBackendType::Null)
     {
         #ifdef HELLOIMGUI_USE_NULL
@@ -666,6 +680,7 @@ void AbstractRunner::InitRenderBackendCallbacks()
 void AbstractRunner::Setup()
 {
     auto& self = *this;
+    HelloImGuiIniSettings::SetUseSettingsStore(params.useBinarySettingsStore);
     InitRenderBackendCallbacks();
 
     InitImGuiContext();
@@ -685,6 +700,7 @@ void AbstractRunner::Setup()
 
     PrepareWindowGeometry();
     Impl_CreateWindow();
+    Internal::SetRedrawWakeFunction([this] { mBackendWindowHelper->PostEmptyEvent(); });
 
     #ifdef HELLOIMGUI_HAS_OPENGL
         if (params.rendererBackendType == RendererBackendType::OpenGL3)
@@ -726,7 +742,7 @@ void AbstractRunner::Setup()
     ImGui::GetIO().Fonts->Clear();
     params.callbacks.LoadAdditionalFonts();
     params.callbacks.LoadAdditionalFonts = nullptr;
-    bool buildSuccess = ImGui::GetIO().Fonts->Build();
+    bool buildSuccess = HelloImGui::Internal::BuildImGuiFontAtlas(params);
     IM_ASSERT(buildSuccess && "ImGui::GetIO().Fonts->Build() failed!");
     {
         // Reset FontGlobalScale if we did not use HelloImGui font loading mechanism
@@ -862,8 +878,10 @@ void AbstractRunner::CreateFramesAndRender()
 		{
 			DpiLog("_CheckDpiAwareParamsChanges returned true => reloaded all fonts\n");
 			// cf https://github.com/ocornut/imgui/issues/6547: we need to recreate the rendering backend device objects
+			WaitForRenderThread();
 			mRenderingBackendCallbacks->Impl_DestroyFontTexture();
 			mRenderingBackendCallbacks->Impl_CreateFontTexture();
+            mLastPresentedFrameHash = 0; // the fonts texture content changed, maybe not its id
 
             mRemoteDisplayHandler.SendFonts();
 		}
@@ -876,6 +894,13 @@ void AbstractRunner::CreateFramesAndRender()
 
         LayoutSettings_HandleChanges();
 
+        // With the binary settings store, a save only appends the modified sections: save when ImGui asks for it
+        if (params.useBinarySettingsStore && ImGui::GetIO().WantSaveIniSettings)
+        {
+            LayoutSettings_Save();
+            ImGui::GetIO().WantSaveIniSettings = false;
+        }
+
         #if TARGET_OS_IOS
         auto insets = GetIPhoneSafeAreaInsets();
         params.appWindowParams.edgeInsets.top = insets.top;
@@ -1010,6 +1035,9 @@ void AbstractRunner::CreateFramesAndRender()
         if (nbEventsAfter > nbEventsBefore)
             timeLastEvent = ImGui::GetTime();
 
+        // The redraw requests which are due are satisfied by this frame
+        Internal::OnFrameStart_ForgetDueRedrawRequests(Internal::ClockSeconds());
+
     } // SCOPED_RELEASE_GIL_ON_MAIN_THREAD end
 
 	if (foldable_region) // Update frame rate stats
@@ -1023,9 +1051,10 @@ void AbstractRunner::CreateFramesAndRender()
         if (params.callbacks.LoadAdditionalFonts != nullptr)
         {
             params.callbacks.LoadAdditionalFonts();
-            ImGui::GetIO().Fonts->Build();
+            HelloImGui::Internal::BuildImGuiFontAtlas(params);
             // cf https://github.com/ocornut/imgui/issues/6547
             // We need to recreate the rendering backend device objects
+            WaitForRenderThread();
             mRenderingBackendCallbacks->Impl_DestroyFontTexture();
             mRenderingBackendCallbacks->Impl_CreateFontTexture();
             params.callbacks.LoadAdditionalFonts = nullptr;
@@ -1034,17 +1063,36 @@ void AbstractRunner::CreateFramesAndRender()
         }
     }
 
+    if (foldable_region) // Create the textures of the images decoded asynchronously, and apply the image cache budget
+    {
+        // The render thread may still be drawing the last frame with the textures
+        if (HelloImGui::internal::ImageFromAssetCache_OnFrameStart([this] { WaitForRenderThread(); }))
+            mLastPresentedFrameHash = 0; // a new texture may reuse the id of an evicted one
+    }
+
+    // Move the messages logged (possibly by other threads) since the last frame into the log widget,
+    // so that the queue does not overflow when LogGui() is not displayed
+    HelloImGui::Internal::Log_DrainPendingRecords();
+
     //
     // Rendering logic
     //
     if (params.callbacks.PreNewFrame)
         params.callbacks.PreNewFrame();
 
+    // With pipelined rendering, the render thread does the whole rendering of the frame
+    bool isRenderingPipelined = CanPipelineRendering();
+    if (isRenderingPipelined && !mRenderThread)
+        mRenderThread = std::make_unique<RenderThread>(mRenderingBackendCallbacks->Impl_RenderFrame_OnRenderThread);
+    else if (!isRenderingPipelined && mRenderThread)
+        mRenderThread.reset();
+
     if (foldable_region)  // New Frame / Rendering and Platform Backend (not ImGui)
     { // SCOPED_RELEASE_GIL_ON_MAIN_THREAD start
         SCOPED_RELEASE_GIL_ON_MAIN_THREAD;
 
-        mRenderingBackendCallbacks->Impl_NewFrame_3D();
+        if (!isRenderingPipelined)
+            mRenderingBackendCallbacks->Impl_NewFrame_3D();
         Impl_NewFrame_PlatformBackend();
 
         {
@@ -1081,10 +1129,13 @@ void AbstractRunner::CreateFramesAndRender()
         #endif
     }
 
+    // When identical frames may be skipped, the clear is deferred until we know whether this frame is rendered
+    bool canSkipIdenticalFrame = CanSkipIdenticalFrames();
+
     // CustomBackground is a user callback
     if (params.callbacks.CustomBackground)
         params.callbacks.CustomBackground();
-    else
+    else if (!canSkipIdenticalFrame && !isRenderingPipelined)
         mRenderingBackendCallbacks->Impl_Frame_3D_ClearColor(params.imGuiWindowParams.backgroundColor);
 
     // iii/ At the end of the second frame, we measure the size of the widgets and use it as the application window size, if the user required auto size
@@ -1100,12 +1151,38 @@ void AbstractRunner::CreateFramesAndRender()
         SCOPED_RELEASE_GIL_ON_MAIN_THREAD;
 
         ImGui::Render();
-        mRenderingBackendCallbacks->Impl_RenderDrawData_To_3D();
+        UpdateFontTexture_IfDirty();
+        if (canSkipIdenticalFrame && IsSameFrameAsLastPresented())
+        {
+            params.fpsIdling.nbSkippedFrames += 1;
+            mLastFrameSkipped = true;
+            WaitAfterSkippedFrame();
+        }
+        else
+        {
+            if (isRenderingPipelined)
+            {
+                mRenderThread->SubmitFrame(ImGui::GetDrawData(), params.imGuiWindowParams.backgroundColor);
+                UpdatePipelineStats();
+            }
+            else
+            {
+                if (canSkipIdenticalFrame)
+                    mRenderingBackendCallbacks->Impl_Frame_3D_ClearColor(params.imGuiWindowParams.backgroundColor);
+                mRenderingBackendCallbacks->Impl_RenderDrawData_To_3D();
 
-        if (ImGui::GetIO().ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
-            Impl_UpdateAndRenderAdditionalPlatformWindows();
+                if (ImGui::GetIO().ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
+                    Impl_UpdateAndRenderAdditionalPlatformWindows();
+            }
 
-        Impl_SwapBuffers();
+            Impl_SwapBuffers();
+
+            params.fpsIdling.nbRenderedFrames += 1;
+            mLastFrameSkipped = false;
+            double now = Internal::ClockSeconds();
+            mPresentInterval = now - mLastPresentTime;
+            mLastPresentTime = now;
+        }
 
         mRemoteDisplayHandler.Heartbeat_PostImGuiRender();
     } // SCOPED_RELEASE_GIL_ON_MAIN_THREAD end
@@ -1129,6 +1206,143 @@ void AbstractRunner::CreateFramesAndRender()
     mIdxFrame += 1;
 }
 
+ImageBuffer AbstractRunner::ScreenshotRgb()
+{
+    WaitForRenderThread();
+    RenderLastFrameIfSkipped();
+    return mRenderingBackendCallbacks->Impl_ScreenshotRgb_3D();
+}
+
+
+bool AbstractRunner::CanSkipIdenticalFrames()
+{
+    if (!params.fpsIdling.skipIdenticalFrames)
+    {
+        mLastPresentedFrameHash = 0;
+        return false;
+    }
+    // The first frames may resize and show the window
+    if (mIdxFrame <= 3)
+        return false;
+    // Renderers where nothing is acquired by Impl_NewFrame_3D, and released by the swap
+    // (with Metal, the drawable is acquired in NewFrame_3D). Null renders nothing anyway.
+    bool rendererSupportsSkipping =
+           (params.rendererBackendType == RendererBackendType::OpenGL3)
+        || (params.rendererBackendType == RendererBackendType::Vulkan)
+        || (params.rendererBackendType == RendererBackendType::DirectX11)
+        || (params.rendererBackendType == RendererBackendType::Software);
+    if (!rendererSupportsSkipping)
+        return false;
+    // What a CustomBackground callback or the additional viewports draw is unknown
+    if (params.callbacks.CustomBackground || (ImGui::GetIO().ConfigFlags & ImGuiConfigFlags_ViewportsEnable))
+        return false;
+    #ifdef HELLOIMGUI_WITH_TEST_ENGINE
+        if (params.useImGuiTestEngine && TestEngineCallbacks::IsRunningTest())
+            return false;
+    #endif
+    return true;
+}
+
+
+// Compares the hash of the draw data with the last presented one (and stores it)
+bool AbstractRunner::IsSameFrameAsLastPresented()
+{
+    uint64_t hash = Internal::HashDrawData(ImGui::GetDrawData());
+    bool isSame = (hash != 0) && (hash == mLastPresentedFrameHash);
+    mLastPresentedFrameHash = hash;
+    return isSame;
+}
+
+
+// A skipped frame does not wait for the vertical sync in the swap: wait for the same duration
+// as the last presented frame, unless an event arrives (at most 1/30s)
+void AbstractRunner::WaitAfterSkippedFrame()
+{
+#ifndef __EMSCRIPTEN__  // the browser drives the frames
+    if (params.fpsIdling.isIdling)
+        return;
+    double elapsedSincePresent = Internal::ClockSeconds() - mLastPresentTime;
+    double waitDuration = ImMin(mPresentInterval, 1. / 30.) - elapsedSincePresent;
+    if (waitDuration > 0.)
+        mBackendWindowHelper->WaitForEventTimeout(waitDuration);
+#endif
+}
+
+
+bool AbstractRunner::CanPipelineRendering()
+{
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    return false;
+#else
+    if (!params.rendererBackendOptions.pipelinedRendering)
+        return false;
+    // Only renderers which are not bound to the main thread can render on the render thread
+    if (!mRenderingBackendCallbacks->Impl_RenderFrame_OnRenderThread)
+        return false;
+    // The first frames create the fonts texture, and size the window
+    if (mIdxFrame <= 3)
+        return false;
+    // CustomBackground and the additional viewports draw from the main thread
+    if (params.callbacks.CustomBackground || (ImGui::GetIO().ConfigFlags & ImGuiConfigFlags_ViewportsEnable))
+        return false;
+    return true;
+#endif
+}
+
+
+// Call this before accessing the framebuffer or the textures of the renderer from the main thread
+void AbstractRunner::WaitForRenderThread()
+{
+    if (mRenderThread)
+        mRenderThread->WaitUntilIdle();
+}
+
+
+// Glyphs rasterized on demand are drawn into the font atlas pixels during the frame:
+// upload them before the frame is rendered (the render thread may be reading the texture)
+void AbstractRunner::UpdateFontTexture_IfDirty()
+{
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    int x, y, w, h;
+    if (!atlas->GetTexDirtyRect(&x, &y, &w, &h))
+        return;
+    WaitForRenderThread();
+    if (mRenderingBackendCallbacks->Impl_UpdateFontTexture)
+        mRenderingBackendCallbacks->Impl_UpdateFontTexture(x, y, w, h);
+    else
+    {
+        mRenderingBackendCallbacks->Impl_DestroyFontTexture();
+        mRenderingBackendCallbacks->Impl_CreateFontTexture();
+    }
+    atlas->ClearTexDirtyRect();
+    mLastPresentedFrameHash = 0; // a glyph may have been rasterized into the cell of another one, with the same UVs
+}
+
+
+void AbstractRunner::UpdatePipelineStats()
+{
+    RenderThread::Stats stats = mRenderThread->GetStats();
+    auto& options = params.rendererBackendOptions;
+    options.pipelineNbFrames = stats.nbFrames;
+    options.pipelineRenderSeconds = stats.renderSeconds;
+    options.pipelineMainWaitSeconds = stats.mainWaitSeconds;
+}
+
+
+// The back buffer of a skipped frame was not drawn: draw it (without presenting it) for screenshots
+void AbstractRunner::RenderLastFrameIfSkipped()
+{
+    if (!mLastFrameSkipped)
+        return;
+    mLastFrameSkipped = false;
+    ImDrawData* drawData = ImGui::GetDrawData();
+    if (drawData == nullptr || !drawData->Valid)
+        return;
+    mRenderingBackendCallbacks->Impl_Frame_3D_ClearColor(params.imGuiWindowParams.backgroundColor);
+    mRenderingBackendCallbacks->Impl_RenderDrawData_To_3D();
+}
+
+
 // Idling for non emscripten, where HelloImGui is responsible for the main loop.
 // This form of idling will call WaitForEventTimeout(), which may call sleep():
 void AbstractRunner::IdleBySleeping()
@@ -1147,6 +1361,12 @@ void AbstractRunner::IdleBySleeping()
 		params.fpsIdling.fpsIdle = 30.f;
 	}
 
+	if (ShallIdleUntilEvent())
+	{
+		IdleUntilEventOrRedrawRequest();
+		return;
+	}
+
 	assert(params.fpsIdling.fpsIdle >= 0.f);
     params.fpsIdling.isIdling = false;
     if ((params.fpsIdling.fpsIdle > 0.f) && params.fpsIdling.enableIdling)
@@ -1162,6 +1382,49 @@ void AbstractRunner::IdleBySleeping()
     }
 }
 
+// Event driven idling (see FpsIdling.eventDrivenIdling)
+bool AbstractRunner::ShallIdleUntilEvent()
+{
+    if (!params.fpsIdling.eventDrivenIdling || !params.fpsIdling.enableIdling)
+        return false;
+    // The remote display needs regular frames
+    if (ShouldRemoteDisplay())
+        return false;
+    // A text input (or a TextEditor) is active: its cursor blinks
+    if (ImGui::GetIO().WantTextInput)
+        return false;
+    return true;
+}
+
+// The next requested redraw, or the time when ImGui will save its modified settings
+// (a negative value if none)
+double AbstractRunner::NextWakeTime(double nextRequestedRedrawTime)
+{
+    double nextWakeTime = nextRequestedRedrawTime;
+    float settingsDirtyTimer = ImGui::GetCurrentContext()->SettingsDirtyTimer;
+    if (settingsDirtyTimer > 0.f)
+    {
+        double settingsSaveTime = Internal::ClockSeconds() + (double)settingsDirtyTimer;
+        if (nextWakeTime < 0. || settingsSaveTime < nextWakeTime)
+            nextWakeTime = settingsSaveTime;
+    }
+    return nextWakeTime;
+}
+
+// Waits for an event, or until the next redraw request is due (without timeout if there is none).
+// A request made by another thread during the wait wakes us up.
+void AbstractRunner::IdleUntilEventOrRedrawRequest()
+{
+    double nextWakeTime = NextWakeTime(Internal::BeginWaitForRedraw());
+    double now = Internal::ClockSeconds();
+    if (nextWakeTime < 0.)
+        mBackendWindowHelper->WaitForEvent();
+    else if (nextWakeTime > now)
+        mBackendWindowHelper->WaitForEventTimeout(nextWakeTime - now);
+    Internal::EndWaitForRedraw();
+    params.fpsIdling.isIdling = (nextWakeTime < 0.) || (nextWakeTime > now);
+}
+
 // Logic for idling under emscripten
 // (this is adapted for emscripten, since CreateFramesAndRender is called 60 times per second by the browser,
 //  and a sleep would actually could a javascript busy loop!)
@@ -1176,6 +1439,16 @@ bool AbstractRunner::ShallIdleThisFrame_Emscripten()
     ImGuiContext& g = *GImGui;
     bool hasInputEvent =  ! g.InputEventsQueue.empty();
 
+    if (ShallIdleUntilEvent())
+    {
+        // The browser still calls us at each animation frame: skip the frames until an event or a redraw is due
+        params.fpsIdling.isIdling = true;
+        double now = Internal::ClockSeconds();
+        double nextWakeTime = NextWakeTime(Internal::NextRequestedRedrawTime());
+        bool isRedrawDue = (nextWakeTime >= 0.) && (nextWakeTime <= now);
+        return !hasInputEvent && !isRedrawDue;
+    }
+
     if (! params.fpsIdling.enableIdling || (params.fpsIdling.fpsIdle <= 0.f) )
     {
         params.fpsIdling.isIdling = false;
@@ -1256,6 +1529,8 @@ void AbstractRunner::TearDown(bool gotException)
         HelloImGuiIniSettings::SaveHelloImGuiMiscSettings(IniSettingsLocation(params), params);
     }
 
+    // The render thread shall not use the textures anymore
+    mRenderThread.reset();
     HelloImGui::internal::Free_ImageFromAssetMap();
 
     if (params.callbacks.BeforeExit)
@@ -1265,6 +1540,7 @@ void AbstractRunner::TearDown(bool gotException)
             TestEngineCallbacks::TearDown_ImGuiContextAlive();
     #endif
 
+    Internal::SetRedrawWakeFunction(nullptr);
     mRenderingBackendCallbacks->Impl_Shutdown_3D();
     Impl_Cleanup();
 
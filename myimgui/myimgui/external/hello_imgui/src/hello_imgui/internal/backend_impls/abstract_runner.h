@@ -5,8 +5,10 @@
 #include "hello_imgui/internal/backend_impls/backend_window_helper/window_geometry_helper.h"
 #include "hello_imgui/internal/backend_impls/rendering_callbacks.h"
 #include "hello_imgui/internal/backend_impls/remote_display_handler.h"
+#include "hello_imgui/internal/backend_impls/render_thread.h"
 #include "hello_imgui/runner_params.h"
 
+#include <cstdint>
 #include <memory>
 #include <functional>
 
@@ -36,7 +38,7 @@ public:
     void OnLowMemory();
 
     // For jupyter notebook, which displays a screenshot post execution
-    ImageBuffer ScreenshotRgb() { return mRenderingBackendCallbacks->Impl_ScreenshotRgb_3D(); }
+    ImageBuffer ScreenshotRgb();
 
     void ChangeWindowSize(ScreenSize windowSize);
 
@@ -97,6 +99,20 @@ private:
     // Logic for idling
     void IdleBySleeping();
     bool ShallIdleThisFrame_Emscripten();
+    bool ShallIdleUntilEvent();
+    double NextWakeTime(double nextRequestedRedrawTime);
+    void IdleUntilEventOrRedrawRequest();
+    // Logic for skipping identical frames (see FpsIdling.skipIdenticalFrames)
+    bool CanSkipIdenticalFrames();
+    bool IsSameFrameAsLastPresented();
+    void WaitAfterSkippedFrame();
+    void RenderLastFrameIfSkipped();
+    // Logic for pipelined rendering (see RendererBackendOptions.pipelinedRendering)
+    bool CanPipelineRendering();
+    void WaitForRenderThread();
+    void UpdatePipelineStats();
+    // Uploads the glyphs rasterized on demand during the frame (see ImFontConfig::RasterizeOnDemand)
+    void UpdateFontTexture_IfDirty();
 
     void SetLayoutResetIfNeeded();
 
@@ -114,6 +130,15 @@ private:
     int mIdxFrame = 0;
     bool mWasWindowAutoResizedOnPreviousFrame = false;
 
+    // Identical frames skipping
+    uint64_t mLastPresentedFrameHash = 0;
+    bool mLastFrameSkipped = false;
+    double mLastPresentTime = 0.;
+    double mPresentInterval = 0.;
+
+    // Pipelined rendering
+    std::unique_ptr<RenderThread> mRenderThread;
+
     // Callbacks related to the rendering backend (OpenGL, ...)
     RenderingCallbacksPtr mRenderingBackendCallbacks;
 
@@ -60,6 +60,11 @@ namespace HelloImGui { namespace BackendApi
         virtual void SetWindowBounds(WindowPointer window, ScreenBounds windowBounds) = 0;
 
         virtual void WaitForEventTimeout(double timeout_seconds) = 0;
+        // Waits until an event arrives (without timeout)
+        virtual void WaitForEvent() = 0;
+        // Wakes up WaitForEvent / WaitForEventTimeout. May be called from any thread:
+        // if no wait is in progress, the next one will return immediately.
+        virtual void PostEmptyEvent() = 0;
 
         // (ImGui backends handle this by themselves)
         //virtual ImVec2 GetDisplayFramebufferScale(WindowPointer window) = 0;
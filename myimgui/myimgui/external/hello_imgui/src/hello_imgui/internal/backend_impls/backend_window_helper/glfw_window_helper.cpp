@@ -189,6 +189,16 @@ namespace HelloImGui { namespace BackendApi
         glfwWaitEventsTimeout(timeout_seconds);
     }
 
+    void GlfwWindowHelper::WaitForEvent()
+    {
+        glfwWaitEvents();
+    }
+
+    void GlfwWindowHelper::PostEmptyEvent()
+    {
+        glfwPostEmptyEvent();
+    }
+
     ImVec2 _GetWindowContentScale(HelloImGui::BackendApi::WindowPointer window)
     {
         float x_scale, y_scale;
@@ -28,6 +28,8 @@ namespace HelloImGui { namespace BackendApi
         void SetWindowBounds(WindowPointer window, ScreenBounds windowBounds) override;
 
         void WaitForEventTimeout(double timeout_seconds) override;
+        void WaitForEvent() override;
+        void PostEmptyEvent() override;
 
         float GetWindowSizeDpiScaleFactor(WindowPointer window) override;
 
@@ -3,7 +3,9 @@
 
 #include "backend_window_helper.h"
 #include "hello_imgui/internal/backend_impls/null_config.h"
-#include <thread>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 
 #ifdef _WIN32
 #ifdef CreateWindow
@@ -36,8 +38,23 @@ namespace HelloImGui { namespace BackendApi
             mWindowBounds = windowBounds;
         }
 
+        // There are no events with the Null backend: only PostEmptyEvent() ends the waits
         void WaitForEventTimeout(double timeout_seconds) override {
-            std::this_thread::sleep_for(std::chrono::milliseconds((int)(timeout_seconds * 1000)));
+            std::unique_lock<std::mutex> lock(mEventMutex);
+            mEventCondition.wait_for(lock, std::chrono::milliseconds((int)(timeout_seconds * 1000)), [this] { return mHasEmptyEvent; });
+            mHasEmptyEvent = false;
+        }
+        void WaitForEvent() override {
+            std::unique_lock<std::mutex> lock(mEventMutex);
+            mEventCondition.wait(lock, [this] { return mHasEmptyEvent; });
+            mHasEmptyEvent = false;
+        }
+        void PostEmptyEvent() override {
+            {
+                std::lock_guard<std::mutex> lock(mEventMutex);
+                mHasEmptyEvent = true;
+            }
+            mEventCondition.notify_one();
         }
 
         float GetWindowSizeDpiScaleFactor(WindowPointer window) override { return NullConfig::GetWindowSizeDpiScaleFactor(); }
@@ -48,6 +65,9 @@ namespace HelloImGui { namespace BackendApi
 
     private:
         ScreenBounds mWindowBounds = {};
+        std::mutex mEventMutex;
+        std::condition_variable mEventCondition;
+        bool mHasEmptyEvent = false;
 
     };
 }} // namespace HelloImGui { namespace BackendApi
@@ -200,6 +200,20 @@ namespace HelloImGui { namespace BackendApi
         SDL_WaitEventTimeout(NULL, timeout_ms);
     }
 
+    void SdlWindowHelper::WaitForEvent()
+    {
+        SDL_WaitEvent(NULL);
+    }
+
+    void SdlWindowHelper::PostEmptyEvent()
+    {
+        // SDL_PushEvent is thread safe. The ImGui backend ignores user events.
+        SDL_Event event;
+        SDL_zero(event);
+        event.type = SDL_USEREVENT;
+        SDL_PushEvent(&event);
+    }
+
     float SdlWindowHelper::GetWindowSizeDpiScaleFactor(WindowPointer window)
     {
         #if TARGET_OS_MAC // is true for any software platform that's derived from macOS, which includes iOS, watchOS, and tvOS
@@ -0,0 +1,167 @@
+#include "hello_imgui/internal/backend_impls/render_thread.h"
+#include "hello_imgui/internal/clock_seconds.h"
+
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace HelloImGui
+{
+    namespace
+    {
+        template<typename T>
+        void CopyVector(ImVector<T>& dst, const ImVector<T>& src)
+        {
+            // ImVector::operator= frees the memory: resize() keeps the capacity of the previous frames.
+            // Some headroom is reserved, so that the small variations of animated widgets do not reallocate
+            if (dst.Capacity < src.Size)
+                dst.reserve(src.Size + src.Size / 4);
+            dst.resize(src.Size);
+            if (src.Size > 0)
+                memcpy(dst.Data, src.Data, (size_t)src.Size * sizeof(T));
+        }
+
+        // A deep copy of an ImDrawData, whose buffers are reused from one frame to the next
+        class DrawDataCopy
+        {
+        public:
+            void CopyFrom(const ImDrawData* src)
+            {
+                while (mDrawLists.size() < (size_t)src->CmdListsCount)
+                    mDrawLists.push_back(std::make_unique<ImDrawList>(nullptr));
+
+                ImDrawData& dst = mDrawData;
+                dst.Valid = src->Valid;
+                dst.CmdListsCount = src->CmdListsCount;
+                dst.TotalIdxCount = src->TotalIdxCount;
+                dst.TotalVtxCount = src->TotalVtxCount;
+                dst.DisplayPos = src->DisplayPos;
+                dst.DisplaySize = src->DisplaySize;
+                dst.FramebufferScale = src->FramebufferScale;
+                dst.OwnerViewport = nullptr;
+                dst.CmdLists.resize(src->CmdListsCount);
+                for (int n = 0; n < src->CmdListsCount; ++n)
+                {
+                    const ImDrawList* srcList = src->CmdLists[n];
+                    ImDrawList* dstList = mDrawLists[(size_t)n].get();
+                    CopyVector(dstList->CmdBuffer, srcList->CmdBuffer);
+                    CopyVector(dstList->IdxBuffer, srcList->IdxBuffer);
+                    CopyVector(dstList->VtxBuffer, srcList->VtxBuffer);
+                    dstList->Flags = srcList->Flags;
+                    dst.CmdLists[n] = dstList;
+                }
+            }
+
+            const ImDrawData* Get() const { return &mDrawData; }
+
+        private:
+            ImDrawData mDrawData;
+            std::vector<std::unique_ptr<ImDrawList>> mDrawLists;
+        };
+    }
+
+
+    struct RenderThread::Impl
+    {
+        RenderFrameFunction renderFrame;
+
+        DrawDataCopy copies[2];
+        int idxNextCopy = 0;
+
+        mutable std::mutex mutex;
+        std::condition_variable condition;
+        const DrawDataCopy* pendingFrame = nullptr;  // submitted, not yet rendered
+        ImVec4 pendingClearColor;
+        bool isRendering = false;
+        bool shallStop = false;
+        Stats stats;
+
+        std::thread thread;
+
+        void Loop()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true)
+            {
+                condition.wait(lock, [this] { return pendingFrame != nullptr || shallStop; });
+                if (pendingFrame == nullptr)
+                    return;
+
+                const DrawDataCopy* frame = pendingFrame;
+                ImVec4 clearColor = pendingClearColor;
+                isRendering = true;
+                lock.unlock();
+
+                double startTime = Internal::ClockSeconds();
+                renderFrame(frame->Get(), clearColor);
+                double renderSeconds = Internal::ClockSeconds() - startTime;
+
+                lock.lock();
+                isRendering = false;
+                pendingFrame = nullptr;
+                stats.nbFrames += 1;
+                stats.renderSeconds += renderSeconds;
+                condition.notify_all();
+            }
+        }
+
+        // Waits until the render thread has no frame (the lock must be held)
+        void WaitUntilIdle(std::unique_lock<std::mutex>& lock)
+        {
+            double startTime = Internal::ClockSeconds();
+            condition.wait(lock, [this] { return pendingFrame == nullptr && !isRendering; });
+            stats.mainWaitSeconds += Internal::ClockSeconds() - startTime;
+        }
+    };
+
+
+    RenderThread::RenderThread(RenderFrameFunction renderFrame)
+        : mImpl(std::make_unique<Impl>())
+    {
+        mImpl->renderFrame = std::move(renderFrame);
+        mImpl->thread = std::thread([this] { mImpl->Loop(); });
+    }
+
+    RenderThread::~RenderThread()
+    {
+        {
+            std::unique_lock<std::mutex> lock(mImpl->mutex);
+            mImpl->WaitUntilIdle(lock);
+            mImpl->shallStop = true;
+        }
+        mImpl->condition.notify_all();
+        mImpl->thread.join();
+    }
+
+    void RenderThread::SubmitFrame(const ImDrawData* drawData, ImVec4 clearColor)
+    {
+        Impl& impl = *mImpl;
+        // The render thread only reads the other copy: this one can be written without lock
+        DrawDataCopy& copy = impl.copies[impl.idxNextCopy];
+        copy.CopyFrom(drawData);
+        impl.idxNextCopy = 1 - impl.idxNextCopy;
+
+        {
+            std::unique_lock<std::mutex> lock(impl.mutex);
+            impl.WaitUntilIdle(lock);
+            impl.pendingFrame = &copy;
+            impl.pendingClearColor = clearColor;
+        }
+        impl.condition.notify_all();
+    }
+
+    void RenderThread::WaitUntilIdle()
+    {
+        std::unique_lock<std::mutex> lock(mImpl->mutex);
+        mImpl->WaitUntilIdle(lock);
+    }
+
+    RenderThread::Stats RenderThread::GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(mImpl->mutex);
+        return mImpl->stats;
+    }
+}
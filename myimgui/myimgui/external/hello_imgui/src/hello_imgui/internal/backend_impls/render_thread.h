@@ -0,0 +1,45 @@
+#pragma once
+#include "imgui.h"
+
+#include <functional>
+#include <memory>
+
+
+namespace HelloImGui
+{
+    // RenderThread: renders the frames on a dedicated thread, while the main thread builds the next one
+    // (see RendererBackendOptions.pipelinedRendering).
+    //
+    // The draw data of each submitted frame is copied into one of two buffers: the copy of frame N+1
+    // overlaps the rendering of frame N, and the main thread only waits if the rendering is slower than its own work.
+    // User callbacks inside the draw data are called from the render thread.
+    class RenderThread
+    {
+    public:
+        // renderFrame clears the framebuffer and renders the draw data; it is called from the render thread
+        using RenderFrameFunction = std::function<void(const ImDrawData* drawData, ImVec4 clearColor)>;
+
+        explicit RenderThread(RenderFrameFunction renderFrame);
+        // Renders the pending frame, then stops the thread
+        ~RenderThread();
+        RenderThread(const RenderThread&) = delete;
+        RenderThread& operator=(const RenderThread&) = delete;
+
+        // Copies the draw data, waits until the previous frame is rendered, and hands the copy to the render thread
+        void SubmitFrame(const ImDrawData* drawData, ImVec4 clearColor);
+        // Waits until all the submitted frames are rendered (call it before accessing the framebuffer or the textures)
+        void WaitUntilIdle();
+
+        struct Stats
+        {
+            int nbFrames = 0;
+            double renderSeconds = 0.;      // time spent by the render thread in renderFrame
+            double mainWaitSeconds = 0.;    // time spent by the main thread waiting for the render thread
+        };
+        Stats GetStats() const;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> mImpl;
+    };
+}
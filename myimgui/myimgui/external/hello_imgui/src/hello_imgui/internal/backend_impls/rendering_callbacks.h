@@ -102,6 +102,15 @@ namespace HelloImGui
         // Callbacks for font texture creation/destruction during runtime (unsupported by DirectX11&12)
         VoidFunction                  Impl_DestroyFontTexture  = [] { HIMG_ERROR("Empty function"); };
         VoidFunction                  Impl_CreateFontTexture   = [] { HIMG_ERROR("Empty function"); };
+        // Optional: uploads a rectangle of the font atlas pixels into the existing font texture
+        // (glyphs rasterized on demand, see ImFontConfig::RasterizeOnDemand).
+        // If not set, the font texture is recreated instead.
+        std::function<void(int x, int y, int w, int h)> Impl_UpdateFontTexture;
+
+        // Optional, for RendererBackendOptions.pipelinedRendering: renders a whole frame (what Impl_NewFrame_3D,
+        // Impl_Frame_3D_ClearColor and Impl_RenderDrawData_To_3D do) from a copy of the draw data.
+        // It is called from the render thread: only renderers which are not bound to a thread set it.
+        std::function<void(const ImDrawData*, ImVec4)> Impl_RenderFrame_OnRenderThread;
     };
 
     using RenderingCallbacksPtr = std::shared_ptr<RenderingCallbacks>;
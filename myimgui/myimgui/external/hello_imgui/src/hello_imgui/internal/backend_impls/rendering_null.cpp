@@ -12,6 +12,8 @@ namespace HelloImGui
 
         callbacks->Impl_RenderDrawData_To_3D = [] {};
 
+        callbacks->Impl_RenderFrame_OnRenderThread = [](const ImDrawData*, ImVec4) {};
+
         callbacks->Impl_ScreenshotRgb_3D = []() { return ImageBuffer{}; };
 
         callbacks->Impl_Frame_3D_ClearColor = [](ImVec4) {};
@@ -20,6 +22,7 @@ namespace HelloImGui
 
         callbacks->Impl_CreateFontTexture = [] {};
         callbacks->Impl_DestroyFontTexture = [] {};
+        callbacks->Impl_UpdateFontTexture = [](int, int, int, int) {};
 
         return callbacks;
     }
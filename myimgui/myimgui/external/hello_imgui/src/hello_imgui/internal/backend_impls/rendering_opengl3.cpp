@@ -36,6 +36,23 @@ namespace HelloImGui
 
         callbacks->Impl_CreateFontTexture = ImGui_ImplOpenGL3_CreateFontsTexture;
         callbacks->Impl_DestroyFontTexture = ImGui_ImplOpenGL3_DestroyFontsTexture;
+        callbacks->Impl_UpdateFontTexture = [](int x, int y, int w, int h) {
+            // Uploads whole rows: GL_UNPACK_ROW_LENGTH, needed for a sub-rectangle, is not available with GLES2 / WebGL
+            (void)x; (void)w;
+            ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+            unsigned char* pixels;
+            int width, height;
+            atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+            GLint lastTexture;
+            glGetIntegerv(GL_TEXTURE_BINDING_2D, &lastTexture);
+            glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)atlas->TexID);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+#ifdef GL_UNPACK_ROW_LENGTH
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#endif
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y, width, h, GL_RGBA, GL_UNSIGNED_BYTE, pixels + (size_t)y * width * 4);
+            glBindTexture(GL_TEXTURE_2D, (GLuint)lastTexture);
+        };
 
         return callbacks;
     }
@@ -0,0 +1,76 @@
+#ifdef HELLOIMGUI_HAS_SOFTWARE
+#include "rendering_software.h"
+
+#include "imgui.h"
+
+#include <memory>
+
+
+namespace HelloImGui
+{
+    static std::unique_ptr<SoftwareRasterizer> gSoftwareRasterizer;
+
+    SoftwareRasterizer* GetSoftwareRasterizer() { return gSoftwareRasterizer.get(); }
+
+    RenderingCallbacksPtr CreateBackendCallbacks_Software()
+    {
+        auto callbacks = std::make_shared<RenderingCallbacks>();
+
+        gSoftwareRasterizer = std::make_unique<SoftwareRasterizer>();
+
+        callbacks->Impl_NewFrame_3D = []
+        {
+            ImGuiIO& io = ImGui::GetIO();
+            if (io.Fonts->TexID == nullptr)
+                gSoftwareRasterizer->CreateFontsTexture();
+            gSoftwareRasterizer->Resize(
+                (int)(io.DisplaySize.x * io.DisplayFramebufferScale.x),
+                (int)(io.DisplaySize.y * io.DisplayFramebufferScale.y));
+        };
+
+        callbacks->Impl_Frame_3D_ClearColor = [](ImVec4 clearColor)
+        {
+            gSoftwareRasterizer->Clear(clearColor);
+        };
+
+        callbacks->Impl_RenderDrawData_To_3D = []
+        {
+            gSoftwareRasterizer->RenderDrawData(ImGui::GetDrawData());
+        };
+
+        callbacks->Impl_RenderFrame_OnRenderThread = [](const ImDrawData* drawData, ImVec4 clearColor)
+        {
+            gSoftwareRasterizer->Resize(
+                (int)(drawData->DisplaySize.x * drawData->FramebufferScale.x),
+                (int)(drawData->DisplaySize.y * drawData->FramebufferScale.y));
+            gSoftwareRasterizer->Clear(clearColor);
+            gSoftwareRasterizer->RenderDrawData(drawData);
+        };
+
+        callbacks->Impl_ScreenshotRgb_3D = []
+        {
+            if (gSoftwareRasterizer == nullptr)
+                return ImageBuffer{};
+            return gSoftwareRasterizer->ScreenshotRgb();
+        };
+
+        callbacks->Impl_GetFrameBufferSize = []
+        {
+            return ScreenSize{gSoftwareRasterizer->Width(), gSoftwareRasterizer->Height()};
+        };
+
+        callbacks->Impl_Shutdown_3D = []
+        {
+            gSoftwareRasterizer->DestroyFontsTexture();
+            gSoftwareRasterizer.reset();
+        };
+
+        callbacks->Impl_CreateFontTexture = [] { gSoftwareRasterizer->CreateFontsTexture(); };
+        callbacks->Impl_DestroyFontTexture = [] { gSoftwareRasterizer->DestroyFontsTexture(); };
+        callbacks->Impl_UpdateFontTexture = [](int x, int y, int w, int h) { gSoftwareRasterizer->UpdateFontsTexture(x, y, w, h); };
+
+        return callbacks;
+    }
+}
+
+#endif // #ifdef HELLOIMGUI_HAS_SOFTWARE
@@ -0,0 +1,18 @@
+#pragma once
+#ifdef HELLOIMGUI_HAS_SOFTWARE
+
+#include "hello_imgui/internal/backend_impls/rendering_callbacks.h"
+#include "hello_imgui/internal/backend_impls/software_rasterizer.h"
+
+// The Software rendering backend: ImGui's draw data is rasterized on the CPU, by SoftwareRasterizer.
+// It is meant to be used with the Null platform backend: it gives headless screenshots
+// (AppWindowScreenshotRgbBuffer, FinalAppWindowScreenshotRgbBuffer) without any GPU.
+namespace HelloImGui
+{
+    RenderingCallbacksPtr CreateBackendCallbacks_Software();
+
+    // The rasterizer of the running app (nullptr when the Software backend is not in use)
+    SoftwareRasterizer* GetSoftwareRasterizer();
+}
+
+#endif // #ifdef HELLOIMGUI_HAS_SOFTWARE
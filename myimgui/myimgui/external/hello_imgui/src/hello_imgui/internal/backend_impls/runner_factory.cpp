@@ -33,6 +33,8 @@ void ChooseBackendTypesIfSelectedAsFirstAvailable(RunnerParams* runnerParams)
             runnerParams->rendererBackendType = RendererBackendType::DirectX11;
         #elif defined(HELLOIMGUI_HAS_DIRECTX12)
             runnerParams->rendererBackendType = RendererBackendType::DirectX12;
+        #elif defined(HELLOIMGUI_HAS_SOFTWARE)
+            runnerParams->rendererBackendType = RendererBackendType::Software;
         #elif defined(HELLOIMGUI_HAS_NULL)
             runnerParams->rendererBackendType = RendererBackendType::Null;
         #endif
@@ -0,0 +1,702 @@
+#include "hello_imgui/internal/backend_impls/software_rasterizer.h"
+
+#include "imgui_internal.h"  // IMGUI_ENABLE_SSE, ImMin, ImMax, ImClamp
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Coverage and blending are computed four pixels at a time with SSE2, when available
+#if defined(IMGUI_ENABLE_SSE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define HELLOIMGUI_RASTERIZER_SSE2
+#endif
+
+namespace HelloImGui
+{
+    namespace
+    {
+        constexpr int TileSize = 64;
+
+        constexpr uint32_t White = 0xFFFFFFFFu;
+
+        inline uint32_t PackRgba(uint32_t r, uint32_t g, uint32_t b, uint32_t a)
+        {
+            return r | (g << 8) | (b << 16) | (a << 24);
+        }
+
+        inline uint32_t ChannelFromFloat(float v)
+        {
+            return (uint32_t)(ImClamp(v, 0.f, 1.f) * 255.f + 0.5f);
+        }
+
+        // ImDrawVert::col (see IM_COL32) => RGBA
+        inline uint32_t ColorFromImU32(ImU32 c)
+        {
+            return PackRgba(
+                (c >> IM_COL32_R_SHIFT) & 0xFF, (c >> IM_COL32_G_SHIFT) & 0xFF,
+                (c >> IM_COL32_B_SHIFT) & 0xFF, (c >> IM_COL32_A_SHIFT) & 0xFF);
+        }
+
+        // a * b / 255, rounded
+        inline uint32_t Mul8(uint32_t a, uint32_t b)
+        {
+            uint32_t t = a * b + 128;
+            return (t + (t >> 8)) >> 8;
+        }
+
+        // Per channel product (vertex color * texel)
+        inline uint32_t Modulate(uint32_t c1, uint32_t c2)
+        {
+            if (c2 == White)
+                return c1;
+            return PackRgba(
+                Mul8(c1 & 0xFF, c2 & 0xFF), Mul8((c1 >> 8) & 0xFF, (c2 >> 8) & 0xFF),
+                Mul8((c1 >> 16) & 0xFF, (c2 >> 16) & 0xFF), Mul8(c1 >> 24, c2 >> 24));
+        }
+
+        // The blend state of ImGui's backends:
+        //     rgb = src.rgb * src.a + dst.rgb * (1 - src.a)
+        //     a   = src.a + dst.a * (1 - src.a)
+        inline uint32_t BlendOver(uint32_t src, uint32_t dst)
+        {
+            uint32_t sa = src >> 24;
+            if (sa == 255)
+                return src;
+            if (sa == 0)
+                return dst;
+            uint32_t ia = 255 - sa;
+            return PackRgba(
+                Mul8(src & 0xFF, sa) + Mul8(dst & 0xFF, ia),
+                Mul8((src >> 8) & 0xFF, sa) + Mul8((dst >> 8) & 0xFF, ia),
+                Mul8((src >> 16) & 0xFF, sa) + Mul8((dst >> 16) & 0xFF, ia),
+                sa + Mul8(dst >> 24, ia));
+        }
+
+#ifdef HELLOIMGUI_RASTERIZER_SSE2
+        // BlendOver() of a constant src over 4 pixels, with the same rounding.
+        // srcPremultiplied: (Mul8(src.rgb, src.a), src.a) twice, and srcInvAlpha: 255 - src.a, in 16 bits lanes
+        inline __m128i BlendOver4(__m128i dst, __m128i srcPremultiplied, __m128i srcInvAlpha)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i half = _mm_set1_epi16(128);
+            auto mul8 = [&](__m128i d) {
+                __m128i t = _mm_add_epi16(_mm_mullo_epi16(d, srcInvAlpha), half);  // <= 65153: no overflow
+                return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+            };
+            __m128i lo = _mm_add_epi16(mul8(_mm_unpacklo_epi8(dst, zero)), srcPremultiplied);
+            __m128i hi = _mm_add_epi16(mul8(_mm_unpackhi_epi8(dst, zero)), srcPremultiplied);
+            return _mm_packus_epi16(lo, hi);
+        }
+#endif
+
+        struct Texture
+        {
+            int width = 0, height = 0;
+            std::vector<uint32_t> texels;
+
+            uint32_t Sample(float u, float v) const
+            {
+                int x = ImClamp((int)std::floor(u * (float)width), 0, width - 1);
+                int y = ImClamp((int)std::floor(v * (float)height), 0, height - 1);
+                return texels[(size_t)y * (size_t)width + (size_t)x];
+            }
+        };
+
+        struct PixelRect
+        {
+            int x0, y0, x1, y1;  // x1 and y1 excluded
+            bool IsEmpty() const { return x1 <= x0 || y1 <= y0; }
+        };
+
+        // The edge function of the segment (p, q) at r is cross(q - p, r - p) = a * r.x + b * r.y + c.
+        // Its coefficients are computed from the endpoints sorted in a canonical order, and then negated
+        // if needed: two triangles which share an edge thus compute the exact opposite values at each pixel,
+        // and agree on which side owns it (no gap, no pixel drawn twice).
+        inline void EdgeFunction(ImVec2 p, ImVec2 q, float* a, float* b, float* c)
+        {
+            bool swapped = (q.x < p.x) || (q.x == p.x && q.y < p.y);
+            if (swapped)
+                std::swap(p, q);
+            *a = p.y - q.y;
+            *b = q.x - p.x;
+            *c = p.x * q.y - p.y * q.x;
+            if (swapped)
+            {
+                *a = -*a;
+                *b = -*b;
+                *c = -*c;
+            }
+        }
+
+        // A pixel center which lies exactly on an edge belongs to the triangle on the side toward which
+        // the edge's normal (a, b) points (among the two triangles which share it, only one satisfies this)
+        inline bool EdgeOwnsZero(float a, float b)
+        {
+            return a > 0.f || (a == 0.f && b > 0.f);
+        }
+
+        enum Attribute { Attr_U, Attr_V, Attr_R, Attr_G, Attr_B, Attr_A, Attr_Count };
+
+        struct Triangle
+        {
+            // Edge functions, evaluated at the pixel centers as (a * x + b * y) + c: a pixel is inside when all are > 0
+            float edgeA[3], edgeB[3], edgeC[3];
+            bool edgeOwnsZero[3];
+            PixelRect bounds;            // the pixels to test (bounding box inter clip rect)
+            const Texture* texture;      // nullptr => white
+            bool constantColor, constantUv;
+            uint32_t color;              // when constantColor (modulated by the texel if constantUv)
+            uint32_t texel;              // when constantUv
+            // Attribute planes: value(x, y) = origin + dx * (x - refX) + dy * (y - refY)
+            float refX, refY;
+            float planeOrigin[Attr_Count], planeDx[Attr_Count], planeDy[Attr_Count];
+
+            float Interpolate(int attr, float x, float y) const
+            {
+                return planeOrigin[attr] + planeDx[attr] * (x - refX) + planeDy[attr] * (y - refY);
+            }
+
+            uint32_t Shade(float x, float y) const
+            {
+                uint32_t c;
+                if (constantColor)
+                    c = color;
+                else
+                {
+                    auto channel = [&](int attr) {
+                        return (uint32_t)ImClamp((int)(Interpolate(attr, x, y) + 0.5f), 0, 255);
+                    };
+                    c = PackRgba(channel(Attr_R), channel(Attr_G), channel(Attr_B), channel(Attr_A));
+                }
+                if (constantUv)
+                    return constantColor ? c : Modulate(c, texel);
+                return Modulate(c, texture->Sample(Interpolate(Attr_U, x, y), Interpolate(Attr_V, x, y)));
+            }
+        };
+
+        // Returns false if the triangle covers no pixel
+        bool SetupTriangle(const ImVec2 positions[3], const ImDrawVert* vertices[3],
+                           const PixelRect& clip, const Texture* texture, Triangle* t)
+        {
+            int i0 = 0, i1 = 1, i2 = 2;
+            ImVec2 p0 = positions[0], p1 = positions[1], p2 = positions[2];
+            float area2 = (p1.x - p0.x) * (p2.y - p0.y) - (p1.y - p0.y) * (p2.x - p0.x);
+            if (area2 == 0.f || std::isnan(area2))
+                return false;
+            if (area2 < 0.f) // ImGui does not care about the winding: reorder the vertices so that area2 > 0
+            {
+                std::swap(i1, i2);
+                std::swap(p1, p2);
+                area2 = -area2;
+            }
+
+            // Pixel x is tested if its center x + 0.5 is inside the triangle's bounding box
+            float minX = ImMin(p0.x, ImMin(p1.x, p2.x)), maxX = ImMax(p0.x, ImMax(p1.x, p2.x));
+            float minY = ImMin(p0.y, ImMin(p1.y, p2.y)), maxY = ImMax(p0.y, ImMax(p1.y, p2.y));
+            t->bounds.x0 = (int)std::ceil(ImClamp(minX - 0.5f, (float)clip.x0, (float)clip.x1));
+            t->bounds.y0 = (int)std::ceil(ImClamp(minY - 0.5f, (float)clip.y0, (float)clip.y1));
+            t->bounds.x1 = ImMin((int)std::floor(ImClamp(maxX - 0.5f, -1.f, (float)clip.x1)) + 1, clip.x1);
+            t->bounds.y1 = ImMin((int)std::floor(ImClamp(maxY - 0.5f, -1.f, (float)clip.y1)) + 1, clip.y1);
+            if (t->bounds.IsEmpty())
+                return false;
+
+            // edge i is opposite to vertex i
+            EdgeFunction(p1, p2, &t->edgeA[0], &t->edgeB[0], &t->edgeC[0]);
+            EdgeFunction(p2, p0, &t->edgeA[1], &t->edgeB[1], &t->edgeC[1]);
+            EdgeFunction(p0, p1, &t->edgeA[2], &t->edgeB[2], &t->edgeC[2]);
+            for (int i = 0; i < 3; ++i)
+                t->edgeOwnsZero[i] = EdgeOwnsZero(t->edgeA[i], t->edgeB[i]);
+
+            const ImDrawVert& v0 = *vertices[i0];
+            const ImDrawVert& v1 = *vertices[i1];
+            const ImDrawVert& v2 = *vertices[i2];
+            t->texture = texture;
+            t->constantColor = (v0.col == v1.col) && (v0.col == v2.col);
+            t->constantUv = (texture == nullptr) || ((v0.uv.x == v1.uv.x) && (v0.uv.x == v2.uv.x) && (v0.uv.y == v1.uv.y) && (v0.uv.y == v2.uv.y));
+            t->texel = (texture == nullptr) ? White : texture->Sample(v0.uv.x, v0.uv.y);
+            t->color = ColorFromImU32(v0.col);
+            if (t->constantColor && t->constantUv)
+            {
+                t->color = Modulate(t->color, t->texel);
+                if ((t->color >> 24) == 0)
+                    return false;
+            }
+
+            t->refX = p0.x;
+            t->refY = p0.y;
+            auto setPlane = [&](int attr, float a0, float a1, float a2) {
+                float d1 = a1 - a0, d2 = a2 - a0;
+                t->planeOrigin[attr] = a0;
+                t->planeDx[attr] = (d1 * (p2.y - p0.y) - d2 * (p1.y - p0.y)) / area2;
+                t->planeDy[attr] = (d2 * (p1.x - p0.x) - d1 * (p2.x - p0.x)) / area2;
+            };
+            if (!t->constantUv)
+            {
+                setPlane(Attr_U, v0.uv.x, v1.uv.x, v2.uv.x);
+                setPlane(Attr_V, v0.uv.y, v1.uv.y, v2.uv.y);
+            }
+            if (!t->constantColor)
+            {
+                uint32_t c0 = ColorFromImU32(v0.col), c1 = ColorFromImU32(v1.col), c2 = ColorFromImU32(v2.col);
+                for (int channel = 0; channel < 4; ++channel)
+                {
+                    int shift = channel * 8;
+                    setPlane(Attr_R + channel,
+                             (float)((c0 >> shift) & 0xFF), (float)((c1 >> shift) & 0xFF), (float)((c2 >> shift) & 0xFF));
+                }
+            }
+            return true;
+        }
+
+        // Conservative test: false if the triangle surely does not cover any pixel of the rect
+        bool TriangleMayTouchRect(const Triangle& t, const PixelRect& rect)
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                float a = t.edgeA[i], b = t.edgeB[i];
+                // The edge function is linear: its max over the rect's pixel centers is at one of the corners
+                float x = (a > 0.f) ? (float)rect.x1 - 0.5f : (float)rect.x0 + 0.5f;
+                float y = (b > 0.f) ? (float)rect.y1 - 0.5f : (float)rect.y0 + 0.5f;
+                float margin = (std::fabs(a) + std::fabs(b)) * 0.25f;
+                if ((a * x + b * y) + t.edgeC[i] < -margin)
+                    return false;
+            }
+            return true;
+        }
+
+        // Draws the pixels of t inside rect (which shall be inside t.bounds)
+        void RasterizeTriangle(const Triangle& t, const PixelRect& rect, uint32_t* pixels, int stride)
+        {
+            const bool flat = t.constantColor && t.constantUv;
+            const bool flatOpaque = flat && ((t.color >> 24) == 255);
+
+#ifdef HELLOIMGUI_RASTERIZER_SSE2
+            const __m128 pixelCenterOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+            const __m128 zero = _mm_setzero_ps();
+            __m128 edgeA[3], edgeC[3], ownsZero[3];
+            for (int i = 0; i < 3; ++i)
+            {
+                edgeA[i] = _mm_set1_ps(t.edgeA[i]);
+                edgeC[i] = _mm_set1_ps(t.edgeC[i]);
+                ownsZero[i] = _mm_castsi128_ps(_mm_set1_epi32(t.edgeOwnsZero[i] ? -1 : 0));
+            }
+            const uint32_t srcAlpha = t.color >> 24;
+            const __m128i srcPremultiplied = _mm_setr_epi16(
+                (short)Mul8(t.color & 0xFF, srcAlpha), (short)Mul8((t.color >> 8) & 0xFF, srcAlpha),
+                (short)Mul8((t.color >> 16) & 0xFF, srcAlpha), (short)srcAlpha,
+                (short)Mul8(t.color & 0xFF, srcAlpha), (short)Mul8((t.color >> 8) & 0xFF, srcAlpha),
+                (short)Mul8((t.color >> 16) & 0xFF, srcAlpha), (short)srcAlpha);
+            const __m128i srcInvAlpha = _mm_set1_epi16((short)(255 - srcAlpha));
+#endif
+
+            for (int y = rect.y0; y < rect.y1; ++y)
+            {
+                uint32_t* row = pixels + (size_t)y * (size_t)stride;
+                const float py = (float)y + 0.5f;
+                float edgeBy[3];
+                for (int i = 0; i < 3; ++i)
+                    edgeBy[i] = t.edgeB[i] * py;
+
+#ifdef HELLOIMGUI_RASTERIZER_SSE2
+                __m128 edgeByV[3];
+                for (int i = 0; i < 3; ++i)
+                    edgeByV[i] = _mm_set1_ps(edgeBy[i]);
+                for (int x = rect.x0; x < rect.x1; x += 4)
+                {
+                    // Same operations as the scalar version, four pixels at a time
+                    __m128 px = _mm_add_ps(_mm_set1_ps((float)x), pixelCenterOffsets);
+                    __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+                    for (int i = 0; i < 3; ++i)
+                    {
+                        __m128 e = _mm_add_ps(_mm_add_ps(_mm_mul_ps(edgeA[i], px), edgeByV[i]), edgeC[i]);
+                        __m128 insideEdge = _mm_or_ps(_mm_cmpgt_ps(e, zero), _mm_and_ps(_mm_cmpeq_ps(e, zero), ownsZero[i]));
+                        inside = _mm_and_ps(inside, insideEdge);
+                    }
+                    int mask = _mm_movemask_ps(inside);
+                    if (rect.x1 - x < 4)
+                        mask &= (1 << (rect.x1 - x)) - 1;
+                    if (mask == 0)
+                        continue;
+                    if (flat && mask == 0xF)
+                    {
+                        __m128i* dst4 = (__m128i*)(row + x);
+                        if (flatOpaque)
+                            _mm_storeu_si128(dst4, _mm_set1_epi32((int)t.color));
+                        else
+                            _mm_storeu_si128(dst4, BlendOver4(_mm_loadu_si128(dst4), srcPremultiplied, srcInvAlpha));
+                        continue;
+                    }
+                    for (int k = 0; k < 4; ++k)
+                    {
+                        if ((mask & (1 << k)) == 0)
+                            continue;
+                        uint32_t& dst = row[x + k];
+                        dst = flatOpaque ? t.color : BlendOver(t.Shade((float)(x + k) + 0.5f, py), dst);
+                    }
+                }
+#else
+                for (int x = rect.x0; x < rect.x1; ++x)
+                {
+                    const float px = (float)x + 0.5f;
+                    bool inside = true;
+                    for (int i = 0; i < 3 && inside; ++i)
+                    {
+                        float e = (t.edgeA[i] * px + edgeBy[i]) + t.edgeC[i];
+                        inside = (e > 0.f) || (e == 0.f && t.edgeOwnsZero[i]);
+                    }
+                    if (!inside)
+                        continue;
+                    uint32_t& dst = row[x];
+                    dst = flatOpaque ? t.color : BlendOver(t.Shade(px, py), dst);
+                }
+#endif
+            }
+        }
+
+        // A persistent pool of worker threads. ParallelFor(n, task) calls task(0..n-1), on the workers
+        // and on the calling thread; the tasks are claimed one at a time through an atomic counter.
+        class WorkerPool
+        {
+        public:
+            explicit WorkerPool(int nbWorkers)
+            {
+                for (int i = 0; i < nbWorkers; ++i)
+                    mThreads.emplace_back([this] { WorkerLoop(); });
+            }
+
+            ~WorkerPool()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    mQuit = true;
+                }
+                mWakeCondition.notify_all();
+                for (auto& thread: mThreads)
+                    thread.join();
+            }
+
+            int NbWorkers() const { return (int)mThreads.size(); }
+
+            void ParallelFor(int nbTasks, const std::function<void(int)>& task)
+            {
+                if (mThreads.empty() || nbTasks <= 1)
+                {
+                    for (int i = 0; i < nbTasks; ++i)
+                        task(i);
+                    return;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    mTask = &task;
+                    mNbTasks = nbTasks;
+                    mNextTask = 0;
+                    mNbBusyWorkers = (int)mThreads.size();
+                    ++mGeneration;
+                }
+                mWakeCondition.notify_all();
+                RunTasks();
+                std::unique_lock<std::mutex> lock(mMutex);
+                mDoneCondition.wait(lock, [this] { return mNbBusyWorkers == 0; });
+                mTask = nullptr;
+            }
+
+        private:
+            void RunTasks()
+            {
+                for (int i = mNextTask++; i < mNbTasks; i = mNextTask++)
+                    (*mTask)(i);
+            }
+
+            void WorkerLoop()
+            {
+                uint64_t seenGeneration = 0;
+                while (true)
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(mMutex);
+                        mWakeCondition.wait(lock, [&] { return mQuit || mGeneration != seenGeneration; });
+                        if (mQuit)
+                            return;
+                        seenGeneration = mGeneration;
+                    }
+                    RunTasks();
+                    {
+                        std::lock_guard<std::mutex> lock(mMutex);
+                        if (--mNbBusyWorkers == 0)
+                            mDoneCondition.notify_one();
+                    }
+                }
+            }
+
+            std::vector<std::thread> mThreads;
+            std::mutex mMutex;
+            std::condition_variable mWakeCondition, mDoneCondition;
+            bool mQuit = false;
+            uint64_t mGeneration = 0;
+            int mNbBusyWorkers = 0;
+            int mNbTasks = 0;
+            std::atomic<int> mNextTask{0};
+            const std::function<void(int)>* mTask = nullptr;
+        };
+
+        int ResolveNbThreads(int nbThreads)
+        {
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+            (void)nbThreads;
+            return 1;
+#else
+            if (nbThreads <= 0)
+                nbThreads = (int)std::thread::hardware_concurrency();
+            return ImMax(nbThreads, 1);
+#endif
+        }
+    }
+
+
+    struct SoftwareRasterizer::Impl
+    {
+        explicit Impl(int nbThreads) : workerPool(ResolveNbThreads(nbThreads) - 1) {}
+
+        int width = 0, height = 0;
+        int nbTilesX = 0, nbTilesY = 0;
+        std::vector<uint32_t> pixels;
+
+        std::vector<std::unique_ptr<Texture>> textures;
+        ImTextureID fontsTexture = nullptr;
+
+        // Per frame data (kept between frames, to avoid reallocations)
+        std::vector<Triangle> triangles;
+        std::vector<std::vector<uint32_t>> bins;  // per tile: the indices of its triangles, in submission order
+        FrameStats stats;
+
+        WorkerPool workerPool;
+
+        PixelRect TileRect(int tileIndex) const
+        {
+            int tx = tileIndex % nbTilesX, ty = tileIndex / nbTilesX;
+            PixelRect r;
+            r.x0 = tx * TileSize;
+            r.y0 = ty * TileSize;
+            r.x1 = ImMin(r.x0 + TileSize, width);
+            r.y1 = ImMin(r.y0 + TileSize, height);
+            return r;
+        }
+
+        void AddTriangle(const Triangle& t)
+        {
+            uint32_t triangleIndex = (uint32_t)triangles.size();
+            triangles.push_back(t);
+            int tx0 = t.bounds.x0 / TileSize, tx1 = (t.bounds.x1 - 1) / TileSize;
+            int ty0 = t.bounds.y0 / TileSize, ty1 = (t.bounds.y1 - 1) / TileSize;
+            bool severalTilesPerAxis = (tx1 > tx0) && (ty1 > ty0);
+            for (int ty = ty0; ty <= ty1; ++ty)
+                for (int tx = tx0; tx <= tx1; ++tx)
+                {
+                    int tileIndex = ty * nbTilesX + tx;
+                    // Long diagonal triangles do not touch all the tiles of their bounding box
+                    if (severalTilesPerAxis && !TriangleMayTouchRect(t, TileRect(tileIndex)))
+                        continue;
+                    bins[(size_t)tileIndex].push_back(triangleIndex);
+                    ++stats.nbBinnedTriangles;
+                }
+        }
+
+        // Sets up the triangles, and bins them into the tiles (in submission order)
+        void SetupAndBin(const ImDrawData* drawData)
+        {
+            triangles.clear();
+            for (auto& bin: bins)
+                bin.clear();
+
+            const ImVec2 displayPos = drawData->DisplayPos;
+            const ImVec2 scale = drawData->FramebufferScale;
+            Triangle triangle;
+            for (int n = 0; n < drawData->CmdListsCount; ++n)
+            {
+                const ImDrawList* drawList = drawData->CmdLists[n];
+                for (const ImDrawCmd& cmd: drawList->CmdBuffer)
+                {
+                    if (cmd.UserCallback != nullptr)
+                    {
+                        if (cmd.UserCallback != ImDrawCallback_ResetRenderState)
+                            cmd.UserCallback(drawList, &cmd);
+                        continue;
+                    }
+
+                    PixelRect clip;
+                    clip.x0 = ImMax((int)((cmd.ClipRect.x - displayPos.x) * scale.x), 0);
+                    clip.y0 = ImMax((int)((cmd.ClipRect.y - displayPos.y) * scale.y), 0);
+                    clip.x1 = ImMin((int)((cmd.ClipRect.z - displayPos.x) * scale.x), width);
+                    clip.y1 = ImMin((int)((cmd.ClipRect.w - displayPos.y) * scale.y), height);
+                    if (clip.IsEmpty())
+                        continue;
+
+                    // Like with the GPU backends, the texture id is trusted: it is a Texture*
+                    const Texture* texture = (const Texture*)cmd.GetTexID();
+                    const ImDrawIdx* indices = drawList->IdxBuffer.Data + cmd.IdxOffset;
+                    const ImDrawVert* vertices = drawList->VtxBuffer.Data + cmd.VtxOffset;
+                    for (unsigned int i = 0; i + 2 < cmd.ElemCount; i += 3)
+                    {
+                        const ImDrawVert* v[3];
+                        ImVec2 positions[3];
+                        for (int k = 0; k < 3; ++k)
+                        {
+                            v[k] = &vertices[indices[i + k]];
+                            positions[k] = ImVec2((v[k]->pos.x - displayPos.x) * scale.x, (v[k]->pos.y - displayPos.y) * scale.y);
+                        }
+                        if (SetupTriangle(positions, v, clip, texture, &triangle))
+                            AddTriangle(triangle);
+                    }
+                }
+            }
+            stats.nbTriangles = triangles.size();
+        }
+
+        void RasterizeTile(int tileIndex)
+        {
+            PixelRect tileRect = TileRect(tileIndex);
+            for (uint32_t triangleIndex: bins[(size_t)tileIndex])
+            {
+                const Triangle& t = triangles[triangleIndex];
+                PixelRect r;
+                r.x0 = ImMax(t.bounds.x0, tileRect.x0);
+                r.y0 = ImMax(t.bounds.y0, tileRect.y0);
+                r.x1 = ImMin(t.bounds.x1, tileRect.x1);
+                r.y1 = ImMin(t.bounds.y1, tileRect.y1);
+                if (!r.IsEmpty())
+                    RasterizeTriangle(t, r, pixels.data(), width);
+            }
+        }
+    };
+
+
+    SoftwareRasterizer::SoftwareRasterizer(int nbThreads)
+        : mImpl(std::make_unique<Impl>(nbThreads))
+    {
+    }
+
+    SoftwareRasterizer::~SoftwareRasterizer() = default;
+
+    ImTextureID SoftwareRasterizer::CreateTexture(const unsigned char* rgbaPixels, int width, int height)
+    {
+        auto texture = std::make_unique<Texture>();
+        texture->width = width;
+        texture->height = height;
+        texture->texels.resize((size_t)width * (size_t)height);
+        for (size_t i = 0; i < texture->texels.size(); ++i)
+        {
+            const unsigned char* p = rgbaPixels + i * 4;
+            texture->texels[i] = PackRgba(p[0], p[1], p[2], p[3]);
+        }
+        ImTextureID textureId = (ImTextureID)texture.get();
+        mImpl->textures.push_back(std::move(texture));
+        return textureId;
+    }
+
+    void SoftwareRasterizer::DestroyTexture(ImTextureID textureId)
+    {
+        auto& textures = mImpl->textures;
+        textures.erase(
+            std::remove_if(textures.begin(), textures.end(),
+                           [textureId](const std::unique_ptr<Texture>& t) { return (ImTextureID)t.get() == textureId; }),
+            textures.end());
+    }
+
+    void SoftwareRasterizer::CreateFontsTexture()
+    {
+        ImGuiIO& io = ImGui::GetIO();
+        unsigned char* pixels;
+        int width, height;
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+        mImpl->fontsTexture = CreateTexture(pixels, width, height);
+        io.Fonts->SetTexID(mImpl->fontsTexture);
+    }
+
+    void SoftwareRasterizer::DestroyFontsTexture()
+    {
+        if (mImpl->fontsTexture == nullptr)
+            return;
+        DestroyTexture(mImpl->fontsTexture);
+        mImpl->fontsTexture = nullptr;
+        if (ImGui::GetCurrentContext() != nullptr)
+            ImGui::GetIO().Fonts->SetTexID(nullptr);
+    }
+
+    void SoftwareRasterizer::UpdateFontsTexture(int x, int y, int width, int height)
+    {
+        if (mImpl->fontsTexture == nullptr)
+            return;
+        Texture* texture = (Texture*)mImpl->fontsTexture;
+        unsigned char* pixels;
+        int atlasWidth, atlasHeight;
+        ImGui::GetIO().Fonts->GetTexDataAsRGBA32(&pixels, &atlasWidth, &atlasHeight);
+        IM_ASSERT(atlasWidth == texture->width && atlasHeight == texture->height);
+        for (int row = y; row < y + height; ++row)
+            for (int column = x; column < x + width; ++column)
+            {
+                const unsigned char* p = pixels + ((size_t)row * atlasWidth + column) * 4;
+                texture->texels[(size_t)row * texture->width + column] = PackRgba(p[0], p[1], p[2], p[3]);
+            }
+    }
+
+    void SoftwareRasterizer::Resize(int width, int height)
+    {
+        Impl& impl = *mImpl;
+        width = ImMax(width, 0);
+        height = ImMax(height, 0);
+        if (width == impl.width && height == impl.height)
+            return;
+        impl.width = width;
+        impl.height = height;
+        impl.pixels.assign((size_t)width * (size_t)height, 0u);
+        impl.nbTilesX = (width + TileSize - 1) / TileSize;
+        impl.nbTilesY = (height + TileSize - 1) / TileSize;
+        impl.bins.resize((size_t)impl.nbTilesX * (size_t)impl.nbTilesY);
+    }
+
+    void SoftwareRasterizer::Clear(ImVec4 color)
+    {
+        uint32_t c = PackRgba(ChannelFromFloat(color.x), ChannelFromFloat(color.y), ChannelFromFloat(color.z), ChannelFromFloat(color.w));
+        std::fill(mImpl->pixels.begin(), mImpl->pixels.end(), c);
+    }
+
+    void SoftwareRasterizer::RenderDrawData(const ImDrawData* drawData)
+    {
+        Impl& impl = *mImpl;
+        impl.stats = FrameStats();
+        if (drawData == nullptr || impl.pixels.empty())
+            return;
+        impl.SetupAndBin(drawData);
+        int nbTiles = impl.nbTilesX * impl.nbTilesY;
+        impl.stats.nbTiles = nbTiles;
+        if (impl.triangles.empty())
+            return;
+        impl.workerPool.ParallelFor(nbTiles, [&impl](int tileIndex) { impl.RasterizeTile(tileIndex); });
+    }
+
+    int SoftwareRasterizer::Width() const { return mImpl->width; }
+    int SoftwareRasterizer::Height() const { return mImpl->height; }
+    int SoftwareRasterizer::NbThreads() const { return mImpl->workerPool.NbWorkers() + 1; }
+    const std::vector<uint32_t>& SoftwareRasterizer::Pixels() const { return mImpl->pixels; }
+    const SoftwareRasterizer::FrameStats& SoftwareRasterizer::LastFrameStats() const { return mImpl->stats; }
+
+    ImageBuffer SoftwareRasterizer::ScreenshotRgb() const
+    {
+        ImageBuffer r;
+        r.width = (size_t)mImpl->width;
+        r.height = (size_t)mImpl->height;
+        r.bufferRgb.resize(r.width * r.height * 3);
+        uint8_t* dst = r.bufferRgb.data();
+        for (uint32_t pixel: mImpl->pixels)
+        {
+            *dst++ = (uint8_t)(pixel & 0xFF);
+            *dst++ = (uint8_t)((pixel >> 8) & 0xFF);
+            *dst++ = (uint8_t)((pixel >> 16) & 0xFF);
+        }
+        return r;
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include "hello_imgui/hello_imgui_screenshot.h"
+#include "imgui.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+
+namespace HelloImGui
+{
+    // SoftwareRasterizer: renders ImDrawData into a RGBA framebuffer, on the CPU.
+    //
+    // It is the engine of the Software rendering backend (headless screenshots, pixel-diff tests),
+    // and can also be used on its own, with any ImGui context:
+    //     SoftwareRasterizer rasterizer;
+    //     rasterizer.CreateFontsTexture();      // uploads the font atlas, and sets io.Fonts->TexID
+    //     rasterizer.Resize(width, height);
+    //     ... ImGui::NewFrame(); (gui) ImGui::Render();
+    //     rasterizer.Clear(ImVec4(0.f, 0.f, 0.f, 1.f));
+    //     rasterizer.RenderDrawData(ImGui::GetDrawData());
+    //     ImageBuffer image = rasterizer.ScreenshotRgb();
+    //
+    // How it works:
+    //     - the triangles are set up (edge functions, attribute planes) and binned into 64x64 pixels tiles
+    //     - the tiles are rasterized in parallel: each tile draws its triangles in submission order,
+    //       so that alpha blending gives the same result as a GPU with the standard ImGui blend state
+    //     - the coverage of 4 pixels is evaluated at once with SSE, when available
+    // The output does not depend on the number of threads. Textures are sampled with the nearest filter.
+    class SoftwareRasterizer
+    {
+    public:
+        // nbThreads: number of threads which rasterize the tiles (the calling thread included);
+        //            0 => one per hardware thread. Always 1 with emscripten without pthreads.
+        explicit SoftwareRasterizer(int nbThreads = 0);
+        ~SoftwareRasterizer();
+        SoftwareRasterizer(const SoftwareRasterizer&) = delete;
+        SoftwareRasterizer& operator=(const SoftwareRasterizer&) = delete;
+
+        // Textures are RGBA32 images, copied into the rasterizer.
+        // Their ImTextureID can be used with ImGui::Image() and ImDrawList (and by other rasterizers,
+        // as long as this one is alive). A null ImTextureID stands for a white texture.
+        ImTextureID CreateTexture(const unsigned char* rgbaPixels, int width, int height);
+        void DestroyTexture(ImTextureID textureId);
+        // Creates the texture of io.Fonts, and stores its id into it
+        void CreateFontsTexture();
+        void DestroyFontsTexture();
+        // Copies a rectangle of the io.Fonts pixels into its texture (e.g. glyphs rasterized on demand)
+        void UpdateFontsTexture(int x, int y, int width, int height);
+
+        // The content of the framebuffer is lost when its size changes
+        void Resize(int width, int height);
+        void Clear(ImVec4 color);
+        void RenderDrawData(const ImDrawData* drawData);
+
+        int Width() const;
+        int Height() const;
+        int NbThreads() const;
+        // One uint32_t per pixel, row after row: R | G << 8 | B << 16 | A << 24
+        const std::vector<uint32_t>& Pixels() const;
+        ImageBuffer ScreenshotRgb() const;
+
+        struct FrameStats
+        {
+            size_t nbTriangles = 0;         // triangles which survived the clipping (and which are not degenerate)
+            size_t nbBinnedTriangles = 0;   // sum of the number of triangles of each tile
+            int nbTiles = 0;
+        };
+        // Stats of the last call to RenderDrawData()
+        const FrameStats& LastFrameStats() const;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> mImpl;
+    };
+}
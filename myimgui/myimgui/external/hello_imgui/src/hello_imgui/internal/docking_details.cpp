@@ -280,6 +280,14 @@ ImRect FullScreenRect_MinusInsets(const RunnerParams& runnerParams)
 }
 
 
+// HelloImGui::AllEdgeToolbarTypes(), without a new vector at each frame
+static const std::vector<EdgeToolbarType>& EdgeToolbarTypes()
+{
+    static const std::vector<EdgeToolbarType> edgeToolbarTypes = HelloImGui::AllEdgeToolbarTypes();
+    return edgeToolbarTypes;
+}
+
+
 // This function returns many different positions:
 // - position of the main dock space (if edgeToolbarTypeOpt==nullopt)
 // - position of an edge toolbar (if edgeToolbarTypeOpt!=nullopt)
@@ -371,7 +379,7 @@ ImRect FixedWindowRect(
 
         auto& edgesToolbarsMap = runnerParams.callbacks.edgesToolbars;
 
-        for(auto edgeToolbarType: HelloImGui::AllEdgeToolbarTypes())
+        for (auto edgeToolbarType: EdgeToolbarTypes())
         {
             if (edgesToolbarsMap.find(edgeToolbarType) != edgesToolbarsMap.end())
             {
@@ -450,7 +458,7 @@ void DoShowToolbar(
 
 void ShowToolbars(const RunnerParams& runnerParams)
 {
-    for (auto edgeToolbarType: HelloImGui::AllEdgeToolbarTypes())
+    for (auto edgeToolbarType: EdgeToolbarTypes())
     {
         if (runnerParams.callbacks.edgesToolbars.find(edgeToolbarType) != runnerParams.callbacks.edgesToolbars.end())
         {
@@ -0,0 +1,105 @@
+#include "hello_imgui/internal/draw_data_hash.h"
+
+#include <cstring>
+
+namespace HelloImGui
+{
+    namespace Internal
+    {
+        namespace
+        {
+            inline uint64_t RotateLeft(uint64_t v, int n) { return (v << n) | (v >> (64 - n)); }
+
+            // Hashes 8 bytes at a time, on 4 independent lanes (so that the multiplications can overlap).
+            // Not a cryptographic hash: it only needs to tell apart two consecutive frames.
+            class Hasher
+            {
+            public:
+                void Add(const void* data, size_t size)
+                {
+                    const unsigned char* p = (const unsigned char*)data;
+                    mLength += size;
+                    for (; size >= 32; p += 32, size -= 32)
+                        for (int lane = 0; lane < 4; ++lane)
+                            mLanes[lane] = Mix(mLanes[lane], Read64(p + lane * 8));
+                    for (; size >= 8; p += 8, size -= 8)
+                        mLanes[0] = Mix(mLanes[0], Read64(p));
+                    if (size > 0)
+                    {
+                        uint64_t tail = 0;
+                        memcpy(&tail, p, size);
+                        mLanes[1] = Mix(mLanes[1], tail);
+                    }
+                }
+
+                template<typename T> void AddValue(const T& value) { Add(&value, sizeof(T)); }
+
+                uint64_t Digest() const
+                {
+                    uint64_t h = mLength;
+                    for (uint64_t lane: mLanes)
+                        h = Mix(h, lane);
+                    // splitmix64 finalizer
+                    h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+                    h = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+                    return h ^ (h >> 31);
+                }
+
+            private:
+                static uint64_t Read64(const unsigned char* p)
+                {
+                    uint64_t v;
+                    memcpy(&v, p, 8);
+                    return v;
+                }
+
+                static uint64_t Mix(uint64_t h, uint64_t v)
+                {
+                    h ^= v * 0x9E3779B97F4A7C15ull;
+                    return RotateLeft(h, 31) * 0xC2B2AE3D27D4EB4Full;
+                }
+
+                uint64_t mLanes[4] = { 0x243F6A8885A308D3ull, 0x13198A2E03707344ull, 0xA4093822299F31D0ull, 0x082EFA98EC4E6C89ull };
+                uint64_t mLength = 0;
+            };
+        }
+
+        uint64_t HashDrawData(const ImDrawData* drawData)
+        {
+            if (drawData == nullptr || !drawData->Valid)
+                return 0;
+
+            Hasher hasher;
+            hasher.AddValue(drawData->DisplayPos);
+            hasher.AddValue(drawData->DisplaySize);
+            hasher.AddValue(drawData->FramebufferScale);
+            hasher.AddValue(drawData->CmdListsCount);
+            for (int n = 0; n < drawData->CmdListsCount; ++n)
+            {
+                const ImDrawList* drawList = drawData->CmdLists[n];
+                hasher.AddValue(drawList->CmdBuffer.Size);
+                for (const ImDrawCmd& cmd: drawList->CmdBuffer)
+                {
+                    if (cmd.UserCallback != nullptr)
+                    {
+                        if (cmd.UserCallback != ImDrawCallback_ResetRenderState)
+                            return 0;
+                        hasher.AddValue(cmd.UserCallback);
+                        continue;
+                    }
+                    hasher.AddValue(cmd.ClipRect);
+                    hasher.AddValue(cmd.TextureId);
+                    hasher.AddValue(cmd.VtxOffset);
+                    hasher.AddValue(cmd.IdxOffset);
+                    hasher.AddValue(cmd.ElemCount);
+                }
+                hasher.AddValue(drawList->VtxBuffer.Size);
+                hasher.Add(drawList->VtxBuffer.Data, (size_t)drawList->VtxBuffer.Size * sizeof(ImDrawVert));
+                hasher.AddValue(drawList->IdxBuffer.Size);
+                hasher.Add(drawList->IdxBuffer.Data, (size_t)drawList->IdxBuffer.Size * sizeof(ImDrawIdx));
+            }
+            uint64_t hash = hasher.Digest();
+            return (hash == 0) ? 1 : hash;
+        }
+    }
+}
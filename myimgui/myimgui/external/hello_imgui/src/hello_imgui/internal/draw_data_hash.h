@@ -0,0 +1,17 @@
+#pragma once
+#include "imgui.h"
+
+#include <cstdint>
+
+namespace HelloImGui
+{
+    namespace Internal
+    {
+        // A 64 bits hash of everything a rendering backend reads from the draw data:
+        // the display rect, the commands (clip rects, texture ids, offsets) and the vertex & index buffers.
+        // Returns 0 (which is never the hash of a frame) if the draw data contains user callbacks,
+        // since what they draw cannot be known.
+        // Note: texture ids are hashed, not the textures content.
+        uint64_t HashDrawData(const ImDrawData* drawData);
+    }
+}
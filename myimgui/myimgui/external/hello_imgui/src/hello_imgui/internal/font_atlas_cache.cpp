@@ -0,0 +1,390 @@
+#include "hello_imgui/internal/font_atlas_cache.h"
+#include "hello_imgui/internal/clock_seconds.h"
+#include "hello_imgui/runner_params.h"
+#include "imgui_internal.h"
+
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+namespace HelloImGui
+{
+    namespace Internal
+    {
+        namespace
+        {
+            // "HIFA" + format version: change the version when the file layout changes
+            const uint32_t CacheMagic = 0x41464948u;
+            const uint32_t CacheVersion = 1;
+
+            // 64 bits FNV-1a
+            class KeyHasher
+            {
+            public:
+                void Add(const void* data, size_t size)
+                {
+                    const unsigned char* p = (const unsigned char*)data;
+                    for (size_t i = 0; i < size; ++i)
+                        mHash = (mHash ^ p[i]) * 0x100000001B3ull;
+                }
+                template<typename T> void AddValue(const T& value) { Add(&value, sizeof(T)); }
+                uint64_t Hash() const { return mHash; }
+
+            private:
+                uint64_t mHash = 0xCBF29CE484222325ull;
+            };
+
+            int IndexOfFont(const ImFontAtlas* atlas, const ImFont* font)
+            {
+                for (int i = 0; i < atlas->Fonts.Size; ++i)
+                    if (atlas->Fonts[i] == font)
+                        return i;
+                return -1;
+            }
+
+            class BinaryWriter
+            {
+            public:
+                void Write(const void* data, size_t size)
+                {
+                    const char* p = (const char*)data;
+                    mBuffer.insert(mBuffer.end(), p, p + size);
+                }
+                template<typename T> void WriteValue(const T& value) { Write(&value, sizeof(T)); }
+                template<typename T> void WriteVector(const ImVector<T>& v)
+                {
+                    WriteValue(v.Size);
+                    Write(v.Data, (size_t)v.Size * sizeof(T));
+                }
+
+                // Writes into a temporary file, then renames it: a concurrent reader never sees a partial file
+                bool SaveToFile(const std::string& filename) const
+                {
+                    std::string tmpFilename = filename + ".tmp";
+                    {
+                        std::ofstream ofs(tmpFilename, std::ios::binary);
+                        if (!ofs.good())
+                            return false;
+                        ofs.write(mBuffer.data(), (std::streamsize)mBuffer.size());
+                        if (!ofs.good())
+                            return false;
+                    }
+                    std::error_code error;
+                    std::filesystem::rename(tmpFilename, filename, error);
+                    return !error;
+                }
+
+            private:
+                std::vector<char> mBuffer;
+            };
+
+            // Reads from a buffer, and fails (instead of overflowing) if the file is truncated or corrupted
+            class BinaryReader
+            {
+            public:
+                explicit BinaryReader(std::vector<char> buffer) : mBuffer(std::move(buffer)) {}
+
+                bool Read(void* data, size_t size)
+                {
+                    if (size > mBuffer.size() - mPosition)
+                        return false;
+                    if (size > 0)
+                        memcpy(data, mBuffer.data() + mPosition, size);
+                    mPosition += size;
+                    return true;
+                }
+                template<typename T> bool ReadValue(T* value) { return Read(value, sizeof(T)); }
+                template<typename T> bool ReadVector(ImVector<T>* v)
+                {
+                    int size;
+                    if (!ReadValue(&size) || size < 0 || (size_t)size > (mBuffer.size() - mPosition) / sizeof(T))
+                        return false;
+                    v->resize(size);
+                    return Read(v->Data, (size_t)size * sizeof(T));
+                }
+                bool IsAtEnd() const { return mPosition == mBuffer.size(); }
+
+            private:
+                std::vector<char> mBuffer;
+                size_t mPosition = 0;
+            };
+
+            bool ReadFile(const std::string& filename, std::vector<char>* content)
+            {
+                std::ifstream ifs(filename, std::ios::binary | std::ios::ate);
+                if (!ifs.good())
+                    return false;
+                std::streamsize size = ifs.tellg();
+                if (size <= 0)
+                    return false;
+                ifs.seekg(0, std::ios::beg);
+                content->resize((size_t)size);
+                return (bool)ifs.read(content->data(), size);
+            }
+
+            // What Build() outputs, besides the fonts lookup tables (which BuildLookupTable() recomputes)
+            void WriteAtlas(BinaryWriter& writer, const ImFontAtlas* atlas, uint64_t key)
+            {
+                writer.WriteValue(CacheMagic);
+                writer.WriteValue(CacheVersion);
+                writer.WriteValue(key);
+
+                writer.WriteValue(atlas->TexWidth);
+                writer.WriteValue(atlas->TexHeight);
+                writer.WriteValue(atlas->TexUvScale);
+                writer.WriteValue(atlas->TexUvWhitePixel);
+                writer.WriteValue(atlas->TexUvLines);
+                writer.WriteValue(atlas->TexPixelsUseColors);
+                size_t nbPixels = (size_t)atlas->TexWidth * (size_t)atlas->TexHeight;
+                bool hasAlpha8 = atlas->TexPixelsAlpha8 != nullptr, hasRgba32 = atlas->TexPixelsRGBA32 != nullptr;
+                writer.WriteValue(hasAlpha8);
+                if (hasAlpha8)
+                    writer.Write(atlas->TexPixelsAlpha8, nbPixels);
+                writer.WriteValue(hasRgba32);
+                if (hasRgba32)
+                    writer.Write(atlas->TexPixelsRGBA32, nbPixels * 4);
+
+                writer.WriteValue(atlas->CustomRects.Size);
+                for (const ImFontAtlasCustomRect& rect: atlas->CustomRects)
+                {
+                    writer.WriteValue(rect.X);
+                    writer.WriteValue(rect.Y);
+                }
+
+                writer.WriteValue(atlas->Fonts.Size);
+                for (const ImFont* font: atlas->Fonts)
+                {
+                    writer.WriteValue(font->FontSize);
+                    writer.WriteValue(font->Ascent);
+                    writer.WriteValue(font->Descent);
+                    writer.WriteValue(font->MetricsTotalSurface);
+                    writer.WriteVector(font->Glyphs);
+                }
+            }
+
+            // The atlas inputs are those of the cache (their key matches): restores its outputs
+            bool ReadAtlas(BinaryReader& reader, ImFontAtlas* atlas)
+            {
+                // What Build() starts with: registers the default custom rects, and rounds the font sizes
+                ImFontAtlasBuildInit(atlas);
+                atlas->TexID = (ImTextureID)NULL;
+                atlas->ClearTexData();
+
+                int texWidth, texHeight;
+                if (!reader.ReadValue(&texWidth) || !reader.ReadValue(&texHeight) || texWidth <= 0 || texHeight <= 0)
+                    return false;
+                atlas->TexWidth = texWidth;
+                atlas->TexHeight = texHeight;
+                if (!reader.ReadValue(&atlas->TexUvScale) || !reader.ReadValue(&atlas->TexUvWhitePixel)
+                    || !reader.ReadValue(&atlas->TexUvLines) || !reader.ReadValue(&atlas->TexPixelsUseColors))
+                    return false;
+                size_t nbPixels = (size_t)texWidth * (size_t)texHeight;
+                bool hasAlpha8, hasRgba32;
+                if (!reader.ReadValue(&hasAlpha8))
+                    return false;
+                if (hasAlpha8)
+                {
+                    atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC(nbPixels);
+                    if (!reader.Read(atlas->TexPixelsAlpha8, nbPixels))
+                        return false;
+                }
+                if (!reader.ReadValue(&hasRgba32))
+                    return false;
+                if (hasRgba32)
+                {
+                    atlas->TexPixelsRGBA32 = (unsigned int*)IM_ALLOC(nbPixels * 4);
+                    if (!reader.Read(atlas->TexPixelsRGBA32, nbPixels * 4))
+                        return false;
+                }
+                if (!hasAlpha8 && !hasRgba32)
+                    return false;
+
+                int nbCustomRects;
+                if (!reader.ReadValue(&nbCustomRects) || nbCustomRects != atlas->CustomRects.Size)
+                    return false;
+                for (ImFontAtlasCustomRect& rect: atlas->CustomRects)
+                    if (!reader.ReadValue(&rect.X) || !reader.ReadValue(&rect.Y))
+                        return false;
+
+                int nbFonts;
+                if (!reader.ReadValue(&nbFonts) || nbFonts != atlas->Fonts.Size)
+                    return false;
+                for (ImFont* font: atlas->Fonts)
+                {
+                    font->ClearOutputData();
+                    font->ContainerAtlas = atlas;
+                    if (!reader.ReadValue(&font->FontSize) || !reader.ReadValue(&font->Ascent) || !reader.ReadValue(&font->Descent)
+                        || !reader.ReadValue(&font->MetricsTotalSurface) || !reader.ReadVector(&font->Glyphs))
+                        return false;
+                    if (font->Glyphs.Size == 0)
+                        return false;
+                }
+                if (!reader.IsAtEnd())
+                    return false;
+
+                // What Build() ends with
+                for (ImFont* font: atlas->Fonts)
+                    font->BuildLookupTable();
+                atlas->TexReady = true;
+                return true;
+            }
+
+            bool LoadAtlas(const std::string& cacheFilename, ImFontAtlas* atlas, uint64_t key)
+            {
+                std::vector<char> content;
+                if (!ReadFile(cacheFilename, &content))
+                    return false;
+                BinaryReader reader(std::move(content));
+                uint32_t magic, version;
+                uint64_t fileKey;
+                if (!reader.ReadValue(&magic) || !reader.ReadValue(&version) || !reader.ReadValue(&fileKey))
+                    return false;
+                if (magic != CacheMagic || version != CacheVersion || fileKey != key)
+                    return false;
+                return ReadAtlas(reader, atlas);
+            }
+        }
+
+
+        uint64_t FontAtlasCacheKey(const ImFontAtlas* atlas)
+        {
+            // A custom builder may depend on anything
+            if (atlas->FontBuilderIO != nullptr || atlas->ConfigData.Size == 0)
+                return 0;
+            // The glyphs rasterized on demand need the font data, which is not in the cache
+            for (const ImFontConfig& cfg: atlas->ConfigData)
+                if (cfg.RasterizeOnDemand)
+                    return 0;
+
+            KeyHasher hasher;
+            hasher.AddValue(CacheVersion);
+            hasher.AddValue(IMGUI_VERSION_NUM);
+            hasher.AddValue(sizeof(ImFontGlyph));
+        #ifdef IMGUI_ENABLE_FREETYPE
+            hasher.AddValue('F');
+        #else
+            hasher.AddValue('S');
+        #endif
+            hasher.AddValue(atlas->Flags);
+            hasher.AddValue(atlas->TexDesiredWidth);
+            hasher.AddValue(atlas->TexGlyphPadding);
+            hasher.AddValue(atlas->FontBuilderFlags);
+
+            hasher.AddValue(atlas->ConfigData.Size);
+            for (const ImFontConfig& cfg: atlas->ConfigData)
+            {
+                hasher.AddValue(cfg.FontDataSize);
+                hasher.Add(cfg.FontData, (size_t)cfg.FontDataSize);
+                hasher.AddValue(cfg.FontNo);
+                hasher.AddValue(cfg.SizePixels);
+                hasher.AddValue(cfg.OversampleH);
+                hasher.AddValue(cfg.OversampleV);
+                hasher.AddValue(cfg.PixelSnapH);
+                hasher.AddValue(cfg.GlyphExtraSpacing);
+                hasher.AddValue(cfg.GlyphOffset);
+                hasher.AddValue(cfg.GlyphMinAdvanceX);
+                hasher.AddValue(cfg.GlyphMaxAdvanceX);
+                hasher.AddValue(cfg.MergeMode);
+                hasher.AddValue(cfg.FontBuilderFlags);
+                hasher.AddValue(cfg.RasterizerMultiply);
+                hasher.AddValue(cfg.RasterizerDensity);
+                hasher.AddValue(cfg.EllipsisChar);
+                hasher.AddValue(IndexOfFont(atlas, cfg.DstFont));
+                // Null ranges stand for the default ones
+                const ImWchar* ranges = cfg.GlyphRanges ? cfg.GlyphRanges : const_cast<ImFontAtlas*>(atlas)->GetGlyphRangesDefault();
+                for (; ranges[0] != 0; ranges += 2)
+                {
+                    hasher.AddValue(ranges[0]);
+                    hasher.AddValue(ranges[1]);
+                }
+                hasher.AddValue((ImWchar)0);
+            }
+
+            hasher.AddValue(atlas->CustomRects.Size);
+            for (const ImFontAtlasCustomRect& rect: atlas->CustomRects)
+            {
+                hasher.AddValue(rect.Width);
+                hasher.AddValue(rect.Height);
+                hasher.AddValue(rect.GlyphID);
+                hasher.AddValue(rect.GlyphAdvanceX);
+                hasher.AddValue(rect.GlyphOffset);
+                hasher.AddValue(IndexOfFont(atlas, rect.Font));
+            }
+
+            uint64_t key = hasher.Hash();
+            return (key == 0) ? 1 : key;
+        }
+
+
+        bool BuildFontAtlas_WithCache(ImFontAtlas* atlas, const std::string& cacheFilename)
+        {
+            uint64_t key = FontAtlasCacheKey(atlas);
+            if (key == 0)
+                return atlas->Build();
+
+            if (LoadAtlas(cacheFilename, atlas, key))
+                return true;
+
+            // Not in the cache (or the file is corrupted): the atlas may be partially restored, Build() resets it
+            bool buildSuccess = atlas->Build();
+            if (buildSuccess)
+            {
+                BinaryWriter writer;
+                WriteAtlas(writer, atlas, key);
+                writer.SaveToFile(cacheFilename); // a failure only means that the next startup will build the atlas again
+            }
+            return buildSuccess;
+        }
+
+
+        std::string FontAtlasCacheLocation(const RunnerParams& runnerParams)
+        {
+            std::string iniLocation = IniSettingsLocation(runnerParams);
+            const std::string iniExtension = ".ini";
+            if (iniLocation.size() >= iniExtension.size()
+                && iniLocation.compare(iniLocation.size() - iniExtension.size(), iniExtension.size(), iniExtension) == 0)
+                iniLocation.resize(iniLocation.size() - iniExtension.size());
+            return iniLocation + "_fonts.cache";
+        }
+
+
+        bool BuildImGuiFontAtlas(const RunnerParams& runnerParams)
+        {
+            ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+            atlas->BuildParallelForFn = runnerParams.useParallelFontAtlasBuild ? FontAtlasBuild_ParallelFor : nullptr;
+            double startTime = ClockSeconds();
+            bool success;
+            if (runnerParams.useFontAtlasCache)
+                success = BuildFontAtlas_WithCache(atlas, FontAtlasCacheLocation(runnerParams));
+            else
+                success = atlas->Build();
+            atlas->BuildTime = (float)(ClockSeconds() - startTime);
+            return success;
+        }
+
+
+        void FontAtlasBuild_ParallelFor(void* /*userData*/, int nbJobs, void (*jobFunc)(void* jobData, int jobIndex), void* jobData)
+        {
+        #if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+            int nbThreads = 1;
+        #else
+            int nbThreads = ImClamp((int)std::thread::hardware_concurrency(), 1, nbJobs);
+        #endif
+            // The jobs are claimed one at a time: their durations vary with the glyphs sizes
+            std::atomic<int> nextJob{0};
+            auto runJobs = [&] {
+                for (int i = nextJob++; i < nbJobs; i = nextJob++)
+                    jobFunc(jobData, i);
+            };
+            std::vector<std::thread> threads;
+            for (int i = 1; i < nbThreads; ++i)
+                threads.emplace_back(runJobs);
+            runJobs();
+            for (auto& thread: threads)
+                thread.join();
+        }
+    }
+}
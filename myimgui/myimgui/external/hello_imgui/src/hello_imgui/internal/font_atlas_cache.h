@@ -0,0 +1,36 @@
+#pragma once
+#include "imgui.h"
+
+#include <cstdint>
+#include <string>
+
+namespace HelloImGui
+{
+    struct RunnerParams;
+
+    namespace Internal
+    {
+        // A cache of the built font atlas (pixels, glyphs, and packed custom rects), stored in a binary file.
+        // Its key is a hash of everything ImFontAtlas::Build() reads: the content of the font files, their sizes,
+        // glyph ranges and configs (oversampling, merge mode, builder flags, ...), the atlas flags and the custom rects.
+        // The font sizes are multiplied by the DPI factor when loading, so that another DPI leads to another key.
+
+        // The key of the atlas inputs (0 if the atlas cannot be cached, e.g. with a custom FontBuilderIO,
+        // or with fonts rasterized on demand)
+        uint64_t FontAtlasCacheKey(const ImFontAtlas* atlas);
+
+        // Restores the atlas from the cache file if its key matches; otherwise builds it,
+        // and saves it into the cache file. Returns false if the build failed.
+        bool BuildFontAtlas_WithCache(ImFontAtlas* atlas, const std::string& cacheFilename);
+
+        // Builds ImGui::GetIO().Fonts, through the cache if runnerParams.useFontAtlasCache,
+        // with parallel rasterization if runnerParams.useParallelFontAtlasBuild. Stores the build duration into atlas->BuildTime.
+        bool BuildImGuiFontAtlas(const RunnerParams& runnerParams);
+
+        // Runs the rasterization jobs of ImFontAtlas::Build() on one thread per core (see ImFontAtlas::BuildParallelForFn)
+        void FontAtlasBuild_ParallelFor(void* userData, int nbJobs, void (*jobFunc)(void* jobData, int jobIndex), void* jobData);
+
+        // The cache file is stored next to the ini settings file: "[ini file name]_fonts.cache"
+        std::string FontAtlasCacheLocation(const RunnerParams& runnerParams);
+    }
+}
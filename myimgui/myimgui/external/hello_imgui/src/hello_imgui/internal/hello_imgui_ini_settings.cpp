@@ -1,6 +1,7 @@
 #include "hello_imgui/internal/hello_imgui_ini_settings.h"
 #include "hello_imgui/internal/inicpp.h"
 #include "hello_imgui/internal/functional_utils.h"
+#include "hello_imgui/internal/settings_store.h"
 #include "imgui_internal.h"
 
 
@@ -158,8 +159,28 @@ namespace HelloImGui
         }
 
 
+        static bool gUseSettingsStore = false;
+
+        void SetUseSettingsStore(bool useSettingsStore)
+        {
+            gUseSettingsStore = useSettingsStore;
+        }
+
         IniParts IniParts::LoadFromFile(const std::string& iniPartsFilename)
         {
+            if (gUseSettingsStore)
+            {
+                const auto& storedParts = Internal::GetSettingsStore(Internal::SettingsStoreLocation(iniPartsFilename)).Parts();
+                // Until the store is written for the first time, the settings come from the ini file (if any)
+                if (!storedParts.empty())
+                {
+                    IniParts iniParts;
+                    for (const auto& storedPart: storedParts)
+                        iniParts.Parts.push_back(IniPart{storedPart.Name, storedPart.Content});
+                    return iniParts;
+                }
+            }
+
             std::string iniPartsContent = FunctionalUtils::read_text_file_or_empty(iniPartsFilename);
             auto iniParts = SplitIniParts(iniPartsContent);
             return iniParts;
@@ -167,6 +188,15 @@ namespace HelloImGui
 
         void IniParts::WriteToFile(const std::string& iniPartsFilename)
         {
+            if (gUseSettingsStore)
+            {
+                std::vector<Internal::SettingsPart> storedParts;
+                for (const auto& iniPart: Parts)
+                    storedParts.push_back(Internal::SettingsPart{iniPart.Name, iniPart.Content});
+                Internal::GetSettingsStore(Internal::SettingsStoreLocation(iniPartsFilename)).Write(storedParts);
+                return;
+            }
+
             std::string iniPartsContent = JoinIniParts(*this);
             FunctionalUtils::write_text_file(iniPartsFilename, iniPartsContent);
         }
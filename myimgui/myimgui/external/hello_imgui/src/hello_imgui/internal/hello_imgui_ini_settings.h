@@ -56,6 +56,11 @@ namespace HelloImGui
         IniParts SplitIniParts(const std::string& s);
         std::string JoinIniParts(const IniParts& parts);
 
+        // If true, IniParts are loaded from and written to a binary SettingsStore ("[ini file name]_settings.store",
+        // see settings_store.h), which only appends the changed sections. The ini file is then only read
+        // while the store is empty (i.e. at the first run). Set by the runner (RunnerParams.useBinarySettingsStore).
+        void SetUseSettingsStore(bool useSettingsStore);
+
         //
         // The settings below are global to the app
         //
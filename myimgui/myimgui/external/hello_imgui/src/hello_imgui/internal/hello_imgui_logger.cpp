@@ -1,5 +1,7 @@
 #include "hello_imgui/hello_imgui_logger.h"
+#include "hello_imgui/internal/clock_seconds.h"
 #include "hello_imgui/internal/imguial_term.h"
+#include "hello_imgui/internal/log_ring_buffer.h"
 #include "hello_imgui/hello_imgui.h"
 
 namespace HelloImGui
@@ -11,36 +13,61 @@ namespace InternalLogBuffer
     char gLogBuffer_[gMaxBufferSize];
     ImGuiAl::Log gLog(gLogBuffer_, gMaxBufferSize);
 
+    // Log() may be called from any thread: the records wait here until the UI thread moves them into gLog
+    static constexpr size_t gNbPendingRecords = 4096;
+    Internal::LogRingBuffer gPendingRecords(gNbPendingRecords);
+    uint64_t gNbDroppedReported = 0;
 }
 
 void Log(LogLevel level, char const* const format, ...)
 {
+    if (level != LogLevel::Debug && level != LogLevel::Info && level != LogLevel::Warning && level != LogLevel::Error)
+        throw std::runtime_error("Log: bad LogLevel !");
+
     va_list args;
     va_start(args, format);
+    InternalLogBuffer::gPendingRecords.Push(level, Internal::ClockSeconds(), format, args);
+    va_end(args);
+}
 
-    if (level == LogLevel::Debug)
-        InternalLogBuffer::gLog.debug(format, args);
-    else if (level == LogLevel::Info)
-        InternalLogBuffer::gLog.info(format, args);
-    else if (level == LogLevel::Warning)
-        InternalLogBuffer::gLog.warning(format, args);
-    else if (level == LogLevel::Error)
-        InternalLogBuffer::gLog.error(format, args);
-    else
-        throw std::runtime_error("Log: bad LogLevel !");
+namespace Internal
+{
+    void Log_DrainPendingRecords()
+    {
+        using namespace InternalLogBuffer;
+        // Each line starts with the time of its Log() call (seconds since the start of the app):
+        // the records of the background threads may be drained several frames later
+        gPendingRecords.Drain([](const LogRecord& record) {
+            if (record.level == LogLevel::Debug)
+                gLog.debug("[%.3f] %s", record.timestamp, record.text);
+            else if (record.level == LogLevel::Info)
+                gLog.info("[%.3f] %s", record.timestamp, record.text);
+            else if (record.level == LogLevel::Warning)
+                gLog.warning("[%.3f] %s", record.timestamp, record.text);
+            else
+                gLog.error("[%.3f] %s", record.timestamp, record.text);
+        });
 
-    va_end(args);
+        uint64_t nbDropped = gPendingRecords.GetStats().nbDropped;
+        if (nbDropped > gNbDroppedReported)
+        {
+            gLog.warning("Log: %llu messages were dropped (more than %zu messages between two frames)",
+                         (unsigned long long)(nbDropped - gNbDroppedReported), gNbPendingRecords);
+            gNbDroppedReported = nbDropped;
+        }
+    }
 }
 
 void LogClear()
 {
+    Internal::Log_DrainPendingRecords();
     InternalLogBuffer::gLog.clear();
 }
 
 void LogGui(ImVec2 size)
 {
+    Internal::Log_DrainPendingRecords();
     InternalLogBuffer::gLog.draw(size);
 }
 
 }  // namespace HelloImGui
-
@@ -0,0 +1,262 @@
+#include "hello_imgui/internal/image_cache.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace HelloImGui
+{
+    namespace Internal
+    {
+        struct ImageCache::Impl
+        {
+            struct Entry
+            {
+                Status status = Status::Loading;
+                ImageAbstractPtr image;
+                size_t bytes = 0;
+                uint64_t lastUsedFrame = 0;
+            };
+
+            Functions functions;
+
+            // Only used by the main thread
+            std::unordered_map<std::string, Entry> entries;
+            uint64_t frameIndex = 0;
+            size_t usedBytes = 0;
+            int nbImages = 0;
+            int nbEvictedImages = 0;
+
+            // Shared with the worker thread
+            mutable std::mutex mutex;
+            std::condition_variable condition;
+            std::deque<std::string> queue;
+            std::vector<std::pair<std::string, DecodedImage>> decoded;
+            int nbDecoding = 0;
+            bool shallStop = false;
+            std::thread thread;
+
+            DecodedImage DecodeNoThrow(const std::string& assetPath)
+            {
+                try
+                {
+                    return functions.decode(assetPath);
+                }
+                catch (...)
+                {
+                    // e.g. a missing asset: the image is reported as Failed
+                    return DecodedImage();
+                }
+            }
+
+            void Loop()
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                while (true)
+                {
+                    condition.wait(lock, [this] { return !queue.empty() || shallStop; });
+                    if (shallStop)
+                        return;
+
+                    std::string assetPath = std::move(queue.front());
+                    queue.pop_front();
+                    nbDecoding = 1;
+                    lock.unlock();
+
+                    DecodedImage image = DecodeNoThrow(assetPath);
+
+                    lock.lock();
+                    decoded.emplace_back(std::move(assetPath), image);
+                    nbDecoding = 0;
+                    condition.notify_all();
+                    if (functions.onDecodedAsync)
+                    {
+                        lock.unlock();
+                        functions.onDecodedAsync();
+                        lock.lock();
+                    }
+                }
+            }
+
+            void Enqueue(const std::string& assetPath)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    queue.push_back(assetPath);
+                }
+                if (!thread.joinable())
+                    thread = std::thread([this] { Loop(); });
+                condition.notify_all();
+            }
+
+            // Waits for the asynchronous decoding of an image (or decodes it now, if the worker did not start it)
+            DecodedImage WaitForDecode(const std::string& assetPath)
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                auto itQueued = std::find(queue.begin(), queue.end(), assetPath);
+                if (itQueued != queue.end())
+                {
+                    queue.erase(itQueued);
+                    lock.unlock();
+                    return DecodeNoThrow(assetPath);
+                }
+                auto findDecoded = [&] {
+                    return std::find_if(decoded.begin(), decoded.end(),
+                                        [&](const std::pair<std::string, DecodedImage>& d) { return d.first == assetPath; });
+                };
+                condition.wait(lock, [&] { return findDecoded() != decoded.end(); });
+                auto itDecoded = findDecoded();
+                DecodedImage image = itDecoded->second;
+                decoded.erase(itDecoded);
+                return image;
+            }
+
+            // Creates the texture, and frees the pixels
+            void Store(Entry& entry, const DecodedImage& image)
+            {
+                entry.status = Status::Failed;
+                if (image.rgba == nullptr)
+                    return;
+                entry.image = functions.createImage();
+                if (entry.image != nullptr)
+                {
+                    entry.image->Width = image.width;
+                    entry.image->Height = image.height;
+                    entry.image->_impl_StoreTexture(image.width, image.height, image.rgba);
+                    entry.status = Status::Ready;
+                    entry.bytes = (size_t)image.width * (size_t)image.height * 4;
+                    usedBytes += entry.bytes;
+                    nbImages += 1;
+                }
+                functions.freePixels(image.rgba);
+            }
+
+            // The least recently used image, among those which were not used during the last frame
+            std::unordered_map<std::string, Entry>::iterator FindEvictable()
+            {
+                auto best = entries.end();
+                for (auto it = entries.begin(); it != entries.end(); ++it)
+                {
+                    const Entry& entry = it->second;
+                    if (entry.status != Status::Ready || entry.lastUsedFrame >= frameIndex)
+                        continue;
+                    if (best == entries.end() || entry.lastUsedFrame < best->second.lastUsedFrame)
+                        best = it;
+                }
+                return best;
+            }
+        };
+
+
+        ImageCache::ImageCache(Functions functions)
+            : mImpl(std::make_unique<Impl>())
+        {
+            mImpl->functions = std::move(functions);
+        }
+
+        ImageCache::~ImageCache()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mImpl->mutex);
+                mImpl->shallStop = true;
+            }
+            mImpl->condition.notify_all();
+            if (mImpl->thread.joinable())
+                mImpl->thread.join();
+            for (auto& d: mImpl->decoded)
+                if (d.second.rgba != nullptr)
+                    mImpl->functions.freePixels(d.second.rgba);
+        }
+
+        ImageCache::Lookup ImageCache::Get(const std::string& assetPath, bool async)
+        {
+        #if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+            // No worker thread without pthreads: the images are always decoded synchronously
+            async = false;
+        #endif
+            Impl& impl = *mImpl;
+            auto it = impl.entries.find(assetPath);
+            if (it == impl.entries.end())
+            {
+                if (async)
+                {
+                    it = impl.entries.emplace(assetPath, Impl::Entry()).first;
+                    impl.Enqueue(assetPath);
+                }
+                else
+                {
+                    // Decoded before the entry is created: a decoding error may throw
+                    DecodedImage image = impl.functions.decode(assetPath);
+                    it = impl.entries.emplace(assetPath, Impl::Entry()).first;
+                    impl.Store(it->second, image);
+                }
+            }
+            else if (it->second.status == Status::Loading && !async)
+                impl.Store(it->second, impl.WaitForDecode(assetPath));
+
+            Impl::Entry& entry = it->second;
+            entry.lastUsedFrame = impl.frameIndex;
+            return Lookup{ entry.status, entry.image };
+        }
+
+        bool ImageCache::OnFrameStart(size_t budgetBytes, const std::function<void()>& beforeTextureChanges)
+        {
+            Impl& impl = *mImpl;
+            bool changed = false;
+            auto beforeChange = [&] {
+                if (!changed && beforeTextureChanges)
+                    beforeTextureChanges();
+                changed = true;
+            };
+
+            std::vector<std::pair<std::string, DecodedImage>> decoded;
+            {
+                std::lock_guard<std::mutex> lock(impl.mutex);
+                decoded.swap(impl.decoded);
+            }
+            for (auto& d: decoded)
+            {
+                auto it = impl.entries.find(d.first);
+                IM_ASSERT(it != impl.entries.end() && it->second.status == Status::Loading);
+                if (d.second.rgba != nullptr)
+                    beforeChange();
+                impl.Store(it->second, d.second);
+            }
+
+            if (budgetBytes > 0)
+            {
+                while (impl.usedBytes > budgetBytes)
+                {
+                    auto it = impl.FindEvictable();
+                    if (it == impl.entries.end())
+                        break;
+                    beforeChange();
+                    impl.usedBytes -= it->second.bytes;
+                    impl.nbImages -= 1;
+                    impl.nbEvictedImages += 1;
+                    impl.entries.erase(it);
+                }
+            }
+
+            impl.frameIndex += 1;
+            return changed;
+        }
+
+        ImageCache::Stats ImageCache::GetStats() const
+        {
+            Stats stats;
+            stats.usedBytes = mImpl->usedBytes;
+            stats.nbImages = mImpl->nbImages;
+            stats.nbEvictedImages = mImpl->nbEvictedImages;
+            std::lock_guard<std::mutex> lock(mImpl->mutex);
+            stats.nbPendingDecodes = (int)mImpl->queue.size() + mImpl->nbDecoding;
+            return stats;
+        }
+    }
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include "hello_imgui/internal/image_abstract.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+
+namespace HelloImGui
+{
+    namespace Internal
+    {
+        // ImageCache: the images displayed by ImageFromAsset & co, with an optional asynchronous decoding
+        // and a memory budget (see RunnerParams.imageFromAssetParams).
+        //
+        // - An image requested asynchronously is decoded on a worker thread: Get() reports it as loading
+        //   until OnFrameStart() creates its texture, at the start of a next frame (the textures are always
+        //   created from the main thread, which owns the renderer context).
+        // - Each texture accounts for width * height * 4 bytes. When the budget is exceeded, OnFrameStart()
+        //   evicts the least recently used images, but not the ones used during the last frame.
+        //   An evicted image is decoded again when it is used again.
+        class ImageCache
+        {
+        public:
+            // RGBA pixels, allocated by the decode function (rgba is null if the decoding failed)
+            struct DecodedImage
+            {
+                int width = 0, height = 0;
+                unsigned char* rgba = nullptr;
+            };
+
+            struct Functions
+            {
+                // Decodes an asset; called from the worker thread when decoding asynchronously
+                std::function<DecodedImage(const std::string& assetPath)> decode;
+                // Frees the pixels returned by decode, once they are stored into a texture
+                std::function<void(unsigned char* rgba)> freePixels;
+                // Creates an empty image for the current renderer (or nullptr if not implemented)
+                std::function<ImageAbstractPtr()> createImage;
+                // Called from the worker thread when an image was decoded (e.g. to request a redraw). Optional.
+                std::function<void()> onDecodedAsync;
+            };
+
+            enum class Status { Ready, Loading, Failed };
+            struct Lookup
+            {
+                Status status = Status::Failed;
+                ImageAbstractPtr image;  // non null if Ready
+            };
+
+            struct Stats
+            {
+                size_t usedBytes = 0;       // sum of width * height * 4 for the textures in the cache
+                int nbImages = 0;           // textures in the cache
+                int nbPendingDecodes = 0;   // images queued or being decoded by the worker thread
+                int nbEvictedImages = 0;    // since the creation of the cache
+            };
+
+            explicit ImageCache(Functions functions);
+            // Stops the worker thread (after its current decoding), and frees the images
+            ~ImageCache();
+            ImageCache(const ImageCache&) = delete;
+            ImageCache& operator=(const ImageCache&) = delete;
+
+            // Returns the image, and marks it as used during this frame.
+            // If it is not in the cache, it is decoded on the worker thread if async (the status is Loading until then),
+            // otherwise it is decoded now. A synchronous request waits for a pending asynchronous decoding.
+            Lookup Get(const std::string& assetPath, bool async);
+
+            // Called by the runner at the start of each frame: creates the textures of the decoded images,
+            // then evicts the least recently used images while the used bytes exceed budgetBytes (0 = unlimited).
+            // beforeTextureChanges is called once before the first texture is created or destroyed
+            // (e.g. to wait for the render thread). Returns true if some textures were created or destroyed.
+            bool OnFrameStart(size_t budgetBytes, const std::function<void()>& beforeTextureChanges);
+
+            Stats GetStats() const;
+
+        private:
+            struct Impl;
+            std::unique_ptr<Impl> mImpl;
+        };
+    }
+}
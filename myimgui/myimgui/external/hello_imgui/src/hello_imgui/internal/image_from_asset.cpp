@@ -1,11 +1,13 @@
 #include "hello_imgui/image_from_asset.h"
 
 #include "hello_imgui/internal/image_abstract.h"
+#include "hello_imgui/internal/image_cache.h"
 #include "hello_imgui/hello_imgui.h"
 #include "image_opengl.h"
 #include "image_dx11.h"
 #include "image_metal.h"
 #include "image_vulkan.h"
+#include "image_software.h"
 
 #include "hello_imgui/image_from_asset.h"
 #include "hello_imgui/hello_imgui_assets.h"
@@ -15,8 +17,8 @@
 #include "hello_imgui/hello_imgui_logger.h"
 #include "stb_image.h"
 
+#include <memory>
 #include <string>
-#include <unordered_map>
 #include <stdexcept>
 
 
@@ -35,14 +37,8 @@ namespace HelloImGui
         return r;
     }
 
-    static std::unordered_map<std::string, ImageAbstractPtr > gImageFromAssetMap;
-
-
-    static ImageAbstractPtr _GetCachedImage(const char*assetPath)
+    static ImageAbstractPtr _CreateConcreteImage()
     {
-        if (gImageFromAssetMap.find(assetPath) != gImageFromAssetMap.end())
-            return gImageFromAssetMap.at(assetPath);
-
         HelloImGui::RendererBackendType rendererBackendType = HelloImGui::GetRunnerParams()->rendererBackendType;
         ImageAbstractPtr concreteImage;
 
@@ -62,30 +58,76 @@ namespace HelloImGui
             if (rendererBackendType == RendererBackendType::DirectX11)
                 concreteImage = std::make_shared<ImageDx11>();
         #endif
+        #if defined(HELLOIMGUI_HAS_SOFTWARE)
+            if (rendererBackendType == RendererBackendType::Software)
+                concreteImage = std::make_shared<ImageSoftware>();
+        #endif
         if (concreteImage == nullptr)
             HelloImGui::Log(LogLevel::Warning, "ImageFromAsset: not implemented for this rendering backend!");
-        gImageFromAssetMap[assetPath] = concreteImage;
+        return concreteImage;
+    }
+
+    // Called from the worker thread of the cache when decoding asynchronously
+    // (the cache then reports the image as failed, instead of throwing)
+    static Internal::ImageCache::DecodedImage _DecodeAsset(const std::string& assetPath)
+    {
+        auto assetData = LoadAssetFileData(assetPath.c_str());
+        if (assetData.data == nullptr)
+            throw std::runtime_error("ImageAbstract: Failed to load image!");
+
+        // Load the image using stbi_load_from_memory
+        Internal::ImageCache::DecodedImage r;
+        r.rgba = stbi_load_from_memory(
+            (unsigned char *)assetData.data, (int)assetData.dataSize,
+            &r.width, &r.height, NULL, 4);
+        FreeAssetFileData(&assetData);
+        if (r.rgba == NULL)
+            throw std::runtime_error("ImageAbstract: Failed to load image!");
+        return r;
+    }
 
-        if (concreteImage != nullptr)
+    static std::unique_ptr<Internal::ImageCache> gImageCache;
+
+    static Internal::ImageCache& _ImageCache()
+    {
+        if (!gImageCache)
         {
-            // Load the image using stbi_load_from_memory
-            auto assetData = LoadAssetFileData(assetPath);
-            IM_ASSERT(assetData.data != nullptr);
-            unsigned char*image_data_rgba = stbi_load_from_memory(
-                (unsigned char *)assetData.data, (int)assetData.dataSize,
-                &concreteImage->Width, &concreteImage->Height, NULL, 4);
-            if (image_data_rgba == NULL)
-            {
-                IM_ASSERT(false && "ImageDx11: Failed to load image!");
-                throw std::runtime_error("ImageAbstract: Failed to load image!");
-            }
-
-            concreteImage->_impl_StoreTexture(concreteImage->Width, concreteImage->Height, image_data_rgba);
+            Internal::ImageCache::Functions functions;
+            functions.decode = _DecodeAsset;
+            functions.freePixels = [](unsigned char* rgba) { stbi_image_free(rgba); };
+            functions.createImage = _CreateConcreteImage;
+            functions.onDecodedAsync = [] { HelloImGui::RequestRedraw(); };
+            gImageCache = std::make_unique<Internal::ImageCache>(functions);
         }
+        return *gImageCache;
+    }
 
-        return gImageFromAssetMap.at(assetPath);
+    // Returns nullptr if the image is still loading (only when async), or if it failed
+    static ImageAbstractPtr _GetCachedImage(const char*assetPath, bool allowAsync, bool* isLoading = nullptr)
+    {
+        bool async = allowAsync && HelloImGui::GetRunnerParams()->imageFromAssetParams.asyncDecode;
+        auto lookup = _ImageCache().Get(assetPath, async);
+        if (isLoading != nullptr)
+            *isLoading = (lookup.status == Internal::ImageCache::Status::Loading);
+        return lookup.image;
     }
 
+    // Displayed while an image is decoded: the image size is not known yet
+    static void _ImagePlaceholder(const ImVec2& askedSize)
+    {
+        ImVec2 size(askedSize);
+        if ((size.x == 0.f) && (size.y == 0.f))
+            size = ImVec2(ImGui::GetFrameHeight(), ImGui::GetFrameHeight());
+        else if (size.y == 0.f)
+            size.y = size.x;
+        else if (size.x == 0.f)
+            size.x = size.y;
+        ImVec2 pos = ImGui::GetCursorScreenPos();
+        ImGui::Dummy(size);
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+        drawList->AddRectFilled(pos, ImVec2(pos.x + size.x, pos.y + size.y), ImGui::GetColorU32(ImGuiCol_FrameBg));
+        drawList->AddRect(pos, ImVec2(pos.x + size.x, pos.y + size.y), ImGui::GetColorU32(ImGuiCol_Border));
+    }
 
 
     void ImageFromAsset(
@@ -93,7 +135,13 @@ namespace HelloImGui
         const ImVec2& uv0, const ImVec2& uv1,
         const ImVec4& tint_col, const ImVec4& border_col)
     {
-        auto cachedImage = _GetCachedImage(assetPath);
+        bool isLoading;
+        auto cachedImage = _GetCachedImage(assetPath, true, &isLoading);
+        if (isLoading)
+        {
+            _ImagePlaceholder(size);
+            return;
+        }
         if (cachedImage == nullptr)
         {
             ImGui::TextColored(ImVec4(1.f, 0.f, 0.f, 1.f), "ImageFromAsset: fail!");
@@ -107,7 +155,13 @@ namespace HelloImGui
 
     bool ImageButtonFromAsset(const char *assetPath, const ImVec2& size, const ImVec2& uv0,  const ImVec2& uv1, int frame_padding, const ImVec4& bg_col, const ImVec4& tint_col)
     {
-        auto cachedImage = _GetCachedImage(assetPath);
+        bool isLoading;
+        auto cachedImage = _GetCachedImage(assetPath, true, &isLoading);
+        if (isLoading)
+        {
+            _ImagePlaceholder(size);
+            return false;
+        }
         if (cachedImage == nullptr)
         {
             ImGui::TextColored(ImVec4(1.f, 0.f, 0.f, 1.f), "ImageButtonFromAsset: fail!");
@@ -122,7 +176,7 @@ namespace HelloImGui
 
     ImTextureID ImTextureIdFromAsset(const char *assetPath)
     {
-        auto cachedImage = _GetCachedImage(assetPath);
+        auto cachedImage = _GetCachedImage(assetPath, false);
         if (cachedImage == nullptr)
             return ImTextureID(0);
         return cachedImage->TextureID();
@@ -130,7 +184,7 @@ namespace HelloImGui
 
     ImVec2 ImageSizeFromAsset(const char *assetPath)
     {
-        auto cachedImage = _GetCachedImage(assetPath);
+        auto cachedImage = _GetCachedImage(assetPath, false);
         if (cachedImage == nullptr)
             return ImVec2(0.f, 0.f);
         return ImVec2((float)cachedImage->Width, (float)cachedImage->Height);
@@ -138,7 +192,7 @@ namespace HelloImGui
 
     ImageAndSize ImageAndSizeFromAsset(const char *assetPath)
     {
-        auto cachedImage = _GetCachedImage(assetPath);
+        auto cachedImage = _GetCachedImage(assetPath, false);
         if (cachedImage == nullptr)
             return {};
         return {cachedImage->TextureID(), ImVec2((float)cachedImage->Width, (float)cachedImage->Height)};
@@ -148,7 +202,22 @@ namespace HelloImGui
     {
         void Free_ImageFromAssetMap()
         {
-            gImageFromAssetMap.clear();
+            gImageCache.reset();
+        }
+
+        bool ImageFromAssetCache_OnFrameStart(const std::function<void()>& beforeTextureChanges)
+        {
+            if (!gImageCache)
+                return false;
+            auto& imageParams = HelloImGui::GetRunnerParams()->imageFromAssetParams;
+            bool changed = gImageCache->OnFrameStart(imageParams.cacheBudgetBytes, beforeTextureChanges);
+
+            auto stats = gImageCache->GetStats();
+            imageParams.cacheUsedBytes = stats.usedBytes;
+            imageParams.nbCachedImages = stats.nbImages;
+            imageParams.nbPendingDecodes = stats.nbPendingDecodes;
+            imageParams.nbEvictedImages = stats.nbEvictedImages;
+            return changed;
         }
     }
 
@@ -0,0 +1,27 @@
+#ifdef HELLOIMGUI_HAS_SOFTWARE
+#include "image_software.h"
+
+#include "hello_imgui/internal/backend_impls/rendering_software.h"
+
+
+namespace HelloImGui
+{
+    void ImageSoftware::_impl_StoreTexture(int width, int height, unsigned char* image_data_rgba)
+    {
+        TextureId = GetSoftwareRasterizer()->CreateTexture(image_data_rgba, width, height);
+    }
+
+    ImageSoftware::~ImageSoftware()
+    {
+        SoftwareRasterizer* rasterizer = GetSoftwareRasterizer();
+        if (rasterizer != nullptr && TextureId != nullptr)
+            rasterizer->DestroyTexture(TextureId);
+    }
+
+    ImTextureID ImageSoftware::TextureID()
+    {
+        return TextureId;
+    }
+}
+
+#endif // #ifdef HELLOIMGUI_HAS_SOFTWARE
@@ -0,0 +1,23 @@
+#pragma once
+#ifdef HELLOIMGUI_HAS_SOFTWARE
+
+#include "image_abstract.h"
+#include <memory>
+
+namespace HelloImGui
+{
+    struct ImageSoftware: public ImageAbstract
+    {
+        ImageSoftware() = default;
+        ~ImageSoftware() override;
+
+        ImTextureID TextureID() override;
+        void _impl_StoreTexture(int width, int height, unsigned char* image_data_rgba) override;
+
+        ImTextureID TextureId = nullptr;
+    };
+
+    using ImageSoftwarePtr = std::shared_ptr<ImageSoftware>;
+}
+
+#endif // #ifdef HELLOIMGUI_HAS_SOFTWARE
@@ -0,0 +1,129 @@
+#include "hello_imgui/internal/log_ring_buffer.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+
+namespace HelloImGui
+{
+    namespace Internal
+    {
+        struct LogRingBuffer::Slot
+        {
+            // == position + 1 when the record at this position is published,
+            // == position when the slot is free for a push at this position
+            std::atomic<size_t> sequence{0};
+            LogLevel level = LogLevel::Info;
+            double timestamp = 0.;
+            size_t length = 0;
+            char* heapText = nullptr;   // if the message does not fit in inlineText
+            char inlineText[InlineTextSize];
+        };
+
+
+        LogRingBuffer::LogRingBuffer(size_t nbSlots)
+        {
+            size_t capacity = 2;
+            while (capacity < nbSlots)
+                capacity *= 2;
+            mSlots = std::make_unique<Slot[]>(capacity);
+            mMask = capacity - 1;
+            for (size_t i = 0; i < capacity; ++i)
+                mSlots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        LogRingBuffer::~LogRingBuffer()
+        {
+            // Frees the long messages which were not drained
+            Drain([](const LogRecord&) {});
+        }
+
+        bool LogRingBuffer::Push(LogLevel level, double timestamp, const char* format, va_list args)
+        {
+            // Claim a slot: only the producers which find it free compete for the enqueue position
+            size_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+            Slot* slot;
+            while (true)
+            {
+                slot = &mSlots[pos & mMask];
+                size_t sequence = slot->sequence.load(std::memory_order_acquire);
+                intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+                if (diff == 0)
+                {
+                    if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                {
+                    // The slot still holds the record pushed one lap ago: the queue is full
+                    mNbDropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                else
+                    pos = mEnqueuePos.load(std::memory_order_relaxed);
+            }
+
+            // The slot is ours until it is published: format the message into it
+            va_list argsCopy;
+            va_copy(argsCopy, args);
+            int needed = vsnprintf(slot->inlineText, InlineTextSize, format, args);
+            if (needed < 0)
+            {
+                needed = 0;
+                slot->inlineText[0] = '\0';
+            }
+            if ((size_t)needed >= InlineTextSize)
+            {
+                slot->heapText = (char*)malloc((size_t)needed + 1);
+                if (slot->heapText != nullptr)
+                    vsnprintf(slot->heapText, (size_t)needed + 1, format, argsCopy);
+                else
+                    needed = (int)InlineTextSize - 1; // Out of memory: keeps the truncated inline text
+            }
+            va_end(argsCopy);
+            slot->level = level;
+            slot->timestamp = timestamp;
+            slot->length = (size_t)needed;
+
+            slot->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        size_t LogRingBuffer::Drain(const std::function<void(const LogRecord& record)>& fn)
+        {
+            size_t nbRecords = 0;
+            while (true)
+            {
+                Slot& slot = mSlots[mDequeuePos & mMask];
+                // Stops at the first record which is not published yet (its producer is still formatting it)
+                if (slot.sequence.load(std::memory_order_acquire) != mDequeuePos + 1)
+                    break;
+
+                LogRecord record;
+                record.level = slot.level;
+                record.timestamp = slot.timestamp;
+                record.text = slot.heapText != nullptr ? slot.heapText : slot.inlineText;
+                record.length = slot.length;
+                fn(record);
+
+                free(slot.heapText);
+                slot.heapText = nullptr;
+                // Free for the push one lap later
+                slot.sequence.store(mDequeuePos + mMask + 1, std::memory_order_release);
+                ++mDequeuePos;
+                ++nbRecords;
+            }
+            return nbRecords;
+        }
+
+        LogRingBuffer::Stats LogRingBuffer::GetStats() const
+        {
+            Stats stats;
+            // The enqueue position only advances for the records which are not dropped
+            stats.nbPushed = mEnqueuePos.load(std::memory_order_relaxed);
+            stats.nbDropped = mNbDropped.load(std::memory_order_relaxed);
+            return stats;
+        }
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include "hello_imgui/hello_imgui_logger.h"
+
+#include <atomic>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+
+namespace HelloImGui
+{
+    namespace Internal
+    {
+        // A log record, as stored by LogRingBuffer
+        struct LogRecord
+        {
+            LogLevel level = LogLevel::Info;
+            double timestamp = 0.;   // ClockSeconds() when the message was logged
+            const char* text = nullptr;
+            size_t length = 0;
+        };
+
+        // LogRingBuffer: a bounded lock-free multi-producer / single-consumer queue of log records.
+        //
+        // Any thread may push (the message is formatted by the producer, directly into its slot);
+        // only one thread (the UI thread) drains. Each slot holds a sequence number which tells whether
+        // it is free or published (D. Vyukov's bounded queue): producers only contend on one atomic index,
+        // and never wait for the consumer. When the queue is full, the record is dropped and counted.
+        // Short messages are stored inline; longer ones are allocated by the producer.
+        class LogRingBuffer
+        {
+        public:
+            // nbSlots is rounded up to a power of 2
+            explicit LogRingBuffer(size_t nbSlots);
+            ~LogRingBuffer();
+            LogRingBuffer(const LogRingBuffer&) = delete;
+            LogRingBuffer& operator=(const LogRingBuffer&) = delete;
+
+            // Thread safe. Returns false if the queue was full (the record is dropped)
+            bool Push(LogLevel level, double timestamp, const char* format, va_list args);
+
+            // Single consumer: calls fn for each published record, in the order of the pushes. Returns the number of records.
+            size_t Drain(const std::function<void(const LogRecord& record)>& fn);
+
+            struct Stats
+            {
+                uint64_t nbPushed = 0;     // records which were pushed (and not dropped)
+                uint64_t nbDropped = 0;    // records which were dropped since the queue was full
+            };
+            Stats GetStats() const;
+
+            static constexpr size_t InlineTextSize = 112;
+
+        private:
+            struct Slot;
+            std::unique_ptr<Slot[]> mSlots;
+            size_t mMask;
+            alignas(64) std::atomic<size_t> mEnqueuePos{0};
+            alignas(64) size_t mDequeuePos = 0;
+            std::atomic<uint64_t> mNbDropped{0};
+        };
+
+        // Moves the records logged by HelloImGui::Log into the log widget, and reports the dropped ones.
+        // Called from the UI thread by LogGui(), LogClear(), and by the runner at the start of each frame.
+        void Log_DrainPendingRecords();
+    }
+}
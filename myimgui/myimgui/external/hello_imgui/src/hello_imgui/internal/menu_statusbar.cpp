@@ -18,10 +18,11 @@ namespace Menu_StatusBar
 
 void ShowDefaultAppMenu_Quit(RunnerParams & runnerParams)
 {
-    std::string menuAppTitle = runnerParams.imGuiWindowParams.menuAppTitle;
-    if (menuAppTitle.empty())
-        menuAppTitle = runnerParams.appWindowParams.windowTitle;
-    if (menuAppTitle.empty())
+    // (not copied into a std::string: this runs at each frame)
+    const char* menuAppTitle = runnerParams.imGuiWindowParams.menuAppTitle.c_str();
+    if (menuAppTitle[0] == '\0')
+        menuAppTitle = runnerParams.appWindowParams.windowTitle.c_str();
+    if (menuAppTitle[0] == '\0')
         menuAppTitle = "App";
 
 #ifdef HELLOIMGUI_CANNOTQUIT
@@ -36,7 +37,7 @@ void ShowDefaultAppMenu_Quit(RunnerParams & runnerParams)
     if (isAppMenuEmpty)
         return;
 
-    if (ImGui::BeginMenu(menuAppTitle.c_str()))
+    if (ImGui::BeginMenu(menuAppTitle))
     {
         if (runnerParams.callbacks.ShowAppMenuItems)
             runnerParams.callbacks.ShowAppMenuItems();
@@ -71,6 +72,21 @@ void ShowMenu(RunnerParams & runnerParams)
 }
 
 
+// The displayed FPS is refreshed twice per second only: otherwise, the status bar would change at each frame,
+// and no identical frame could be skipped (see FpsIdling.skipIdenticalFrames)
+static float DisplayedFrameRate()
+{
+    static float displayedFrameRate = 0.f;
+    static double lastRefreshTime = -1.;
+    double now = ImGui::GetTime();
+    if (lastRefreshTime < 0. || now - lastRefreshTime >= 0.5 || now < lastRefreshTime)
+    {
+        displayedFrameRate = HelloImGui::FrameRate();
+        lastRefreshTime = now;
+    }
+    return displayedFrameRate;
+}
+
 void ShowStatusBar(RunnerParams & params)
 {
     float statusWindowHeight = ImGui::GetFrameHeight() * 1.4f;
@@ -102,7 +118,7 @@ void ShowStatusBar(RunnerParams & params)
 		if (ShouldRemoteDisplay())
 		{
 			ImGui::SameLine(ImGui::GetIO().DisplaySize.x - 5.f * ImGui::GetFontSize());
-			ImGui::Text("FPS: %.1f", HelloImGui::FrameRate());
+			ImGui::Text("FPS: %.1f", DisplayedFrameRate());
 		}
 		else
 		{
@@ -114,7 +130,10 @@ void ShowStatusBar(RunnerParams & params)
 			ImGui::Checkbox("Enable idling", &params.fpsIdling.enableIdling);
 			ImGui::SameLine();
 			ImGui::SetCursorPosY(ImGui::GetCursorPosY() - dy);
-			ImGui::Text("FPS: %.1f%s", HelloImGui::FrameRate(), idlingInfo);
+			ImGui::Text("FPS: %.1f%s", DisplayedFrameRate(), idlingInfo);
+			if (params.fpsIdling.skipIdenticalFrames)
+				ImGui::SetItemTooltip("Rendered frames: %d\nSkipped identical frames: %d",
+				                      params.fpsIdling.nbRenderedFrames, params.fpsIdling.nbSkippedFrames);
 		}
     }
 
@@ -0,0 +1,82 @@
+#include "hello_imgui/internal/redraw_requests.h"
+
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+namespace HelloImGui
+{
+    namespace Internal
+    {
+        namespace
+        {
+            struct RedrawRequests
+            {
+                std::mutex mutex;
+                // A min heap of the requested times (an earlier request does not replace the later ones)
+                std::priority_queue<double, std::vector<double>, std::greater<double>> times;
+                bool isWaiting = false;
+                std::function<void()> wakeFunction;
+            };
+
+            RedrawRequests& GetRedrawRequests()
+            {
+                static RedrawRequests redrawRequests;
+                return redrawRequests;
+            }
+        }
+
+        void RequestRedrawAt(double clockSeconds)
+        {
+            RedrawRequests& requests = GetRedrawRequests();
+            std::lock_guard<std::mutex> lock(requests.mutex);
+            bool isEarliest = requests.times.empty() || (clockSeconds < requests.times.top());
+            // A request at or after a pending one is dropped: the frame drawn for the pending one will make it again
+            // if it is still needed. Otherwise, an animation which requests its next frame at each frame would leave
+            // one pending request per frame drawn during a burst of events, and would never go back to fpsIdle.
+            if (isEarliest)
+                requests.times.push(clockSeconds);
+            // The runner computed its timeout before this request: wake it up, so that it computes it again
+            if (isEarliest && requests.isWaiting && requests.wakeFunction)
+                requests.wakeFunction();
+        }
+
+        void OnFrameStart_ForgetDueRedrawRequests(double now)
+        {
+            RedrawRequests& requests = GetRedrawRequests();
+            std::lock_guard<std::mutex> lock(requests.mutex);
+            while (!requests.times.empty() && requests.times.top() <= now)
+                requests.times.pop();
+        }
+
+        double NextRequestedRedrawTime()
+        {
+            RedrawRequests& requests = GetRedrawRequests();
+            std::lock_guard<std::mutex> lock(requests.mutex);
+            return requests.times.empty() ? -1. : requests.times.top();
+        }
+
+        double BeginWaitForRedraw()
+        {
+            RedrawRequests& requests = GetRedrawRequests();
+            std::lock_guard<std::mutex> lock(requests.mutex);
+            requests.isWaiting = true;
+            return requests.times.empty() ? -1. : requests.times.top();
+        }
+
+        void EndWaitForRedraw()
+        {
+            RedrawRequests& requests = GetRedrawRequests();
+            std::lock_guard<std::mutex> lock(requests.mutex);
+            requests.isWaiting = false;
+        }
+
+        void SetRedrawWakeFunction(const std::function<void()>& wakeFunction)
+        {
+            RedrawRequests& requests = GetRedrawRequests();
+            std::lock_guard<std::mutex> lock(requests.mutex);
+            requests.wakeFunction = wakeFunction;
+        }
+    }
+}
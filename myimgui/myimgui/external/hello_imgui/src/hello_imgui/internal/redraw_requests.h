@@ -0,0 +1,32 @@
+#pragma once
+#include <functional>
+
+namespace HelloImGui
+{
+    namespace Internal
+    {
+        // Redraw requests, made by HelloImGui::RequestRedraw / RequestRedrawIn (from any thread),
+        // and consumed by the runner when it idles (see FpsIdling.eventDrivenIdling).
+        // Times are expressed with ClockSeconds().
+
+        // Requests a new frame at the given time. Wakes the runner up if it is waiting.
+        // A request at or after a pending one is dropped (it shall be made again by the frame drawn for the pending one).
+        void RequestRedrawAt(double clockSeconds);
+
+        // Called by the runner at the start of each frame: forgets the requests which are due
+        void OnFrameStart_ForgetDueRedrawRequests(double now);
+
+        // Time of the next requested redraw (or a negative value if none)
+        double NextRequestedRedrawTime();
+
+        // The runner waits for events between BeginWaitForRedraw() and EndWaitForRedraw().
+        // BeginWaitForRedraw returns the time of the next requested redraw (or a negative value if none).
+        // A request made after BeginWaitForRedraw() calls the wake function.
+        double BeginWaitForRedraw();
+        void EndWaitForRedraw();
+
+        // The wake function is set by the runner (it posts an empty event to the window backend),
+        // and is called from the thread which requests a redraw.
+        void SetRedrawWakeFunction(const std::function<void()>& wakeFunction);
+    }
+}
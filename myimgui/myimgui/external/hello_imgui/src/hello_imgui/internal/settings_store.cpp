@@ -0,0 +1,407 @@
+#include "hello_imgui/internal/settings_store.h"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace HelloImGui
+{
+    namespace Internal
+    {
+        namespace
+        {
+            // "HISS" + format version: change the version when the file layout changes
+            const uint32_t StoreMagic = 0x53534948u;
+            const uint32_t StoreVersion = 1;
+            const size_t HeaderSize = 2 * sizeof(uint32_t);
+
+            // A record: op, key size, value size, key, value, checksum (of all the previous fields)
+            const char OpPut = 'P';
+            const char OpDelete = 'D';
+            const size_t RecordOverhead = 1 + 3 * sizeof(uint32_t);
+
+            // 32 bits FNV-1a
+            uint32_t Checksum(const char* data, size_t size)
+            {
+                uint32_t hash = 0x811C9DC5u;
+                for (size_t i = 0; i < size; ++i)
+                    hash = (hash ^ (unsigned char)data[i]) * 0x01000193u;
+                return hash;
+            }
+
+            template<typename T> void AppendValue(std::vector<char>& buffer, const T& value)
+            {
+                const char* p = (const char*)&value;
+                buffer.insert(buffer.end(), p, p + sizeof(T));
+            }
+
+            void EncodeRecord(std::vector<char>& buffer, char op, const std::string& key, const std::string& value)
+            {
+                size_t start = buffer.size();
+                buffer.push_back(op);
+                AppendValue(buffer, (uint32_t)key.size());
+                AppendValue(buffer, (uint32_t)value.size());
+                buffer.insert(buffer.end(), key.begin(), key.end());
+                buffer.insert(buffer.end(), value.begin(), value.end());
+                AppendValue(buffer, Checksum(buffer.data() + start, buffer.size() - start));
+            }
+
+            size_t EncodedRecordSize(const std::string& key, const std::string& value)
+            {
+                return RecordOverhead + key.size() + value.size();
+            }
+
+            // The whole file, mapped read-only into memory
+            class MappedFile
+            {
+            public:
+                explicit MappedFile(const std::string& filename)
+                {
+                #ifdef _WIN32
+                    mFile = CreateFileW(std::filesystem::u8path(filename).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+                    if (mFile == INVALID_HANDLE_VALUE)
+                        return;
+                    mExists = true;
+                    LARGE_INTEGER size;
+                    if (!GetFileSizeEx(mFile, &size) || size.QuadPart == 0)
+                        return;
+                    mMapping = CreateFileMappingW(mFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                    if (mMapping == nullptr)
+                        return;
+                    mData = (const char*)MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0);
+                    if (mData != nullptr)
+                        mSize = (size_t)size.QuadPart;
+                #else
+                    mFd = open(filename.c_str(), O_RDONLY);
+                    if (mFd < 0)
+                        return;
+                    mExists = true;
+                    struct stat st;
+                    if (fstat(mFd, &st) != 0 || st.st_size == 0)
+                        return;
+                    void* data = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, mFd, 0);
+                    if (data == MAP_FAILED)
+                        return;
+                    mData = (const char*)data;
+                    mSize = (size_t)st.st_size;
+                #endif
+                }
+
+                ~MappedFile()
+                {
+                #ifdef _WIN32
+                    if (mData != nullptr)
+                        UnmapViewOfFile(mData);
+                    if (mMapping != nullptr)
+                        CloseHandle(mMapping);
+                    if (mFile != INVALID_HANDLE_VALUE)
+                        CloseHandle(mFile);
+                #else
+                    if (mData != nullptr)
+                        munmap((void*)mData, mSize);
+                    if (mFd >= 0)
+                        close(mFd);
+                #endif
+                }
+
+                MappedFile(const MappedFile&) = delete;
+                MappedFile& operator=(const MappedFile&) = delete;
+
+                bool Exists() const { return mExists; }
+                const char* Data() const { return mData; }
+                size_t Size() const { return mSize; }
+
+            private:
+                bool mExists = false;
+                const char* mData = nullptr;
+                size_t mSize = 0;
+            #ifdef _WIN32
+                HANDLE mFile = INVALID_HANDLE_VALUE;
+                HANDLE mMapping = nullptr;
+            #else
+                int mFd = -1;
+            #endif
+            };
+
+            // Record keys:
+            //     "L"                          -> the part names (each followed by '\n')
+            //     "O" + part                   -> the keys of its sections (each followed by '\n')
+            //     "S" + part + '\n' + section  -> the section text
+            // A section key is its "[...]" line ("" for the text before the first one), made unique
+            // inside its part by a suffix ("\x1f" + number) if the line is repeated.
+            std::string SectionKey(const std::string& section)
+            {
+                if (section.empty() || section[0] != '[')
+                    return "";
+                return section.substr(0, section.find('\n'));
+            }
+
+            std::vector<std::pair<std::string, std::string>> RecordsOfParts(const std::vector<SettingsPart>& parts)
+            {
+                std::vector<std::pair<std::string, std::string>> records;
+                std::string partNames;
+                for (const auto& part: parts)
+                {
+                    partNames += part.Name + "\n";
+                    std::string sectionKeys;
+                    std::unordered_map<std::string, int> nbSameKeys;
+                    for (const std::string& section: SplitSettingsSections(part.Content))
+                    {
+                        std::string key = SectionKey(section);
+                        int nbSame = nbSameKeys[key]++;
+                        if (nbSame > 0)
+                            key += "\x1f" + std::to_string(nbSame);
+                        sectionKeys += key + "\n";
+                        records.emplace_back("S" + part.Name + "\n" + key, section);
+                    }
+                    records.emplace_back("O" + part.Name, sectionKeys);
+                }
+                records.emplace_back("L", partNames);
+                return records;
+            }
+
+            std::vector<std::string> SplitTerminatedLines(const std::string& s)
+            {
+                std::vector<std::string> lines;
+                size_t start = 0;
+                for (size_t end = s.find('\n'); end != std::string::npos; end = s.find('\n', start))
+                {
+                    lines.push_back(s.substr(start, end - start));
+                    start = end + 1;
+                }
+                return lines;
+            }
+        }
+
+
+        std::vector<std::string> SplitSettingsSections(const std::string& content)
+        {
+            std::vector<std::string> sections;
+            size_t sectionStart = 0;
+            size_t lineStart = 0;
+            while (lineStart < content.size())
+            {
+                if (content[lineStart] == '[' && lineStart > sectionStart)
+                {
+                    sections.push_back(content.substr(sectionStart, lineStart - sectionStart));
+                    sectionStart = lineStart;
+                }
+                size_t lineEnd = content.find('\n', lineStart);
+                lineStart = (lineEnd == std::string::npos) ? content.size() : lineEnd + 1;
+            }
+            if (sectionStart < content.size())
+                sections.push_back(content.substr(sectionStart));
+            return sections;
+        }
+
+
+        SettingsStore::SettingsStore(std::string filename, size_t compactionMinBytes)
+            : mFilename(std::move(filename)), mCompactionMinBytes(compactionMinBytes)
+        {
+            Load();
+        }
+
+        void SettingsStore::Load()
+        {
+            MappedFile file(mFilename);
+            const char* data = file.Data();
+            const size_t size = file.Size();
+            uint32_t magic = 0, version = 0;
+            if (size >= HeaderSize)
+            {
+                memcpy(&magic, data, sizeof(uint32_t));
+                memcpy(&version, data + sizeof(uint32_t), sizeof(uint32_t));
+            }
+            if (magic != StoreMagic || version != StoreVersion)
+            {
+                // The file will be rewritten at the first Write()
+                mNeedsCompaction = true;
+                return;
+            }
+
+            // Replay the records, until the end or a truncated / corrupted one
+            size_t pos = HeaderSize;
+            while (size - pos >= RecordOverhead)
+            {
+                const char* record = data + pos;
+                uint32_t keySize, valueSize;
+                memcpy(&keySize, record + 1, sizeof(uint32_t));
+                memcpy(&valueSize, record + 1 + sizeof(uint32_t), sizeof(uint32_t));
+                if ((size_t)keySize + (size_t)valueSize > size - pos - RecordOverhead)
+                    break;
+                size_t checkedSize = 1 + 2 * sizeof(uint32_t) + keySize + valueSize;
+                uint32_t checksum;
+                memcpy(&checksum, record + checkedSize, sizeof(uint32_t));
+                if (checksum != Checksum(record, checkedSize))
+                    break;
+
+                std::string key(record + 1 + 2 * sizeof(uint32_t), keySize);
+                if (record[0] == OpPut)
+                    mRecords[key] = std::string(record + 1 + 2 * sizeof(uint32_t) + keySize, valueSize);
+                else if (record[0] == OpDelete)
+                    mRecords.erase(key);
+                else
+                    break;
+                pos += checkedSize + sizeof(uint32_t);
+            }
+            if (pos != size)
+                mNeedsCompaction = true;
+
+            mStats.fileBytes = size;
+            mStats.liveBytes = HeaderSize;
+            for (const auto& record: mRecords)
+                mStats.liveBytes += EncodedRecordSize(record.first, record.second);
+
+            // Rebuild the parts from their records
+            auto itNames = mRecords.find("L");
+            if (itNames == mRecords.end())
+                return;
+            for (const std::string& partName: SplitTerminatedLines(itNames->second))
+            {
+                SettingsPart part;
+                part.Name = partName;
+                auto itKeys = mRecords.find("O" + partName);
+                if (itKeys != mRecords.end())
+                    for (const std::string& sectionKey: SplitTerminatedLines(itKeys->second))
+                    {
+                        auto itSection = mRecords.find("S" + partName + "\n" + sectionKey);
+                        if (itSection != mRecords.end())
+                            part.Content += itSection->second;
+                    }
+                mParts.push_back(std::move(part));
+            }
+        }
+
+        bool SettingsStore::Write(const std::vector<SettingsPart>& parts)
+        {
+            std::vector<std::pair<std::string, std::string>> records = RecordsOfParts(parts);
+
+            std::vector<char> delta;
+            int nbRecords = 0;
+            std::unordered_map<std::string, std::string> newRecords;
+            size_t liveBytes = HeaderSize;
+            for (auto& record: records)
+            {
+                auto it = mRecords.find(record.first);
+                if (it == mRecords.end() || it->second != record.second)
+                {
+                    EncodeRecord(delta, OpPut, record.first, record.second);
+                    ++nbRecords;
+                }
+                liveBytes += EncodedRecordSize(record.first, record.second);
+                newRecords.emplace(std::move(record.first), std::move(record.second));
+            }
+            for (const auto& record: mRecords)
+                if (newRecords.find(record.first) == newRecords.end())
+                {
+                    EncodeRecord(delta, OpDelete, record.first, "");
+                    ++nbRecords;
+                }
+
+            mRecords = std::move(newRecords);
+            mParts = parts;
+            mStats.liveBytes = liveBytes;
+
+            size_t fileBytesAfterAppend = mStats.fileBytes + delta.size();
+            if (mNeedsCompaction || (fileBytesAfterAppend > 2 * liveBytes && fileBytesAfterAppend > mCompactionMinBytes))
+                return Compact();
+            mStats.nbLastWrittenRecords = nbRecords;
+            if (delta.empty())
+                return true;
+            return AppendRecords(delta);
+        }
+
+        bool SettingsStore::AppendRecords(const std::vector<char>& records)
+        {
+            std::ofstream ofs(mFilename, std::ios::binary | std::ios::app);
+            if (!ofs.good())
+                return false;
+            ofs.write(records.data(), (std::streamsize)records.size());
+            if (!ofs.good())
+            {
+                // The tail may be partially written: rewrite the whole file next time
+                mNeedsCompaction = true;
+                return false;
+            }
+            mStats.fileBytes += records.size();
+            return true;
+        }
+
+        std::vector<char> SettingsStore::EncodeLiveRecords() const
+        {
+            std::vector<char> buffer;
+            AppendValue(buffer, StoreMagic);
+            AppendValue(buffer, StoreVersion);
+            for (const auto& record: RecordsOfParts(mParts))
+                EncodeRecord(buffer, OpPut, record.first, record.second);
+            return buffer;
+        }
+
+        // Writes into a temporary file, then renames it: the file is never partially rewritten
+        bool SettingsStore::Compact()
+        {
+            std::vector<char> buffer = EncodeLiveRecords();
+            std::string tmpFilename = mFilename + ".tmp";
+            {
+                std::ofstream ofs(tmpFilename, std::ios::binary);
+                if (!ofs.good())
+                    return false;
+                ofs.write(buffer.data(), (std::streamsize)buffer.size());
+                if (!ofs.good())
+                    return false;
+            }
+            std::error_code error;
+            std::filesystem::rename(tmpFilename, mFilename, error);
+            if (error)
+                return false;
+
+            mNeedsCompaction = false;
+            mStats.fileBytes = buffer.size();
+            mStats.nbLastWrittenRecords = (int)mRecords.size();
+            mStats.nbCompactions += 1;
+            return true;
+        }
+
+
+        static std::unordered_map<std::string, std::unique_ptr<SettingsStore>> gSettingsStores;
+
+        SettingsStore& GetSettingsStore(const std::string& filename)
+        {
+            auto& store = gSettingsStores[filename];
+            if (!store)
+                store = std::make_unique<SettingsStore>(filename);
+            return *store;
+        }
+
+        void ForgetSettingsStore(const std::string& filename)
+        {
+            gSettingsStores.erase(filename);
+        }
+
+        std::string SettingsStoreLocation(const std::string& iniFilename)
+        {
+            std::string location = iniFilename;
+            const std::string iniExtension = ".ini";
+            if (location.size() >= iniExtension.size()
+                && location.compare(location.size() - iniExtension.size(), iniExtension.size(), iniExtension) == 0)
+                location.resize(location.size() - iniExtension.size());
+            return location + "_settings.store";
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+namespace HelloImGui
+{
+    namespace Internal
+    {
+        // A named text part of the settings (as HelloImGuiIniSettings::IniParts::IniPart)
+        struct SettingsPart
+        {
+            std::string Name;
+            std::string Content;
+        };
+
+        // SettingsStore: the settings parts, stored in a compact binary file which is only appended to.
+        //
+        // Each part is split into records: one per ini section (a "[Window][Foo]" header and its lines),
+        // plus the order of the sections, and the order of the parts. Write() appends only the records
+        // which changed since the last write (or a deletion for the removed ones), in one write.
+        // When the dead records make the file more than twice as large as the live ones, it is compacted
+        // (rewritten into a temporary file, which is renamed). The file is loaded with a single mmap; the records
+        // are replayed in order, and a truncated or corrupted tail (e.g. after a crash) is ignored.
+        class SettingsStore
+        {
+        public:
+            // Loads the file if it exists. compactionMinBytes: the file is never compacted below this size
+            explicit SettingsStore(std::string filename, size_t compactionMinBytes = 64 * 1024);
+
+            // The parts, as they were last written (empty if the file does not exist)
+            const std::vector<SettingsPart>& Parts() const { return mParts; }
+
+            // Appends the records which differ from Parts() (or compacts the file). Returns false if the file cannot be written
+            bool Write(const std::vector<SettingsPart>& parts);
+
+            struct Stats
+            {
+                size_t fileBytes = 0;
+                size_t liveBytes = 0;            // size of the records which are not overwritten
+                int nbLastWrittenRecords = 0;    // records appended by the last Write (all the records if it compacted)
+                int nbCompactions = 0;
+            };
+            Stats GetStats() const { return mStats; }
+
+        private:
+            void Load();
+            bool AppendRecords(const std::vector<char>& records);
+            bool Compact();
+            std::vector<char> EncodeLiveRecords() const;
+
+            std::string mFilename;
+            size_t mCompactionMinBytes;
+            std::unordered_map<std::string, std::string> mRecords;  // key -> value of the live records
+            std::vector<SettingsPart> mParts;
+            bool mNeedsCompaction = false;   // the file is missing, or has a bad header or a corrupted tail
+            Stats mStats;
+        };
+
+        // Splits a part into its records' sections: text before the first "[...]" line, then one section per "[...]" line
+        std::vector<std::string> SplitSettingsSections(const std::string& content);
+
+        // The store of a file (the file is loaded once per process)
+        SettingsStore& GetSettingsStore(const std::string& filename);
+        // Forgets the store of a file (e.g. when its file was deleted)
+        void ForgetSettingsStore(const std::string& filename);
+
+        // The store file of an ini file: "[ini file name]_settings.store"
+        std::string SettingsStoreLocation(const std::string& iniFilename);
+    }
+}
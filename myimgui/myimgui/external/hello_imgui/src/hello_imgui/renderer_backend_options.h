@@ -84,6 +84,22 @@ struct RendererBackendOptions
     // `openGlOptions`:
     // Advanced options for OpenGL. Use at your own risk.
     std::optional<OpenGlOptions> openGlOptions = std::nullopt;
+
+    // `pipelinedRendering`:
+    // Set to true to render each frame on a render thread, while the main thread builds the next one
+    // (the draw data is copied). Only available with the Software and Null renderers, since the GPU contexts
+    // are bound to the main thread; ignored otherwise, and with multiple viewports or a CustomBackground.
+    // Textures used by the frame being rendered shall not be destroyed.
+    bool pipelinedRendering = false;
+
+    // `pipelineNbFrames`, `pipelineRenderSeconds`, `pipelineMainWaitSeconds`:
+    // (dynamically updated during execution, when pipelinedRendering is active)
+    // The number of frames rendered by the render thread, the time it spent rendering them,
+    // and the time the main thread waited for it. The rendering overlapped the main thread work during
+    // (pipelineRenderSeconds - pipelineMainWaitSeconds).
+    int    pipelineNbFrames = 0;
+    double pipelineRenderSeconds = 0.;
+    double pipelineMainWaitSeconds = 0.;
 };
 
 
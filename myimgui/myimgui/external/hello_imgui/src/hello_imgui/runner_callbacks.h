@@ -191,6 +191,9 @@ struct RunnerCallbacks
     // If LoadAdditionalFonts==LoadDefaultFont_WithFontAwesomeIcons, this parameter control
     // which icon font will be loaded by default.
     DefaultIconFont defaultIconFont = DefaultIconFont::FontAwesome4;
+    // If true, the icons of the default icon font are rasterized when first displayed
+    // (see FontLoadingParams.rasterizeOnDemand)
+    bool defaultIconFontRasterizeOnDemand = false;
 
     // `SetupImGuiConfig`: default=_ImGuiDefaultSettings::SetupDefaultImGuiConfig*.
     //  If needed, change ImGui config via SetupImGuiConfig
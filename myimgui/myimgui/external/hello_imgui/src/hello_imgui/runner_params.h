@@ -7,6 +7,7 @@
 #include "hello_imgui/remote_params.h"
 #include "hello_imgui/renderer_backend_options.h"
 #include "hello_imgui/dpi_aware.h"
+#include <cstddef>
 #include <vector>
 
 namespace HelloImGui
@@ -39,6 +40,7 @@ enum class RendererBackendType
     Vulkan,
     DirectX11,
     DirectX12,
+    Software,   // CPU rasterizer, for headless screenshots (use it with PlatformBackendType::Null)
     Null
 };
 
@@ -133,6 +135,57 @@ struct FpsIdling
     // `rememberEnableIdling`: _bool, default=true_.
     //  If true, the last value of enableIdling is restored from the settings at startup.
     bool  rememberEnableIdling = false;
+
+    // `eventDrivenIdling`: _bool, default=false_.
+    //  If true, an idling application does not refresh at fpsIdle: it waits (without timeout)
+    //  until an event arrives, or until a redraw requested by HelloImGui::RequestRedraw()
+    //  or HelloImGui::RequestRedrawIn() is due. Animated widgets and background jobs shall request
+    //  their redraws. While a text input is active (blinking cursor), fpsIdle is used instead.
+    bool  eventDrivenIdling = false;
+
+    // `skipIdenticalFrames`: _bool, default=false_.
+    //  If true, the draw data is hashed after ImGui::Render(): when it is identical to the last
+    //  presented frame, the rendering and the swap are skipped (the gui code still runs).
+    //  Only for the OpenGL3, Vulkan, DirectX11 and Software renderers, and not with
+    //  a CustomBackground callback, multiple viewports, or ImDrawList user callbacks.
+    //  Do not use it if your app updates the content of its textures in place.
+    bool  skipIdenticalFrames = false;
+
+    // `nbRenderedFrames`, `nbSkippedFrames`: int (dynamically updated during execution)
+    //  Number of frames which were rendered, or skipped since they were identical to the previous one.
+    int   nbRenderedFrames = 0;
+    int   nbSkippedFrames = 0;
+};
+// @@md
+
+
+// --------------------------------------------------------------------------------------------------------------------
+
+// @@md#ImageFromAssetParams
+
+// ImageFromAssetParams: how the images displayed by HelloImGui::ImageFromAsset & co are loaded and cached
+struct ImageFromAssetParams
+{
+    // `asyncDecode`: _bool, default=false_.
+    //  If true, ImageFromAsset and ImageButtonFromAsset decode the images on a worker thread,
+    //  and display a placeholder until their texture is created (at the start of a next frame).
+    //  ImTextureIdFromAsset, ImageSizeFromAsset and ImageAndSizeFromAsset still wait for the image.
+    //  Ignored under emscripten without pthreads (the images are then decoded synchronously).
+    bool   asyncDecode = false;
+
+    // `cacheBudgetBytes`: _size_t, default=0 (unlimited)_.
+    //  Memory budget of the cached textures (width * height * 4 bytes per image). When it is exceeded,
+    //  the least recently displayed images are evicted (but not the ones displayed during the last frame),
+    //  and they are decoded again if displayed again. With a budget, a texture id returned by
+    //  ImTextureIdFromAsset stays valid as long as it is requested at each frame.
+    size_t cacheBudgetBytes = 0;
+
+    // `cacheUsedBytes`, `nbCachedImages`, `nbPendingDecodes`, `nbEvictedImages`:
+    //  (dynamically updated during execution)
+    size_t cacheUsedBytes = 0;
+    int    nbCachedImages = 0;
+    int    nbPendingDecodes = 0;
+    int    nbEvictedImages = 0;
 };
 // @@md
 
@@ -224,6 +277,24 @@ struct RunnerParams
     // `iniFilename_useAppWindowTitle`: _bool, default = true_.
     // Shall the iniFilename be derived from appWindowParams.windowTitle (if not empty)
     bool iniFilename_useAppWindowTitle = true;
+    // `useFontAtlasCache`: _bool, default = false_.
+    // If true, the built font atlas (texture and glyphs) is saved into a binary file
+    // next to the ini file ("[ini file name]_fonts.cache"), and restored at the next
+    // startup (or DPI change) instead of rasterizing the fonts again, provided that
+    // the font files, sizes, glyph ranges and configs did not change.
+    bool useFontAtlasCache = false;
+    // `useParallelFontAtlasBuild`: _bool, default = true_.
+    // If true, the glyphs of the font atlas are rasterized on all the CPU cores
+    // (the atlas is identical to the one of a serial build). The build duration
+    // is shown in the Metrics window (Fonts section).
+    bool useParallelFontAtlasBuild = true;
+    // `useBinarySettingsStore`: _bool, default = false_.
+    // If true, the settings (layouts, windows, docking, tables, user prefs...) are stored
+    // in a binary file next to the ini file ("[ini file name]_settings.store") instead of the ini file:
+    // only the modified ini sections are appended to it (the file is compacted when it grows too much),
+    // so that the layout is also saved a few seconds after each change (when ImGui marks its settings
+    // as modified), and not only at exit. At the first run, the settings are imported from the ini file.
+    bool useBinarySettingsStore = false;
 
 
     // --------------- Exit -------------------
@@ -245,6 +316,10 @@ struct RunnerParams
     // If it fails, look at DpiAwareParams (and the corresponding Ini file settings)
     DpiAwareParams dpiAwareParams;
 
+    // --------------- Images from assets -----------
+    // `imageFromAssetParams`: _see ImageFromAssetParams_ (asynchronous decoding, cache budget)
+    ImageFromAssetParams imageFromAssetParams;
+
     // --------------- Misc -------------------
 
     // `useImGuiTestEngine`: _bool, default=false_.
@@ -276,10 +351,10 @@ struct RunnerParams
 // IniSettingsLocation returns the path to the ini file for the application settings.
 std::string IniSettingsLocation(const RunnerParams& runnerParams);
 
-// HasIniSettings returns true if the ini file for the application settings exists.
+// HasIniSettings returns true if the ini file (or the binary settings store) for the application settings exists.
 bool HasIniSettings(const RunnerParams& runnerParams);
 
-// DeleteIniSettings deletes the ini file for the application settings.
+// DeleteIniSettings deletes the ini file (and the binary settings store) for the application settings.
 void DeleteIniSettings(const RunnerParams& runnerParams);
 
 // @@md
@@ -57,6 +57,10 @@
 //---- Pack colors to BGRA8 instead of RGBA8 (to avoid converting from one to another)
 //#define IMGUI_USE_BGRA_PACKED_COLOR
 
+//---- Use a hash index in ImGuiStorage (tree nodes open state, windows/dock nodes maps...) instead of a sorted array.
+// O(1) queries and insertions instead of O(log N) queries and O(N) insertions. ImGuiStorage::Data is then in insertion order.
+//#define IMGUI_USE_HASHED_STORAGE
+
 //---- Use 32-bit for ImWchar (default is 16-bit) to support Unicode planes 1-16. (e.g. point beyond 0xFFFF like emoticons, dingbats, symbols, shapes, ancient languages, etc...)
 //#define IMGUI_USE_WCHAR32
 
@@ -2068,51 +2068,155 @@ static const ImU32 GCrc32LookupTable[256] =
     0xBDBDF21C,0xCABAC28A,0x53B39330,0x24B4A3A6,0xBAD03605,0xCDD70693,0x54DE5729,0x23D967BF,0xB3667A2E,0xC4614AB8,0x5D681B02,0x2A6F2B94,0xB40BBE37,0xC30C8EA1,0x5A05DF1B,0x2D02EF8D,
 };
 
-// Known size hash
-// It is ok to call ImHashData on a string with known length but the ### operator won't be supported.
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
-ImGuiID ImHashData(const void* data_p, size_t data_size, ImGuiID seed)
+// CRC32 update functions (crc is the non-inverted state): ImHashData() and ImHashStr() are computed by one of them.
+// - Bytewise: the reference implementation, one byte at a time with GCrc32LookupTable.
+// - SlicingBy8: 8 bytes at a time with 8 lookup tables (8KB, built once). Little-endian CPUs only.
+// - HardwareCrc32: ARMv8 CRC32 instructions, when enabled at compile time (e.g. always on Apple arm64, or with -march=armv8-a+crc).
+// All of them use the zlib polynomial, and give the same hashes. x86's SSE4.2 crc32 instruction is not used: it computes
+// CRC-32C (Castagnoli polynomial), which would change every ID (and the IDs persisted in .ini files).
+// The fastest available backend is selected at the first hash, i.e. from ImGui::CreateContext() in practice.
+typedef ImU32 (*ImCrc32UpdateFunc)(ImU32 crc, const unsigned char* data, size_t data_size);
+
+static ImU32 ImCrc32UpdateBytewise(ImU32 crc, const unsigned char* data, size_t data_size)
 {
-    ImU32 crc = ~seed;
-    const unsigned char* data = (const unsigned char*)data_p;
     const ImU32* crc32_lut = GCrc32LookupTable;
     while (data_size-- != 0)
         crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ *data++];
-    return ~crc;
+    return crc;
+}
+
+struct ImCrc32SlicingTables
+{
+    ImU32 Tables[8][256];
+    ImCrc32SlicingTables()
+    {
+        for (int i = 0; i < 256; i++)
+            Tables[0][i] = GCrc32LookupTable[i];
+        for (int k = 1; k < 8; k++)
+            for (int i = 0; i < 256; i++)
+                Tables[k][i] = (Tables[k - 1][i] >> 8) ^ GCrc32LookupTable[Tables[k - 1][i] & 0xFF];
+    }
+};
+
+static const ImCrc32SlicingTables& ImCrc32GetSlicingTables()
+{
+    static const ImCrc32SlicingTables tables; // Thread-safe initialization
+    return tables;
+}
+
+static ImU32 ImCrc32UpdateSlicingBy8(ImU32 crc, const unsigned char* data, size_t data_size)
+{
+    const ImU32 (*t)[256] = ImCrc32GetSlicingTables().Tables;
+    while (data_size >= 8)
+    {
+        ImU32 lo, hi;
+        memcpy(&lo, data, 4);
+        memcpy(&hi, data + 4, 4);
+        lo ^= crc;
+        crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24]
+            ^ t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+        data += 8;
+        data_size -= 8;
+    }
+    return ImCrc32UpdateBytewise(crc, data, data_size);
+}
+
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+static ImU32 ImCrc32UpdateHardware(ImU32 crc, const unsigned char* data, size_t data_size)
+{
+    while (data_size >= 8)
+    {
+        uint64_t v;
+        memcpy(&v, data, 8);
+        crc = __crc32d(crc, v);
+        data += 8;
+        data_size -= 8;
+    }
+    while (data_size-- != 0)
+        crc = __crc32b(crc, *data++);
+    return crc;
+}
+#endif
+
+static ImU32 ImCrc32UpdateSelect(ImU32 crc, const unsigned char* data, size_t data_size);
+static ImCrc32UpdateFunc GImCrc32Update = ImCrc32UpdateSelect;
+static ImHashBackend GImHashBackend = -1;
+
+static bool ImCrc32IsLittleEndian()
+{
+    const ImU32 one = 1;
+    unsigned char first_byte;
+    memcpy(&first_byte, &one, 1);
+    return first_byte == 1;
+}
+
+static ImU32 ImCrc32UpdateSelect(ImU32 crc, const unsigned char* data, size_t data_size)
+{
+    if (!ImHashSetBackend(ImHashBackend_HardwareCrc32) && !ImHashSetBackend(ImHashBackend_SlicingBy8))
+        ImHashSetBackend(ImHashBackend_Bytewise);
+    return GImCrc32Update(crc, data, data_size);
+}
+
+bool ImHashSetBackend(ImHashBackend backend)
+{
+    ImCrc32UpdateFunc func = NULL;
+    switch (backend)
+    {
+    case ImHashBackend_Bytewise: func = ImCrc32UpdateBytewise; break;
+    case ImHashBackend_SlicingBy8: func = ImCrc32IsLittleEndian() ? ImCrc32UpdateSlicingBy8 : NULL; break;
+#if defined(__ARM_FEATURE_CRC32)
+    case ImHashBackend_HardwareCrc32: func = ImCrc32UpdateHardware; break;
+#endif
+    default: break;
+    }
+    if (func == NULL)
+        return false;
+    GImCrc32Update = func;
+    GImHashBackend = backend;
+    return true;
+}
+
+ImHashBackend ImHashGetBackend()
+{
+    if (GImHashBackend < 0)
+        ImHashData("", 0); // Selects the backend
+    return GImHashBackend;
+}
+
+const char* ImHashGetBackendName(ImHashBackend backend)
+{
+    switch (backend)
+    {
+    case ImHashBackend_Bytewise: return "Bytewise";
+    case ImHashBackend_SlicingBy8: return "SlicingBy8";
+    case ImHashBackend_HardwareCrc32: return "HardwareCrc32";
+    default: return "Unknown";
+    }
+}
+
+// Known size hash
+// It is ok to call ImHashData on a string with known length but the ### operator won't be supported.
+ImGuiID ImHashData(const void* data_p, size_t data_size, ImGuiID seed)
+{
+    return ~GImCrc32Update(~seed, (const unsigned char*)data_p, data_size);
 }
 
 // Zero-terminated string hash, with support for ### to reset back to seed value
 // We support a syntax of "label###id" where only "###id" is included in the hash, and only "label" gets displayed.
 // Because this syntax is rarely used we are optimizing for the common case.
 // - If we reach ### in the string we discard the hash so far and reset to the seed.
-// - We don't do 'current += 2; continue;' after handling ### to keep the code smaller/faster (measured ~10% diff in Debug build)
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
+// Since the hash restarts at the last ###, we look for it first: the remaining bytes are then hashed in one go.
 ImGuiID ImHashStr(const char* data_p, size_t data_size, ImGuiID seed)
 {
-    seed = ~seed;
-    ImU32 crc = seed;
-    const unsigned char* data = (const unsigned char*)data_p;
-    const ImU32* crc32_lut = GCrc32LookupTable;
-    if (data_size != 0)
-    {
-        while (data_size-- != 0)
-        {
-            unsigned char c = *data++;
-            if (c == '#' && data_size >= 2 && data[0] == '#' && data[1] == '#')
-                crc = seed;
-            crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ c];
-        }
-    }
-    else
-    {
-        while (unsigned char c = *data++)
-        {
-            if (c == '#' && data[0] == '#' && data[1] == '#')
-                crc = seed;
-            crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ c];
-        }
-    }
-    return ~crc;
+    if (data_size == 0)
+        data_size = strlen(data_p);
+    const char* data_end = data_p + data_size;
+    const char* hash_begin = data_p;
+    for (const char* p = data_p; (p = (const char*)memchr(p, '#', (size_t)(data_end - p))) != NULL; p++)
+        if (data_end - p >= 3 && p[1] == '#' && p[2] == '#')
+            hash_begin = p;
+    return ~GImCrc32Update(~seed, (const unsigned char*)hash_begin, (size_t)(data_end - hash_begin));
 }
 
 //-----------------------------------------------------------------------------
@@ -2476,6 +2580,8 @@ void ImGui::ColorConvertHSVtoRGB(float h, float s, float v, float& out_r, float&
 // Helper: Key->value storage
 //-----------------------------------------------------------------------------
 
+#ifndef IMGUI_USE_HASHED_STORAGE
+
 // std::lower_bound but without the bullshit
 static ImGuiStorage::ImGuiStoragePair* LowerBound(ImVector<ImGuiStorage::ImGuiStoragePair>& data, ImGuiID key)
 {
@@ -2499,7 +2605,97 @@ static ImGuiStorage::ImGuiStoragePair* LowerBound(ImVector<ImGuiStorage::ImGuiSt
     return first;
 }
 
+static ImGuiStorage::ImGuiStoragePair* StorageFind(const ImGuiStorage* storage, ImGuiID key)
+{
+    ImVector<ImGuiStorage::ImGuiStoragePair>& data = const_cast<ImVector<ImGuiStorage::ImGuiStoragePair>&>(storage->Data);
+    ImGuiStorage::ImGuiStoragePair* it = LowerBound(data, key);
+    if (it == data.end() || it->key != key)
+        return NULL;
+    return it;
+}
+
+// Returns the pair for new_pair.key, inserting new_pair if missing
+static ImGuiStorage::ImGuiStoragePair* StorageFindOrInsert(ImGuiStorage* storage, const ImGuiStorage::ImGuiStoragePair& new_pair)
+{
+    ImGuiStorage::ImGuiStoragePair* it = LowerBound(storage->Data, new_pair.key);
+    if (it == storage->Data.end() || it->key != new_pair.key)
+        it = storage->Data.insert(it, new_pair);
+    return it;
+}
+
+#else // #ifndef IMGUI_USE_HASHED_STORAGE
+
+// Open addressing with linear probing. The keys are mostly CRC32 hashes already, but ids made of small integers are mixed too.
+static inline int StorageHashSlot(ImGuiID key, int mask)
+{
+    ImU32 h = key;
+    h ^= h >> 16;
+    h *= 0x7FEB352D;
+    h ^= h >> 15;
+    return (int)(h & (ImU32)mask);
+}
+
+static void StorageIndexPair(ImGuiStorage* storage, int pair_idx)
+{
+    const int mask = storage->HashIndex.Size - 1;
+    int slot = StorageHashSlot(storage->Data[pair_idx].key, mask);
+    while (storage->HashIndex[slot] != -1)
+        slot = (slot + 1) & mask;
+    storage->HashIndex[slot] = pair_idx;
+}
+
+static void StorageRebuildHashIndex(ImGuiStorage* storage, int pairs_count)
+{
+    int capacity = 16;
+    while (capacity < pairs_count * 2)
+        capacity *= 2;
+    storage->HashIndex.resize(capacity);
+    memset(storage->HashIndex.Data, 0xFF, (size_t)capacity * sizeof(int)); // -1
+    for (int n = 0; n < storage->Data.Size; n++)
+        StorageIndexPair(storage, n);
+    storage->HashIndexCount = storage->Data.Size;
+}
+
+static ImGuiStorage::ImGuiStoragePair* StorageFind(const ImGuiStorage* storage_c, ImGuiID key)
+{
+    ImGuiStorage* storage = const_cast<ImGuiStorage*>(storage_c);
+    if (storage->HashIndexCount != storage->Data.Size)
+        StorageRebuildHashIndex(storage, storage->Data.Size);
+    if (storage->Data.Size == 0)
+        return NULL;
+    const int mask = storage->HashIndex.Size - 1;
+    for (int slot = StorageHashSlot(key, mask); ; slot = (slot + 1) & mask)
+    {
+        const int pair_idx = storage->HashIndex[slot];
+        if (pair_idx == -1)
+            return NULL;
+        if (storage->Data[pair_idx].key == key)
+            return &storage->Data[pair_idx];
+    }
+}
+
+// Returns the pair for new_pair.key, appending new_pair to Data if missing
+static ImGuiStorage::ImGuiStoragePair* StorageFindOrInsert(ImGuiStorage* storage, const ImGuiStorage::ImGuiStoragePair& new_pair)
+{
+    if (ImGuiStorage::ImGuiStoragePair* it = StorageFind(storage, new_pair.key))
+        return it;
+    storage->Data.push_back(new_pair);
+    if (storage->Data.Size * 2 > storage->HashIndex.Size)
+    {
+        StorageRebuildHashIndex(storage, storage->Data.Size);
+    }
+    else
+    {
+        StorageIndexPair(storage, storage->Data.Size - 1);
+        storage->HashIndexCount++;
+    }
+    return &storage->Data.back();
+}
+
+#endif // #ifndef IMGUI_USE_HASHED_STORAGE
+
 // For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
+// (with IMGUI_USE_HASHED_STORAGE, this is also how to iterate Data by key order)
 void ImGuiStorage::BuildSortByKey()
 {
     struct StaticFunc
@@ -2513,14 +2709,15 @@ void ImGuiStorage::BuildSortByKey()
         }
     };
     ImQsort(Data.Data, (size_t)Data.Size, sizeof(ImGuiStoragePair), StaticFunc::PairComparerByID);
+#ifdef IMGUI_USE_HASHED_STORAGE
+    StorageRebuildHashIndex(this, Data.Size);
+#endif
 }
 
 int ImGuiStorage::GetInt(ImGuiID key, int default_val) const
 {
-    ImGuiStoragePair* it = LowerBound(const_cast<ImVector<ImGuiStoragePair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return default_val;
-    return it->val_i;
+    ImGuiStoragePair* it = StorageFind(this, key);
+    return it ? it->val_i : default_val;
 }
 
 bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
@@ -2530,27 +2727,20 @@ bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
 
 float ImGuiStorage::GetFloat(ImGuiID key, float default_val) const
 {
-    ImGuiStoragePair* it = LowerBound(const_cast<ImVector<ImGuiStoragePair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return default_val;
-    return it->val_f;
+    ImGuiStoragePair* it = StorageFind(this, key);
+    return it ? it->val_f : default_val;
 }
 
 void* ImGuiStorage::GetVoidPtr(ImGuiID key) const
 {
-    ImGuiStoragePair* it = LowerBound(const_cast<ImVector<ImGuiStoragePair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return NULL;
-    return it->val_p;
+    ImGuiStoragePair* it = StorageFind(this, key);
+    return it ? it->val_p : NULL;
 }
 
 // References are only valid until a new value is added to the storage. Calling a Set***() function or a Get***Ref() function invalidates the pointer.
 int* ImGuiStorage::GetIntRef(ImGuiID key, int default_val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_i;
+    return &StorageFindOrInsert(this, ImGuiStoragePair(key, default_val))->val_i;
 }
 
 bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
@@ -2560,28 +2750,17 @@ bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
 
 float* ImGuiStorage::GetFloatRef(ImGuiID key, float default_val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_f;
+    return &StorageFindOrInsert(this, ImGuiStoragePair(key, default_val))->val_f;
 }
 
 void** ImGuiStorage::GetVoidPtrRef(ImGuiID key, void* default_val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_p;
+    return &StorageFindOrInsert(this, ImGuiStoragePair(key, default_val))->val_p;
 }
 
-// FIXME-OPT: Need a way to reuse the result of lower_bound when doing GetInt()/SetInt() - not too bad because it only happens on explicit interaction (maximum one a frame)
 void ImGuiStorage::SetInt(ImGuiID key, int val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        Data.insert(it, ImGuiStoragePair(key, val));
-    else
-        it->val_i = val;
+    StorageFindOrInsert(this, ImGuiStoragePair(key, val))->val_i = val;
 }
 
 void ImGuiStorage::SetBool(ImGuiID key, bool val)
@@ -2591,20 +2770,12 @@ void ImGuiStorage::SetBool(ImGuiID key, bool val)
 
 void ImGuiStorage::SetFloat(ImGuiID key, float val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        Data.insert(it, ImGuiStoragePair(key, val));
-    else
-        it->val_f = val;
+    StorageFindOrInsert(this, ImGuiStoragePair(key, val))->val_f = val;
 }
 
 void ImGuiStorage::SetVoidPtr(ImGuiID key, void* val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        Data.insert(it, ImGuiStoragePair(key, val));
-    else
-        it->val_p = val;
+    StorageFindOrInsert(this, ImGuiStoragePair(key, val))->val_p = val;
 }
 
 void ImGuiStorage::SetAllInt(int v)
@@ -19402,6 +19573,9 @@ static void ImGui::DockSettingsHandler_WriteAll(ImGuiContext* ctx, ImGuiSettings
     // (unlike our windows settings, because nodes are always built we can do a full rewrite of the SettingsNode buffer)
     dc->NodesSettings.resize(0);
     dc->NodesSettings.reserve(dc->Nodes.Data.Size);
+#ifdef IMGUI_USE_HASHED_STORAGE
+    dc->Nodes.BuildSortByKey(); // Same order as the sorted storage, for the same .ini output
+#endif
     for (int n = 0; n < dc->Nodes.Data.Size; n++)
         if (ImGuiDockNode* node = (ImGuiDockNode*)dc->Nodes.Data[n].val_p)
             if (node->IsRootNode())
@@ -19869,6 +20043,8 @@ void ImGui::ShowFontAtlas(ImFontAtlas* atlas)
         DebugNodeFont(font);
         PopID();
     }
+    if (atlas->BuildTime > 0.0f)
+        Text("Build time: %.1f ms (%s rasterization)", atlas->BuildTime * 1000.0f, atlas->BuildParallelForFn ? "parallel" : "serial");
     if (TreeNode("Font Atlas", "Font Atlas (%dx%d pixels)", atlas->TexWidth, atlas->TexHeight))
     {
         ImGuiContext& g = *GImGui;
@@ -19879,6 +20055,23 @@ void ImGui::ShowFontAtlas(ImFontAtlas* atlas)
         Image(atlas->TexID, ImVec2((float)atlas->TexWidth, (float)atlas->TexHeight), ImVec2(0.0f, 0.0f), ImVec2(1.0f, 1.0f), tint_col, border_col);
         TreePop();
     }
+
+    if (TreeNode("Text Size Cache", "Text Size Cache (%s)", atlas->TextSizeCacheCapacity > 0 ? "enabled" : "disabled"))
+    {
+        SetNextItemWidth(GetFontSize() * 8);
+        if (InputInt("Capacity", &atlas->TextSizeCacheCapacity, 1024, 4096))
+            atlas->TextSizeCacheCapacity = ImClamp(atlas->TextSizeCacheCapacity, 0, 1 << 20);
+        if (const ImFontTextSizeCache* cache = atlas->TextSizeCache)
+        {
+            const ImU64 lookups = cache->Hits + cache->Misses;
+            Text("Entries: %d (%d bytes)", cache->Entries.Size, cache->Entries.size_in_bytes());
+            Text("Hits: %" IM_PRIu64 ", Misses: %" IM_PRIu64 ", Hit rate: %.1f%%", cache->Hits, cache->Misses, lookups > 0 ? 100.0 * (double)cache->Hits / (double)lookups : 0.0);
+            Text("Clears: %d", cache->Clears);
+            if (SmallButton("Clear"))
+                ImFontAtlasClearTextSizeCache(atlas);
+        }
+        TreePop();
+    }
 }
 
 void ImGui::ShowMetricsWindow(bool* p_open)
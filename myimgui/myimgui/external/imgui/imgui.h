@@ -149,6 +149,7 @@ struct ImDrawData;                  // All draw command lists required to render
 struct ImDrawList;                  // A single draw command list (generally one per window, conceptually you may see this as a dynamic "mesh" builder)
 struct ImDrawListSharedData;        // Data shared among multiple draw lists (typically owned by parent ImGui context, but you may create one yourself)
 struct ImDrawListSplitter;          // Helper to split a draw list into different layers which can be drawn into out of order, then flattened back.
+struct ImDrawTextRun;               // A single-line span of text with its position and color, for ImDrawList::AddTextRuns()
 struct ImDrawVert;                  // A single vertex (pos + uv + col = 20 bytes by default. Override layout with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
 struct ImFont;                      // Runtime data for a single font within a parent ImFontAtlas
 struct ImFontAtlas;                 // Runtime data for multiple fonts, bake multiple fonts into a single texture, TTF/OTF font loader
@@ -2540,11 +2541,21 @@ struct ImGuiStorage
     };
 
     ImVector<ImGuiStoragePair>      Data;
+#ifdef IMGUI_USE_HASHED_STORAGE
+    ImVector<int>                   HashIndex;          // [Internal] Open addressing table of indices into Data (-1: empty slot). Power of 2 size, at most half full.
+    int                             HashIndexCount = 0; // [Internal] Number of pairs of Data referenced by HashIndex: it is rebuilt if Data was modified directly.
+#endif
 
     // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N)
     // - Set***() functions find pair, insertion on demand if missing.
     // - Sorted insertion is costly, paid once. A typical frame shouldn't need to insert any new pair.
+    // - With IMGUI_USE_HASHED_STORAGE, pairs are found with a hash index instead (O(1) queries and insertions),
+    //   and Data is in insertion order, until BuildSortByKey() sorts it.
+#ifdef IMGUI_USE_HASHED_STORAGE
+    void                Clear() { Data.clear(); HashIndex.clear(); HashIndexCount = 0; }
+#else
     void                Clear() { Data.clear(); }
+#endif
     IMGUI_API int       GetInt(ImGuiID key, int default_val = 0) const;
     IMGUI_API void      SetInt(ImGuiID key, int val);
     IMGUI_API bool      GetBool(ImGuiID key, bool default_val = false) const;
@@ -2820,6 +2831,16 @@ enum ImDrawListFlags_
     ImDrawListFlags_AllowVtxOffset          = 1 << 3,  // Can emit 'VtxOffset > 0' to allow large meshes. Set when 'ImGuiBackendFlags_RendererHasVtxOffset' is enabled.
 };
 
+// A single-line span of text, for ImDrawList::AddTextRuns()
+// (text_end is required; '\n' and '\r' are skipped, they do not start a new line)
+struct ImDrawTextRun
+{
+    ImVec2          Pos;
+    ImU32           Col;
+    const char*     TextBegin;
+    const char*     TextEnd;
+};
+
 // Draw command list
 // This is the low-level list of polygons that ImGui:: functions are filling. At the end of the frame,
 // all command lists are passed to your ImGuiIO::RenderDrawListFn function for rendering.
@@ -2885,6 +2906,7 @@ struct ImDrawList
     IMGUI_API void  AddEllipseFilled(const ImVec2& center, const ImVec2& radius, ImU32 col, float rot = 0.0f, int num_segments = 0);
     IMGUI_API void  AddText(const ImVec2& pos, ImU32 col, const char* text_begin, const char* text_end = NULL);
     IMGUI_API void  AddText(const ImFont* font, float font_size, const ImVec2& pos, ImU32 col, const char* text_begin, const char* text_end = NULL, float wrap_width = 0.0f, const ImVec4* cpu_fine_clip_rect = NULL);
+    IMGUI_API void  AddTextRuns(const ImFont* font, float font_size, const ImDrawTextRun* runs, int runs_count); // Many single-line runs sharing one font and the current clip rect, batched in vertex reservations of at most 8192 characters (a longer run is split). Faster than one AddText() per run.
     IMGUI_API void  AddBezierCubic(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, ImU32 col, float thickness, int num_segments = 0); // Cubic Bezier (4 control points)
     IMGUI_API void  AddBezierQuadratic(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, ImU32 col, float thickness, int num_segments = 0);               // Quadratic Bezier (3 control points)
 
@@ -3013,6 +3035,7 @@ struct ImFontConfig
     float           RasterizerMultiply;     // 1.0f     // Linearly brighten (>1.0f) or darken (<1.0f) font output. Brightening small fonts may be a good workaround to make them more readable. This is a silly thing we may remove in the future.
     float           RasterizerDensity;      // 1.0f     // DPI scale for rasterization, not altering other font metrics: make it easy to swap between e.g. a 100% and a 400% fonts for a zooming display. IMPORTANT: If you increase this it is expected that you increase font scale accordingly, otherwise quality may look lowered.
     ImWchar         EllipsisChar;           // -1       // Explicitly specify unicode codepoint of ellipsis character. When fonts are being merged first specified ellipsis will be used.
+    bool            RasterizeOnDemand;      // false    // Opt-in: rasterize the glyphs the first time they are looked up, into the dynamic glyphs area of the atlas (see ImFontAtlas::DynamicGlyphsCapacity), instead of during Build(). For large ranges of which few glyphs are displayed (icons, CJK). stb_truetype builder only (ignored by FreeType).
 
     // [Internal]
     char            Name[40];               // Name (strictly to ease debugging)
@@ -3027,7 +3050,8 @@ struct ImFontGlyph
 {
     unsigned int    Colored : 1;        // Flag to indicate glyph is colored and should generally ignore tinting (make it usable with no shift on little-endian as this is used in loops)
     unsigned int    Visible : 1;        // Flag to indicate glyph has no visible pixels (e.g. space). Allow early out when rendering.
-    unsigned int    Codepoint : 30;     // 0x0000..0x10FFFF
+    unsigned int    Dynamic : 1;        // Flag to indicate glyph is rasterized on demand (ImFontConfig::RasterizeOnDemand): its UVs are only valid in the glyph returned by ImFont::FindGlyph().
+    unsigned int    Codepoint : 29;     // 0x0000..0x10FFFF
     float           AdvanceX;           // Distance to next character (= data from font + ImFontConfig::GlyphExtraSpacing.x baked in)
     float           X0, Y0, X1, Y1;     // Glyph corners
     float           U0, V0, U1, V1;     // Texture coordinates
@@ -3114,6 +3138,11 @@ struct ImFontAtlas
     bool                        IsBuilt() const             { return Fonts.Size > 0 && TexReady; } // Bit ambiguous: used to detect when user didn't build texture but effectively we should check TexID != 0 except that would be backend dependent...
     void                        SetTexID(ImTextureID id)    { TexID = id; }
 
+    // Glyphs rasterized on demand (see ImFontConfig::RasterizeOnDemand) modify the pixels after Build().
+    // Before rendering, the backend shall update this rectangle of its texture (or recreate the whole texture), then clear it.
+    IMGUI_API bool              GetTexDirtyRect(int* out_x, int* out_y, int* out_w, int* out_h) const; // Returns false if the texture is up to date
+    IMGUI_API void              ClearTexDirtyRect();
+
     //-------------------------------------------
     // Glyph Ranges
     //-------------------------------------------
@@ -3161,9 +3190,16 @@ struct ImFontAtlas
     int                         TexGlyphPadding;    // Padding between glyphs within texture in pixels. Defaults to 1. If your rendering method doesn't rely on bilinear filtering you may set this to 0 (will also need to set AntiAliasedLinesUseTex = false).
     bool                        Locked;             // Marked as Locked by ImGui::NewFrame() so attempt to modify the atlas will assert.
     void*                       UserData;           // Store your own atlas related user-data (if e.g. you have multiple font atlas).
+    int                         TextSizeCacheCapacity; // Opt-in: number of ImFont::CalcTextSizeA() results cached for the fonts of this atlas (0: disabled, the default). Rounded up to a power of two, 40 bytes per entry.
+    int                         DynamicGlyphsCapacity; // Number of cells reserved in the texture for the glyphs rasterized on demand (ImFontConfig::RasterizeOnDemand). Defaults to 256. When they are all used, the least recently used glyph is evicted.
+    void                        (*BuildParallelForFn)(void* user_data, int jobs_count, void (*job_func)(void* job_data, int job_index), void* job_data); // Opt-in: runs the glyphs rasterization jobs of Build() in parallel (slices of glyphs with stb_truetype, one job per source font with FreeType). Must call job_func(job_data, i) for every i in [0, jobs_count), from any threads, and return once they are all done. The texture is identical to the one of a serial build. The memory allocators (see SetAllocatorFunctions()) must be thread-safe.
+    void*                       BuildParallelForUserData; // User data passed to BuildParallelForFn.
+    float                       BuildTime;          // Duration of the last Build() in seconds, when measured by the application (displayed by Metrics/Debugger > Fonts).
 
     // [Internal]
     // NB: Access texture data via GetTexData*() calls! Which will setup a default font for you.
+    struct ImFontTextSizeCache* TextSizeCache;      // Created on demand, when TextSizeCacheCapacity > 0. See imgui_internal.h
+    struct ImFontDynamicGlyphs* DynamicGlyphs;      // Created by Build() when a font is rasterized on demand. See imgui_internal.h
     bool                        TexReady;           // Set when texture was built matching current font input
     bool                        TexPixelsUseColors; // Tell whether our texture data is known to use colors (rather than just alpha channel), in order to help backend select a format.
     unsigned char*              TexPixelsAlpha8;    // 1 component per pixel, each component is unsigned 8-bit. Total size = TexWidth * TexHeight
@@ -3218,6 +3254,7 @@ struct ImFont
     float                       Ascent, Descent;    // 4+4   // out //            // Ascent: distance from top to bottom of e.g. 'A' [0..FontSize]
     int                         MetricsTotalSurface;// 4     // out //            // Total surface in pixels to get an idea of the font rasterization/texture cost (not exact, we approximate the cost of padding between glyphs)
     ImU8                        Used4kPagesMap[(IM_UNICODE_CODEPOINT_MAX+1)/4096/8]; // 2 bytes if ImWchar=ImWchar16, 34 bytes if ImWchar==ImWchar32. Store 1-bit for each block of 4K codepoints that has one active glyph. This is mainly used to facilitate iterations across all used codepoints.
+    ImVector<int>               DynamicGlyphCells;  // 12-16 // out //            // Per glyph index, for the Dynamic glyphs: cell of ContainerAtlas->DynamicGlyphs which holds its pixels (>= 0), or -2 - source config index while not rasterized.
 
     // Methods
     IMGUI_API ImFont();
@@ -3234,6 +3271,7 @@ struct ImFont
     IMGUI_API const char*       CalcWordWrapPositionA(float scale, const char* text, const char* text_end, float wrap_width) const;
     IMGUI_API void              RenderChar(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, ImWchar c) const;
     IMGUI_API void              RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width = 0.0f, bool cpu_fine_clip = false) const;
+    IMGUI_API void              RenderTextRuns(ImDrawList* draw_list, float size, const ImVec4& clip_rect, const ImDrawTextRun* runs, int runs_count) const;
 
     // [Internal] Don't use!
     IMGUI_API void              BuildLookupTable();
@@ -129,8 +129,10 @@ namespace IMGUI_STB_NAMESPACE
 #ifdef  IMGUI_ENABLE_STB_TRUETYPE
 #ifndef STB_TRUETYPE_IMPLEMENTATION                         // in case the user already have an implementation in the _same_ compilation unit (e.g. unity builds)
 #ifndef IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION           // in case the user already have an implementation in another compilation unit
-#define STBTT_malloc(x,u)   ((void)(u), IM_ALLOC(x))
-#define STBTT_free(x,u)     ((void)(u), IM_FREE(x))
+static inline void*     ImFontAtlasBuildJobAlloc(size_t size, void* allocator);
+static inline void      ImFontAtlasBuildJobFree(void* ptr, void* allocator);
+#define STBTT_malloc(x,u)   ((u) ? ImFontAtlasBuildJobAlloc(x, u) : IM_ALLOC(x))
+#define STBTT_free(x,u)     ((u) ? ImFontAtlasBuildJobFree(x, u) : IM_FREE(x))
 #define STBTT_assert(x)     do { IM_ASSERT(x); } while(0)
 #define STBTT_fmod(x,y)     ImFmod(x,y)
 #define STBTT_sqrt(x)       ImSqrt(x)
@@ -1644,6 +1646,22 @@ void ImDrawList::AddText(const ImFont* font, float font_size, const ImVec2& pos,
     font->RenderText(this, font_size, pos, col, clip_rect, text_begin, text_end, wrap_width, cpu_fine_clip_rect != NULL);
 }
 
+void ImDrawList::AddTextRuns(const ImFont* font, float font_size, const ImDrawTextRun* runs, int runs_count)
+{
+    if (runs_count <= 0)
+        return;
+
+    // Pull default font/size from the shared ImDrawListSharedData instance
+    if (font == NULL)
+        font = _Data->Font;
+    if (font_size == 0.0f)
+        font_size = _Data->FontSize;
+
+    IM_ASSERT(font->ContainerAtlas->TexID == _CmdHeader.TextureId);  // Use high-level ImGui::PushFont() or low-level ImDrawList::PushTextureId() to change font.
+
+    font->RenderTextRuns(this, font_size, _CmdHeader.ClipRect, runs, runs_count);
+}
+
 void ImDrawList::AddText(const ImVec2& pos, ImU32 col, const char* text_begin, const char* text_end)
 {
     AddText(NULL, 0.0f, pos, col, text_begin, text_end);
@@ -2384,10 +2402,13 @@ static const ImVec2 FONT_ATLAS_DEFAULT_TEX_CURSOR_DATA[ImGuiMouseCursor_COUNT][3
     { ImVec2(109,0),ImVec2(13,15), ImVec2( 6, 7) }, // ImGuiMouseCursor_NotAllowed
 };
 
+static void ImFontAtlasDestroyDynamicGlyphsSources(ImFontAtlas* atlas);
+
 ImFontAtlas::ImFontAtlas()
 {
     memset(this, 0, sizeof(*this));
     TexGlyphPadding = 1;
+    DynamicGlyphsCapacity = 256;
     PackIdMouseCursors = PackIdLines = -1;
 }
 
@@ -2395,6 +2416,8 @@ ImFontAtlas::~ImFontAtlas()
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
     Clear();
+    if (TextSizeCache)
+        IM_DELETE(TextSizeCache);
 }
 
 void    ImFontAtlas::ClearInputData()
@@ -2417,6 +2440,7 @@ void    ImFontAtlas::ClearInputData()
     ConfigData.clear();
     CustomRects.clear();
     PackIdMouseCursors = PackIdLines = -1;
+    ImFontAtlasDestroyDynamicGlyphsSources(this); // The glyphs rasterized on demand which are not rasterized yet will be hidden
     // Important: we leave TexReady untouched
 }
 
@@ -2438,6 +2462,8 @@ void    ImFontAtlas::ClearFonts()
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
     Fonts.clear_delete();
     TexReady = false;
+    ImFontAtlasClearTextSizeCache(this);
+    ImFontAtlasDestroyDynamicGlyphs(this);
 }
 
 void    ImFontAtlas::Clear()
@@ -2447,6 +2473,24 @@ void    ImFontAtlas::Clear()
     ClearFonts();
 }
 
+bool    ImFontAtlas::GetTexDirtyRect(int* out_x, int* out_y, int* out_w, int* out_h) const
+{
+    const ImFontDynamicGlyphs* dynamic_glyphs = DynamicGlyphs;
+    if (dynamic_glyphs == NULL || dynamic_glyphs->DirtyX0 >= dynamic_glyphs->DirtyX1)
+        return false;
+    *out_x = dynamic_glyphs->DirtyX0;
+    *out_y = dynamic_glyphs->DirtyY0;
+    *out_w = dynamic_glyphs->DirtyX1 - dynamic_glyphs->DirtyX0;
+    *out_h = dynamic_glyphs->DirtyY1 - dynamic_glyphs->DirtyY0;
+    return true;
+}
+
+void    ImFontAtlas::ClearTexDirtyRect()
+{
+    if (ImFontDynamicGlyphs* dynamic_glyphs = DynamicGlyphs)
+        dynamic_glyphs->DirtyX0 = dynamic_glyphs->DirtyY0 = dynamic_glyphs->DirtyX1 = dynamic_glyphs->DirtyY1 = 0;
+}
+
 void    ImFontAtlas::GetTexDataAsAlpha8(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel)
 {
     // Build atlas on demand
@@ -2698,6 +2742,7 @@ bool    ImFontAtlas::Build()
     }
 
     // Build
+    ImFontAtlasDestroyDynamicGlyphs(this);
     return builder_io->FontBuilder_Build(this);
 }
 
@@ -2734,6 +2779,43 @@ struct ImFontBuildSrcData
     int                 GlyphsCount;        // Glyph count (excluding missing glyphs and glyphs already set by an earlier source font)
     ImBitVector         GlyphsSet;          // Glyph bit map (random access, 1-bit per codepoint. This will be a maximum of 8KB)
     ImVector<int>       GlyphsList;         // Glyph codepoints list (flattened version of GlyphsSet)
+    ImVector<int>       DynamicGlyphsList;  // Glyph codepoints list, when rasterized on demand (ImFontConfig::RasterizeOnDemand). Not packed nor counted in GlyphsCount.
+};
+
+// Rasterization job of the stb_truetype builder: a slice of the glyphs of a source font (see ImFontAtlas::BuildParallelForFn).
+// The glyphs of a job are rendered into their own packed rectangles, so that the jobs can run in any order, on any thread.
+struct ImFontBuildRasterJob
+{
+    int                 SrcIndex;           // Index into atlas->ConfigData[] and src_tmp_array[]
+    int                 GlyphStart;         // First glyph, in the GlyphsList of the source
+    int                 GlyphsCount;
+};
+
+// Allocations of the rasterization jobs, when they run in parallel: stb_truetype allocates through the userdata of the font info.
+// They call the allocator functions directly, since ImGui::MemAlloc() updates the metrics of the current context.
+struct ImFontBuildJobAllocator
+{
+    ImGuiMemAllocFunc   AllocFunc;
+    ImGuiMemFreeFunc    FreeFunc;
+    void*               UserData;
+};
+
+static inline void* ImFontAtlasBuildJobAlloc(size_t size, void* allocator)
+{
+    ImFontBuildJobAllocator* a = (ImFontBuildJobAllocator*)allocator;
+    return a->AllocFunc(size, a->UserData);
+}
+
+static inline void ImFontAtlasBuildJobFree(void* ptr, void* allocator)
+{
+    ImFontBuildJobAllocator* a = (ImFontBuildJobAllocator*)allocator;
+    a->FreeFunc(ptr, a->UserData);
+}
+
+// Font info of a source font rasterized on demand
+struct ImFontDynamicGlyphsSource
+{
+    stbtt_fontinfo      FontInfo;
 };
 
 // Temporary data for one destination ImFont* (multiple source fonts can be merged into one destination ImFont)
@@ -2757,6 +2839,83 @@ static void UnpackBitVectorToFlatIndexList(const ImBitVector* in, ImVector<int>*
                     out->push_back((int)(((it - it_begin) << 5) + bit_n));
 }
 
+// Scale applied by stbtt_PackFontRangesRenderIntoRects() to the glyphs of a source font
+static float ImFontAtlasBuildRasterizationScale(const stbtt_fontinfo* info, const ImFontConfig& cfg)
+{
+    return (cfg.SizePixels > 0.0f) ? stbtt_ScaleForPixelHeight(info, cfg.SizePixels * cfg.RasterizerDensity) : stbtt_ScaleForMappingEmToPixels(info, -cfg.SizePixels * cfg.RasterizerDensity);
+}
+
+// For a glyph rasterized on demand: outputs the size of its rectangle (as gathered before packing, padding included),
+// and the metrics which stbtt_PackFontRangesRenderIntoRects() outputs once it is rasterized at (0, 0), without rasterizing it.
+static void ImFontAtlasBuildDynamicGlyphRect(const stbtt_fontinfo* info, const ImFontConfig& cfg, float scale, int padding, int codepoint, stbrp_rect* out_rect, stbtt_packedchar* out_packed_char)
+{
+    const int glyph_index_in_font = stbtt_FindGlyphIndex(info, codepoint);
+    int x0, y0, x1, y1, advance, lsb;
+    stbtt_GetGlyphBitmapBoxSubpixel(info, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
+    stbtt_GetGlyphHMetrics(info, glyph_index_in_font, &advance, &lsb);
+    memset(out_rect, 0, sizeof(*out_rect));
+    out_rect->w = (stbrp_coord)(x1 - x0 + padding + cfg.OversampleH - 1);
+    out_rect->h = (stbrp_coord)(y1 - y0 + padding + cfg.OversampleV - 1);
+
+    // Same computations as stbtt_PackFontRangesRenderIntoRects(), which pads on the left and top
+    const int w = out_rect->w - padding;
+    const int h = out_rect->h - padding;
+    const float recip_h = 1.0f / cfg.OversampleH;
+    const float recip_v = 1.0f / cfg.OversampleV;
+    const float sub_x = stbtt__oversample_shift(cfg.OversampleH);
+    const float sub_y = stbtt__oversample_shift(cfg.OversampleV);
+    out_packed_char->x0 = (stbtt_int16)padding;
+    out_packed_char->y0 = (stbtt_int16)padding;
+    out_packed_char->x1 = (stbtt_int16)out_rect->w;
+    out_packed_char->y1 = (stbtt_int16)out_rect->h;
+    out_packed_char->xadvance = scale * advance;
+    out_packed_char->xoff = (float)x0 * recip_h + sub_x;
+    out_packed_char->yoff = (float)y0 * recip_v + sub_y;
+    out_packed_char->xoff2 = (x0 + w) * recip_h + sub_x;
+    out_packed_char->yoff2 = (y0 + h) * recip_v + sub_y;
+}
+
+// Data shared by the rasterization jobs of a build
+struct ImFontBuildRasterJobsData
+{
+    ImFontAtlas*                Atlas;
+    ImFontBuildSrcData*         SrcTmpArray;
+    const stbtt_pack_context*   PackContext;
+    const ImFontBuildRasterJob* Jobs;
+    ImFontBuildJobAllocator*    Allocator;      // NULL when the jobs run serially
+};
+
+static void ImFontAtlasBuildRasterJob(void* job_data, int job_index)
+{
+    ImFontBuildRasterJobsData* data = (ImFontBuildRasterJobsData*)job_data;
+    const ImFontBuildRasterJob& job = data->Jobs[job_index];
+    ImFontAtlas* atlas = data->Atlas;
+    const ImFontConfig& cfg = atlas->ConfigData[job.SrcIndex];
+    ImFontBuildSrcData& src_tmp = data->SrcTmpArray[job.SrcIndex];
+
+    // Own copies of the pack context (its oversampling is modified while rendering) and of the font info (it holds the allocator)
+    stbtt_pack_context spc = *data->PackContext;
+    stbtt_fontinfo font_info = src_tmp.FontInfo;
+    font_info.userdata = data->Allocator;
+    stbtt_pack_range range = src_tmp.PackRange;
+    range.array_of_unicode_codepoints += job.GlyphStart;
+    range.chardata_for_range += job.GlyphStart;
+    range.num_chars = job.GlyphsCount;
+    stbrp_rect* rects = src_tmp.Rects + job.GlyphStart;
+    stbtt_PackFontRangesRenderIntoRects(&spc, &font_info, &range, 1, rects);
+
+    // Apply multiply operator
+    if (cfg.RasterizerMultiply != 1.0f)
+    {
+        unsigned char multiply_table[256];
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+        stbrp_rect* r = rects;
+        for (int glyph_i = 0; glyph_i < job.GlyphsCount; glyph_i++, r++)
+            if (r->was_packed)
+                ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
+    }
+}
+
 static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
 {
     IM_ASSERT(atlas->ConfigData.Size > 0);
@@ -2858,14 +3017,39 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         dst_tmp_array[dst_i].GlyphsSet.Clear();
     dst_tmp_array.clear();
 
+    // The glyphs rasterized on demand are not packed: only cells large enough for each of them are reserved (cf step 6).
+    ImFontDynamicGlyphs* dynamic_glyphs = NULL;
+    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+    {
+        ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
+        if (!atlas->ConfigData[src_i].RasterizeOnDemand || src_tmp.GlyphsCount == 0)
+            continue;
+        if (dynamic_glyphs == NULL)
+        {
+            dynamic_glyphs = atlas->DynamicGlyphs = IM_NEW(ImFontDynamicGlyphs)();
+            dynamic_glyphs->Sources.resize(atlas->ConfigData.Size, NULL);
+        }
+        src_tmp.DynamicGlyphsList.swap(src_tmp.GlyphsList);
+        src_tmp.GlyphsCount = 0;
+    }
+    if (dynamic_glyphs != NULL)
+    {
+        total_glyphs_count = 0;
+        for (const ImFontBuildSrcData& src_tmp : src_tmp_array)
+            total_glyphs_count += src_tmp.GlyphsList.Size;
+    }
+
     // Allocate packing character data and flag packed characters buffer as non-packed (x0=y0=x1=y1=0)
     // (We technically don't need to zero-clear buf_rects, but let's do it for the sake of sanity)
     ImVector<stbrp_rect> buf_rects;
     ImVector<stbtt_packedchar> buf_packedchars;
     buf_rects.resize(total_glyphs_count);
     buf_packedchars.resize(total_glyphs_count);
-    memset(buf_rects.Data, 0, (size_t)buf_rects.size_in_bytes());
-    memset(buf_packedchars.Data, 0, (size_t)buf_packedchars.size_in_bytes());
+    if (total_glyphs_count > 0) // may be 0 when all the glyphs are rasterized on demand
+    {
+        memset(buf_rects.Data, 0, (size_t)buf_rects.size_in_bytes());
+        memset(buf_packedchars.Data, 0, (size_t)buf_packedchars.size_in_bytes());
+    }
 
     // 4. Gather glyphs sizes so we can pack them in our virtual canvas.
     int total_surface = 0;
@@ -2874,6 +3058,20 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
     {
         ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
+        if (src_tmp.DynamicGlyphsList.Size > 0)
+        {
+            // Cells of the glyphs rasterized on demand: large enough for the largest of them
+            const ImFontConfig& cfg = atlas->ConfigData[src_i];
+            const float scale = ImFontAtlasBuildRasterizationScale(&src_tmp.FontInfo, cfg);
+            for (int codepoint : src_tmp.DynamicGlyphsList)
+            {
+                stbrp_rect rect;
+                stbtt_packedchar unused_packed_char;
+                ImFontAtlasBuildDynamicGlyphRect(&src_tmp.FontInfo, cfg, scale, atlas->TexGlyphPadding, codepoint, &rect, &unused_packed_char);
+                dynamic_glyphs->CellWidth = ImMax(dynamic_glyphs->CellWidth, (int)rect.w);
+                dynamic_glyphs->CellHeight = ImMax(dynamic_glyphs->CellHeight, (int)rect.h);
+            }
+        }
         if (src_tmp.GlyphsCount == 0)
             continue;
 
@@ -2893,7 +3091,7 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         src_tmp.PackRange.v_oversample = (unsigned char)cfg.OversampleV;
 
         // Gather the sizes of all rectangles we will need to pack (this loop is based on stbtt_PackFontRangesGatherRects)
-        const float scale = (cfg.SizePixels > 0.0f) ? stbtt_ScaleForPixelHeight(&src_tmp.FontInfo, cfg.SizePixels * cfg.RasterizerDensity) : stbtt_ScaleForMappingEmToPixels(&src_tmp.FontInfo, -cfg.SizePixels * cfg.RasterizerDensity);
+        const float scale = ImFontAtlasBuildRasterizationScale(&src_tmp.FontInfo, cfg);
         const int padding = atlas->TexGlyphPadding;
         for (int glyph_i = 0; glyph_i < src_tmp.GlyphsList.Size; glyph_i++)
         {
@@ -2916,6 +3114,10 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         atlas->TexWidth = atlas->TexDesiredWidth;
     else
         atlas->TexWidth = (surface_sqrt >= 4096 * 0.7f) ? 4096 : (surface_sqrt >= 2048 * 0.7f) ? 2048 : (surface_sqrt >= 1024 * 0.7f) ? 1024 : 512;
+    if (dynamic_glyphs != NULL && atlas->TexDesiredWidth <= 0)
+        while (atlas->TexWidth < dynamic_glyphs->CellWidth)
+            atlas->TexWidth *= 2;
+    IM_ASSERT((dynamic_glyphs == NULL || dynamic_glyphs->CellWidth <= atlas->TexWidth) && "TexDesiredWidth is too small for the glyphs rasterized on demand!");
 
     // 5. Start packing
     // Pack our extra data rectangles first, so it will be on the upper-left corner of our texture (UV will have small values).
@@ -2940,6 +3142,17 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
                 atlas->TexHeight = ImMax(atlas->TexHeight, src_tmp.Rects[glyph_i].y + src_tmp.Rects[glyph_i].h);
     }
 
+    // Reserve the cells of the glyphs rasterized on demand below the packed glyphs (full rows of cells)
+    if (dynamic_glyphs != NULL)
+    {
+        dynamic_glyphs->CellsPerRow = ImMax(atlas->TexWidth / dynamic_glyphs->CellWidth, 1);
+        const int rows_count = (ImMax(atlas->DynamicGlyphsCapacity, 1) + dynamic_glyphs->CellsPerRow - 1) / dynamic_glyphs->CellsPerRow;
+        dynamic_glyphs->Cells.resize(rows_count * dynamic_glyphs->CellsPerRow);
+        memset(dynamic_glyphs->Cells.Data, 0, (size_t)dynamic_glyphs->Cells.size_in_bytes());
+        dynamic_glyphs->AreaY = atlas->TexHeight;
+        atlas->TexHeight += rows_count * dynamic_glyphs->CellHeight;
+    }
+
     // 7. Allocate texture
     atlas->TexHeight = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (atlas->TexHeight + 1) : ImUpperPowerOfTwo(atlas->TexHeight);
     atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
@@ -2949,27 +3162,35 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     spc.height = atlas->TexHeight;
 
     // 8. Render/rasterize font characters into the texture
+    // By jobs of consecutive glyphs of a source, which run in parallel if BuildParallelForFn is set.
+    // Each glyph is rendered into its own packed rectangle: the texture does not depend on the order of the jobs.
+    const int RASTER_JOB_GLYPHS_MAX = 64;
+    ImVector<ImFontBuildRasterJob> raster_jobs;
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
-    {
-        ImFontConfig& cfg = atlas->ConfigData[src_i];
-        ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
-        if (src_tmp.GlyphsCount == 0)
-            continue;
-
-        stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &src_tmp.PackRange, 1, src_tmp.Rects);
-
-        // Apply multiply operator
-        if (cfg.RasterizerMultiply != 1.0f)
+        for (int glyph_start = 0; glyph_start < src_tmp_array[src_i].GlyphsCount; glyph_start += RASTER_JOB_GLYPHS_MAX)
         {
-            unsigned char multiply_table[256];
-            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
-            stbrp_rect* r = &src_tmp.Rects[0];
-            for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++, r++)
-                if (r->was_packed)
-                    ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
+            ImFontBuildRasterJob job;
+            job.SrcIndex = src_i;
+            job.GlyphStart = glyph_start;
+            job.GlyphsCount = ImMin(src_tmp_array[src_i].GlyphsCount - glyph_start, RASTER_JOB_GLYPHS_MAX);
+            raster_jobs.push_back(job);
         }
-        src_tmp.Rects = NULL;
-    }
+    const bool parallel_raster = (atlas->BuildParallelForFn != NULL && raster_jobs.Size > 1);
+    ImFontBuildJobAllocator job_allocator;
+    ImGui::GetAllocatorFunctions(&job_allocator.AllocFunc, &job_allocator.FreeFunc, &job_allocator.UserData);
+    ImFontBuildRasterJobsData raster_jobs_data;
+    raster_jobs_data.Atlas = atlas;
+    raster_jobs_data.SrcTmpArray = src_tmp_array.Data;
+    raster_jobs_data.PackContext = &spc;
+    raster_jobs_data.Jobs = raster_jobs.Data;
+    raster_jobs_data.Allocator = parallel_raster ? &job_allocator : NULL;
+    if (parallel_raster)
+        atlas->BuildParallelForFn(atlas->BuildParallelForUserData, raster_jobs.Size, ImFontAtlasBuildRasterJob, &raster_jobs_data);
+    else
+        for (int job_i = 0; job_i < raster_jobs.Size; job_i++)
+            ImFontAtlasBuildRasterJob(&raster_jobs_data, job_i);
+    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+        src_tmp_array[src_i].Rects = NULL;
 
     // End packing
     stbtt_PackEnd(&spc);
@@ -3011,6 +3232,32 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
             float y1 = q.y1 * inv_rasterization_scale + font_off_y;
             dst_font->AddGlyph(&cfg, (ImWchar)codepoint, x0, y0, x1, y1, q.s0, q.t0, q.s1, q.t1, pc.xadvance * inv_rasterization_scale);
         }
+
+        // Register the glyphs rasterized on demand, with the metrics they will have once rasterized, but no UVs yet
+        if (src_tmp.DynamicGlyphsList.Size == 0)
+            continue;
+        ImFontDynamicGlyphsSource* dynamic_source = dynamic_glyphs->Sources[src_i] = IM_NEW(ImFontDynamicGlyphsSource)();
+        dynamic_source->FontInfo = src_tmp.FontInfo;
+        const float scale = ImFontAtlasBuildRasterizationScale(&src_tmp.FontInfo, cfg);
+        for (int codepoint : src_tmp.DynamicGlyphsList)
+        {
+            stbrp_rect unused_rect;
+            stbtt_packedchar pc;
+            ImFontAtlasBuildDynamicGlyphRect(&src_tmp.FontInfo, cfg, scale, atlas->TexGlyphPadding, codepoint, &unused_rect, &pc);
+            stbtt_aligned_quad q;
+            float unused_x = 0.0f, unused_y = 0.0f;
+            stbtt_GetPackedQuad(&pc, atlas->TexWidth, atlas->TexHeight, 0, &unused_x, &unused_y, &q, 0);
+            float x0 = q.x0 * inv_rasterization_scale + font_off_x;
+            float y0 = q.y0 * inv_rasterization_scale + font_off_y;
+            float x1 = q.x1 * inv_rasterization_scale + font_off_x;
+            float y1 = q.y1 * inv_rasterization_scale + font_off_y;
+            dst_font->AddGlyph(&cfg, (ImWchar)codepoint, x0, y0, x1, y1, 0.0f, 0.0f, 0.0f, 0.0f, pc.xadvance * inv_rasterization_scale);
+            if (!dst_font->Glyphs.back().Visible)
+                continue; // Nothing to rasterize
+            dst_font->Glyphs.back().Dynamic = 1;
+            dst_font->DynamicGlyphCells.resize(dst_font->Glyphs.Size, -1);
+            dst_font->DynamicGlyphCells.back() = -2 - src_i;
+        }
     }
 
     // Cleanup
@@ -3027,8 +3274,174 @@ const ImFontBuilderIO* ImFontAtlasGetBuilderForStbTruetype()
     return &io;
 }
 
+// Rasterizes a glyph into a cell of the dynamic glyphs area, and sets its UVs
+static void ImFontAtlasBuildRenderDynamicGlyph(ImFontAtlas* atlas, ImFontDynamicGlyphsSource* source, const ImFontConfig& cfg, int cell_x, int cell_y, ImFontGlyph* glyph)
+{
+    ImFontDynamicGlyphs* dynamic_glyphs = atlas->DynamicGlyphs;
+    const int cell_w = dynamic_glyphs->CellWidth;
+    const int cell_h = dynamic_glyphs->CellHeight;
+    for (int y = 0; y < cell_h; y++)
+        memset(atlas->TexPixelsAlpha8 + (size_t)(cell_y + y) * atlas->TexWidth + cell_x, 0, (size_t)cell_w);
+
+    // Same rasterization as the packed glyphs (cf steps 4 and 8 of ImFontAtlasBuildWithStbTruetype()), at the cell position
+    const float scale = ImFontAtlasBuildRasterizationScale(&source->FontInfo, cfg);
+    int codepoint = (int)glyph->Codepoint;
+    stbrp_rect rect;
+    stbtt_packedchar pc;
+    ImFontAtlasBuildDynamicGlyphRect(&source->FontInfo, cfg, scale, atlas->TexGlyphPadding, codepoint, &rect, &pc);
+    IM_ASSERT(rect.w <= cell_w && rect.h <= cell_h);
+    rect.x = (stbrp_coord)cell_x;
+    rect.y = (stbrp_coord)cell_y;
+    rect.was_packed = 1;
+    stbtt_pack_range range = {};
+    range.font_size = cfg.SizePixels * cfg.RasterizerDensity;
+    range.array_of_unicode_codepoints = &codepoint;
+    range.num_chars = 1;
+    range.chardata_for_range = &pc;
+    range.h_oversample = (unsigned char)cfg.OversampleH;
+    range.v_oversample = (unsigned char)cfg.OversampleV;
+    stbtt_pack_context spc = {};
+    spc.width = atlas->TexWidth;
+    spc.height = atlas->TexHeight;
+    spc.stride_in_bytes = atlas->TexWidth;
+    spc.padding = atlas->TexGlyphPadding;
+    spc.pixels = atlas->TexPixelsAlpha8;
+    stbtt_PackFontRangesRenderIntoRects(&spc, &source->FontInfo, &range, 1, &rect);
+    if (cfg.RasterizerMultiply != 1.0f)
+    {
+        unsigned char multiply_table[256];
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+        ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, rect.x, rect.y, rect.w, rect.h, atlas->TexWidth * 1);
+    }
+
+    // Keep the RGBA32 pixels (if the backend requested them) in sync, as GetTexDataAsRGBA32() converts them
+    if (atlas->TexPixelsRGBA32 != NULL)
+        for (int y = 0; y < cell_h; y++)
+        {
+            const unsigned char* src = atlas->TexPixelsAlpha8 + (size_t)(cell_y + y) * atlas->TexWidth + cell_x;
+            unsigned int* dst = atlas->TexPixelsRGBA32 + (size_t)(cell_y + y) * atlas->TexWidth + cell_x;
+            for (int x = 0; x < cell_w; x++)
+                dst[x] = IM_COL32(255, 255, 255, (unsigned int)src[x]);
+        }
+
+    stbtt_aligned_quad q;
+    float unused_x = 0.0f, unused_y = 0.0f;
+    stbtt_GetPackedQuad(&pc, atlas->TexWidth, atlas->TexHeight, 0, &unused_x, &unused_y, &q, 0);
+    glyph->U0 = q.s0;
+    glyph->V0 = q.t0;
+    glyph->U1 = q.s1;
+    glyph->V1 = q.t1;
+
+    if (dynamic_glyphs->DirtyX0 >= dynamic_glyphs->DirtyX1)
+    {
+        dynamic_glyphs->DirtyX0 = cell_x;
+        dynamic_glyphs->DirtyY0 = cell_y;
+        dynamic_glyphs->DirtyX1 = cell_x + cell_w;
+        dynamic_glyphs->DirtyY1 = cell_y + cell_h;
+    }
+    else
+    {
+        dynamic_glyphs->DirtyX0 = ImMin(dynamic_glyphs->DirtyX0, cell_x);
+        dynamic_glyphs->DirtyY0 = ImMin(dynamic_glyphs->DirtyY0, cell_y);
+        dynamic_glyphs->DirtyX1 = ImMax(dynamic_glyphs->DirtyX1, cell_x + cell_w);
+        dynamic_glyphs->DirtyY1 = ImMax(dynamic_glyphs->DirtyY1, cell_y + cell_h);
+    }
+}
+
+const ImFontGlyph* ImFontAtlasUseDynamicGlyph(ImFontAtlas* atlas, ImFont* font, const ImFontGlyph* glyph)
+{
+    ImFontDynamicGlyphs* dynamic_glyphs = atlas->DynamicGlyphs;
+    const int glyph_index = (int)(glyph - font->Glyphs.Data);
+    if (dynamic_glyphs == NULL || glyph_index < 0 || glyph_index >= font->DynamicGlyphCells.Size)
+        return glyph; // Not a glyph of this font (e.g. InputText() password font, which uses a glyph returned by FindGlyph())
+
+    ImGuiContext* ctx = GImGui;
+    const int frame_count = ctx ? ctx->FrameCount : 0;
+    int& glyph_cell = font->DynamicGlyphCells.Data[glyph_index];
+    if (glyph_cell >= 0)
+    {
+        dynamic_glyphs->Cells.Data[glyph_cell].LastUsedFrame = frame_count;
+        return glyph;
+    }
+
+    // Use a free cell, or evict the least recently used glyph (but not one used during this frame: its vertices may already be emitted)
+    const int source_n = -2 - glyph_cell;
+    ImFontDynamicGlyphsSource* source = (source_n < dynamic_glyphs->Sources.Size) ? dynamic_glyphs->Sources[source_n] : NULL;
+    int cell_n = -1;
+    for (int n = 0; n < dynamic_glyphs->Cells.Size; n++)
+    {
+        const ImFontDynamicGlyphsCell& cell = dynamic_glyphs->Cells.Data[n];
+        if (cell.Font == NULL)
+        {
+            cell_n = n;
+            break;
+        }
+        if (cell.LastUsedFrame != frame_count && (cell_n == -1 || cell.LastUsedFrame < dynamic_glyphs->Cells.Data[cell_n].LastUsedFrame))
+            cell_n = n;
+    }
+    if (source == NULL || cell_n == -1 || atlas->TexPixelsAlpha8 == NULL)
+    {
+        dynamic_glyphs->NotRasterized++;
+        dynamic_glyphs->HiddenGlyph = *glyph;
+        dynamic_glyphs->HiddenGlyph.Visible = 0;
+        dynamic_glyphs->HiddenGlyph.Dynamic = 0;
+        return &dynamic_glyphs->HiddenGlyph;
+    }
+
+    ImFontDynamicGlyphsCell& cell = dynamic_glyphs->Cells.Data[cell_n];
+    if (cell.Font != NULL)
+    {
+        cell.Font->DynamicGlyphCells[cell.GlyphIndex] = -2 - cell.SourceIndex;
+        dynamic_glyphs->Evicted++;
+    }
+    const int cell_x = (cell_n % dynamic_glyphs->CellsPerRow) * dynamic_glyphs->CellWidth;
+    const int cell_y = dynamic_glyphs->AreaY + (cell_n / dynamic_glyphs->CellsPerRow) * dynamic_glyphs->CellHeight;
+    ImFontAtlasBuildRenderDynamicGlyph(atlas, source, atlas->ConfigData[source_n], cell_x, cell_y, (ImFontGlyph*)glyph);
+    cell.Font = font;
+    cell.GlyphIndex = glyph_index;
+    cell.SourceIndex = source_n;
+    cell.LastUsedFrame = frame_count;
+    glyph_cell = cell_n;
+    dynamic_glyphs->Rasterized++;
+    return glyph;
+}
+
+#else
+
+// Only the stb_truetype builder creates glyphs rasterized on demand
+struct ImFontDynamicGlyphsSource
+{
+    int                 Unused;
+};
+
+const ImFontGlyph* ImFontAtlasUseDynamicGlyph(ImFontAtlas*, ImFont*, const ImFontGlyph* glyph)
+{
+    return glyph;
+}
+
 #endif // IMGUI_ENABLE_STB_TRUETYPE
 
+static void ImFontAtlasDestroyDynamicGlyphsSources(ImFontAtlas* atlas)
+{
+    if (ImFontDynamicGlyphs* dynamic_glyphs = atlas->DynamicGlyphs)
+        for (ImFontDynamicGlyphsSource*& source : dynamic_glyphs->Sources)
+            if (source)
+            {
+                IM_DELETE(source);
+                source = NULL;
+            }
+}
+
+void ImFontAtlasDestroyDynamicGlyphs(ImFontAtlas* atlas)
+{
+    ImFontDynamicGlyphs* dynamic_glyphs = atlas->DynamicGlyphs;
+    if (dynamic_glyphs == NULL)
+        return;
+    ImFontAtlasDestroyDynamicGlyphsSources(atlas);
+    IM_DELETE(dynamic_glyphs);
+    atlas->DynamicGlyphs = NULL;
+}
+
 void ImFontAtlasUpdateConfigDataPointers(ImFontAtlas* atlas)
 {
     for (ImFontConfig& font_cfg : atlas->ConfigData)
@@ -3593,6 +4006,7 @@ void    ImFont::ClearOutputData()
     Glyphs.clear();
     IndexAdvanceX.clear();
     IndexLookup.clear();
+    DynamicGlyphCells.clear();
     FallbackGlyph = NULL;
     ContainerAtlas = NULL;
     DirtyLookupTables = true;
@@ -3620,6 +4034,8 @@ void ImFont::BuildLookupTable()
     IndexAdvanceX.clear();
     IndexLookup.clear();
     DirtyLookupTables = false;
+    if (ContainerAtlas)
+        ImFontAtlasClearTextSizeCache(ContainerAtlas); // The advances may change
     memset(Used4kPagesMap, 0, sizeof(Used4kPagesMap));
     GrowIndex(max_codepoint + 1);
     for (int i = 0; i < Glyphs.Size; i++)
@@ -3642,6 +4058,7 @@ void ImFont::BuildLookupTable()
         ImFontGlyph& tab_glyph = Glyphs.back();
         tab_glyph = *FindGlyph((ImWchar)' ');
         tab_glyph.Codepoint = '\t';
+        tab_glyph.Dynamic = 0; // Not in DynamicGlyphCells (and a space has no pixels)
         tab_glyph.AdvanceX *= IM_TABSIZE;
         IndexAdvanceX[(int)tab_glyph.Codepoint] = (float)tab_glyph.AdvanceX;
         IndexLookup[(int)tab_glyph.Codepoint] = (ImWchar)(Glyphs.Size - 1);
@@ -3750,6 +4167,7 @@ void ImFont::AddGlyph(const ImFontConfig* cfg, ImWchar codepoint, float x0, floa
     glyph.Codepoint = (unsigned int)codepoint;
     glyph.Visible = (x0 != x1) && (y0 != y1);
     glyph.Colored = false;
+    glyph.Dynamic = false;
     glyph.X0 = x0;
     glyph.Y0 = y0;
     glyph.X1 = x1;
@@ -3782,14 +4200,22 @@ void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
     IndexAdvanceX[dst] = (src < index_size) ? IndexAdvanceX.Data[src] : 1.0f;
 }
 
+// The glyphs rasterized on demand are rasterized when they are looked up (see ImFontConfig::RasterizeOnDemand)
+static inline const ImFontGlyph* ImFontUseGlyph(const ImFont* font, const ImFontGlyph* glyph)
+{
+    if (glyph != NULL && glyph->Dynamic)
+        return ImFontAtlasUseDynamicGlyph(font->ContainerAtlas, (ImFont*)font, glyph);
+    return glyph;
+}
+
 const ImFontGlyph* ImFont::FindGlyph(ImWchar c) const
 {
     if (c >= (size_t)IndexLookup.Size)
-        return FallbackGlyph;
+        return ImFontUseGlyph(this, FallbackGlyph);
     const ImWchar i = IndexLookup.Data[c];
     if (i == (ImWchar)-1)
-        return FallbackGlyph;
-    return &Glyphs.Data[i];
+        return ImFontUseGlyph(this, FallbackGlyph);
+    return ImFontUseGlyph(this, &Glyphs.Data[i]);
 }
 
 const ImFontGlyph* ImFont::FindGlyphNoFallback(ImWchar c) const
@@ -3799,7 +4225,7 @@ const ImFontGlyph* ImFont::FindGlyphNoFallback(ImWchar c) const
     const ImWchar i = IndexLookup.Data[c];
     if (i == (ImWchar)-1)
         return NULL;
-    return &Glyphs.Data[i];
+    return ImFontUseGlyph(this, &Glyphs.Data[i]);
 }
 
 // Wrapping skips upcoming blanks
@@ -3913,11 +4339,102 @@ const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const c
     return s;
 }
 
+void ImFontAtlasClearTextSizeCache(ImFontAtlas* atlas)
+{
+    ImFontTextSizeCache* cache = atlas->TextSizeCache;
+    if (cache == NULL)
+        return;
+    if (cache->Entries.Size > 0)
+        memset(cache->Entries.Data, 0, (size_t)cache->Entries.size_in_bytes());
+    cache->Clears++;
+}
+
+// MurmurHash64A (Austin Appleby, public domain)
+static ImU64 ImFontTextSizeCacheHash(const void* data, size_t data_size, ImU64 seed)
+{
+    const ImU64 m = 0xC6A4A7935BD1E995ULL;
+    const int r = 47;
+    ImU64 h = seed ^ ((ImU64)data_size * m);
+    const unsigned char* p = (const unsigned char*)data;
+    for (; data_size >= 8; data_size -= 8, p += 8)
+    {
+        ImU64 k;
+        memcpy(&k, p, 8);
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+        h ^= k;
+        h *= m;
+    }
+    if (data_size > 0)
+    {
+        ImU64 tail = 0;
+        memcpy(&tail, p, data_size);
+        h ^= tail;
+        h *= m;
+    }
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+    return h;
+}
+
+// Returns the cache slot for this text, creating or resizing the cache if TextSizeCapacity changed.
+// *out_hit tells whether the slot holds the size of this text, otherwise the caller shall store it there.
+static ImFontTextSizeCacheEntry* ImFontTextSizeCacheLookup(ImFontAtlas* atlas, const ImFont* font, float size, float wrap_width, const char* text_begin, const char* text_end, bool* out_hit)
+{
+    ImFontTextSizeCache* cache = atlas->TextSizeCache;
+    if (cache == NULL)
+        cache = atlas->TextSizeCache = IM_NEW(ImFontTextSizeCache)();
+    int capacity = 1;
+    while (capacity < atlas->TextSizeCacheCapacity)
+        capacity *= 2;
+    if (cache->Entries.Size != capacity)
+    {
+        cache->Entries.resize(capacity);
+        ImFontAtlasClearTextSizeCache(atlas);
+    }
+
+    struct { const ImFont* Font; float Size; float WrapWidth; } key_prefix = { font, size, wrap_width };
+    const int text_length = (int)(text_end - text_begin);
+    const ImU64 text_hash = ImFontTextSizeCacheHash(text_begin, (size_t)text_length, ImFontTextSizeCacheHash(&key_prefix, sizeof(key_prefix), 0));
+    ImFontTextSizeCacheEntry* entry = &cache->Entries.Data[text_hash & (ImU64)(capacity - 1)];
+    *out_hit = entry->Font == font && entry->TextHash == text_hash && entry->TextLength == text_length && entry->FontSize == size && entry->WrapWidth == wrap_width;
+    if (*out_hit)
+    {
+        cache->Hits++;
+    }
+    else
+    {
+        cache->Misses++;
+        entry->Font = font;
+        entry->FontSize = size;
+        entry->WrapWidth = wrap_width;
+        entry->TextHash = text_hash;
+        entry->TextLength = text_length;
+    }
+    return entry;
+}
+
 ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end, const char** remaining) const
 {
     if (!text_end)
         text_end = text_begin + strlen(text_begin); // FIXME-OPT: Need to avoid this.
 
+    // Opt-in cache (when measuring whole texts)
+    ImFontTextSizeCacheEntry* cache_entry = NULL;
+    if (ContainerAtlas && ContainerAtlas->TextSizeCacheCapacity > 0 && max_width == FLT_MAX && text_end - text_begin >= IM_FONT_TEXT_SIZE_CACHE_MIN_LENGTH)
+    {
+        bool hit;
+        cache_entry = ImFontTextSizeCacheLookup(ContainerAtlas, this, size, wrap_width, text_begin, text_end, &hit);
+        if (hit)
+        {
+            if (remaining)
+                *remaining = text_end;
+            return cache_entry->TextSize;
+        }
+    }
+
     const float line_height = size;
     const float scale = size / FontSize;
 
@@ -3988,6 +4505,8 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
     if (remaining)
         *remaining = s;
 
+    if (cache_entry)
+        cache_entry->TextSize = text_size;
     return text_size;
 }
 
@@ -4191,6 +4710,156 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     draw_list->_VtxCurrentIdx = vtx_index;
 }
 
+static inline bool ImDrawTextRunIsVisible(const ImDrawTextRun& run, const ImVec4& clip_rect, float line_height)
+{
+    return (run.Col & IM_COL32_A_MASK) != 0 && run.TextBegin != run.TextEnd
+        && run.Pos.y <= clip_rect.w && run.Pos.y + line_height >= clip_rect.y && run.Pos.x <= clip_rect.z;
+}
+
+// Batched version of RenderText() for many single-line runs sharing one font and one clip rect:
+// - vertices are reserved once for a whole batch of runs, and trimmed once at the end of it
+// - the ASCII characters are decoded and looked up inline (other characters go through ImTextCharFromUtf8() and FindGlyph())
+// - a run stops being decoded as soon as it goes past the right of the clip rect
+void ImFont::RenderTextRuns(ImDrawList* draw_list, float size, const ImVec4& clip_rect, const ImDrawTextRun* runs, int runs_count) const
+{
+    const float scale = size / FontSize;
+    const float line_height = FontSize * scale;
+    const int batch_chars_max = 8192; // Keeps each reservation well within the reach of 16-bit indices
+
+    int run_n = 0;
+    const char* run_resume = NULL; // A run longer than batch_chars_max is split: where the next batch resumes runs[run_n]
+    float run_resume_x = 0.0f;
+    while (run_n < runs_count)
+    {
+        // Select the runs of this batch, and count the characters of the visible ones.
+        // If the batch starts with a run longer than batch_chars_max, it only takes its first characters [.., split_end)
+        int batch_end = run_n;
+        int chars_count = 0;
+        const char* split_end = NULL;
+        for (; batch_end < runs_count; batch_end++)
+        {
+            const ImDrawTextRun& run = runs[batch_end];
+            if (!ImDrawTextRunIsVisible(run, clip_rect, line_height))
+                continue;
+            const char* run_begin = (batch_end == run_n && run_resume != NULL) ? run_resume : run.TextBegin;
+            const int run_chars = (int)(run.TextEnd - run_begin);
+            if (chars_count + run_chars > batch_chars_max)
+            {
+                if (chars_count == 0)
+                {
+                    split_end = run_begin + batch_chars_max;
+                    for (int n = 0; n < 3 && (*split_end & 0xC0) == 0x80; n++) // Do not split a UTF-8 sequence
+                        split_end--;
+                    chars_count = (int)(split_end - run_begin);
+                }
+                break;
+            }
+            chars_count += run_chars;
+        }
+        if (chars_count == 0)
+        {
+            run_n = batch_end;
+            run_resume = NULL;
+            continue;
+        }
+
+        // Reserve vertices for the worst case (every character visible)
+        const int vtx_count_max = chars_count * 4;
+        const int idx_count_max = chars_count * 6;
+        const int idx_expected_size = draw_list->IdxBuffer.Size + idx_count_max;
+        draw_list->PrimReserve(idx_count_max, vtx_count_max);
+        ImDrawVert*  vtx_write = draw_list->_VtxWritePtr;
+        ImDrawIdx*   idx_write = draw_list->_IdxWritePtr;
+        unsigned int vtx_index = draw_list->_VtxCurrentIdx;
+
+        const int batch_runs_end = (split_end != NULL) ? batch_end + 1 : batch_end;
+        for (int n = run_n; n < batch_runs_end; n++)
+        {
+            const ImDrawTextRun& run = runs[n];
+            if (!ImDrawTextRunIsVisible(run, clip_rect, line_height))
+                continue;
+
+            // Align to be pixel perfect (a resumed run continues where the previous batch stopped)
+            const bool is_resumed = (n == run_n && run_resume != NULL);
+            float x = is_resumed ? run_resume_x : IM_TRUNC(run.Pos.x);
+            const float y = IM_TRUNC(run.Pos.y);
+            const ImU32 col = run.Col;
+            const ImU32 col_untinted = col | ~IM_COL32_A_MASK;
+
+            const char* s = is_resumed ? run_resume : run.TextBegin;
+            const char* text_end = (n == batch_end) ? split_end : run.TextEnd;
+            while (s < text_end && x <= clip_rect.z)
+            {
+                // Decode and look up the glyph, with a fast path for ASCII
+                const ImFontGlyph* glyph;
+                unsigned int c = (unsigned char)*s;
+                if (c < 0x80)
+                {
+                    s += 1;
+                    if (c == '\n' || c == '\r')
+                        continue;
+                    const ImWchar i = (c < (unsigned int)IndexLookup.Size) ? IndexLookup.Data[c] : (ImWchar)-1;
+                    glyph = ImFontUseGlyph(this, (i != (ImWchar)-1) ? &Glyphs.Data[i] : FallbackGlyph);
+                }
+                else
+                {
+                    s += ImTextCharFromUtf8(&c, s, text_end);
+                    glyph = FindGlyph((ImWchar)c);
+                }
+                if (glyph == NULL)
+                    continue;
+
+                const float char_width = glyph->AdvanceX * scale;
+                if (glyph->Visible)
+                {
+                    const float x1 = x + glyph->X0 * scale;
+                    const float x2 = x + glyph->X1 * scale;
+                    if (x2 >= clip_rect.x)
+                    {
+                        const float y1 = y + glyph->Y0 * scale;
+                        const float y2 = y + glyph->Y1 * scale;
+                        const float u1 = glyph->U0;
+                        const float v1 = glyph->V0;
+                        const float u2 = glyph->U1;
+                        const float v2 = glyph->V1;
+                        const ImU32 glyph_col = glyph->Colored ? col_untinted : col;
+
+                        // Same inlined PrimRectUV() as RenderText()
+                        vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = glyph_col; vtx_write[0].uv.x = u1; vtx_write[0].uv.y = v1;
+                        vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = glyph_col; vtx_write[1].uv.x = u2; vtx_write[1].uv.y = v1;
+                        vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = glyph_col; vtx_write[2].uv.x = u2; vtx_write[2].uv.y = v2;
+                        vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = glyph_col; vtx_write[3].uv.x = u1; vtx_write[3].uv.y = v2;
+                        idx_write[0] = (ImDrawIdx)(vtx_index); idx_write[1] = (ImDrawIdx)(vtx_index + 1); idx_write[2] = (ImDrawIdx)(vtx_index + 2);
+                        idx_write[3] = (ImDrawIdx)(vtx_index); idx_write[4] = (ImDrawIdx)(vtx_index + 2); idx_write[5] = (ImDrawIdx)(vtx_index + 3);
+                        vtx_write += 4;
+                        vtx_index += 4;
+                        idx_write += 6;
+                    }
+                }
+                x += char_width;
+            }
+
+            // The rest of a split run goes into the next batch, unless it is clipped
+            if (n == batch_end)
+            {
+                run_resume = (x <= clip_rect.z) ? s : NULL;
+                run_resume_x = x;
+            }
+        }
+        if (split_end == NULL)
+            run_resume = NULL;
+        run_n = (split_end != NULL && run_resume == NULL) ? batch_end + 1 : batch_end;
+
+        // Give back unused vertices (clipped ones, blanks)
+        draw_list->VtxBuffer.Size = (int)(vtx_write - draw_list->VtxBuffer.Data);
+        draw_list->IdxBuffer.Size = (int)(idx_write - draw_list->IdxBuffer.Data);
+        draw_list->CmdBuffer[draw_list->CmdBuffer.Size - 1].ElemCount -= (idx_expected_size - draw_list->IdxBuffer.Size);
+        draw_list->_VtxWritePtr = vtx_write;
+        draw_list->_IdxWritePtr = idx_write;
+        draw_list->_VtxCurrentIdx = vtx_index;
+    }
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImGui Internal Render Helpers
 //-----------------------------------------------------------------------------
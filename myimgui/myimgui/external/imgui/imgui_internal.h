@@ -363,6 +363,19 @@ namespace ImStb
 IMGUI_API ImGuiID       ImHashData(const void* data, size_t data_size, ImGuiID seed = 0);
 IMGUI_API ImGuiID       ImHashStr(const char* data, size_t data_size = 0, ImGuiID seed = 0);
 
+// Helpers: Hashing backends (all of them compute the same CRC32, the fastest one available is selected at the first hash)
+typedef int ImHashBackend;
+enum ImHashBackend_
+{
+    ImHashBackend_Bytewise,         // One byte at a time, with a 1KB table
+    ImHashBackend_SlicingBy8,       // 8 bytes at a time, with 8KB of tables (little-endian CPUs)
+    ImHashBackend_HardwareCrc32,    // ARMv8 CRC32 instructions (when compiled with __ARM_FEATURE_CRC32)
+    ImHashBackend_COUNT
+};
+IMGUI_API bool          ImHashSetBackend(ImHashBackend backend);    // Returns false if not available on this build/CPU. Not thread-safe: for tests and benchmarks.
+IMGUI_API ImHashBackend ImHashGetBackend();
+IMGUI_API const char*   ImHashGetBackendName(ImHashBackend backend);
+
 // Helpers: Sorting
 #ifndef ImQsort
 static inline void      ImQsort(void* base, size_t count, size_t size_of_element, int(IMGUI_CDECL *compare_func)(void const*, void const*)) { if (count > 1) qsort(base, count, size_of_element, compare_func); }
@@ -3862,6 +3875,61 @@ IMGUI_API void      ImFontAtlasBuildRender32bppRectFromString(ImFontAtlas* atlas
 IMGUI_API void      ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_multiply_factor);
 IMGUI_API void      ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsigned char* pixels, int x, int y, int w, int h, int stride);
 
+// Opt-in cache of ImFont::CalcTextSizeA() results, shared by the fonts of an atlas (see ImFontAtlas::TextSizeCacheCapacity).
+// - Keyed by (font, size, wrap width, 64-bit text hash and length). Only the texts measured without max_width, of at least IM_FONT_TEXT_SIZE_CACHE_MIN_LENGTH bytes.
+// - The text itself is not stored: two texts of the same length whose hashes collide would share their size (with a 64-bit hash, this is not expected to happen in practice).
+// - Direct-mapped: an entry is replaced by the next text which hashes to the same slot, so its memory is bounded by the capacity.
+// - Cleared when the fonts lookup tables are rebuilt (atlas build, AddRemapChar()...), and when the fonts are cleared.
+// - CalcTextSizeA() then writes into the atlas: do not enable it if several threads measure text with the same atlas.
+#define IM_FONT_TEXT_SIZE_CACHE_MIN_LENGTH 8
+struct ImFontTextSizeCacheEntry
+{
+    const ImFont*   Font;           // NULL for an empty slot
+    ImU64           TextHash;       // Not ImHashData(): a CRC32 is too short for a key which is not checked against the text
+    float           FontSize;
+    float           WrapWidth;
+    int             TextLength;
+    ImVec2          TextSize;
+};
+struct ImFontTextSizeCache
+{
+    ImVector<ImFontTextSizeCacheEntry> Entries;
+    ImU64           Hits;           // Since the cache creation
+    ImU64           Misses;
+    int             Clears;
+};
+IMGUI_API void      ImFontAtlasClearTextSizeCache(ImFontAtlas* atlas);
+
+// Glyphs rasterized on demand (see ImFontConfig::RasterizeOnDemand), created by the stb_truetype builder.
+// - Build() computes their metrics (so that text layout does not depend on them being rasterized), but not their pixels.
+// - ImFont::FindGlyph() rasterizes them into a grid of same size cells, placed below the glyphs rasterized by Build().
+// - When all cells are used, the least recently used one is evicted (never one used during the current frame: if they
+//   all are, the glyph is not displayed). The modified pixels are reported by ImFontAtlas::GetTexDirtyRect().
+// - FindGlyph() then writes into the atlas: do not look up glyphs with the same atlas from several threads.
+// - The rasterization needs the input data (fonts) and the texture pixels: do not call ClearInputData() nor ClearTexData().
+struct ImFontDynamicGlyphsCell
+{
+    ImFont*         Font;           // NULL for a free cell
+    int             GlyphIndex;     // Index in Font->Glyphs
+    int             SourceIndex;    // Index in ImFontAtlas::ConfigData
+    int             LastUsedFrame;
+};
+struct ImFontDynamicGlyphsSource;   // stb_truetype font info, see imgui_draw.cpp
+struct ImFontDynamicGlyphs
+{
+    ImVector<ImFontDynamicGlyphsCell> Cells;
+    ImVector<ImFontDynamicGlyphsSource*> Sources;   // Per ImFontAtlas::ConfigData (NULL if not rasterized on demand, or after ClearInputData())
+    int             AreaY;          // Top of the cells area in the texture (cells start at x=0)
+    int             CellWidth, CellHeight, CellsPerRow;
+    int             DirtyX0, DirtyY0, DirtyX1, DirtyY1; // Modified pixels since Build() or ImFontAtlas::ClearTexDirtyRect() (empty if DirtyX0 >= DirtyX1)
+    ImFontGlyph     HiddenGlyph;    // Returned when a glyph cannot be rasterized: same metrics, not visible
+    ImU64           Rasterized;     // Since Build()
+    ImU64           Evicted;
+    ImU64           NotRasterized;  // Glyphs looked up while all the cells were in use during the frame
+};
+IMGUI_API const ImFontGlyph* ImFontAtlasUseDynamicGlyph(ImFontAtlas* atlas, ImFont* font, const ImFontGlyph* glyph); // Rasterizes it if needed
+IMGUI_API void      ImFontAtlasDestroyDynamicGlyphs(ImFontAtlas* atlas);
+
 //-----------------------------------------------------------------------------
 // [SECTION] Test Engine specific hooks (imgui_test_engine)
 //-----------------------------------------------------------------------------
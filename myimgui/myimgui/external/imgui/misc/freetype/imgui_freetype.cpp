@@ -409,10 +409,20 @@ struct ImFontBuildSrcGlyphFT
     ImFontBuildSrcGlyphFT() { memset((void*)this, 0, sizeof(*this)); }
 };
 
+// Temporary rasterization buffer, in a list per source font
+struct ImFontBuildBitmapChunkFT
+{
+    ImFontBuildBitmapChunkFT*   Next;
+    // Followed by the pixels
+};
+
 struct ImFontBuildSrcDataFT
 {
     FreeTypeFont        Font;
     stbrp_rect*         Rects;              // Rectangle to pack. We first fill in their size and the packer will give us their position.
+    ImFontBuildBitmapChunkFT* BitmapChunks; // Temporary rasterization buffers of the glyphs (the first one is being filled)
+    int                 BitmapChunkUsedBytes;
+    int                 Surface;            // Total surface of Rects
     const ImWchar*      SrcRanges;          // Ranges as requested by user (user is allowed to request too much, e.g. 0x0020..0xFFFF)
     int                 DstIndex;           // Index into atlas->Fonts[] and dst_tmp_array[]
     int                 GlyphsHighest;      // Highest requested codepoint
@@ -430,6 +440,81 @@ struct ImFontBuildDstDataFT
     ImBitVector         GlyphsSet;          // This is used to resolve collision when multiple sources are merged into a same destination font.
 };
 
+// Allocations of the rasterization jobs, when they run in parallel (see ImFontAtlas::BuildParallelForFn).
+// They call the allocator functions directly, since ImGui::MemAlloc() updates the metrics of the current context.
+struct ImFontBuildJobAllocatorFT
+{
+    ImGuiMemAllocFunc   AllocFunc;
+    ImGuiMemFreeFunc    FreeFunc;
+    void*               UserData;
+};
+
+// Data shared by the rasterization jobs of a build: one job per source font, since a FT_Face can only be used by one thread at a time
+struct ImFontBuildRasterJobsDataFT
+{
+    ImFontAtlas*                atlas;
+    ImFontBuildSrcDataFT*       src_tmp_array;
+    ImFontBuildJobAllocatorFT*  allocator;          // nullptr when the jobs run serially
+};
+
+static void ImFontAtlasBuildRasterSourceFT(void* job_data, int src_i)
+{
+    // We could not find a way to retrieve accurate glyph size without rendering them.
+    // (e.g. slot->metrics->width not always matching bitmap->width, especially considering the Oblique transform)
+    // We allocate in chunks of 256 KB to not waste too much extra memory ahead. Hopefully users of FreeType won't mind the temporary allocations.
+    const int BITMAP_BUFFERS_CHUNK_SIZE = 256 * 1024;
+
+    ImFontBuildRasterJobsDataFT* data = (ImFontBuildRasterJobsDataFT*)job_data;
+    ImFontAtlas* atlas = data->atlas;
+    ImFontBuildSrcDataFT& src_tmp = data->src_tmp_array[src_i];
+    ImFontConfig& cfg = atlas->ConfigData[src_i];
+    if (src_tmp.GlyphsCount == 0)
+        return;
+
+    // Compute multiply table if requested
+    const bool multiply_enabled = (cfg.RasterizerMultiply != 1.0f);
+    unsigned char multiply_table[256];
+    if (multiply_enabled)
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+
+    // Gather the sizes of all rectangles we will need to pack
+    const int padding = atlas->TexGlyphPadding;
+    for (int glyph_i = 0; glyph_i < src_tmp.GlyphsList.Size; glyph_i++)
+    {
+        ImFontBuildSrcGlyphFT& src_glyph = src_tmp.GlyphsList[glyph_i];
+
+        const FT_Glyph_Metrics* metrics = src_tmp.Font.LoadGlyph(src_glyph.Codepoint);
+        if (metrics == nullptr)
+            continue;
+
+        // Render glyph into a bitmap (currently held by FreeType)
+        const FT_Bitmap* ft_bitmap = src_tmp.Font.RenderGlyphAndGetInfo(&src_glyph.Info);
+        if (ft_bitmap == nullptr)
+            continue;
+
+        // Allocate new temporary chunk if needed
+        const int bitmap_size_in_bytes = src_glyph.Info.Width * src_glyph.Info.Height * 4;
+        if (src_tmp.BitmapChunks == nullptr || src_tmp.BitmapChunkUsedBytes + bitmap_size_in_bytes > BITMAP_BUFFERS_CHUNK_SIZE)
+        {
+            const size_t chunk_size = sizeof(ImFontBuildBitmapChunkFT) + BITMAP_BUFFERS_CHUNK_SIZE;
+            ImFontBuildBitmapChunkFT* chunk = (ImFontBuildBitmapChunkFT*)(data->allocator ? data->allocator->AllocFunc(chunk_size, data->allocator->UserData) : IM_ALLOC(chunk_size));
+            chunk->Next = src_tmp.BitmapChunks;
+            src_tmp.BitmapChunks = chunk;
+            src_tmp.BitmapChunkUsedBytes = 0;
+        }
+        IM_ASSERT(src_tmp.BitmapChunkUsedBytes + bitmap_size_in_bytes <= BITMAP_BUFFERS_CHUNK_SIZE); // We could probably allocate custom-sized buffer instead.
+
+        // Blit rasterized pixels to our temporary buffer and keep a pointer to it.
+        src_glyph.BitmapData = (unsigned int*)((unsigned char*)(src_tmp.BitmapChunks + 1) + src_tmp.BitmapChunkUsedBytes);
+        src_tmp.BitmapChunkUsedBytes += bitmap_size_in_bytes;
+        src_tmp.Font.BlitGlyph(ft_bitmap, src_glyph.BitmapData, src_glyph.Info.Width, multiply_enabled ? multiply_table : nullptr);
+
+        src_tmp.Rects[glyph_i].w = (stbrp_coord)(src_glyph.Info.Width + padding);
+        src_tmp.Rects[glyph_i].h = (stbrp_coord)(src_glyph.Info.Height + padding);
+        src_tmp.Surface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
+    }
+}
+
 bool ImFontAtlasBuildWithFreeTypeEx(FT_Library ft_library, ImFontAtlas* atlas, unsigned int extra_flags)
 {
     IM_ASSERT(atlas->ConfigData.Size > 0);
@@ -548,69 +633,37 @@ bool ImFontAtlasBuildWithFreeTypeEx(FT_Library ft_library, ImFontAtlas* atlas, u
     buf_rects.resize(total_glyphs_count);
     memset(buf_rects.Data, 0, (size_t)buf_rects.size_in_bytes());
 
-    // Allocate temporary rasterization data buffers.
-    // We could not find a way to retrieve accurate glyph size without rendering them.
-    // (e.g. slot->metrics->width not always matching bitmap->width, especially considering the Oblique transform)
-    // We allocate in chunks of 256 KB to not waste too much extra memory ahead. Hopefully users of FreeType won't mind the temporary allocations.
-    const int BITMAP_BUFFERS_CHUNK_SIZE = 256 * 1024;
-    int buf_bitmap_current_used_bytes = 0;
-    ImVector<unsigned char*> buf_bitmap_buffers;
-    buf_bitmap_buffers.push_back((unsigned char*)IM_ALLOC(BITMAP_BUFFERS_CHUNK_SIZE));
-
     // 4. Gather glyphs sizes so we can pack them in our virtual canvas.
     // 8. Render/rasterize font characters into the texture
-    int total_surface = 0;
+    // Into temporary buffers, by one job per source font, which run in parallel if BuildParallelForFn is set.
     int buf_rects_out_n = 0;
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
     {
         ImFontBuildSrcDataFT& src_tmp = src_tmp_array[src_i];
-        ImFontConfig& cfg = atlas->ConfigData[src_i];
         if (src_tmp.GlyphsCount == 0)
             continue;
-
         src_tmp.Rects = &buf_rects[buf_rects_out_n];
         buf_rects_out_n += src_tmp.GlyphsCount;
-
-        // Compute multiply table if requested
-        const bool multiply_enabled = (cfg.RasterizerMultiply != 1.0f);
-        unsigned char multiply_table[256];
-        if (multiply_enabled)
-            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
-
-        // Gather the sizes of all rectangles we will need to pack
-        const int padding = atlas->TexGlyphPadding;
-        for (int glyph_i = 0; glyph_i < src_tmp.GlyphsList.Size; glyph_i++)
-        {
-            ImFontBuildSrcGlyphFT& src_glyph = src_tmp.GlyphsList[glyph_i];
-
-            const FT_Glyph_Metrics* metrics = src_tmp.Font.LoadGlyph(src_glyph.Codepoint);
-            if (metrics == nullptr)
-                continue;
-
-            // Render glyph into a bitmap (currently held by FreeType)
-            const FT_Bitmap* ft_bitmap = src_tmp.Font.RenderGlyphAndGetInfo(&src_glyph.Info);
-            if (ft_bitmap == nullptr)
-                continue;
-
-            // Allocate new temporary chunk if needed
-            const int bitmap_size_in_bytes = src_glyph.Info.Width * src_glyph.Info.Height * 4;
-            if (buf_bitmap_current_used_bytes + bitmap_size_in_bytes > BITMAP_BUFFERS_CHUNK_SIZE)
-            {
-                buf_bitmap_current_used_bytes = 0;
-                buf_bitmap_buffers.push_back((unsigned char*)IM_ALLOC(BITMAP_BUFFERS_CHUNK_SIZE));
-            }
-            IM_ASSERT(buf_bitmap_current_used_bytes + bitmap_size_in_bytes <= BITMAP_BUFFERS_CHUNK_SIZE); // We could probably allocate custom-sized buffer instead.
-
-            // Blit rasterized pixels to our temporary buffer and keep a pointer to it.
-            src_glyph.BitmapData = (unsigned int*)(buf_bitmap_buffers.back() + buf_bitmap_current_used_bytes);
-            buf_bitmap_current_used_bytes += bitmap_size_in_bytes;
-            src_tmp.Font.BlitGlyph(ft_bitmap, src_glyph.BitmapData, src_glyph.Info.Width, multiply_enabled ? multiply_table : nullptr);
-
-            src_tmp.Rects[glyph_i].w = (stbrp_coord)(src_glyph.Info.Width + padding);
-            src_tmp.Rects[glyph_i].h = (stbrp_coord)(src_glyph.Info.Height + padding);
-            total_surface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
-        }
     }
+    bool parallel_raster = (atlas->BuildParallelForFn != nullptr && src_tmp_array.Size > 1);
+#ifdef IMGUI_ENABLE_FREETYPE_LUNASVG
+    if (src_load_color)
+        parallel_raster = false; // The SVG renderer hooks of the library share one state
+#endif
+    ImFontBuildJobAllocatorFT job_allocator;
+    ImGui::GetAllocatorFunctions(&job_allocator.AllocFunc, &job_allocator.FreeFunc, &job_allocator.UserData);
+    ImFontBuildRasterJobsDataFT raster_jobs_data;
+    raster_jobs_data.atlas = atlas;
+    raster_jobs_data.src_tmp_array = src_tmp_array.Data;
+    raster_jobs_data.allocator = parallel_raster ? &job_allocator : nullptr;
+    if (parallel_raster)
+        atlas->BuildParallelForFn(atlas->BuildParallelForUserData, src_tmp_array.Size, ImFontAtlasBuildRasterSourceFT, &raster_jobs_data);
+    else
+        for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+            ImFontAtlasBuildRasterSourceFT(&raster_jobs_data, src_i);
+    int total_surface = 0;
+    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+        total_surface += src_tmp_array[src_i].Surface;
 
     // We need a width for the skyline algorithm, any width!
     // The exact width doesn't really matter much, but some API/GPU have texture size limitations and increasing width can decrease height.
@@ -741,8 +794,16 @@ bool ImFontAtlasBuildWithFreeTypeEx(FT_Library ft_library, ImFontAtlas* atlas, u
     atlas->TexPixelsUseColors = tex_use_colors;
 
     // Cleanup
-    for (int buf_i = 0; buf_i < buf_bitmap_buffers.Size; buf_i++)
-        IM_FREE(buf_bitmap_buffers[buf_i]);
+    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+        for (ImFontBuildBitmapChunkFT* chunk = src_tmp_array[src_i].BitmapChunks; chunk != nullptr; )
+        {
+            ImFontBuildBitmapChunkFT* next = chunk->Next;
+            if (raster_jobs_data.allocator)
+                job_allocator.FreeFunc(chunk, job_allocator.UserData);
+            else
+                IM_FREE(chunk);
+            chunk = next;
+        }
     src_tmp_array.clear_destruct();
 
     ImFontAtlasBuildFinish(atlas);
@@ -751,33 +812,39 @@ bool ImFontAtlasBuildWithFreeTypeEx(FT_Library ft_library, ImFontAtlas* atlas, u
 }
 
 // FreeType memory allocation callbacks
-static void* FreeType_Alloc(FT_Memory /*memory*/, long size)
+// memory->user is the allocator of the rasterization jobs when they run in parallel, and the default allocator is used (ImGui::MemAlloc() is not thread-safe)
+static void* FreeType_Alloc(FT_Memory memory, long size)
 {
+    if (ImFontBuildJobAllocatorFT* job_allocator = (ImFontBuildJobAllocatorFT*)memory->user)
+        return job_allocator->AllocFunc((size_t)size, job_allocator->UserData);
     return GImGuiFreeTypeAllocFunc((size_t)size, GImGuiFreeTypeAllocatorUserData);
 }
 
-static void FreeType_Free(FT_Memory /*memory*/, void* block)
+static void FreeType_Free(FT_Memory memory, void* block)
 {
-    GImGuiFreeTypeFreeFunc(block, GImGuiFreeTypeAllocatorUserData);
+    if (ImFontBuildJobAllocatorFT* job_allocator = (ImFontBuildJobAllocatorFT*)memory->user)
+        job_allocator->FreeFunc(block, job_allocator->UserData);
+    else
+        GImGuiFreeTypeFreeFunc(block, GImGuiFreeTypeAllocatorUserData);
 }
 
-static void* FreeType_Realloc(FT_Memory /*memory*/, long cur_size, long new_size, void* block)
+static void* FreeType_Realloc(FT_Memory memory, long cur_size, long new_size, void* block)
 {
     // Implement realloc() as we don't ask user to provide it.
     if (block == nullptr)
-        return GImGuiFreeTypeAllocFunc((size_t)new_size, GImGuiFreeTypeAllocatorUserData);
+        return FreeType_Alloc(memory, new_size);
 
     if (new_size == 0)
     {
-        GImGuiFreeTypeFreeFunc(block, GImGuiFreeTypeAllocatorUserData);
+        FreeType_Free(memory, block);
         return nullptr;
     }
 
     if (new_size > cur_size)
     {
-        void* new_block = GImGuiFreeTypeAllocFunc((size_t)new_size, GImGuiFreeTypeAllocatorUserData);
+        void* new_block = FreeType_Alloc(memory, new_size);
         memcpy(new_block, block, (size_t)cur_size);
-        GImGuiFreeTypeFreeFunc(block, GImGuiFreeTypeAllocatorUserData);
+        FreeType_Free(memory, block);
         return new_block;
     }
 
@@ -788,7 +855,10 @@ static bool ImFontAtlasBuildWithFreeType(ImFontAtlas* atlas)
 {
     // FreeType memory management: https://www.freetype.org/freetype2/docs/design/design-4.html
     FT_MemoryRec_ memory_rec = {};
-    memory_rec.user = nullptr;
+    ImFontBuildJobAllocatorFT job_allocator;
+    ImGui::GetAllocatorFunctions(&job_allocator.AllocFunc, &job_allocator.FreeFunc, &job_allocator.UserData);
+    const bool default_allocator = (GImGuiFreeTypeAllocFunc == ImGuiFreeTypeDefaultAllocFunc && GImGuiFreeTypeFreeFunc == ImGuiFreeTypeDefaultFreeFunc);
+    memory_rec.user = (atlas->BuildParallelForFn != nullptr && default_allocator) ? &job_allocator : nullptr;
     memory_rec.alloc = &FreeType_Alloc;
     memory_rec.free = &FreeType_Free;
     memory_rec.realloc = &FreeType_Realloc;
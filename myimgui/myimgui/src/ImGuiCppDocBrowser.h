@@ -9,6 +9,7 @@ class ImGuiCppDocBrowser: public WindowWithEditor
 public:
     ImGuiCppDocBrowser();
     void gui();
+    SourceParse::GuiHeaderTree& guiHeaderTree() { return mGuiHeaderTree; }
 
 private:
     void guiTags();
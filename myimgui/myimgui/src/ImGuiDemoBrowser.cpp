@@ -2,6 +2,7 @@
 
 #include "imgui_utilities/HyperlinkHelper.h"
 #include "imgui_utilities/ImGuiExt.h"
+#include "imgui_utilities/FrameProfiler.h"
 #include "source_parse/ImGuiDemoParser.h"
 
 #include "hello_imgui/hello_imgui.h"
@@ -24,6 +25,7 @@ ImGuiDemoBrowser *gImGuiDemoBrowser = nullptr;
 extern HelloImGui::RunnerParams runnerParams; // defined in ImGuiManual.cpp
 void implImGuiDemoCallbackDemoCallback(const char* file, int line, const char* section, void* /*user_data*/)
 {
+    FRAME_PROFILER_SCOPE("DemoMarkerCallback");
     if (!GImGuiDemoMarker_IsActive)
         return;
     if (ImGuiDemoMarkerHighlightZone(line))
@@ -80,6 +82,9 @@ void ImGuiDemoBrowser::ImGuiDemoCallback(const char* /*file*/, int /*line_number
 
 void ImGuiDemoBrowser::gui()
 {
+    for (auto sourceElements: AllSourceElements())
+        updateTocAfterEdits(*sourceElements);
+
     guiHelp();
     guiDemoCodeTags();
     guiSave();
@@ -88,9 +93,35 @@ void ImGuiDemoBrowser::gui()
 }
 
 
+// Only the edited lines are scanned again for IMGUI_DEMO_MARKER, and the TOC nodes are patched in place
+void ImGuiDemoBrowser::updateTocAfterEdits(SourceElements& sourceElements)
+{
+    auto& editor = sourceElements.mWindowWithEditor.InnerTextEditor();
+    const auto& editorChanges = editor.GetLinesChanges();
+    if (editorChanges.empty())
+        return;
+    FRAME_PROFILER_SCOPE("updateTocAfterEdits");
+
+    std::vector<SourceParse::LinesChange> changes;
+    changes.reserve(editorChanges.size());
+    for (const auto& change: editorChanges)
+        changes.push_back({ change.mLine, change.mLinesBefore, change.mLinesAfter });
+    editor.ClearLinesChanges();
+
+    std::pmr::string lineText;
+    auto getLine = [&editor, &lineText](int lineNumber) {
+        editor.GetLineText(lineNumber, lineText);
+        return std::string(lineText);
+    };
+    auto& linesWithTags = sourceElements.AnnotatedSource.linesWithTags;
+    SourceParse::UpdateImGuiDemoCodeLines(linesWithTags, changes, editor.GetTotalLines(), getLine);
+    sourceElements.mGuiHeaderTree.updateLinesWithTags(linesWithTags);
+}
+
+
 void ImGuiDemoBrowser::guiHelp()
 {
-    std::string help =
+    const char* help =
         "This is the code of imgui_demo.cpp. It is the best way to learn about Dear ImGui! \n"
         "\n"
         "* On the left, you can see a demo that showcases all the widgets and features of ImGui:\n"
@@ -102,7 +133,7 @@ void ImGuiDemoBrowser::guiHelp()
         ;
     ImGui::TextColored(ImVec4(0.9f, 0.9f, 0.f, 1.0f), "(?)");
     if (ImGui::IsItemHovered())
-        ImGui::SetTooltip("%s", help.c_str());
+        ImGui::SetTooltip("%s", help);
     ImGui::SameLine(50.f);
 }
 
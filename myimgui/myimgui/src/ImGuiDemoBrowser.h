@@ -1,4 +1,5 @@
 #pragma once
+#include <array>
 #include <memory>
 
 #include "WindowWithEditor.h"
@@ -17,6 +18,9 @@ public:
     void gui();
     void ImGuiDemoCallback(const char* file, int line_number, const char* demo_title);
 
+    SourceParse::GuiHeaderTree& guiHeaderTree() { return CurrentSourceElements().mGuiHeaderTree; }
+    WindowWithEditor& windowWithEditor() { return CurrentSourceElements().mWindowWithEditor; }
+
 private:
     void guiHelp();
     void guiSave();
@@ -32,7 +36,9 @@ private:
         SourceElements(const SourceParse::AnnotatedSource& as, const std::string& editorLabel)
             : AnnotatedSource(as), mGuiHeaderTree(as.linesWithTags), mWindowWithEditor(editorLabel)
         {
-            mWindowWithEditor.InnerTextEditor().SetText(as.source.sourceCode);
+            mWindowWithEditor.setEditorSource(as.source);
+            // The demo code may be edited: its table of content follows the edits (see updateTocAfterEdits)
+            mWindowWithEditor.InnerTextEditor().SetTrackLinesChanges(true);
         }
     };
 
@@ -41,7 +47,9 @@ private:
         return mViewPythonOrCpp == ViewPythonOrCpp::Cpp ? mSourceElementsCpp : mSourceElementsPython;
     }
 
-    std::vector<SourceElements *> AllSourceElements(){ return {&mSourceElementsCpp, &mSourceElementsPython}; }
+    std::array<SourceElements *, 2> AllSourceElements(){ return {&mSourceElementsCpp, &mSourceElementsPython}; }
+
+    void updateTocAfterEdits(SourceElements& sourceElements);
 
     SourceElements mSourceElementsCpp;
     SourceElements mSourceElementsPython;
@@ -9,6 +9,7 @@ class ImGuiHeaderDocBrowser: public WindowWithEditor
 public:
     ImGuiHeaderDocBrowser();
     void gui();
+    SourceParse::GuiHeaderTree& guiHeaderTree() { return mGuiHeaderTree; }
 private:
     void guiTags();
     void guiGithubButton();
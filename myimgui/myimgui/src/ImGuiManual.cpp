@@ -1,29 +1,15 @@
-#include "AboutWindow.h"
-#include "Acknowledgments.h"
-#include "ImGuiCodeBrowser.h"
-#include "ImGuiCppDocBrowser.h"
-#include "ImGuiHeaderDocBrowser.h"
-#include "ImGuiDemoBrowser.h"
-#include "ImGuiReadmeBrowser.h"
+#include "ImGuiManual.h"
+#include "SourceCache.h"
 #include "imgui_utilities/HyperlinkHelper.h"
-
-
-#include "hello_imgui/hello_imgui.h"
-#include "JsClipboardTricks.h"
+#include "imgui_utilities/FrameProfiler.h"
+#include "imgui_utilities/AllocationTracker.h"
+#include "imgui_utilities/FrameArena.h"
+#include "imgui_internal.h"
 
 HelloImGui::RunnerParams runnerParams;
 
-int main(int, char **)
+ImGuiManual::ImGuiManual()
 {
-    // Our gui providers for the different windows
-    ImGuiDemoBrowser imGuiDemoBrowser;
-    ImGuiCppDocBrowser imGuiCppDocBrowser;
-    ImGuiHeaderDocBrowser imGuiHeaderDocBrowser;
-    ImGuiCodeBrowser imGuiCodeBrowser;
-    ImGuiReadmeBrowser imGuiReadmeBrowser;
-    Acknowledgments acknowledgments;
-    AboutWindow aboutWindow;
-
     //
     // Below, we will define all our application parameters and callbacks
     // before starting it.
@@ -40,6 +26,20 @@ int main(int, char **)
     runnerParams.imGuiWindowParams.showMenuBar = true;
     runnerParams.imGuiWindowParams.showStatusBar = true;
 
+    // Reading the manual mostly shows still frames: do not render them again
+    runnerParams.fpsIdling.skipIdenticalFrames = true;
+    // When idle, wait for user events instead of refreshing at fpsIdle (the demo window requests its own redraws)
+    runnerParams.fpsIdling.eventDrivenIdling = true;
+    // Restore the font atlas from disk instead of rasterizing the fonts at each startup
+    runnerParams.useFontAtlasCache = true;
+    // Decode the png sources of the libraries browser on a worker thread (where threads are available), and keep at most 64MB of them
+#if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+    runnerParams.imageFromAssetParams.asyncDecode = true;
+#endif
+    runnerParams.imageFromAssetParams.cacheBudgetBytes = 64 * 1024 * 1024;
+    // Save the layout of the many dockable windows incrementally, a few seconds after each change
+    runnerParams.useBinarySettingsStore = true;
+
     // Split the screen in two parts (two "DockSpaces")
     // This will split the preexisting default dockspace "MainDockSpace"
     // in two parts:
@@ -57,9 +57,19 @@ int main(int, char **)
         {
             dock_imguiDemoWindow.label = "Dear ImGui Demo";
             dock_imguiDemoWindow.dockSpaceName = "MainDockSpace";// This window goes into "MainDockSpace"
-            dock_imguiDemoWindow.GuiFunction = [&dock_imguiDemoWindow] {
-                if (dock_imguiDemoWindow.isVisible)
-                    ImGui::ShowDemoWindow(nullptr);
+            // (with callBeginEnd=false, GuiFunction is only called when the window is visible)
+            dock_imguiDemoWindow.GuiFunction = [] {
+                ImGui::ShowDemoWindow(nullptr);
+                // The demo is animated (plots, progress bars, ...): with event driven idling,
+                // keep refreshing it at fpsIdle while it is shown (i.e. not collapsed or in a hidden tab)
+                const auto& fpsIdling = runnerParams.fpsIdling;
+                if (fpsIdling.enableIdling && fpsIdling.eventDrivenIdling && fpsIdling.fpsIdle > 0.f)
+                {
+                    ImGuiWindow* demoWindow = ImGui::FindWindowByName("Dear ImGui Demo");
+                    bool isDemoShown = (demoWindow != nullptr) && demoWindow->Active && !demoWindow->SkipItems;
+                    if (isDemoShown)
+                        HelloImGui::RequestRedrawIn(1.0 / (double)fpsIdling.fpsIdle);
+                }
             };
             dock_imguiDemoWindow.callBeginEnd = false;
         };
@@ -69,7 +79,7 @@ int main(int, char **)
             dock_imguiDemoCode.label = "Demo Code";
             dock_imguiDemoCode.dockSpaceName = "CodeSpace";// This window goes into "CodeSpace"
             dock_imguiDemoCode.isVisible = true;
-            dock_imguiDemoCode.GuiFunction = [&imGuiDemoBrowser] { imGuiDemoBrowser.gui(); };
+            dock_imguiDemoCode.GuiFunction = [this] { imGuiDemoBrowser.gui(); };
             dock_imguiDemoCode.imGuiWindowFlags = ImGuiWindowFlags_HorizontalScrollbar;
         };
 
@@ -78,7 +88,7 @@ int main(int, char **)
             dock_imGuiCppDocBrowser.label = imGuiCppDocBrowser.windowLabel();
             dock_imGuiCppDocBrowser.dockSpaceName = "CodeSpace";
             dock_imGuiCppDocBrowser.isVisible = false;
-            dock_imGuiCppDocBrowser.GuiFunction = [&imGuiCppDocBrowser] { imGuiCppDocBrowser.gui(); };
+            dock_imGuiCppDocBrowser.GuiFunction = [this] { imGuiCppDocBrowser.gui(); };
         };
 
         HelloImGui::DockableWindow dock_imGuiHeaderDocBrowser;
@@ -86,7 +96,7 @@ int main(int, char **)
             dock_imGuiHeaderDocBrowser.label = imGuiHeaderDocBrowser.windowLabel();
             dock_imGuiHeaderDocBrowser.dockSpaceName = "CodeSpace";
             dock_imGuiHeaderDocBrowser.isVisible = true;
-            dock_imGuiHeaderDocBrowser.GuiFunction = [&imGuiHeaderDocBrowser] { imGuiHeaderDocBrowser.gui(); };
+            dock_imGuiHeaderDocBrowser.GuiFunction = [this] { imGuiHeaderDocBrowser.gui(); };
         };
 
         HelloImGui::DockableWindow dock_imguiReadme;
@@ -94,7 +104,7 @@ int main(int, char **)
             dock_imguiReadme.label = "ImGui - Readme";
             dock_imguiReadme.dockSpaceName = "CodeSpace";
             dock_imguiReadme.isVisible = false;
-            dock_imguiReadme.GuiFunction = [&imGuiReadmeBrowser] { imGuiReadmeBrowser.gui(); };
+            dock_imguiReadme.GuiFunction = [this] { imGuiReadmeBrowser.gui(); };
         };
 
         HelloImGui::DockableWindow dock_imguiCodeBrowser;
@@ -102,7 +112,7 @@ int main(int, char **)
             dock_imguiCodeBrowser.label = "ImGui - Code";
             dock_imguiCodeBrowser.dockSpaceName = "CodeSpace";
             dock_imguiCodeBrowser.isVisible = false;
-            dock_imguiCodeBrowser.GuiFunction = [&imGuiCodeBrowser] { imGuiCodeBrowser.gui(); };
+            dock_imguiCodeBrowser.GuiFunction = [this] { imGuiCodeBrowser.gui(); };
         };
 
         HelloImGui::DockableWindow dock_acknowledgments;
@@ -111,7 +121,7 @@ int main(int, char **)
             dock_acknowledgments.dockSpaceName = "CodeSpace";
             dock_acknowledgments.isVisible = false;
             dock_acknowledgments.includeInViewMenu = false;
-            dock_acknowledgments.GuiFunction = [&acknowledgments] { acknowledgments.gui(); };
+            dock_acknowledgments.GuiFunction = [this] { acknowledgments.gui(); };
         };
 
         HelloImGui::DockableWindow dock_about;
@@ -120,7 +130,16 @@ int main(int, char **)
             dock_about.dockSpaceName = "CodeSpace";
             dock_about.isVisible = false;
             dock_about.includeInViewMenu = false;
-            dock_about.GuiFunction = [&aboutWindow] { aboutWindow.gui(); };
+            dock_about.GuiFunction = [this] { aboutWindow.gui(); };
+        };
+
+        HelloImGui::DockableWindow dock_sourceCacheDebug;
+        {
+            dock_sourceCacheDebug.label = "Debug - Source cache";
+            dock_sourceCacheDebug.dockSpaceName = "MainDockSpace";
+            dock_sourceCacheDebug.isVisible = false;
+            dock_sourceCacheDebug.includeInViewMenu = false;
+            dock_sourceCacheDebug.GuiFunction = [] { guiSourceCachesDebugPanel(); };
         };
 
         //
@@ -134,17 +153,38 @@ int main(int, char **)
             // dock_imguiReadme,
             dock_imguiCodeBrowser,
             dock_acknowledgments,
-            dock_about};
+            dock_about,
+            dock_sourceCacheDebug};
+
+        // Instrument the windows, so that their timings are shown in the profiler overlay
+        for (auto& dockableWindow: runnerParams.dockingParams.dockableWindows)
+            dockableWindow.GuiFunction = FrameProfiler::InstrumentFunction(dockableWindow.label, dockableWindow.GuiFunction);
     }
 
+    // Profiler overlay (toggled from the "Debug" menu), with optional allocation tracking
+    static bool showProfilerOverlay = false;
+    AllocationTracker::InstallImGuiAllocator();
+    runnerParams.callbacks.PreNewFrame = [] {
+        FrameArena::Reset();
+        FrameProfiler::BeginFrame();
+        AllocationTracker::BeginFrame();
+    };
+    runnerParams.callbacks.ShowGui = [] {
+        if (showProfilerOverlay)
+        {
+            FrameProfiler::ShowOverlay(&showProfilerOverlay);
+            FrameProfiler::SetEnabled(showProfilerOverlay);
+        }
+    };
+
     // Set the app menu
     runnerParams.callbacks.ShowMenus = []{
-        HelloImGui::DockableWindow *aboutWindow =
-            runnerParams.dockingParams.dockableWindowOfName("About this manual");
-          HelloImGui::DockableWindow *acknowledgmentWindow =
-              runnerParams.dockingParams.dockableWindowOfName("Acknowledgments");
         if (ImGui::BeginMenu("Links & About"))
         {
+            HelloImGui::DockableWindow *aboutWindow =
+                runnerParams.dockingParams.dockableWindowOfName("About this manual");
+            HelloImGui::DockableWindow *acknowledgmentWindow =
+                runnerParams.dockingParams.dockableWindowOfName("Acknowledgments");
             ImGui::TextDisabled("Links");
             if (ImGui::MenuItem("ImGui Github repository"))
                 HyperlinkHelper::OpenUrl("https://github.com/ocornut/imgui");
@@ -165,6 +205,15 @@ int main(int, char **)
                 acknowledgmentWindow->isVisible = true;
             ImGui::EndMenu();
         }
+        if (ImGui::BeginMenu("Debug"))
+        {
+            HelloImGui::DockableWindow *sourceCacheWindow =
+                runnerParams.dockingParams.dockableWindowOfName("Debug - Source cache");
+            ImGui::MenuItem("Source cache", nullptr, &sourceCacheWindow->isVisible);
+            if (ImGui::MenuItem("Profiler overlay", nullptr, &showProfilerOverlay))
+                FrameProfiler::SetEnabled(showProfilerOverlay);
+            ImGui::EndMenu();
+        }
     };
 
     // Add some widgets in the status bar
@@ -178,14 +227,9 @@ int main(int, char **)
       HelloImGui::ImGuiDefaultSettings::LoadDefaultFont_WithFontAwesomeIcons();
       LoadMonospaceFont();
       MarkdownHelper::LoadFonts();
+      // The manual measures the same labels at each frame (hit rate shown in Metrics/Debugger > Fonts)
+      ImGui::GetIO().Fonts->TextSizeCacheCapacity = 4096; // 160 KB
     };
 
     runnerParams.dockingParams.focusDockableWindow("Demo Code");
-
-#ifdef IMGUIMANUAL_CLIPBOARD_IMPORT_FROM_BROWSER
-    JsClipboard_AddJsHook();
-#endif
-
-    HelloImGui::Run(runnerParams);
-    return 0;
 }
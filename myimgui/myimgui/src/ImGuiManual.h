@@ -0,0 +1,30 @@
+#pragma once
+#include "AboutWindow.h"
+#include "Acknowledgments.h"
+#include "ImGuiCodeBrowser.h"
+#include "ImGuiCppDocBrowser.h"
+#include "ImGuiHeaderDocBrowser.h"
+#include "ImGuiDemoBrowser.h"
+#include "ImGuiReadmeBrowser.h"
+
+#include "hello_imgui/hello_imgui.h"
+
+extern HelloImGui::RunnerParams runnerParams; // defined in ImGuiManual.cpp
+
+// The manual's gui providers for the different windows.
+// Its constructor fills runnerParams (windows, menus, fonts, callbacks);
+// the app (ImGuiManual.main.cpp) and the headless benchmark (imgui_manual_bench)
+// then only have to call HelloImGui::Run(runnerParams).
+class ImGuiManual
+{
+public:
+    ImGuiManual();
+
+    ImGuiDemoBrowser imGuiDemoBrowser;
+    ImGuiCppDocBrowser imGuiCppDocBrowser;
+    ImGuiHeaderDocBrowser imGuiHeaderDocBrowser;
+    ImGuiCodeBrowser imGuiCodeBrowser;
+    ImGuiReadmeBrowser imGuiReadmeBrowser;
+    Acknowledgments acknowledgments;
+    AboutWindow aboutWindow;
+};
@@ -0,0 +1,15 @@
+#include "ImGuiManual.h"
+#include "JsClipboardTricks.h"
+
+int main(int, char **)
+{
+    // The manual's windows; runnerParams is filled by ImGuiManual's constructor
+    ImGuiManual imGuiManual;
+
+#ifdef IMGUIMANUAL_CLIPBOARD_IMPORT_FROM_BROWSER
+    JsClipboard_AddJsHook();
+#endif
+
+    HelloImGui::Run(runnerParams);
+    return 0;
+}
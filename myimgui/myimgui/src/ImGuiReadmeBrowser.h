@@ -9,7 +9,7 @@ public:
     ImGuiReadmeBrowser() : mSource(SourceParse::ReadSource("imgui/README.md")) {}
     inline void gui()
     {
-        MarkdownHelper::Markdown(mSource.sourceCode);
+        MarkdownHelper::Markdown(*mSource.sourceCode);
     }
 private:
     SourceParse::SourceFile mSource;
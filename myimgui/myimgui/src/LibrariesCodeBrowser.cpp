@@ -1,38 +1,51 @@
 #include "LibrariesCodeBrowser.h"
 #include "imgui_utilities/MarkdownHelper.h"
 #include "imgui_utilities/ImGuiExt.h"
+#include "imgui_utilities/FrameArena.h"
 #include "hello_imgui/hello_imgui.h"
 #include <fplus/fplus.hpp>
 
-namespace
-{
-    std::string MarkdownLinkString(const std::string &url)
-    {
-        return std::string("[") + url + "]" + "(" + url + ")";
-    }
-}
-
-
 LibrariesCodeBrowser::LibrariesCodeBrowser(
     const std::string & windowName,
     const std::vector<SourceParse::Library> &librarySources,
     std::string currentSourcePath)
         : WindowWithEditor(windowName)
         , mLibraries(librarySources)
+        , mSourceCache(windowName)
 {
     if (!currentSourcePath.empty())
+    {
         mCurrentSource = SourceParse::ReadSource(currentSourcePath);
-    mEditor.SetText(mCurrentSource.sourceCode);
+        setEditorSource(mCurrentSource);
+    }
+}
+
+void LibrariesCodeBrowser::openSource(const SourceParse::SourcePath& sourcePath)
+{
+    // Stash the current file (with its colorized text), and reuse the new one if it was recently opened
+    if (!mCurrentSource.sourcePath.empty())
+        mSourceCache.store({std::move(mCurrentSource), mEditor.TakeTextSnapshot()});
+
+    auto cachedEntry = mSourceCache.take(sourcePath);
+    if (cachedEntry.has_value())
+    {
+        mCurrentSource = std::move(cachedEntry->sourceFile);
+        mEditor.RestoreTextSnapshot(std::move(cachedEntry->editorText));
+    }
+    else
+    {
+        mCurrentSource = SourceParse::ReadSource(sourcePath);
+        setEditorSource(mCurrentSource);
+    }
 }
 
 void LibrariesCodeBrowser::gui()
 {
-    if (guiSelectLibrarySource())
-        mEditor.SetText(mCurrentSource.sourceCode);
+    guiSelectLibrarySource();
 
-    std::string sourcePath = mCurrentSource.sourcePath;
+    const std::string& sourcePath = mCurrentSource.sourcePath;
     if (fplus::is_suffix_of(std::string(".md"), sourcePath))
-        MarkdownHelper::Markdown(mCurrentSource.sourceCode);
+        MarkdownHelper::Markdown(*mCurrentSource.sourceCode);
     else if (fplus::is_suffix_of(std::string(".png"), sourcePath))
     {
         HelloImGui::ImageFromAsset(sourcePath.c_str(), ImVec2(ImGui::GetWindowSize().x - 30.f, 0.f));
@@ -48,18 +61,18 @@ bool LibrariesCodeBrowser::guiSelectLibrarySource()
     {
         ImGui::Text("%s", librarySource.name.c_str());
         ImGui::SameLine(150.f);
-        MarkdownHelper::Markdown(MarkdownLinkString(librarySource.url));
+        MarkdownHelper::Markdown(FrameArena::Format("[%s](%s)", librarySource.url.c_str(), librarySource.url.c_str()));
         MarkdownHelper::Markdown(librarySource.shortDoc);
         for (const auto & source: librarySource.sourcePaths)
         {
-            std::string currentSourcePath = librarySource.path + "/" + source;
-            bool isSelected = (currentSourcePath == mCurrentSource.sourcePath);
-            std::string buttonLabel = source + "##" + librarySource.path;
+            FrameArena::String currentSourcePath = FrameArena::Format("%s/%s", librarySource.path.c_str(), source.c_str());
+            bool isSelected = (std::string_view(currentSourcePath) == mCurrentSource.sourcePath);
+            FrameArena::String buttonLabel = FrameArena::Format("%s##%s", source.c_str(), librarySource.path.c_str());
             if (isSelected)
                 ImGui::TextDisabled("%s", source.c_str());
             else if (ImGui::Button(buttonLabel.c_str()))
             {
-                mCurrentSource = SourceParse::ReadSource(currentSourcePath);
+                openSource(std::string(currentSourcePath));
                 changed = true;
             }
             ImGuiExt::SameLine_IfPossible(150.f);
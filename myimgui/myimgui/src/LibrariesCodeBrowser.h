@@ -1,5 +1,6 @@
 #pragma once
 #include "source_parse/Sources.h"
+#include "SourceCache.h"
 #include "WindowWithEditor.h"
 #include "hello_imgui/hello_imgui.h"
 #include <unordered_map>
@@ -16,7 +17,9 @@ public:
     void gui();
 private:
     bool guiSelectLibrarySource();
+    void openSource(const SourceParse::SourcePath& sourcePath);
 
     std::vector<SourceParse::Library> mLibraries;
     SourceParse::SourceFile mCurrentSource;
+    SourceCache mSourceCache;
 };
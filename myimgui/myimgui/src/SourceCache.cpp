@@ -0,0 +1,123 @@
+#include "SourceCache.h"
+#include "imgui.h"
+#include <algorithm>
+
+std::vector<SourceCache *> gAllSourceCaches;
+
+namespace
+{
+    // (the texts shared with other readers are counted as if they were owned by the entry)
+    size_t EntryMemorySize(const SourceCache::Entry& entry)
+    {
+        const auto& sourceCode = entry.sourceFile.sourceCode;
+        return entry.sourceFile.sourcePath.capacity()
+               + (sourceCode ? sourceCode->capacity() : 0)
+               + entry.editorText.MemorySize();
+    }
+}
+
+SourceCache::SourceCache(const std::string& label, size_t maxBytes)
+    : mLabel(label)
+    , mMaxBytes(maxBytes)
+{
+    gAllSourceCaches.push_back(this);
+}
+
+SourceCache::~SourceCache()
+{
+    gAllSourceCaches.erase(
+        std::remove(gAllSourceCaches.begin(), gAllSourceCaches.end(), this),
+        gAllSourceCaches.end());
+}
+
+std::optional<SourceCache::Entry> SourceCache::take(const SourceParse::SourcePath& sourcePath)
+{
+    auto it = mEntriesByPath.find(sourcePath);
+    if (it == mEntriesByPath.end())
+    {
+        ++mNbMisses;
+        return std::nullopt;
+    }
+    ++mNbHits;
+    auto listIt = it->second;
+    Entry r = std::move(listIt->entry);
+    mCurrentBytes -= listIt->bytes;
+    mLruList.erase(listIt);
+    mEntriesByPath.erase(it);
+    return r;
+}
+
+void SourceCache::store(Entry&& entry)
+{
+    const auto sourcePath = entry.sourceFile.sourcePath;
+    auto existing = mEntriesByPath.find(sourcePath);
+    if (existing != mEntriesByPath.end())
+    {
+        mCurrentBytes -= existing->second->bytes;
+        mLruList.erase(existing->second);
+        mEntriesByPath.erase(existing);
+    }
+
+    size_t bytes = EntryMemorySize(entry);
+    if (bytes > mMaxBytes)
+    {
+        // It would evict all the others, and then itself
+        ++mNbEvictions;
+        return;
+    }
+    mLruList.push_front({std::move(entry), bytes});
+    mEntriesByPath[sourcePath] = mLruList.begin();
+    mCurrentBytes += bytes;
+    evictIfNeeded();
+}
+
+void SourceCache::setMaxBytes(size_t maxBytes)
+{
+    mMaxBytes = maxBytes;
+    evictIfNeeded();
+}
+
+void SourceCache::evictIfNeeded()
+{
+    while (mCurrentBytes > mMaxBytes && !mLruList.empty())
+    {
+        auto& oldest = mLruList.back();
+        mCurrentBytes -= oldest.bytes;
+        mEntriesByPath.erase(oldest.entry.sourceFile.sourcePath);
+        mLruList.pop_back();
+        ++mNbEvictions;
+    }
+}
+
+void SourceCache::guiDebugPanel()
+{
+    ImGui::PushID(this);
+    if (ImGui::TreeNode(mLabel.c_str()))
+    {
+        size_t nbRequests = mNbHits + mNbMisses;
+        float hitRate = nbRequests > 0 ? (float)mNbHits / (float)nbRequests : 0.f;
+        ImGui::Text("Hits: %zu  Misses: %zu  (hit rate %.0f%%)", mNbHits, mNbMisses, hitRate * 100.f);
+        ImGui::Text("Evictions: %zu", mNbEvictions);
+        ImGui::Text("Memory: %.2f / %.2f MB", (float)mCurrentBytes / (1024.f * 1024.f), (float)mMaxBytes / (1024.f * 1024.f));
+
+        int maxMB = (int)(mMaxBytes / (1024 * 1024));
+        ImGui::SetNextItemWidth(150.f);
+        if (ImGui::SliderInt("Memory cap (MB)", &maxMB, 0, 256))
+            setMaxBytes((size_t)maxMB * 1024 * 1024);
+
+        for (const auto& cachedEntry: mLruList)
+            ImGui::BulletText("%s (%.2f MB)", cachedEntry.entry.sourceFile.sourcePath.c_str(), (float)cachedEntry.bytes / (1024.f * 1024.f));
+        ImGui::TreePop();
+    }
+    ImGui::PopID();
+}
+
+void guiSourceCachesDebugPanel()
+{
+    auto sourceStoreStats = SourceParse::GetSourceStoreStats();
+    ImGui::Text("Source files in memory: %zu (%.2f MB, shared by their readers)",
+                sourceStoreStats.nbFiles, (float)sourceStoreStats.nbBytes / (1024.f * 1024.f));
+    ImGui::TextDisabled("Files recently opened in the code browsers (most recent first)");
+    for (auto sourceCache: gAllSourceCaches)
+        sourceCache->guiDebugPanel();
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include "source_parse/Sources.h"
+#include "TextEditor.h"
+#include <list>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+
+// A bounded LRU cache of the source files opened by a LibrariesCodeBrowser.
+// It keeps both the source text and the colorized editor text, so that switching back
+// to a recently viewed file neither re-reads it nor re-colorizes it.
+class SourceCache
+{
+public:
+    struct Entry
+    {
+        SourceParse::SourceFile sourceFile;
+        TextEditor::TextSnapshot editorText;
+    };
+
+    SourceCache(const std::string& label, size_t maxBytes = 64 * 1024 * 1024);
+    ~SourceCache();
+
+    // Returns (and removes) the entry for this path, if present: its content is now owned by the caller
+    std::optional<Entry> take(const SourceParse::SourcePath& sourcePath);
+    // Stores an entry as the most recently used one, evicting the oldest ones if over budget
+    // (an entry larger than the budget is dropped, and counted as evicted)
+    void store(Entry&& entry);
+
+    void setMaxBytes(size_t maxBytes);
+    size_t maxBytes() const { return mMaxBytes; }
+    size_t currentBytes() const { return mCurrentBytes; }
+
+    size_t nbHits() const { return mNbHits; }
+    size_t nbMisses() const { return mNbMisses; }
+    size_t nbEvictions() const { return mNbEvictions; }
+
+    void guiDebugPanel();
+
+private:
+    struct CachedEntry
+    {
+        Entry entry;
+        size_t bytes;
+    };
+    using LruList = std::list<CachedEntry>;
+
+    void evictIfNeeded();
+
+    std::string mLabel;
+    size_t mMaxBytes;
+    size_t mCurrentBytes = 0;
+    LruList mLruList; // most recently used first
+    std::unordered_map<SourceParse::SourcePath, LruList::iterator> mEntriesByPath;
+
+    size_t mNbHits = 0, mNbMisses = 0, mNbEvictions = 0;
+};
+
+// Shows the stats of all the source caches
+void guiSourceCachesDebugPanel();
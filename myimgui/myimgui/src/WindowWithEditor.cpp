@@ -1,8 +1,13 @@
 #include "imgui_utilities/ImGuiExt.h"
+#include "imgui_utilities/FrameProfiler.h"
+#include "imgui_utilities/FrameArena.h"
 #include "hello_imgui/hello_imgui.h"
 #include "hello_imgui/icons_font_awesome_4.h"
 #include <fplus/fplus.hpp>
-#include <map>
+#include <algorithm>
+#include <array>
+#include <string_view>
+#include <unordered_map>
 #include "WindowWithEditor.h"
 #include "JsClipboardTricks.h"
 
@@ -11,6 +16,9 @@ std::vector<WindowWithEditor *> gAllWindowWithEditors;
 
 ImFont * gMonospaceFont = nullptr;
 
+// The colorized texts shown by the read-only editors, by language and path (see TextEditor::SetSharedLines)
+std::unordered_map<std::string, std::weak_ptr<TextEditor::Lines>> gSharedEditorLines;
+
 void LoadMonospaceFont()
 {
     float fontSize = 14.f;
@@ -25,32 +33,67 @@ WindowWithEditor::WindowWithEditor(const std::string& windowLabel)
     mEditor.SetPalette(TextEditor::GetLightPalette());
     mEditor.SetLanguageDefinition(TextEditor::LanguageDefinition::CPlusPlus());
     mEditor.SetReadOnly(true);
+    mEditor.SetMonospaceMode(true); // the code is rendered with gMonospaceFont
+    mEditor.SetUndoMemoryBudget(4 * 1024 * 1024); // long editing sessions of imgui_demo.cpp, within the emscripten heap
     gAllEditors.push_back(&mEditor);
     gAllWindowWithEditors.push_back(this);
 }
 
+void WindowWithEditor::setEditorSource(const SourceParse::SourceFile &sourceFile)
+{
+    if (!mEditor.IsReadOnly())
+    {
+        mEditor.SetText(*sourceFile.sourceCode);
+        return;
+    }
+
+    auto& sharedLines = gSharedEditorLines[mEditor.GetLanguageDefinition().mName + "|" + sourceFile.sourcePath];
+    if (auto lines = sharedLines.lock())
+    {
+        // Take over the colorizer progress of an editor which shows this text, so that it is not colorized again
+        auto itOwner = std::find_if(gAllEditors.begin(), gAllEditors.end(), [&lines](const TextEditor* editor) {
+            return editor->GetSharedLines() == lines;
+        });
+        if (itOwner != gAllEditors.end())
+            mEditor.SetSharedLines(**itOwner);
+        else
+            mEditor.SetSharedLines(lines); // e.g. the text is only held by a SourceCache snapshot
+    }
+    else
+    {
+        mEditor.SetText(*sourceFile.sourceCode);
+        sharedLines = mEditor.GetSharedLines();
+    }
+}
+
 void WindowWithEditor::setEditorAnnotatedSource(const SourceParse::AnnotatedSource &annotatedSource)
 {
-    mEditor.SetText(annotatedSource.source.sourceCode);
+    setEditorSource(annotatedSource.source);
     std::unordered_set<int> lineNumbers;
     for (auto line : annotatedSource.linesWithTags)
         lineNumbers.insert(line.lineNumber + 1);
     mEditor.SetBreakpoints(lineNumbers);
 }
 
-void RenderLongLinesOverlay(const std::string& currentCodeLine)
+std::string_view TrimWhitespace(std::string_view s)
 {
-    using namespace std::literals;
+    const char *whitespaces = " \t\r\n";
+    size_t first = s.find_first_not_of(whitespaces);
+    if (first == std::string_view::npos)
+        return {};
+    size_t last = s.find_last_not_of(whitespaces);
+    return s.substr(first, last - first + 1);
+}
 
-    std::string code, comment;
+void RenderLongLinesOverlay(std::string_view currentCodeLine)
+{
+    std::string_view code = currentCodeLine, comment;
     {
-        auto commentPosition = fplus::find_first_instance_of_token("//"s, currentCodeLine);
-        if (commentPosition.is_nothing())
-            code = currentCodeLine;
-        else
+        size_t commentPosition = currentCodeLine.find("//");
+        if (commentPosition != std::string_view::npos)
         {
-            code = fplus::trim_whitespace(fplus::take(commentPosition.unsafe_get_just(), currentCodeLine));
-            comment = fplus::drop(commentPosition.unsafe_get_just() + 2, currentCodeLine);
+            code = TrimWhitespace(currentCodeLine.substr(0, commentPosition));
+            comment = currentCodeLine.substr(commentPosition + 2);
         }
     }
 
@@ -76,13 +119,13 @@ void RenderLongLinesOverlay(const std::string& currentCodeLine)
         if (!code.empty())
         {
             ImGui::PushFont(gMonospaceFont);
-            ImGui::TextWrapped("%s", code.c_str());
+            ImGui::TextWrapped("%.*s", (int)code.size(), code.data());
             ImGui::PopFont();
         }
         if (!comment.empty())
         {
             ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.6f, 1.f, 0.6f, 1.f));
-            ImGui::TextWrapped("%s", comment.c_str());
+            ImGui::TextWrapped("%.*s", (int)comment.size(), comment.data());
             ImGui::PopStyleColor();
         }
         ImGui::End();
@@ -123,16 +166,21 @@ void WindowWithEditor::RenderEditor(const std::string &filename, VoidFunction ad
     guiStatusLine(filename);
 
     ImGui::PushFont(gMonospaceFont);
-    mEditor.Render(filename.c_str());
+    {
+        FRAME_PROFILER_SCOPE("TextEditor::Render");
+        mEditor.Render(filename.c_str());
+    }
 
+    FrameArena::String currentLineText = FrameArena::MakeString();
+    mEditor.GetLineText(mEditor.GetCursorPosition().mLine, currentLineText);
     bool lineTooLong = false;
     {
         float editorWidth = ImGui::GetItemRectSize().x;
-        float textWidth = ImGui::CalcTextSize(mEditor.GetCurrentLineText().c_str()).x + ImGui::GetFontSize() * 4.f;
+        float textWidth = ImGui::CalcTextSize(currentLineText.c_str()).x + ImGui::GetFontSize() * 4.f;
         lineTooLong = textWidth > editorWidth;
     }
     if (mShowLongLinesOverlay && lineTooLong)
-        RenderLongLinesOverlay(mEditor.GetCurrentLineText());
+        RenderLongLinesOverlay(currentLineText);
 
 #ifdef __EMSCRIPTEN__
     handleJsClipboardShortcuts();
@@ -144,27 +192,29 @@ void WindowWithEditor::RenderEditor(const std::string &filename, VoidFunction ad
 
 void WindowWithEditor::editorContextMenu()
 {
-    if (mEditor.GetSelectedText().empty())
+    if (!mEditor.HasSelection())
         return;
     if (ImGui::BeginPopupContextItem("item context menu"))
     {
-        std::map<std::string, std::string> fileAndEditorWindowName
-            {
+        static const std::array<std::pair<const char *, const char *>, 2> fileAndEditorWindowName
+            {{
                 {"imgui.h", "imgui.h - Doc"},
                 // {"imgui.cpp", "imgui.cpp - Doc"},
                 {"imgui_demo.cpp", "ImGui - Demo Code"}
-            };
+            }};
 
-        std::string selectionShort = mEditor.GetSelectedText();
-        if (selectionShort.size() > 30)
-            selectionShort = fplus::take(30, selectionShort) + "...";
+        FrameArena::String selection = FrameArena::MakeString();
+        mEditor.GetSelectedText(selection);
+        const char *ellipsis = selection.size() > 30 ? "..." : "";
+        int selectionShortLength = (int)std::min(selection.size(), (size_t)30);
 
         for (const auto& kv: fileAndEditorWindowName)
         {
-            std::string label = "Search for \"" + selectionShort + "\" in " + kv.first;
+            FrameArena::String label = FrameArena::Format(
+                "Search for \"%.*s%s\" in %s", selectionShortLength, selection.c_str(), ellipsis, kv.first);
             if (ImGui::Selectable(label.c_str()))
                 WindowWithEditor::searchForFirstOccurenceAndFocusWindow(
-                    mEditor.GetSelectedText(), kv.second);
+                    std::string(selection), kv.second);
         }
         ImGui::EndPopup();
     }
@@ -195,35 +245,33 @@ void WindowWithEditor::guiFind()
         ImGui::SameLine();
     }
     // If changed, check number of matches
+    FrameArena::String lineText = FrameArena::MakeString(); // scratch buffer, reused for each line
+    auto lineMatches = [this, &lineText](int lineNumber) {
+        mEditor.GetLineText(lineNumber, lineText);
+        return mFilter.PassFilter(lineText.c_str());
+    };
     if (filterChanged)
     {
-        const auto & lines = mEditor.GetTextLines();
-        mNbFindMatches = (int)fplus::count_if([this](auto s){ return mFilter.PassFilter(s.c_str());}, lines);
+        mNbFindMatches = 0;
+        for (int lineNumber = 0; lineNumber < mEditor.GetTotalLines(); ++lineNumber)
+            if (lineMatches(lineNumber))
+                ++mNbFindMatches;
     }
 
     // Draw number of matches
     {
         if (mNbFindMatches > 0)
         {
-            const auto & lines = mEditor.GetTextLines();
-            bool thisLineMatch = mFilter.PassFilter(mEditor.GetCurrentLineText().c_str());
-            if (!thisLineMatch)
+            int currentLine = mEditor.GetCursorPosition().mLine;
+            if (!lineMatches(currentLine))
                 ImGui::Text("---/%3i", mNbFindMatches);
             else
             {
-                std::vector<size_t> allMatchingLinesNumbers =
-                    fplus::find_all_idxs_by(
-                        [this](const std::string& s) {
-                          return mFilter.PassFilter(s.c_str());
-                        },
-                        lines);
-                auto matchNumber = fplus::find_first_idx(
-                    (size_t)mEditor.GetCursorPosition().mLine,
-                    allMatchingLinesNumbers);
-                if (matchNumber.is_just())
-                    ImGui::Text("%3i/%3i", (int)matchNumber.unsafe_get_just() + 1, mNbFindMatches);
-                else
-                    ImGui::Text("Houston, we have a bug");
+                int matchNumber = 1;
+                for (int lineNumber = 0; lineNumber < currentLine; ++lineNumber)
+                    if (lineMatches(lineNumber))
+                        ++matchNumber;
+                ImGui::Text("%3i/%3i", matchNumber, mNbFindMatches);
                 ImGui::SameLine();
             }
             ImGui::SameLine();
@@ -235,31 +283,28 @@ void WindowWithEditor::guiFind()
     {
         bool searchDown = ImGui::SmallButton(ICON_FA_ARROW_DOWN); ImGui::SameLine();
         bool searchUp = ImGui::SmallButton(ICON_FA_ARROW_UP); ImGui::SameLine();
-        std::vector<std::string> linesToSearch;
         int currentLine = mEditor.GetCursorPosition().mLine ;
         if (searchUp)
         {
-            const auto & lines = mEditor.GetTextLines();
-            linesToSearch = fplus::get_segment(0, currentLine, lines);
-            auto line_idx = fplus::find_last_idx_by(
-                [this](const std::string &line) {
-                  return mFilter.PassFilter(line.c_str());
-                },
-                linesToSearch);
-            if (line_idx.is_just())
-                mEditor.SetCursorPosition({(int)line_idx.unsafe_get_just(), 0}, 3);
+            for (int lineNumber = currentLine - 1; lineNumber >= 0; --lineNumber)
+            {
+                if (lineMatches(lineNumber))
+                {
+                    mEditor.SetCursorPosition({lineNumber, 0}, 3);
+                    break;
+                }
+            }
         }
         if (searchDown)
         {
-            const auto &lines = mEditor.GetTextLines();
-            linesToSearch = fplus::get_segment(currentLine + 1, lines.size(), lines);
-            auto line_idx = fplus::find_first_idx_by(
-                [this](const std::string &line) {
-                  return mFilter.PassFilter(line.c_str());
-                },
-                linesToSearch);
-            if (line_idx.is_just())
-                mEditor.SetCursorPosition({(int)line_idx.unsafe_get_just() + currentLine + 1, 0}, 3);
+            for (int lineNumber = currentLine + 1; lineNumber < mEditor.GetTotalLines(); ++lineNumber)
+            {
+                if (lineMatches(lineNumber))
+                {
+                    mEditor.SetCursorPosition({lineNumber, 0}, 3);
+                    break;
+                }
+            }
         }
     }
 
@@ -11,6 +11,9 @@ class WindowWithEditor
 public:
     WindowWithEditor(const std::string & windowLabel);
 
+    // Shows a source file: read-only editors which show the same file share its colorized text
+    // (it is copied if the user enables editing)
+    void setEditorSource(const SourceParse::SourceFile &sourceFile);
     void setEditorAnnotatedSource(const SourceParse::AnnotatedSource &annotatedSource);
     void RenderEditor(const std::string& filename, VoidFunction additionalGui = {});
 
@@ -0,0 +1,100 @@
+// imgui_hash_bench: micro-benchmark of ImHashStr's backends, on the labels the manual hashes at each frame
+// (the tags of its tables of content, and the "source##path" buttons of its code browsers).
+// Prints the timings as JSON:
+//     {
+//       "nb_labels": ..., "nb_bytes": ...,
+//       "selected_backend": "...",     // the backend selected at startup
+//       "backends": [{"name": ..., "ns_per_label": ..., "mb_per_s": ..., "same_hashes": true}, ...]
+//     }
+// Usage: imgui_hash_bench [nb_iterations]
+#include "source_parse/ImGuiCodeParser.h"
+#include "source_parse/ImGuiDemoParser.h"
+#include "source_parse/Sources.h"
+#include "imgui.h"
+#include "imgui_internal.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<std::string> ManualLabels()
+    {
+        std::vector<std::string> labels;
+        auto addTocLabels = [&labels](const SourceParse::AnnotatedSource& annotatedSource) {
+            for (const auto& lineWithTag: annotatedSource.linesWithTags)
+                labels.push_back(lineWithTag.tag);
+        };
+        addTocLabels(SourceParse::ReadImGuiHeaderDoc());
+        addTocLabels(SourceParse::ReadImGuiCppDoc());
+        addTocLabels(SourceParse::ReadImGuiDemoCode());
+
+        for (const auto& libraries: { SourceParse::imguiLibrary(), SourceParse::acknowldegmentLibraries() })
+            for (const auto& library: libraries)
+                for (const auto& source: library.sourcePaths)
+                    labels.push_back(source + "##" + library.path);
+        return labels;
+    }
+
+    std::vector<ImGuiID> HashLabels(const std::vector<std::string>& labels, ImGuiID seed)
+    {
+        std::vector<ImGuiID> r;
+        r.reserve(labels.size());
+        for (const auto& label: labels)
+            r.push_back(ImHashStr(label.c_str(), 0, seed));
+        return r;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int nbIterations = (argc > 1) ? atoi(argv[1]) : 2000;
+
+    const ImHashBackend selectedBackend = ImHashGetBackend();
+    const std::vector<std::string> labels = ManualLabels();
+    size_t nbBytes = 0;
+    for (const auto& label: labels)
+        nbBytes += label.size();
+
+    // Labels are hashed with their window's ID as seed
+    const ImGuiID seed = ImHashStr("Dear ImGui Manual");
+
+    ImHashSetBackend(ImHashBackend_Bytewise);
+    const std::vector<ImGuiID> referenceHashes = HashLabels(labels, seed);
+
+    printf("{\n");
+    printf("  \"nb_labels\": %zu, \"nb_bytes\": %zu,\n", labels.size(), nbBytes);
+    printf("  \"selected_backend\": \"%s\",\n", ImHashGetBackendName(selectedBackend));
+    printf("  \"backends\": [");
+    bool allSame = true;
+    bool first = true;
+    for (ImHashBackend backend = 0; backend < ImHashBackend_COUNT; ++backend)
+    {
+        if (!ImHashSetBackend(backend))
+            continue;
+        bool sameHashes = (HashLabels(labels, seed) == referenceHashes);
+        allSame = allSame && sameHashes;
+
+        ImGuiID accumulated = 0; // keeps the hashes alive
+        auto start = Clock::now();
+        for (int i = 0; i < nbIterations; ++i)
+            for (const auto& label: labels)
+                accumulated += ImHashStr(label.c_str(), 0, seed);
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        double nsPerLabel = seconds * 1e9 / ((double)nbIterations * (double)labels.size());
+        double mbPerSecond = (double)nbBytes * nbIterations / seconds / 1e6;
+        printf("%s\n    {\"name\": \"%s\", \"ns_per_label\": %.2f, \"mb_per_s\": %.1f, \"same_hashes\": %s, \"sum\": %u}",
+               first ? "" : ",", ImHashGetBackendName(backend), nsPerLabel, mbPerSecond, sameHashes ? "true" : "false", accumulated);
+        first = false;
+    }
+    printf("\n  ]\n}\n");
+
+    ImHashSetBackend(selectedBackend);
+    return allSame ? 0 : 1;
+}
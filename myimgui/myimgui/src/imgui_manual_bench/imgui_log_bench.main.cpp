@@ -0,0 +1,132 @@
+// imgui_log_bench: throughput of HelloImGui::Log's lock-free queue (LogRingBuffer), when N threads log
+// while the UI thread drains, compared to a mutex around the log widget's buffer (ImGuiAl::Log).
+// Prints the timings as JSON:
+//     {
+//       "nb_records_per_thread": ...,
+//       "runs": [{"sink": ..., "threads": ..., "mrecords_per_s": ..., "nb_dropped": ..., "mean_latency_us": ...}, ...]
+//     }
+// mrecords_per_s counts all the Log calls, including the records dropped when the queue was full (the UI thread
+// drains continuously here, but with fewer cores than threads the producers may fill the queue before it runs).
+// The latency is the time between the formatting of a record and its drain (it is not measured with the mutex).
+// Usage: imgui_log_bench [nb_records_per_thread]
+#include "hello_imgui/internal/clock_seconds.h"
+#include "hello_imgui/internal/imguial_term.h"
+#include "hello_imgui/internal/log_ring_buffer.h"
+
+#include <atomic>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using HelloImGui::Internal::ClockSeconds;
+    using HelloImGui::Internal::LogRecord;
+    using HelloImGui::Internal::LogRingBuffer;
+
+    struct Run
+    {
+        double seconds = 0.;
+        unsigned long long nbDropped = 0;
+        double meanLatencySeconds = 0.;
+    };
+
+    // A typical message of a background job
+    const char* const MessageFormat = "Worker %d: parsed %s (%d lines) in %.2f ms";
+
+    bool PushRecord(LogRingBuffer& buffer, const char* format, ...)
+    {
+        va_list args;
+        va_start(args, format);
+        bool pushed = buffer.Push(HelloImGui::LogLevel::Info, ClockSeconds(), format, args);
+        va_end(args);
+        return pushed;
+    }
+
+    // Starts nbThreads producers, and calls uiThreadWork until they are done
+    template<typename ProducerWork, typename UiThreadWork>
+    double RunProducers(int nbThreads, ProducerWork producerWork, UiThreadWork uiThreadWork)
+    {
+        std::atomic<int> nbRunning{nbThreads};
+        std::vector<std::thread> producers;
+        double start = ClockSeconds();
+        for (int t = 0; t < nbThreads; ++t)
+            producers.emplace_back([&, t] {
+                producerWork(t);
+                --nbRunning;
+            });
+        while (nbRunning > 0)
+            uiThreadWork();
+        for (auto& producer: producers)
+            producer.join();
+        uiThreadWork();
+        return ClockSeconds() - start;
+    }
+
+    Run RunRingBuffer(int nbThreads, int nbRecordsPerThread)
+    {
+        LogRingBuffer buffer(4096); // as HelloImGui::Log
+        double sumLatency = 0.;
+        unsigned long long nbDrained = 0;
+        Run run;
+        run.seconds = RunProducers(
+            nbThreads,
+            [&](int t) {
+                for (int i = 0; i < nbRecordsPerThread; ++i)
+                    PushRecord(buffer, MessageFormat, t, "imgui_demo.cpp", i, 1.25);
+            },
+            [&] {
+                double now = ClockSeconds();
+                nbDrained += buffer.Drain([&](const LogRecord& record) { sumLatency += now - record.timestamp; });
+            });
+        run.nbDropped = buffer.GetStats().nbDropped;
+        run.meanLatencySeconds = nbDrained > 0 ? sumLatency / (double)nbDrained : 0.;
+        return run;
+    }
+
+    Run RunMutexLog(int nbThreads, int nbRecordsPerThread)
+    {
+        static char logBuffer[600000]; // as HelloImGui::Log's widget
+        ImGuiAl::Log log(logBuffer, sizeof(logBuffer));
+        std::mutex mutex;
+        Run run;
+        run.seconds = RunProducers(
+            nbThreads,
+            [&](int t) {
+                for (int i = 0; i < nbRecordsPerThread; ++i)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    log.info(MessageFormat, t, "imgui_demo.cpp", i, 1.25);
+                }
+            },
+            [&] { std::this_thread::yield(); });
+        return run;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int nbRecordsPerThread = (argc > 1) ? atoi(argv[1]) : 200000;
+
+    printf("{\n");
+    printf("  \"nb_records_per_thread\": %d,\n", nbRecordsPerThread);
+    printf("  \"runs\": [");
+    bool first = true;
+    for (int nbThreads: { 1, 2, 4, 8 })
+    {
+        for (const char* sink: { "lock_free_ring", "mutex_fifo" })
+        {
+            bool isRing = (sink[0] == 'l');
+            Run run = isRing ? RunRingBuffer(nbThreads, nbRecordsPerThread) : RunMutexLog(nbThreads, nbRecordsPerThread);
+            double mRecordsPerSecond = (double)nbThreads * nbRecordsPerThread / run.seconds / 1e6;
+            printf("%s\n    {\"sink\": \"%s\", \"threads\": %d, \"mrecords_per_s\": %.2f, \"nb_dropped\": %llu, \"mean_latency_us\": %.1f}",
+                   first ? "" : ",", sink, nbThreads, mRecordsPerSecond, run.nbDropped, run.meanLatencySeconds * 1e6);
+            first = false;
+        }
+    }
+    printf("\n  ]\n}\n");
+    return 0;
+}
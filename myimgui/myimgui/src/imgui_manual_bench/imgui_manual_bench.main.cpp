@@ -0,0 +1,409 @@
+// imgui_manual_bench: boots the full manual with hello_imgui's Null platform & renderer backends,
+// replays a scripted set of interactions, and prints the timings as JSON:
+//     {
+//       "imgui_storage": "sorted",    // or "hashed", with IMGUI_USE_HASHED_STORAGE
+//       "renderer": "null",           // or "software", with --software
+//       "pipelined": false,           // true with --pipelined
+//       "startup_ms": ...,            // from main() to the end of the first frame
+//       "frames": ...,
+//       "frame_ms": {"p50": ..., "p99": ..., "max": ...},
+//       "steps": [{"name": ..., "frames": ..., "p50": ..., "p99": ..., "max": ...}, ...],
+//       "peak_rss_kb": ...,
+//       "idle_allocations": {"frames": ..., "max_per_frame": ...},
+//       "pipeline": {"frames": ..., "render_ms_per_frame": ..., "main_wait_ms_per_frame": ..., "overlap": ...}
+//     }
+// Usage: imgui_manual_bench [--software] [--pipelined] [--check-idle-allocations] [output.json]     (prints to stdout if no output file is given)
+//     --software:  renders with the Software renderer, instead of the Null one
+//     --pipelined: renders on a render thread, while the main thread builds the next frame
+//                  ("overlap" is the part of the rendering time during which the main thread did not wait)
+//     --check-idle-allocations: fails (exit code 1) if an idle frame of the manual does a heap allocation after warm-up
+//                  (the operator new allocations are only counted with IMGUI_MANUAL_TRACK_ALLOCATIONS=ON,
+//                  otherwise only ImGui's allocations are)
+//
+// Frame times are measured from PreNewFrame to AfterSwap, i.e. they include NewFrame, the gui,
+// ImGui::Render and the rendering (or its submission to the render thread), but not the idling (which is disabled here).
+#include "ImGuiManual.h"
+#include "imgui_utilities/AllocationTracker.h"
+#include "imgui_internal.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+extern bool GImGuiDemoMarker_IsActive;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double MsSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    // A scripted interaction: action(frameIdx) is called before each of its nbFrames frames
+    struct BenchStep
+    {
+        std::string name;
+        int nbFrames;
+        std::function<void(int frameIdx)> action;
+        std::vector<double> frameTimesMs = {};
+    };
+
+    void FocusWindow(const std::string& label)
+    {
+        runnerParams.dockingParams.focusDockableWindow(label);
+    }
+
+    // Types text one char per frame into a TOC filter
+    std::function<void(int)> TypeIntoTocFilter(SourceParse::GuiHeaderTree& guiHeaderTree, const std::string& text)
+    {
+        return [&guiHeaderTree, text](int frameIdx) {
+            size_t nbChars = std::min((size_t)frameIdx + 1, text.size());
+            guiHeaderTree.setFilter(text.substr(0, nbChars));
+        };
+    }
+
+    // Moves the cursor down by a page each frame, until the end of the editor
+    BenchStep ScrollThroughEditor(const std::string& stepName, TextEditor& editor, const std::string& windowLabel)
+    {
+        const int linesPerFrame = 60;
+        int nbFrames = editor.GetTotalLines() / linesPerFrame + 1;
+        return {stepName, nbFrames, [&editor, windowLabel](int frameIdx) {
+            if (frameIdx == 0)
+                FocusWindow(windowLabel);
+            int line = std::min(frameIdx * linesPerFrame, editor.GetTotalLines() - 1);
+            editor.SetCursorPosition({line, 0});
+        }};
+    }
+
+    std::vector<BenchStep> MakeBenchSteps(ImGuiManual& manual)
+    {
+        std::vector<BenchStep> steps;
+
+        // Warm up (layout, docking, font atlas), then a few idle frames
+        steps.push_back({"warmup", 30, [](int) {}});
+        steps.push_back({"idle", 120, [](int) {}});
+
+        // Open each dockable window, and leave it displayed for a few frames
+        {
+            const int nbFramesPerWindow = 20;
+            std::vector<std::string> labels;
+            for (const auto& dockableWindow: runnerParams.dockingParams.dockableWindows)
+                labels.push_back(dockableWindow.label);
+            steps.push_back({"open_windows", (int)labels.size() * nbFramesPerWindow, [labels](int frameIdx) {
+                if (frameIdx % nbFramesPerWindow == 0)
+                    FocusWindow(labels[frameIdx / nbFramesPerWindow]);
+            }});
+        }
+
+        // Type into the TOC filters (imgui.h doc, then demo code)
+        {
+            std::string text = "ImGui::Begin";
+            auto typeText = TypeIntoTocFilter(manual.imGuiHeaderDocBrowser.guiHeaderTree(), text);
+            std::string windowLabel = manual.imGuiHeaderDocBrowser.windowLabel();
+            steps.push_back({"toc_filter_imgui_h", (int)text.size() + 10, [typeText, windowLabel](int frameIdx) {
+                if (frameIdx == 0)
+                    FocusWindow(windowLabel);
+                typeText(frameIdx);
+            }});
+        }
+        {
+            std::string text = "Tables";
+            auto typeText = TypeIntoTocFilter(manual.imGuiDemoBrowser.guiHeaderTree(), text);
+            steps.push_back({"toc_filter_demo", (int)text.size() + 10, [typeText](int frameIdx) {
+                if (frameIdx == 0)
+                    FocusWindow("Demo Code");
+                typeText(frameIdx);
+            }});
+        }
+
+        // Expand / collapse all the nodes of the imgui.h TOC (their open state lives in an ImGuiStorage)
+        {
+            const int nbFramesPerAction = 2;
+            SourceParse::GuiHeaderTree& guiHeaderTree = manual.imGuiHeaderDocBrowser.guiHeaderTree();
+            std::string windowLabel = manual.imGuiHeaderDocBrowser.windowLabel();
+            steps.push_back({"toc_expand_collapse_imgui_h", 30 * nbFramesPerAction, [&guiHeaderTree, windowLabel](int frameIdx) {
+                if (frameIdx == 0)
+                {
+                    FocusWindow(windowLabel);
+                    guiHeaderTree.setFilter("");
+                }
+                if (frameIdx % nbFramesPerAction == 0)
+                {
+                    if ((frameIdx / nbFramesPerAction) % 2 == 0)
+                        guiHeaderTree.expandAll();
+                    else
+                        guiHeaderTree.collapseAll();
+                }
+            }});
+        }
+
+        // Search in imgui.cpp
+        {
+            const int nbFramesPerSearch = 10;
+            std::vector<std::string> searches = {"Docking", "Viewports", "ImGuiIO", "CalcTextSize", "EndFrame"};
+            std::string windowLabel = manual.imGuiCppDocBrowser.windowLabel();
+            steps.push_back({"search_imgui_cpp", (int)searches.size() * nbFramesPerSearch, [searches, windowLabel](int frameIdx) {
+                if (frameIdx % nbFramesPerSearch == 0)
+                    WindowWithEditor::searchForFirstOccurenceAndFocusWindow(searches[frameIdx / nbFramesPerSearch], windowLabel);
+            }});
+        }
+
+        // Scroll down to the end of imgui_demo.cpp
+        steps.push_back(ScrollThroughEditor(
+            "scroll_demo_code", manual.imGuiDemoBrowser.windowWithEditor().InnerTextEditor(), "Demo Code"));
+
+        // Scroll through imgui.cpp, with and without the editor's monospace fast path
+        for (bool monospaceMode: {false, true})
+        {
+            TextEditor& editor = manual.imGuiCppDocBrowser.InnerTextEditor();
+            BenchStep step = ScrollThroughEditor(
+                monospaceMode ? "scroll_imgui_cpp_monospace" : "scroll_imgui_cpp_generic_layout",
+                editor, manual.imGuiCppDocBrowser.windowLabel());
+            auto scroll = step.action;
+            step.action = [scroll, &editor, monospaceMode](int frameIdx) {
+                if (frameIdx == 0)
+                    editor.SetMonospaceMode(monospaceMode);
+                scroll(frameIdx);
+            };
+            steps.push_back(step);
+        }
+
+        // Hover the demo window in "Code Lookup" mode: the demo markers will move the demo code editor
+        {
+            const int nbColumns = 4, nbRows = 60;
+            steps.push_back({"hover_code_lookup", nbColumns * nbRows, [](int frameIdx) {
+                if (frameIdx == 0)
+                {
+                    GImGuiDemoMarker_IsActive = true;
+                    FocusWindow("Dear ImGui Demo");
+                }
+                ImGuiWindow* demoWindow = ImGui::FindWindowByName("Dear ImGui Demo");
+                if (demoWindow == nullptr)
+                    return;
+                ImRect rect = demoWindow->InnerRect;
+                int column = frameIdx / nbRows, row = frameIdx % nbRows;
+                ImVec2 mousePos(
+                    rect.Min.x + rect.GetWidth() * ((float)column + 0.5f) / (float)nbColumns,
+                    rect.Min.y + rect.GetHeight() * ((float)row + 0.5f) / (float)nbRows);
+                ImGui::GetIO().AddMousePosEvent(mousePos.x, mousePos.y);
+            }});
+        }
+
+        return steps;
+    }
+
+    double Percentile(std::vector<double> values, double percentile)
+    {
+        if (values.empty())
+            return 0.;
+        std::sort(values.begin(), values.end());
+        size_t idx = (size_t)(percentile / 100. * (double)(values.size() - 1) + 0.5);
+        return values[std::min(idx, values.size() - 1)];
+    }
+
+    long PeakRssKb()
+    {
+#if defined(__linux__)
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss;          // kilobytes on linux
+#elif defined(__APPLE__)
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss / 1024;   // bytes on macOS
+#else
+        return -1;
+#endif
+    }
+
+    std::string TimingsJson(const std::vector<double>& frameTimesMs)
+    {
+        std::stringstream ss;
+        ss << std::fixed;
+        ss.precision(3);
+        ss << "\"p50\": " << Percentile(frameTimesMs, 50.)
+           << ", \"p99\": " << Percentile(frameTimesMs, 99.)
+           << ", \"max\": " << Percentile(frameTimesMs, 100.);
+        return ss.str();
+    }
+
+    std::string PipelineJson(const HelloImGui::RendererBackendOptions& options)
+    {
+        std::stringstream ss;
+        ss << std::fixed;
+        ss.precision(3);
+        int nbFrames = options.pipelineNbFrames;
+        double renderMs = nbFrames > 0 ? options.pipelineRenderSeconds * 1000. / nbFrames : 0.;
+        double mainWaitMs = nbFrames > 0 ? options.pipelineMainWaitSeconds * 1000. / nbFrames : 0.;
+        double overlap = renderMs > 0. ? std::max(0., 1. - mainWaitMs / renderMs) : 0.;
+        ss << "\"frames\": " << nbFrames
+           << ", \"render_ms_per_frame\": " << renderMs
+           << ", \"main_wait_ms_per_frame\": " << mainWaitMs
+           << ", \"overlap\": " << overlap;
+        return ss.str();
+    }
+
+    // Allocations of the idle frames, once warmed up
+    struct IdleAllocations
+    {
+        std::vector<uint64_t> perFrame;
+        static constexpr int NbWarmupFrames = 30; // e.g. the first redraw requests grow their heap
+
+        uint64_t MaxPerFrame() const
+        {
+            uint64_t r = 0;
+            for (size_t i = NbWarmupFrames; i < perFrame.size(); ++i)
+                r = std::max(r, perFrame[i]);
+            return r;
+        }
+        size_t NbFrames() const { return perFrame.size() > NbWarmupFrames ? perFrame.size() - NbWarmupFrames : 0; }
+    };
+
+    std::string MakeReportJson(double startupMs, const std::vector<BenchStep>& steps, const IdleAllocations& idleAllocations)
+    {
+        std::vector<double> allFrameTimesMs;
+        for (const auto& step: steps)
+            if (step.name != "warmup")
+                allFrameTimesMs.insert(allFrameTimesMs.end(), step.frameTimesMs.begin(), step.frameTimesMs.end());
+
+        std::stringstream ss;
+        ss << std::fixed;
+        ss.precision(3);
+        ss << "{\n";
+#ifdef IMGUI_USE_HASHED_STORAGE
+        ss << "  \"imgui_storage\": \"hashed\",\n";
+#else
+        ss << "  \"imgui_storage\": \"sorted\",\n";
+#endif
+        bool isSoftware = (runnerParams.rendererBackendType == HelloImGui::RendererBackendType::Software);
+        bool isPipelined = runnerParams.rendererBackendOptions.pipelinedRendering;
+        ss << "  \"renderer\": \"" << (isSoftware ? "software" : "null") << "\",\n";
+        ss << "  \"pipelined\": " << (isPipelined ? "true" : "false") << ",\n";
+        ss << "  \"startup_ms\": " << startupMs << ",\n";
+        ss << "  \"frames\": " << allFrameTimesMs.size() << ",\n";
+        ss << "  \"frame_ms\": {" << TimingsJson(allFrameTimesMs) << "},\n";
+        ss << "  \"steps\": [\n";
+        for (size_t i = 0; i < steps.size(); ++i)
+        {
+            const auto& step = steps[i];
+            ss << "    {\"name\": \"" << step.name << "\", \"frames\": " << step.frameTimesMs.size()
+               << ", " << TimingsJson(step.frameTimesMs) << "}"
+               << (i + 1 < steps.size() ? ",\n" : "\n");
+        }
+        ss << "  ],\n";
+        ss << "  \"peak_rss_kb\": " << PeakRssKb() << ",\n";
+        ss << "  \"idle_allocations\": {\"frames\": " << idleAllocations.NbFrames()
+           << ", \"max_per_frame\": " << idleAllocations.MaxPerFrame() << "}";
+        if (isPipelined)
+            ss << ",\n  \"pipeline\": {" << PipelineJson(runnerParams.rendererBackendOptions) << "}";
+        ss << "\n";
+        ss << "}\n";
+        return ss.str();
+    }
+}
+
+int main(int argc, char **argv)
+{
+    auto startTime = Clock::now();
+
+    bool useSoftwareRenderer = false, usePipelinedRendering = false, checkIdleAllocations = false;
+    std::string outputFile;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--software")
+            useSoftwareRenderer = true;
+        else if (arg == "--pipelined")
+            usePipelinedRendering = true;
+        else if (arg == "--check-idle-allocations")
+            checkIdleAllocations = true;
+        else
+            outputFile = arg;
+    }
+
+    ImGuiManual manual;
+
+    runnerParams.platformBackendType = HelloImGui::PlatformBackendType::Null;
+    runnerParams.rendererBackendType = useSoftwareRenderer ? HelloImGui::RendererBackendType::Software : HelloImGui::RendererBackendType::Null;
+    runnerParams.rendererBackendOptions.pipelinedRendering = usePipelinedRendering;
+    runnerParams.fpsIdling.enableIdling = false;
+    // Always start from the default layout
+    runnerParams.iniFolderType = HelloImGui::IniFolderType::TempFolder;
+    runnerParams.iniFilename = "imgui_manual_bench.ini";
+    HelloImGui::DeleteIniSettings(runnerParams);
+
+    std::vector<BenchStep> steps = MakeBenchSteps(manual);
+    size_t currentStep = 0;
+    int currentStepFrame = 0;
+    double startupMs = -1.;
+    Clock::time_point frameStartTime;
+
+    // The allocations are counted during the idle step only, from PreNewFrame to AfterSwap
+    IdleAllocations idleAllocations;
+    AllocationTracker::Counters frameStartAllocations;
+    auto isIdleStep = [&] { return currentStep < steps.size() && steps[currentStep].name == "idle"; };
+
+    auto previousPreNewFrame = runnerParams.callbacks.PreNewFrame;
+    runnerParams.callbacks.PreNewFrame = [&] {
+        if (previousPreNewFrame)
+            previousPreNewFrame();
+        frameStartTime = Clock::now();
+        if (currentStep < steps.size())
+            steps[currentStep].action(currentStepFrame);
+        AllocationTracker::SetEnabled(isIdleStep());
+        frameStartAllocations = AllocationTracker::ThreadCounters();
+    };
+    runnerParams.callbacks.AfterSwap = [&] {
+        double frameMs = MsSince(frameStartTime);
+        if (isIdleStep())
+            idleAllocations.perFrame.push_back((AllocationTracker::ThreadCounters() - frameStartAllocations).nbAllocations);
+        if (startupMs < 0.)
+        {
+            startupMs = MsSince(startTime);
+            return;
+        }
+        if (currentStep >= steps.size())
+            return;
+        steps[currentStep].frameTimesMs.push_back(frameMs);
+        ++currentStepFrame;
+        if (currentStepFrame >= steps[currentStep].nbFrames)
+        {
+            ++currentStep;
+            currentStepFrame = 0;
+        }
+        if (currentStep >= steps.size())
+            runnerParams.appShallExit = true;
+    };
+
+    HelloImGui::Run(runnerParams);
+
+    std::string report = MakeReportJson(startupMs, steps, idleAllocations);
+    if (!outputFile.empty())
+    {
+        std::ofstream outFile(outputFile);
+        if (!outFile.good())
+        {
+            std::cerr << "imgui_manual_bench: cannot write " << outputFile << "\n";
+            return 1;
+        }
+        outFile << report;
+    }
+    else
+        std::cout << report;
+
+    if (checkIdleAllocations && idleAllocations.MaxPerFrame() > 0)
+    {
+        std::cerr << "imgui_manual_bench: an idle frame did " << idleAllocations.MaxPerFrame() << " heap allocations\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,121 @@
+// imgui_raster_bench: throughput of hello_imgui's SoftwareRasterizer (the Software rendering backend),
+// on the draw data of the demo window plus a window full of shapes and text, in a headless ImGui context.
+// Prints the timings as JSON:
+//     {
+//       "width": ..., "height": ..., "nb_triangles": ..., "nb_binned_triangles": ...,
+//       "runs": [{"threads": ..., "ms_per_frame": ..., "mtri_per_s": ..., "same_pixels": true}, ...]
+//     }
+// Usage: imgui_raster_bench [nb_iterations]
+#include "hello_imgui/internal/backend_impls/software_rasterizer.h"
+#include "imgui.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    const int Width = 1280, Height = 800;
+
+    void ShapesWindow()
+    {
+        ImGui::SetNextWindowPos(ImVec2(Width * 0.5f, 0.f));
+        ImGui::SetNextWindowSize(ImVec2(Width * 0.5f, (float)Height));
+        ImGui::Begin("Shapes");
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+        ImVec2 origin = ImGui::GetCursorScreenPos();
+        for (int i = 0; i < 200; ++i)
+        {
+            ImVec2 p(origin.x + (float)(i % 20) * 30.f, origin.y + (float)(i / 20) * 30.f);
+            ImU32 color = IM_COL32(50 + i % 200, 100, 255 - i % 200, 160);
+            if (i % 2 == 0)
+                drawList->AddCircleFilled(ImVec2(p.x + 12.f, p.y + 12.f), 12.f, color);
+            else
+                drawList->AddRectFilled(p, ImVec2(p.x + 24.f, p.y + 24.f), color, 6.f);
+        }
+        ImGui::SetCursorScreenPos(ImVec2(origin.x, origin.y + 320.f));
+        for (int i = 0; i < 25; ++i)
+            ImGui::Text("Line %d: the quick brown fox jumps over the lazy dog, 0123456789", i);
+        ImGui::End();
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int nbIterations = (argc > 1) ? atoi(argv[1]) : 100;
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2((float)Width, (float)Height);
+    io.DeltaTime = 1.f / 60.f;
+
+    std::vector<int> threadCounts = {1, 2, 4};
+    int nbHardwareThreads = (int)std::thread::hardware_concurrency();
+    if (std::find(threadCounts.begin(), threadCounts.end(), nbHardwareThreads) == threadCounts.end() && nbHardwareThreads > 0)
+        threadCounts.push_back(nbHardwareThreads);
+
+    // All the rasterizers share the fonts texture of the first one: textures are only read while rendering
+    std::vector<std::unique_ptr<HelloImGui::SoftwareRasterizer>> rasterizers;
+    for (int nbThreads: threadCounts)
+    {
+        rasterizers.push_back(std::make_unique<HelloImGui::SoftwareRasterizer>(nbThreads));
+        rasterizers.back()->Resize(Width, Height);
+    }
+    rasterizers.front()->CreateFontsTexture();
+
+    for (int i = 0; i < 4; ++i) // let the windows settle
+    {
+        ImGui::NewFrame();
+        ImGui::ShowDemoWindow();
+        ImGui::SetWindowPos("Dear ImGui Demo", ImVec2(0.f, 0.f));
+        ImGui::SetWindowSize("Dear ImGui Demo", ImVec2(Width * 0.5f, (float)Height));
+        ShapesWindow();
+        ImGui::Render();
+    }
+    const ImDrawData* drawData = ImGui::GetDrawData();
+
+    printf("{\n");
+    printf("  \"width\": %d, \"height\": %d,", Width, Height);
+    std::vector<uint32_t> referencePixels;
+    bool allSame = true;
+    bool first = true;
+    for (size_t r = 0; r < rasterizers.size(); ++r)
+    {
+        HelloImGui::SoftwareRasterizer& rasterizer = *rasterizers[r];
+        auto start = Clock::now();
+        for (int i = 0; i < nbIterations; ++i)
+        {
+            rasterizer.Clear(ImVec4(0.45f, 0.55f, 0.60f, 1.00f));
+            rasterizer.RenderDrawData(drawData);
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        const auto& stats = rasterizer.LastFrameStats();
+        if (r == 0)
+        {
+            referencePixels = rasterizer.Pixels();
+            printf(" \"nb_triangles\": %zu, \"nb_binned_triangles\": %zu,\n", stats.nbTriangles, stats.nbBinnedTriangles);
+            printf("  \"runs\": [");
+        }
+        bool samePixels = (rasterizer.Pixels() == referencePixels);
+        allSame = allSame && samePixels;
+
+        double msPerFrame = seconds * 1e3 / (double)nbIterations;
+        double mtriPerSecond = (double)stats.nbTriangles * (double)nbIterations / seconds / 1e6;
+        printf("%s\n    {\"threads\": %d, \"ms_per_frame\": %.3f, \"mtri_per_s\": %.2f, \"same_pixels\": %s}",
+               first ? "" : ",", rasterizer.NbThreads(), msPerFrame, mtriPerSecond, samePixels ? "true" : "false");
+        first = false;
+    }
+    printf("\n  ]\n}\n");
+
+    rasterizers.front()->DestroyFontsTexture();
+    ImGui::DestroyContext();
+    return allSame ? 0 : 1;
+}
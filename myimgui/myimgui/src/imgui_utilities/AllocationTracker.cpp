@@ -0,0 +1,74 @@
+#include "AllocationTracker.h"
+#include "imgui.h"
+
+#include <atomic>
+#include <cstdlib>
+
+namespace AllocationTracker
+{
+    namespace
+    {
+        std::atomic<bool> gEnabled{false};
+        std::atomic<bool> gOperatorNewHooked{false};
+
+        // Plain thread_local PODs: they are usable from operator new, even during a thread's startup
+        thread_local uint64_t tNbAllocations = 0;
+        thread_local uint64_t tNbBytes = 0;
+
+        Counters gFrameStartCounters;
+        Counters gLastFrameCounters;
+        bool gHasFrameStart = false;
+
+        void *ImGuiAlloc(size_t size, void *)
+        {
+            OnAllocation(size);
+            return std::malloc(size);
+        }
+
+        void ImGuiFree(void *ptr, void *)
+        {
+            std::free(ptr);
+        }
+    }
+
+    void SetEnabled(bool enabled)
+    {
+        gEnabled = enabled;
+        gHasFrameStart = false;
+    }
+    bool IsEnabled() { return gEnabled.load(std::memory_order_relaxed); }
+
+    void InstallImGuiAllocator()
+    {
+        ImGui::SetAllocatorFunctions(ImGuiAlloc, ImGuiFree);
+    }
+
+    bool IsOperatorNewHooked() { return gOperatorNewHooked; }
+    void SetOperatorNewHooked() { gOperatorNewHooked = true; }
+
+    void OnAllocation(size_t size)
+    {
+        if (!gEnabled.load(std::memory_order_relaxed))
+            return;
+        ++tNbAllocations;
+        tNbBytes += size;
+    }
+
+    Counters ThreadCounters()
+    {
+        return { tNbAllocations, tNbBytes };
+    }
+
+    void BeginFrame()
+    {
+        if (!IsEnabled())
+            return;
+        Counters now = ThreadCounters();
+        if (gHasFrameStart)
+            gLastFrameCounters = now - gFrameStartCounters;
+        gFrameStartCounters = now;
+        gHasFrameStart = true;
+    }
+
+    Counters LastFrameCounters() { return gLastFrameCounters; }
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Counts the heap allocations, in order to find the allocations done by steady-state frames.
+//
+// Two hooks feed the counters:
+//   * ImGui's allocator: see InstallImGuiAllocator()
+//   * the global operator new: it is replaced by AllocationTracker_NewDelete.cpp, which is only linked
+//     when building with IMGUI_MANUAL_TRACK_ALLOCATIONS=ON (and in the tests)
+//
+// Counting is disabled by default. When enabled, FrameProfiler scopes also report
+// the allocations done inside them (see the profiler overlay).
+namespace AllocationTracker
+{
+    struct Counters
+    {
+        uint64_t nbAllocations = 0;
+        uint64_t nbBytes = 0;
+    };
+    inline Counters operator-(const Counters& a, const Counters& b)
+    {
+        return { a.nbAllocations - b.nbAllocations, a.nbBytes - b.nbBytes };
+    }
+
+    void SetEnabled(bool enabled);
+    bool IsEnabled();
+
+    // Routes ImGui's allocations through the tracker. Shall be called before ImGui::CreateContext()
+    void InstallImGuiAllocator();
+    // True if AllocationTracker_NewDelete.cpp is linked
+    bool IsOperatorNewHooked();
+
+    // Called by the hooks
+    void OnAllocation(size_t size);
+    void SetOperatorNewHooked();
+
+    // Allocations done by the current thread since the start (only counted while enabled)
+    Counters ThreadCounters();
+
+    // Shall be called once per frame, before ImGui::NewFrame(), from the gui thread
+    void BeginFrame();
+    // Allocations done by the gui thread during the last complete frame
+    Counters LastFrameCounters();
+}
@@ -0,0 +1,47 @@
+// Replaces the global operator new/delete, so that AllocationTracker counts the C++ heap allocations.
+//
+// This file is not part of the imgui_utilities library: an object defining operator new inside
+// a static library would always be linked. It is added to the executables
+// when building with IMGUI_MANUAL_TRACK_ALLOCATIONS=ON (and to the tests).
+// (the aligned variants are not replaced: they keep using the default implementation)
+#include "AllocationTracker.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    void *TrackedAlloc(std::size_t size)
+    {
+        AllocationTracker::OnAllocation(size);
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    const bool gRegistered = (AllocationTracker::SetOperatorNewHooked(), true);
+}
+
+void *operator new(std::size_t size)
+{
+    void *ptr = TrackedAlloc(size);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void *operator new[](std::size_t size)
+{
+    void *ptr = TrackedAlloc(size);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void *operator new(std::size_t size, const std::nothrow_t&) noexcept { return TrackedAlloc(size); }
+void *operator new[](std::size_t size, const std::nothrow_t&) noexcept { return TrackedAlloc(size); }
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
@@ -0,0 +1,130 @@
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+
+namespace FrameArena
+{
+    namespace
+    {
+        class ArenaResource: public std::pmr::memory_resource
+        {
+        public:
+            void reset()
+            {
+                // If the last frame needed several blocks, replace them by a single one large enough for all:
+                // the next frames will then fit in it
+                if (mBlocks.size() > 1)
+                {
+                    size_t totalSize = capacity();
+                    mBlocks.clear();
+                    mBlocks.push_back(Block(totalSize));
+                }
+                mOffset = 0;
+                mBytesUsed = 0;
+            }
+
+            size_t bytesUsed() const { return mBytesUsed; }
+
+            size_t capacity() const
+            {
+                size_t r = 0;
+                for (const auto& block: mBlocks)
+                    r += block.size;
+                return r;
+            }
+
+        protected:
+            void *do_allocate(size_t bytes, size_t alignment) override
+            {
+                void *ptr = allocateInLastBlock(bytes, alignment);
+                if (ptr == nullptr)
+                {
+                    size_t blockSize = std::max(MinBlockSize, bytes + alignment);
+                    if (!mBlocks.empty())
+                        blockSize = std::max(blockSize, mBlocks.back().size * 2);
+                    mBlocks.push_back(Block(blockSize));
+                    mOffset = 0;
+                    ptr = allocateInLastBlock(bytes, alignment);
+                }
+                mBytesUsed += bytes;
+                return ptr;
+            }
+
+            // Memory is only released by reset()
+            void do_deallocate(void *, size_t, size_t) override {}
+
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+            {
+                return this == &other;
+            }
+
+        private:
+            struct Block
+            {
+                explicit Block(size_t size_) : data(new char[size_]), size(size_) {}
+                std::unique_ptr<char[]> data;
+                size_t size;
+            };
+
+            void *allocateInLastBlock(size_t bytes, size_t alignment)
+            {
+                if (mBlocks.empty())
+                    return nullptr;
+                Block& block = mBlocks.back();
+                uintptr_t base = (uintptr_t)block.data.get();
+                uintptr_t aligned = (base + mOffset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+                size_t newOffset = (size_t)(aligned - base) + bytes;
+                if (newOffset > block.size)
+                    return nullptr;
+                mOffset = newOffset;
+                return (void *)aligned;
+            }
+
+            static constexpr size_t MinBlockSize = 64 * 1024;
+            std::vector<Block> mBlocks;
+            size_t mOffset = 0;
+            size_t mBytesUsed = 0;
+        };
+
+        ArenaResource& Arena()
+        {
+            static ArenaResource arena;
+            return arena;
+        }
+    }
+
+    std::pmr::memory_resource *Resource() { return &Arena(); }
+
+    String MakeString(std::string_view s)
+    {
+        return String(s, Resource());
+    }
+
+    String Format(const char *fmt, ...)
+    {
+        va_list args;
+        va_start(args, fmt);
+        va_list argsCopy;
+        va_copy(argsCopy, args);
+        int length = vsnprintf(nullptr, 0, fmt, args);
+        va_end(args);
+
+        String r(Resource());
+        if (length > 0)
+        {
+            r.resize((size_t)length);
+            vsnprintf(r.data(), (size_t)length + 1, fmt, argsCopy);
+        }
+        va_end(argsCopy);
+        return r;
+    }
+
+    void Reset() { Arena().reset(); }
+
+    size_t BytesUsed() { return Arena().bytesUsed(); }
+    size_t Capacity() { return Arena().capacity(); }
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// A per-frame bump allocator, for the gui's transient data (labels, scratch buffers, ...).
+//
+// Everything allocated from it is released at once by Reset(), at the start of each frame:
+// arena backed strings and vectors shall not be kept from one frame to the next.
+// Its memory blocks are kept between frames, so that steady-state frames do not touch the heap.
+// Not thread safe: use it from the gui thread only.
+//
+// Usage:
+//     FrameArena::String label = FrameArena::Format("%s##%d", tag.c_str(), lineNumber);
+//     FrameArena::Vector<int> scratch = FrameArena::MakeVector<int>();
+namespace FrameArena
+{
+    using String = std::pmr::string;
+    template<typename T> using Vector = std::pmr::vector<T>;
+
+    std::pmr::memory_resource *Resource();
+
+    String MakeString(std::string_view s = {});
+    template<typename T> Vector<T> MakeVector() { return Vector<T>(Resource()); }
+    // printf-like formatting into an arena string
+    String Format(const char *fmt, ...);
+
+    // Shall be called once per frame, before ImGui::NewFrame()
+    void Reset();
+
+    size_t BytesUsed(); // during the current frame
+    size_t Capacity();
+}
@@ -0,0 +1,437 @@
+#include "FrameProfiler.h"
+#include "AllocationTracker.h"
+#include "imgui.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace FrameProfiler
+{
+    namespace
+    {
+        struct ScopeEvent
+        {
+            const char *name = nullptr;
+            uint64_t frameIdx = 0;
+            double startUs = 0.;
+            double durationUs = 0.;
+            int depth = 0;
+            uint32_t threadIdx = 0;
+            uint64_t nbAllocations = 0;
+            uint64_t nbBytes = 0;
+        };
+
+        // Fixed size multi-producer ring buffer: writers reserve a slot with a fetch_add,
+        // and publish it by storing its sequence number once filled (a seqlock: the fences order the
+        // event copy between the two sequence stores, and readers check the sequence before and after it).
+        // Readers skip slots that are being (re)written.
+        class EventRingBuffer
+        {
+        public:
+            static constexpr size_t Capacity = 1 << 16;
+
+            void push(const ScopeEvent& event)
+            {
+                uint64_t idx = mWriteIdx.fetch_add(1, std::memory_order_relaxed);
+                Slot& slot = mSlots[idx & (Capacity - 1)];
+                slot.sequence.store(0, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                slot.event = event;
+                slot.sequence.store(idx + 1, std::memory_order_release);
+            }
+
+            // Returns the published events, oldest first
+            std::vector<ScopeEvent> snapshot() const
+            {
+                std::vector<ScopeEvent> r;
+                uint64_t writeIdx = mWriteIdx.load(std::memory_order_acquire);
+                uint64_t firstIdx = writeIdx > Capacity ? writeIdx - Capacity : 0;
+                r.reserve((size_t)(writeIdx - firstIdx));
+                ScopeEvent event;
+                for (uint64_t idx = firstIdx; idx < writeIdx; ++idx)
+                    if (read(idx, &event) == ReadResult::Ok)
+                        r.push_back(event);
+                return r;
+            }
+
+            // Appends the events published since fromIdx (the value returned by the previous call), oldest first.
+            // Stops at the first slot which is still being written: it will be read by the next call.
+            uint64_t appendSince(uint64_t fromIdx, std::vector<ScopeEvent>& events) const
+            {
+                uint64_t writeIdx = mWriteIdx.load(std::memory_order_acquire);
+                uint64_t idx = std::max(fromIdx, writeIdx > Capacity ? writeIdx - Capacity : (uint64_t)0);
+                ScopeEvent event;
+                for (; idx < writeIdx; ++idx)
+                {
+                    ReadResult result = read(idx, &event);
+                    if (result == ReadResult::NotYetPublished)
+                        break;
+                    if (result == ReadResult::Ok)
+                        events.push_back(event);
+                }
+                return idx;
+            }
+
+        private:
+            struct Slot
+            {
+                std::atomic<uint64_t> sequence{0};
+                ScopeEvent event;
+            };
+            enum class ReadResult { Ok, NotYetPublished, Overwritten };
+
+            ReadResult read(uint64_t idx, ScopeEvent *event) const
+            {
+                const Slot& slot = mSlots[idx & (Capacity - 1)];
+                uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+                if (sequence != idx + 1)
+                    return sequence < idx + 1 ? ReadResult::NotYetPublished : ReadResult::Overwritten;
+                *event = slot.event;
+                std::atomic_thread_fence(std::memory_order_acquire);
+                // A writer which reused the slot during the copy may have torn it
+                if (slot.sequence.load(std::memory_order_relaxed) != idx + 1)
+                    return ReadResult::Overwritten;
+                return ReadResult::Ok;
+            }
+
+            std::array<Slot, Capacity> mSlots;
+            std::atomic<uint64_t> mWriteIdx{0};
+        };
+
+        struct FrameStart
+        {
+            uint64_t frameIdx;
+            double startUs;
+        };
+
+        constexpr size_t NbFramesKept = 256;
+
+        std::atomic<bool> gEnabled{false};
+        std::atomic<uint64_t> gFrameIdx{0};
+        EventRingBuffer gEvents;
+        std::array<FrameStart, NbFramesKept> gFrameStarts{};
+        std::atomic<uint32_t> gNbThreads{0};
+        std::atomic<uint32_t> gGuiThreadIdx{0}; // the flame chart only shows the gui thread
+
+        thread_local int tDepth = 0;
+        thread_local uint32_t tThreadIdx = gNbThreads.fetch_add(1);
+
+        double NowUs()
+        {
+            using namespace std::chrono;
+            static const auto start = steady_clock::now();
+            return (double)duration_cast<nanoseconds>(steady_clock::now() - start).count() / 1000.;
+        }
+
+        ImU32 ColorOfName(const char *name)
+        {
+            uint32_t hash = 2166136261u; // FNV-1a
+            for (const char *c = name; *c; ++c)
+                hash = (hash ^ (uint8_t)*c) * 16777619u;
+            float hue = (float)(hash % 360) / 360.f;
+            float r, g, b;
+            ImGui::ColorConvertHSVtoRGB(hue, 0.5f, 0.8f, r, g, b);
+            return ImGui::ColorConvertFloat4ToU32(ImVec4(r, g, b, 1.f));
+        }
+    }
+
+    void SetEnabled(bool enabled) { gEnabled = enabled; }
+    bool IsEnabled() { return gEnabled; }
+
+    void BeginFrame()
+    {
+        if (!gEnabled)
+            return;
+        gGuiThreadIdx = tThreadIdx;
+        uint64_t frameIdx = ++gFrameIdx;
+        gFrameStarts[frameIdx % NbFramesKept] = { frameIdx, NowUs() };
+    }
+
+    ScopedTimer::ScopedTimer(const char *name)
+        : mName(gEnabled ? name : nullptr)
+        , mStartUs(0.)
+    {
+        if (mName == nullptr)
+            return;
+        mStartUs = NowUs();
+        ++tDepth;
+        auto allocations = AllocationTracker::ThreadCounters();
+        mNbAllocationsStart = allocations.nbAllocations;
+        mNbBytesStart = allocations.nbBytes;
+    }
+
+    ScopedTimer::~ScopedTimer()
+    {
+        if (mName == nullptr)
+            return;
+        --tDepth;
+        ScopeEvent event;
+        event.name = mName;
+        event.frameIdx = gFrameIdx.load(std::memory_order_relaxed);
+        event.startUs = mStartUs;
+        event.durationUs = NowUs() - mStartUs;
+        event.depth = tDepth;
+        event.threadIdx = tThreadIdx;
+        auto allocations = AllocationTracker::ThreadCounters();
+        event.nbAllocations = allocations.nbAllocations - mNbAllocationsStart;
+        event.nbBytes = allocations.nbBytes - mNbBytesStart;
+        gEvents.push(event);
+    }
+
+    const char *InternName(const std::string& name)
+    {
+        static std::mutex mutex;
+        static std::unordered_set<std::string> names; // node based: c_str() stays valid
+        std::lock_guard<std::mutex> lock(mutex);
+        return names.insert(name).first->c_str();
+    }
+
+    std::function<void(void)> InstrumentFunction(const std::string& name, const std::function<void(void)>& fn)
+    {
+        if (!fn)
+            return fn;
+        const char *internedName = InternName(name);
+        return [internedName, fn]() {
+            ScopedTimer scopedTimer(internedName);
+            fn();
+        };
+    }
+
+    bool ExportChromeTrace(const std::string& filename)
+    {
+        std::ofstream os(filename);
+        if (!os.good())
+            return false;
+        auto events = gEvents.snapshot();
+        os << std::fixed << std::setprecision(3);
+        os << "{\"traceEvents\":[\n";
+        bool first = true;
+        for (const auto& event: events)
+        {
+            if (!first)
+                os << ",\n";
+            first = false;
+            std::string name = event.name;
+            std::replace(name.begin(), name.end(), '"', '\'');
+            std::replace(name.begin(), name.end(), '\\', '/');
+            os << "{\"name\":\"" << name << "\",\"cat\":\"gui\",\"ph\":\"X\""
+               << ",\"ts\":" << event.startUs << ",\"dur\":" << event.durationUs
+               << ",\"pid\":1,\"tid\":" << event.threadIdx
+               << ",\"args\":{\"frame\":" << event.frameIdx
+               << ",\"allocations\":" << event.nbAllocations << ",\"bytes\":" << event.nbBytes << "}}";
+        }
+        os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+        return os.good();
+    }
+
+    namespace
+    {
+        struct ScopeStats
+        {
+            double totalUs = 0.;
+            double maxFrameUs = 0.;
+            int nbCalls = 0;
+            uint64_t nbAllocations = 0;
+            uint64_t nbBytes = 0;
+        };
+
+        void ShowScopeStatsTable(const std::vector<ScopeEvent>& events, uint64_t firstFrame, uint64_t lastFrame)
+        {
+            // Sum the durations per scope and per frame
+            std::map<std::string, std::map<uint64_t, double>> durationsPerScopeAndFrame;
+            std::map<std::string, ScopeStats> statsPerScope;
+            for (const auto& event: events)
+            {
+                if (event.frameIdx < firstFrame || event.frameIdx > lastFrame)
+                    continue;
+                durationsPerScopeAndFrame[event.name][event.frameIdx] += event.durationUs;
+                auto& stats = statsPerScope[event.name];
+                stats.totalUs += event.durationUs;
+                ++stats.nbCalls;
+                stats.nbAllocations += event.nbAllocations;
+                stats.nbBytes += event.nbBytes;
+            }
+            for (auto& kv: statsPerScope)
+                for (const auto& frameDuration: durationsPerScopeAndFrame[kv.first])
+                    kv.second.maxFrameUs = std::max(kv.second.maxFrameUs, frameDuration.second);
+
+            double nbFrames = (double)(lastFrame - firstFrame + 1);
+            bool showAllocations = AllocationTracker::IsEnabled();
+            ImGuiTableFlags tableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit;
+            if (ImGui::BeginTable("ScopeStats", showAllocations ? 6 : 4, tableFlags))
+            {
+                ImGui::TableSetupColumn("Scope", ImGuiTableColumnFlags_WidthStretch);
+                ImGui::TableSetupColumn("Avg (ms/frame)");
+                ImGui::TableSetupColumn("Max (ms/frame)");
+                ImGui::TableSetupColumn("Calls/frame");
+                if (showAllocations)
+                {
+                    ImGui::TableSetupColumn("Allocs/frame");
+                    ImGui::TableSetupColumn("KB/frame");
+                }
+                ImGui::TableHeadersRow();
+                for (const auto& kv: statsPerScope)
+                {
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn(); ImGui::TextUnformatted(kv.first.c_str());
+                    ImGui::TableNextColumn(); ImGui::Text("%.3f", kv.second.totalUs / nbFrames / 1000.);
+                    ImGui::TableNextColumn(); ImGui::Text("%.3f", kv.second.maxFrameUs / 1000.);
+                    ImGui::TableNextColumn(); ImGui::Text("%.1f", (double)kv.second.nbCalls / nbFrames);
+                    if (showAllocations)
+                    {
+                        ImGui::TableNextColumn(); ImGui::Text("%.1f", (double)kv.second.nbAllocations / nbFrames);
+                        ImGui::TableNextColumn(); ImGui::Text("%.2f", (double)kv.second.nbBytes / nbFrames / 1024.);
+                    }
+                }
+                ImGui::EndTable();
+            }
+        }
+
+        void ShowFlameChart(const std::vector<ScopeEvent>& events, uint64_t firstFrame, uint64_t lastFrame)
+        {
+            const FrameStart& firstFrameStart = gFrameStarts[firstFrame % NbFramesKept];
+            const FrameStart& endFrameStart = gFrameStarts[(lastFrame + 1) % NbFramesKept];
+            if (firstFrameStart.frameIdx != firstFrame || endFrameStart.frameIdx != lastFrame + 1)
+                return;
+            double t0 = firstFrameStart.startUs, t1 = endFrameStart.startUs;
+            if (t1 <= t0)
+                return;
+
+            const float rowHeight = ImGui::GetTextLineHeight() + 2.f;
+            int maxDepth = 0;
+            for (const auto& event: events)
+                if (event.frameIdx >= firstFrame && event.frameIdx <= lastFrame && event.threadIdx == gGuiThreadIdx)
+                    maxDepth = std::max(maxDepth, event.depth);
+
+            ImVec2 origin = ImGui::GetCursorScreenPos();
+            float width = ImGui::GetContentRegionAvail().x;
+            float height = rowHeight * (float)(maxDepth + 1);
+            ImGui::InvisibleButton("FlameChart", ImVec2(width, height));
+            ImDrawList *drawList = ImGui::GetWindowDrawList();
+            auto toX = [&](double us) { return origin.x + (float)((us - t0) / (t1 - t0)) * width; };
+
+            // Frame separators
+            for (uint64_t frameIdx = firstFrame + 1; frameIdx <= lastFrame; ++frameIdx)
+            {
+                const FrameStart& frameStart = gFrameStarts[frameIdx % NbFramesKept];
+                if (frameStart.frameIdx != frameIdx)
+                    continue;
+                float x = toX(frameStart.startUs);
+                drawList->AddLine(ImVec2(x, origin.y), ImVec2(x, origin.y + height), IM_COL32(255, 255, 255, 80));
+            }
+
+            const ScopeEvent *hoveredEvent = nullptr;
+            ImVec2 mousePos = ImGui::GetMousePos();
+            for (const auto& event: events)
+            {
+                if (event.frameIdx < firstFrame || event.frameIdx > lastFrame || event.threadIdx != gGuiThreadIdx)
+                    continue;
+                ImVec2 a(toX(event.startUs), origin.y + rowHeight * (float)event.depth);
+                ImVec2 b(std::max(toX(event.startUs + event.durationUs), a.x + 1.f), a.y + rowHeight - 1.f);
+                drawList->AddRectFilled(a, b, ColorOfName(event.name));
+                if (b.x - a.x > 30.f)
+                {
+                    ImVec4 clipRect(a.x, a.y, b.x - 2.f, b.y);
+                    drawList->AddText(nullptr, 0.f, ImVec2(a.x + 2.f, a.y + 1.f), IM_COL32_BLACK, event.name, nullptr, 0.f, &clipRect);
+                }
+                if (ImGui::IsItemHovered() && mousePos.x >= a.x && mousePos.x < b.x && mousePos.y >= a.y && mousePos.y < b.y)
+                    hoveredEvent = &event;
+            }
+            if (hoveredEvent != nullptr)
+                ImGui::SetTooltip("%s\n%.3f ms (frame %llu)", hoveredEvent->name, hoveredEvent->durationUs / 1000., (unsigned long long)hoveredEvent->frameIdx);
+        }
+    }
+
+    void ShowOverlay(bool *p_open)
+    {
+        static int nbFramesStats = 60;
+        static int nbFramesFlameChart = 3;
+        static bool paused = false;
+        static uint64_t pausedFrameIdx = 0;
+        static std::string exportStatus;
+        // The events of the last NbFramesKept frames (at most as many as the ring buffer holds),
+        // updated with the events published since the last frame
+        static std::vector<ScopeEvent> events;
+        static uint64_t nextEventIdx = 0;
+
+        ImGui::SetNextWindowSize(ImVec2(600.f, 400.f), ImGuiCond_FirstUseEver);
+        ImGui::SetNextWindowBgAlpha(0.85f);
+        if (!ImGui::Begin("Profiler", p_open, ImGuiWindowFlags_NoDocking))
+        {
+            ImGui::End();
+            return;
+        }
+
+        if (ImGui::Checkbox("Pause", &paused) && paused)
+            pausedFrameIdx = gFrameIdx;
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(100.f);
+        ImGui::SliderInt("Stats frames", &nbFramesStats, 1, (int)NbFramesKept - 2);
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(100.f);
+        ImGui::SliderInt("Flame chart frames", &nbFramesFlameChart, 1, 30);
+        ImGui::SameLine();
+        if (ImGui::Button("Export Chrome trace"))
+        {
+            std::string filename = "imgui_manual_trace.json";
+            exportStatus = ExportChromeTrace(filename) ? "Saved " + filename : "Could not write " + filename;
+        }
+        if (!exportStatus.empty())
+        {
+            ImGui::SameLine();
+            ImGui::TextDisabled("%s", exportStatus.c_str());
+        }
+
+        bool trackAllocations = AllocationTracker::IsEnabled();
+        if (ImGui::Checkbox("Track allocations", &trackAllocations))
+            AllocationTracker::SetEnabled(trackAllocations);
+        if (trackAllocations)
+        {
+            auto lastFrameAllocations = AllocationTracker::LastFrameCounters();
+            ImGui::SameLine();
+            ImGui::Text("Last frame: %llu allocations, %.2f KB",
+                        (unsigned long long)lastFrameAllocations.nbAllocations,
+                        (double)lastFrameAllocations.nbBytes / 1024.);
+            if (!AllocationTracker::IsOperatorNewHooked())
+            {
+                ImGui::SameLine();
+                ImGui::TextDisabled("(ImGui allocations only: build with IMGUI_MANUAL_TRACK_ALLOCATIONS=ON to track operator new)");
+            }
+        }
+
+        // The current frame is not complete yet: only show finished frames
+        // (there are none until the profiler was enabled during a whole frame)
+        uint64_t frameIdx = paused ? pausedFrameIdx : gFrameIdx.load();
+        uint64_t lastFrame = (frameIdx > 0) ? frameIdx - 1 : 0;
+        if (!paused)
+        {
+            nextEventIdx = gEvents.appendSince(nextEventIdx, events);
+            uint64_t oldestFrameKept = lastFrame > NbFramesKept ? lastFrame - NbFramesKept : 0;
+            events.erase(
+                std::remove_if(events.begin(), events.end(), [oldestFrameKept](const ScopeEvent& event) { return event.frameIdx < oldestFrameKept; }),
+                events.end());
+            if (events.size() > EventRingBuffer::Capacity)
+                events.erase(events.begin(), events.end() - EventRingBuffer::Capacity);
+        }
+
+        if (lastFrame > (uint64_t)nbFramesFlameChart)
+        {
+            ImGui::SeparatorText("Flame chart");
+            ShowFlameChart(events, lastFrame - (uint64_t)nbFramesFlameChart + 1, lastFrame);
+        }
+        if (lastFrame > (uint64_t)nbFramesStats)
+        {
+            ImGui::SeparatorText("Timings per scope");
+            ShowScopeStatsTable(events, lastFrame - (uint64_t)nbFramesStats + 1, lastFrame);
+        }
+        ImGui::End();
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+
+// A light CPU profiler for the manual's frames.
+//
+// Scoped timings are recorded into a lock-free ring buffer (any thread may record),
+// and can be displayed in an overlay (per scope timings + flame chart of the last frames),
+// or exported as a Chrome trace file (open it with chrome://tracing or https://ui.perfetto.dev).
+// When AllocationTracker is enabled, the scopes also record the heap allocations done inside them.
+//
+// Usage:
+//     void MyGui()
+//     {
+//         FRAME_PROFILER_SCOPE("MyGui");
+//         ...
+//     }
+namespace FrameProfiler
+{
+    // Recording is disabled by default: ScopedTimer then costs a single test
+    void SetEnabled(bool enabled);
+    bool IsEnabled();
+
+    // Shall be called once per frame, before ImGui::NewFrame()
+    void BeginFrame();
+
+    // Scope names are not copied: they shall outlive the profiler (string literals, or InternName())
+    class ScopedTimer
+    {
+    public:
+        explicit ScopedTimer(const char *name);
+        ~ScopedTimer();
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+    private:
+        const char *mName;
+        double mStartUs;
+        uint64_t mNbAllocationsStart = 0, mNbBytesStart = 0;
+    };
+
+    // Returns a persistent copy of a scope name
+    const char *InternName(const std::string& name);
+
+    // Returns a function that calls fn inside a scope named name
+    std::function<void(void)> InstrumentFunction(const std::string& name, const std::function<void(void)>& fn);
+
+    void ShowOverlay(bool *p_open);
+
+    // Writes the recorded timings in the Chrome trace event format
+    bool ExportChromeTrace(const std::string& filename);
+}
+
+#define FRAME_PROFILER_CONCAT_IMPL(a, b) a##b
+#define FRAME_PROFILER_CONCAT(a, b) FRAME_PROFILER_CONCAT_IMPL(a, b)
+#define FRAME_PROFILER_SCOPE(name) FrameProfiler::ScopedTimer FRAME_PROFILER_CONCAT(frameProfilerScope_, __LINE__)(name)
@@ -1,11 +1,12 @@
 #pragma once
 #include "imgui.h"
 #include <string>
+#include <string_view>
 
 namespace MarkdownHelper
 {
     extern ImFont *fontH1, *fontH2, *fontH3;
 
     void LoadFonts();
-    void Markdown(const std::string &markdown_);
+    void Markdown(std::string_view markdown_);
 }
\ No newline at end of file
@@ -1,7 +1,10 @@
 #include "hello_imgui/hello_imgui.h"
 #include "hello_imgui/icons_font_awesome_4.h"
+#include "imgui_utilities/FrameProfiler.h"
 #include "GuiHeaderTree.h"
 
+#include <functional>
+
 namespace SourceParse
 {
 
@@ -31,8 +34,6 @@ ImGuiTreeNodeFlags makeTreeNodeFlags(bool isLeafNode, bool isSelected)
 
 int GuiHeaderTree::guiImpl(int currentEditorLineNumber, const HeaderTree& headerTree, bool isRootNode)
 {
-    using namespace std::literals;
-
     const auto &lineWithTag = headerTree.value_;
     int clickedLineNumber = -1;
 
@@ -51,9 +52,6 @@ int GuiHeaderTree::guiImpl(int currentEditorLineNumber, const HeaderTree& header
 
     ImGuiTreeNodeFlags treeNodeFlags = makeTreeNodeFlags(isLeafNode, isSelected);
 
-    std::string title = lineWithTag.tag
-                        + "##" + std::to_string(lineWithTag.lineNumber);
-
     if (mExpandCollapseAction == ExpandCollapseAction::CollapseAll)
         ImGui::SetNextItemOpen(false, ImGuiCond_Always);
     if (mExpandCollapseAction == ExpandCollapseAction::ExpandAll)
@@ -64,7 +62,9 @@ int GuiHeaderTree::guiImpl(int currentEditorLineNumber, const HeaderTree& header
         isNodeOpen = true;
     else
     {
-        isNodeOpen = ImGui::TreeNodeEx(title.c_str(), treeNodeFlags);
+        // The node's ID depends on its tag (not on its line), so that it stays open when the source is edited
+        // (siblings with the same tag are told apart by the caller's PushID)
+        isNodeOpen = ImGui::TreeNodeEx(lineWithTag.tag.c_str(), treeNodeFlags);
         if (ImGui::IsItemClicked())
             clickedLineNumber = lineWithTag.lineNumber;
     }
@@ -74,9 +74,19 @@ int GuiHeaderTree::guiImpl(int currentEditorLineNumber, const HeaderTree& header
         auto showChildrenNodes = [this, &headerTree, currentEditorLineNumber]()
         {
           int clickedLineNumber_Child = -1;
-          for(const auto& headerTreeChild: headerTree.children_)
+          const auto& children = headerTree.children_;
+          for (size_t i = 0; i < children.size(); ++i)
           {
+              const auto& headerTreeChild = children[i];
+              // Siblings may share a tag (e.g. "Parameters stacks (shared)" and "(current window)" in imgui.h):
+              // the ID includes the rank of the child among the previous siblings with the same tag
+              int sameTagRank = 0;
+              for (size_t j = 0; j < i; ++j)
+                  if (children[j].value_.tag == headerTreeChild.value_.tag)
+                      ++sameTagRank;
+              ImGui::PushID(sameTagRank);
               int line = guiImpl(currentEditorLineNumber, headerTreeChild, false);
+              ImGui::PopID();
               if (line > 0)
                   clickedLineNumber_Child = line;
           }
@@ -95,12 +105,12 @@ int GuiHeaderTree::guiImpl(int currentEditorLineNumber, const HeaderTree& header
 
 bool DrawImGuiTextFilterWithTooltip(
     ImGuiTextFilter &imGuiTextFilter,
-    const std::string &tooltipText =
+    const char *tooltipText =
         "Filter usage:[-excl],incl\n"
         "For example:\n"
         "   \"button\" will search for \"button\"\n"
         "   \"-widget,button\" will search for \"button\" without \"widget\"",
-    const std::string& filterLabel =
+    const char *filterLabel =
         "Filter usage:[-excl],incl"
     )
 {
@@ -112,12 +122,12 @@ bool DrawImGuiTextFilterWithTooltip(
     {
         ImGui::BeginTooltip();
         ImGui::PushTextWrapPos(ImGui::GetFontSize() * 35.0f);
-        ImGui::TextUnformatted(tooltipText.c_str());
+        ImGui::TextUnformatted(tooltipText);
         ImGui::PopTextWrapPos();
         ImGui::EndTooltip();
     }
     ImGui::SetNextItemWidth(200.f);
-    return imGuiTextFilter.Draw(filterLabel.c_str());
+    return imGuiTextFilter.Draw(filterLabel);
 }
 
 
@@ -125,6 +135,7 @@ bool DrawImGuiTextFilterWithTooltip(
 // return a line number if the user selected a tag, returns -1 otherwise
 int GuiHeaderTree::gui(int currentEditorLineNumber)
 {
+    FRAME_PROFILER_SCOPE("GuiHeaderTree::gui");
     ImGui::Checkbox("Show Table Of Content", &mShowToc);
     if (!mShowToc)
         return -1;
@@ -164,6 +175,40 @@ void GuiHeaderTree::showExpandCollapseButtons()
         mExpandCollapseAction = ExpandCollapseAction::CollapseAll;
 }
 
+void GuiHeaderTree::setFilter(const std::string& filter)
+{
+    snprintf(mFilter.InputBuf, IM_ARRAYSIZE(mFilter.InputBuf), "%s", filter.c_str());
+    mFilter.Build();
+    applyTocFilter();
+}
+
+void GuiHeaderTree::updateLinesWithTags(const LinesWithTags& linesWithTags)
+{
+    // The tree nodes, in the order of linesWithTags (pre-order)
+    std::vector<HeaderTree*> nodes;
+    std::function<void(HeaderTree&)> collectNodes = [&nodes, &collectNodes](HeaderTree& tree) {
+        for (auto& child: tree.children_)
+        {
+            nodes.push_back(&child);
+            collectNodes(child);
+        }
+    };
+    collectNodes(mHeaderTree);
+
+    bool sameHeaders = (nodes.size() == linesWithTags.size());
+    for (size_t i = 0; sameHeaders && i < nodes.size(); ++i)
+        sameHeaders = (nodes[i]->value_.tag == linesWithTags[i].tag) && (nodes[i]->value_.level == linesWithTags[i].level);
+
+    if (sameHeaders)
+    {
+        for (size_t i = 0; i < nodes.size(); ++i)
+            nodes[i]->value_.lineNumber = linesWithTags[i].lineNumber;
+    }
+    else
+        mHeaderTree = makeHeaderTree(linesWithTags);
+    applyTocFilter();
+}
+
 void GuiHeaderTree::applyTocFilter()
 {
     auto lambdaPassFilter = [this](const LineWithTag& t) {
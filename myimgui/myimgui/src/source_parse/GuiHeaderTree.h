@@ -17,6 +17,14 @@ namespace SourceParse
         virtual int gui(int currentEditorLineNumber);
 
         void setShowToc(bool v) { mShowToc = v; }
+        // Sets the TOC filter, as if it had been typed by the user
+        void setFilter(const std::string& filter);
+        // Expands / collapses all the nodes at the next frame, as if the buttons had been clicked
+        void expandAll() { mExpandCollapseAction = ExpandCollapseAction::ExpandAll; }
+        void collapseAll() { mExpandCollapseAction = ExpandCollapseAction::CollapseAll; }
+        // Updates the tree after the source was edited: when only the line numbers changed,
+        // the nodes are patched in place (and keep their open / closed state); otherwise the tree is rebuilt.
+        void updateLinesWithTags(const LinesWithTags& linesWithTags);
 
     protected:
         int guiImpl(int currentEditorLineNumber, const HeaderTree& headerTree, bool isRootNode);
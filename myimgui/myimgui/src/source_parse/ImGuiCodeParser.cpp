@@ -318,7 +318,7 @@ AnnotatedSource ReadImGuiHeaderDoc()
     std::string sourcePath = "imgui/imgui.h";
     AnnotatedSource r;
     r.source = ReadSource(sourcePath);
-    r.linesWithTags = findImGuiHeaderDoc(r.source.sourceCode);
+    r.linesWithTags = findImGuiHeaderDoc(*r.source.sourceCode);
     return r;
 }
 
@@ -395,7 +395,7 @@ AnnotatedSource ReadImGuiCppDoc()
     std::string sourcePath = "imgui/imgui.cpp";
     AnnotatedSource r;
     r.source = ReadSource(sourcePath);
-    r.linesWithTags = findImGuiCppDoc(r.source.sourceCode);
+    r.linesWithTags = findImGuiCppDoc(*r.source.sourceCode);
     return r;
 }
 
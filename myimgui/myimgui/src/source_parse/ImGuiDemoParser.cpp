@@ -1,46 +1,42 @@
 #include <fplus/fplus.hpp>
-#include "source_parse/Sources.h"
+#include "source_parse/ImGuiDemoParser.h"
+
+#include <algorithm>
+#include <optional>
 
 using namespace std::literals;
 
 namespace SourceParse
 {
 
-LinesWithTags findImGuiDemoCodeLines(const std::string &sourceCode)
+// codeLine look like "    IMGUI_DEMO_MARKER("Menu/Tools");"
+// And in this case, we return {lineNumber, "Menu/Tools", level 2}
+// (lines with an incomplete marker, as can be found while it is typed in the editor, are ignored)
+std::optional<LineWithTag> parseDemoMarkerLine(int lineNumber, const std::string& codeLine)
 {
-    static std::string regionToken = "IMGUI_DEMO_MARKER";
-
-    auto lines = fplus::split('\n', true, sourceCode);
-    auto numberedLines = fplus::enumerate(lines);
-
-    auto demoCodeLines = fplus::keep_if([](const NumberedLine& v) {
-        return fplus::is_prefix_of("IMGUI_DEMO_MARKER("s, fplus::trim_whitespace_left(v.second));
-    }, numberedLines);
-
-    LinesWithTags tags = fplus::transform([](const NumberedLine& v) {
-        LineWithTag r;
-        // codeLine look like "    IMGUI_DEMO_MARKER("Menu/Tools");"
-        // And for a tag like this, the title should be "Tools", and the level should be 2
-        std::string codeLine = v.second;
-
-        r.lineNumber = (int)v.first;
-        {
-            // codeLine look like
-            //          IMGUI_DEMO_MARKER("Menu/Tools");
-            // And in this case, we return {"Menu/Tools"}
-            auto tokens = fplus::split('"', true, codeLine);
-            assert(tokens.size() >= 3);
-            std::string tagsString = tokens[1];
-
-            r.tag = tagsString;
-            r.level = fplus::count('/', r.tag) + 1;
-        }
-        return r;
-    }, demoCodeLines);
+    if (!fplus::is_prefix_of("IMGUI_DEMO_MARKER("s, fplus::trim_whitespace_left(codeLine)))
+        return std::nullopt;
+    auto tokens = fplus::split('"', true, codeLine);
+    if (tokens.size() < 3)
+        return std::nullopt;
+
+    LineWithTag r;
+    r.lineNumber = lineNumber;
+    r.tag = tokens[1];
+    r.level = (int)fplus::split('/', false, r.tag).size();
+    if (r.level == 0)
+        return std::nullopt;
+    return r;
+}
 
+// Adds the intermediate headers which are implied by the markers,
+// e.g. "Widgets" before the first "Widgets/Basic", and simplifies the tags to their last level.
+// The full tag of each marker is kept inside _original_tag_full
+LinesWithTags addMissingDemoHeaders(const LinesWithTags& markers)
+{
     LinesWithTags tags_with_added_missing_headers;
     int last_level = 0;
-    for (auto tag_copy: tags)
+    for (auto tag_copy: markers)
     {
         std::vector<std::string> tag_levels = fplus::split('/', false, tag_copy.tag);
         while (tag_copy.level > last_level + 1)
@@ -62,13 +58,103 @@ LinesWithTags findImGuiDemoCodeLines(const std::string &sourceCode)
     return tags_with_added_missing_headers;
 }
 
+LinesWithTags findImGuiDemoCodeLines(const std::string &sourceCode)
+{
+    auto lines = fplus::split('\n', true, sourceCode);
+
+    LinesWithTags markers;
+    for (size_t i = 0; i < lines.size(); ++i)
+    {
+        auto marker = parseDemoMarkerLine((int)i, lines[i]);
+        if (marker.has_value())
+            markers.push_back(*marker);
+    }
+    return addMissingDemoHeaders(markers);
+}
+
+
+void UpdateImGuiDemoCodeLines(
+    LinesWithTags& linesWithTags,
+    const std::vector<LinesChange>& changes,
+    int nbLines,
+    const std::function<std::string(int lineNumber)>& getLine)
+{
+    if (changes.empty())
+        return;
+
+    // The markers, with their full tag (the headers added by addMissingDemoHeaders are rebuilt at the end)
+    LinesWithTags markers;
+    for (const auto& lineWithTag: linesWithTags)
+    {
+        if (lineWithTag._original_tag_full.empty())
+            continue;
+        LineWithTag marker = lineWithTag;
+        marker.tag = lineWithTag._original_tag_full;
+        marker._original_tag_full.clear();
+        markers.push_back(marker);
+    }
+
+    // Apply the changes in order: the markers of the replaced lines are dropped, and the ones below are shifted.
+    // The replacing lines are the dirty intervals [first, last), which will be scanned again.
+    std::vector<std::pair<int, int>> dirtyIntervals;
+    for (const auto& change: changes)
+    {
+        int changeEnd = change.line + change.nbLinesBefore;
+        int delta = change.nbLinesAfter - change.nbLinesBefore;
+
+        LinesWithTags shiftedMarkers;
+        for (auto marker: markers)
+        {
+            if (marker.lineNumber >= change.line && marker.lineNumber < changeEnd)
+                continue;
+            if (marker.lineNumber >= changeEnd)
+                marker.lineNumber += delta;
+            shiftedMarkers.push_back(marker);
+        }
+        markers = std::move(shiftedMarkers);
+
+        std::pair<int, int> changed = { change.line, change.line + change.nbLinesAfter };
+        std::vector<std::pair<int, int>> shiftedIntervals;
+        for (auto interval: dirtyIntervals)
+        {
+            if (interval.second < change.line)
+                shiftedIntervals.push_back(interval);
+            else if (interval.first > changeEnd)
+                shiftedIntervals.push_back({ interval.first + delta, interval.second + delta });
+            else
+            {
+                // Overlapping or adjacent: merge it into the changed lines
+                changed.first = std::min(changed.first, interval.first);
+                if (interval.second > changeEnd)
+                    changed.second = std::max(changed.second, interval.second + delta);
+            }
+        }
+        if (changed.second > changed.first)
+            shiftedIntervals.push_back(changed);
+        dirtyIntervals = std::move(shiftedIntervals);
+    }
+
+    for (const auto& interval: dirtyIntervals)
+        for (int lineNumber = interval.first; lineNumber < std::min(interval.second, nbLines); ++lineNumber)
+        {
+            auto marker = parseDemoMarkerLine(lineNumber, getLine(lineNumber));
+            if (marker.has_value())
+                markers.push_back(*marker);
+        }
+
+    std::stable_sort(markers.begin(), markers.end(), [](const LineWithTag& a, const LineWithTag& b) {
+        return a.lineNumber < b.lineNumber;
+    });
+    linesWithTags = addMissingDemoHeaders(markers);
+}
+
 
 AnnotatedSource ReadImGuiDemoCode()
 {
     std::string sourcePath = "imgui/imgui_demo.cpp";
     AnnotatedSource r;
     r.source = ReadSource(sourcePath);
-    r.linesWithTags = findImGuiDemoCodeLines(r.source.sourceCode);
+    r.linesWithTags = findImGuiDemoCodeLines(*r.source.sourceCode);
     return r;
 }
 
@@ -77,7 +163,7 @@ AnnotatedSource ReadImGuiDemoCodePython()
     std::string sourcePath = "imgui_manual/imgui_demo_python/imgui_demo.py";
     AnnotatedSource r;
     r.source = ReadSource(sourcePath);
-    r.linesWithTags = findImGuiDemoCodeLines(r.source.sourceCode);
+    r.linesWithTags = findImGuiDemoCodeLines(*r.source.sourceCode);
     return r;
 }
 
@@ -98,7 +184,7 @@ std::unordered_map<std::string, SourceCode> FindExampleAppsCode()
      */
 
     // Step 1 : find all section starts
-    auto numberedLines = fplus::enumerate(fplus::split_lines(true, sourceFile.sourceCode));
+    auto numberedLines = fplus::enumerate(fplus::split_lines(true, *sourceFile.sourceCode));
     auto isLineExampleAppSectionStarts = [&numberedLines](const NumberedLine& numberedLine) {
         size_t lineNumber = numberedLine.first;
         if (lineNumber >= numberedLines.size() - 1)
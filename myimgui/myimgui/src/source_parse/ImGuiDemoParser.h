@@ -1,10 +1,30 @@
 #pragma once
+#include <functional>
 #include <unordered_map>
+#include <vector>
 #include "source_parse/Sources.h"
 
 namespace SourceParse
 {
     AnnotatedSource ReadImGuiDemoCode();
     AnnotatedSource ReadImGuiDemoCodePython();
+    LinesWithTags findImGuiDemoCodeLines(const std::string& sourceCode);
     std::unordered_map<std::string, SourceCode> FindExampleAppsCode();
+
+    // The lines [line, line + nbLinesBefore) of a source were replaced by the lines [line, line + nbLinesAfter)
+    struct LinesChange
+    {
+        int line;
+        int nbLinesBefore;
+        int nbLinesAfter;
+    };
+
+    // Updates the tags returned by ReadImGuiDemoCode() after some edits of the demo code:
+    // only the changed lines are scanned again for IMGUI_DEMO_MARKER (getLine returns the current text of a line),
+    // and the markers below them are shifted.
+    void UpdateImGuiDemoCodeLines(
+        LinesWithTags& linesWithTags,
+        const std::vector<LinesChange>& changes, // in the order of the edits
+        int nbLines,
+        const std::function<std::string(int lineNumber)>& getLine);
 } // namespace SourceParse
@@ -1,6 +1,7 @@
 #include "hello_imgui/hello_imgui_assets.h"
 #include <fplus/fplus.hpp>
 #include <imgui.h>
+#include <unordered_map>
 #include "Sources.h"
 
 using namespace std::literals;
@@ -12,6 +13,13 @@ namespace {
         r = fplus::keep_if([](auto s) { return !s.empty();}, r);
         return r;
     };
+
+    // The texts returned by ReadSource, by path: they are not owned by the store
+    std::unordered_map<SourceParse::SourcePath, std::weak_ptr<const SourceParse::SourceCode>>& SourceStore()
+    {
+        static std::unordered_map<SourceParse::SourcePath, std::weak_ptr<const SourceParse::SourceCode>> store;
+        return store;
+    }
 }
 
 namespace SourceParse
@@ -132,14 +140,35 @@ std::vector<Library> acknowldegmentLibraries()
 
 SourceFile ReadSource(const std::string sourcePath)
 {
+    SourceFile r;
+    r.sourcePath = sourcePath;
+
+    auto& storedCode = SourceStore()[sourcePath];
+    r.sourceCode = storedCode.lock();
+    if (r.sourceCode)
+        return r;
+
     std::string assetPath = std::string("code/") + sourcePath;
     auto assetData = HelloImGui::LoadAssetFileData(assetPath.c_str());
     assert(assetData.data != nullptr);
-
-    SourceFile r;
-    r.sourcePath = sourcePath;
-    r.sourceCode = std::string((const char *) assetData.data);
+    r.sourceCode = std::make_shared<const SourceCode>((const char *) assetData.data);
     HelloImGui::FreeAssetFileData(&assetData);
+
+    storedCode = r.sourceCode;
+    return r;
+}
+
+SourceStoreStats GetSourceStoreStats()
+{
+    SourceStoreStats r;
+    for (const auto& kv: SourceStore())
+    {
+        if (auto sourceCode = kv.second.lock())
+        {
+            ++r.nbFiles;
+            r.nbBytes += sourceCode->size();
+        }
+    }
     return r;
 }
 
@@ -2,6 +2,7 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <memory>
 #include <ostream>
 
 
@@ -11,10 +12,13 @@ using SourceCode = std::string;
 using SourcePath = std::string;
 using LibraryFolderPath = std::string;
 
+// The text of a source file: it is immutable, and shared by all the readers of the file (see ReadSource)
+using SharedSourceCode = std::shared_ptr<const SourceCode>;
+
 struct SourceFile
 {
     SourcePath sourcePath;
-    SourceCode sourceCode;
+    SharedSourceCode sourceCode;
 };
 
 struct LineWithTag
@@ -51,8 +55,19 @@ std::vector<Library> otherLibraries();
 std::vector<Library> acknowldegmentLibraries();
 
 
+// Reads a source file from the assets. A file is read only once while its text is held by a reader:
+// ReadSource then returns the same shared text (its memory is released with the last reader).
+// Not thread safe: use it from the gui thread only.
 SourceFile ReadSource(const std::string sourcePath);
 
+// The source files currently held in memory by their readers
+struct SourceStoreStats
+{
+    size_t nbFiles = 0;
+    size_t nbBytes = 0;
+};
+SourceStoreStats GetSourceStoreStats();
+
 inline std::ostream& operator<<(std::ostream& os, const SourceParse::LineWithTag& t)
 {
     os << "{line:" << t.lineNumber << ", " << t.tag << ", level:" << t.level << "}";
@@ -0,0 +1,149 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "imgui_utilities/AllocationTracker.h"
+#include "imgui_utilities/FrameArena.h"
+#include "source_parse/GuiHeaderTree.h"
+#include "TextEditor.h"
+#include "imgui.h"
+
+#include <array>
+#include <memory>
+
+using namespace SourceParse;
+
+namespace
+{
+    // A headless ImGui context: no backend, the font atlas is built but not uploaded
+    struct HeadlessImGui
+    {
+        HeadlessImGui()
+        {
+            AllocationTracker::InstallImGuiAllocator();
+            ImGui::CreateContext();
+            ImGuiIO& io = ImGui::GetIO();
+            io.IniFilename = nullptr;
+            io.DisplaySize = ImVec2(1280.f, 800.f);
+            io.DeltaTime = 1.f / 60.f;
+            unsigned char *pixels;
+            int width, height;
+            io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+        }
+        ~HeadlessImGui()
+        {
+            AllocationTracker::SetEnabled(false);
+            ImGui::DestroyContext();
+        }
+
+        // Runs nbWarmupFrames, then returns the allocations done during one more frame
+        template<typename GuiFunction>
+        AllocationTracker::Counters measureIdleFrame(GuiFunction gui, int nbWarmupFrames = 10)
+        {
+            for (int i = 0; i < nbWarmupFrames; ++i)
+                runFrame(gui);
+            AllocationTracker::SetEnabled(true);
+            auto before = AllocationTracker::ThreadCounters();
+            runFrame(gui);
+            auto after = AllocationTracker::ThreadCounters();
+            AllocationTracker::SetEnabled(false);
+            return after - before;
+        }
+
+        template<typename GuiFunction>
+        void runFrame(GuiFunction gui)
+        {
+            FrameArena::Reset();
+            ImGui::NewFrame();
+            gui();
+            ImGui::Render();
+        }
+    };
+
+    LinesWithTags makeTocLines()
+    {
+        LinesWithTags r;
+        for (int i = 0; i < 40; ++i)
+        {
+            std::string tag = "A rather long table of content entry #" + std::to_string(i);
+            r.push_back({ i * 10, tag, 1 + i % 3 });
+        }
+        return r;
+    }
+}
+
+TEST_CASE("AllocationTracker counts operator new and ImGui allocations")
+{
+    HeadlessImGui headlessImGui;
+    CHECK(AllocationTracker::IsOperatorNewHooked());
+
+    AllocationTracker::SetEnabled(true);
+    auto before = AllocationTracker::ThreadCounters();
+    auto values = std::make_unique<std::array<int, 100>>();
+    void *imguiBuffer = ImGui::MemAlloc(64);
+    auto after = AllocationTracker::ThreadCounters();
+    AllocationTracker::SetEnabled(false);
+    ImGui::MemFree(imguiBuffer);
+
+    auto diff = after - before;
+    CHECK(diff.nbAllocations == 2);
+    CHECK(diff.nbBytes == sizeof(std::array<int, 100>) + 64);
+
+    // Nothing is counted while disabled
+    before = AllocationTracker::ThreadCounters();
+    auto otherValues = std::make_unique<int>(3);
+    CHECK((AllocationTracker::ThreadCounters() - before).nbAllocations == 0);
+}
+
+// The same check on the whole manual is done by imgui_manual_bench --check-idle-allocations (test imgui_manual_idle_allocations)
+TEST_CASE("An idle frame with the demo window and an editor does no heap allocation after warm-up")
+{
+    HeadlessImGui headlessImGui;
+    TextEditor editor;
+    editor.SetLanguageDefinition(TextEditor::LanguageDefinition::CPlusPlus());
+    std::string code;
+    for (int i = 0; i < 200; ++i)
+        code += "int value_" + std::to_string(i) + " = " + std::to_string(i) + "; // a comment\n";
+    editor.SetText(code);
+
+    auto allocations = headlessImGui.measureIdleFrame([&editor] {
+        ImGui::ShowDemoWindow();
+        ImGui::Begin("Editor");
+        editor.Render("Code");
+        ImGui::End();
+    });
+    CHECK(allocations.nbAllocations == 0);
+}
+
+TEST_CASE("An idle frame with a table of content does no heap allocation after warm-up")
+{
+    HeadlessImGui headlessImGui;
+    GuiHeaderTree guiHeaderTree(makeTocLines());
+
+    auto allocations = headlessImGui.measureIdleFrame([&guiHeaderTree] {
+        ImGui::Begin("TOC");
+        guiHeaderTree.gui(-1);
+        ImGui::End();
+    });
+    CHECK(allocations.nbAllocations == 0);
+}
+
+TEST_CASE("FrameArena reuses its blocks after Reset")
+{
+    auto useArena = [] {
+        FrameArena::Reset();
+        FrameArena::Vector<int> values = FrameArena::MakeVector<int>();
+        for (int i = 0; i < 100000; ++i)
+            values.push_back(i);
+        FrameArena::String label = FrameArena::Format("%s##%d", "A rather long label, beyond small string optimization", 42);
+        CHECK(label == "A rather long label, beyond small string optimization##42");
+    };
+
+    useArena(); // warm-up: the arena grows, and merges its blocks at the next Reset
+    useArena();
+    AllocationTracker::SetEnabled(true);
+    auto before = AllocationTracker::ThreadCounters();
+    useArena();
+    auto after = AllocationTracker::ThreadCounters();
+    AllocationTracker::SetEnabled(false);
+    CHECK((after - before).nbAllocations == 0);
+}
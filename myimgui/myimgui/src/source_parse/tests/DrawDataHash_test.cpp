@@ -0,0 +1,96 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "hello_imgui/internal/draw_data_hash.h"
+#include "imgui.h"
+
+#include <cstdint>
+
+using HelloImGui::Internal::HashDrawData;
+
+namespace
+{
+    // A headless ImGui context, with a built fonts atlas
+    struct HeadlessImGui
+    {
+        HeadlessImGui()
+        {
+            ImGui::CreateContext();
+            ImGuiIO& io = ImGui::GetIO();
+            io.IniFilename = nullptr;
+            io.DisplaySize = ImVec2(640.f, 480.f);
+            io.DeltaTime = 1.f / 60.f;
+            unsigned char* pixels; int width, height;
+            io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+        }
+        ~HeadlessImGui() { ImGui::DestroyContext(); }
+
+        template<typename GuiFunction>
+        uint64_t frameHash(GuiFunction gui)
+        {
+            ImGui::NewFrame();
+            gui();
+            ImGui::Render();
+            return HashDrawData(ImGui::GetDrawData());
+        }
+    };
+}
+
+TEST_CASE("HashDrawData: identical frames have the same hash, and any change is detected")
+{
+    HeadlessImGui headlessImGui;
+    float value = 0.5f;
+    ImVec4 buttonColor = ImGui::GetStyle().Colors[ImGuiCol_Button];
+    auto gui = [&] {
+        ImGui::SetNextWindowPos(ImVec2(10.f, 10.f));
+        ImGui::Begin("Window");
+        ImGui::Text("Hello");
+        ImGui::SliderFloat("Value", &value, 0.f, 1.f);
+        ImGui::PushStyleColor(ImGuiCol_Button, buttonColor);
+        ImGui::Button("Button");
+        ImGui::PopStyleColor();
+        ImGui::End();
+    };
+
+    for (int i = 0; i < 3; ++i) // let the window settle
+        headlessImGui.frameHash(gui);
+
+    uint64_t reference = headlessImGui.frameHash(gui);
+    CHECK(reference != 0);
+    CHECK(headlessImGui.frameHash(gui) == reference);
+
+    value = 0.6f; // moves the slider grab
+    uint64_t changedValue = headlessImGui.frameHash(gui);
+    CHECK(changedValue != reference);
+    value = 0.5f;
+    CHECK(headlessImGui.frameHash(gui) == reference);
+
+    buttonColor.w *= 0.5f; // only changes the vertices colors
+    CHECK(headlessImGui.frameHash(gui) != reference);
+    buttonColor = ImGui::GetStyle().Colors[ImGuiCol_Button];
+    CHECK(headlessImGui.frameHash(gui) == reference);
+
+    ImGui::GetIO().DisplaySize = ImVec2(800.f, 600.f);
+    CHECK(headlessImGui.frameHash(gui) != reference);
+}
+
+TEST_CASE("HashDrawData returns 0 when the frame cannot be hashed")
+{
+    HeadlessImGui headlessImGui;
+    CHECK(HashDrawData(nullptr) == 0);
+
+    ImDrawCallback callback = [](const ImDrawList*, const ImDrawCmd*) {};
+    auto gui = [&callback] {
+        ImGui::Begin("Window");
+        ImGui::GetWindowDrawList()->AddCallback(callback, nullptr);
+        ImGui::End();
+    };
+    headlessImGui.frameHash(gui); // the window is hidden during its first frame
+
+    // What a user callback draws is unknown
+    CHECK(headlessImGui.frameHash(gui) == 0);
+
+    // ImDrawCallback_ResetRenderState is known to every backend
+    callback = ImDrawCallback_ResetRenderState;
+    CHECK(headlessImGui.frameHash(gui) != 0);
+}
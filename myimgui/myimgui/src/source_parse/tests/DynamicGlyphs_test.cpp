@@ -0,0 +1,151 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "imgui.h"
+#include "imgui_internal.h"
+
+#include <vector>
+
+namespace
+{
+    ImFont* AddFont(ImFontAtlas* atlas, bool rasterizeOnDemand)
+    {
+        ImFontConfig config;
+        config.RasterizeOnDemand = rasterizeOnDemand;
+        return atlas->AddFontDefault(&config);
+    }
+
+    // The alpha pixels of a glyph, read from the atlas at its UVs
+    std::vector<unsigned char> GlyphPixels(const ImFontAtlas& atlas, const ImFontGlyph* glyph)
+    {
+        int x0 = (int)(glyph->U0 * atlas.TexWidth + 0.5f), y0 = (int)(glyph->V0 * atlas.TexHeight + 0.5f);
+        int x1 = (int)(glyph->U1 * atlas.TexWidth + 0.5f), y1 = (int)(glyph->V1 * atlas.TexHeight + 0.5f);
+        std::vector<unsigned char> pixels;
+        for (int y = y0; y < y1; ++y)
+            for (int x = x0; x < x1; ++x)
+                pixels.push_back(atlas.TexPixelsAlpha8[y * atlas.TexWidth + x]);
+        return pixels;
+    }
+
+    bool SameMetrics(const ImFontGlyph* a, const ImFontGlyph* b)
+    {
+        return a->Codepoint == b->Codepoint && a->Visible == b->Visible && a->AdvanceX == b->AdvanceX
+            && a->X0 == b->X0 && a->Y0 == b->Y0 && a->X1 == b->X1 && a->Y1 == b->Y1;
+    }
+
+    // Visible glyphs of the default font
+    std::vector<ImWchar> VisibleCodepoints(const ImFont* font)
+    {
+        std::vector<ImWchar> codepoints;
+        for (const ImFontGlyph& glyph: font->Glyphs)
+            if (glyph.Visible)
+                codepoints.push_back((ImWchar)glyph.Codepoint);
+        return codepoints;
+    }
+
+    void RunFrame(const std::vector<ImWchar>& displayedCodepoints, ImFont* font)
+    {
+        ImGui::NewFrame();
+        for (ImWchar c: displayedCodepoints)
+            font->FindGlyph(c);
+        ImGui::EndFrame();
+    }
+}
+
+TEST_CASE("Glyphs rasterized on demand are identical to the glyphs rasterized by Build()")
+{
+    ImFontAtlas eagerAtlas, lazyAtlas;
+    ImFont* eagerFont = AddFont(&eagerAtlas, false);
+    ImFont* lazyFont = AddFont(&lazyAtlas, true);
+    REQUIRE(eagerAtlas.Build());
+    REQUIRE(lazyAtlas.Build());
+    REQUIRE(lazyAtlas.DynamicGlyphs != nullptr);
+    CHECK(eagerAtlas.DynamicGlyphs == nullptr);
+
+    // The metrics (hence the text layout) are known without rasterizing
+    REQUIRE(lazyFont->Glyphs.Size == eagerFont->Glyphs.Size);
+    for (int i = 0; i < eagerFont->Glyphs.Size; ++i)
+        CHECK(SameMetrics(&lazyFont->Glyphs[i], &eagerFont->Glyphs[i]));
+    CHECK(lazyFont->CalcTextSizeA(13.f, FLT_MAX, 0.f, "Hello, world").x == eagerFont->CalcTextSizeA(13.f, FLT_MAX, 0.f, "Hello, world").x);
+    const ImU64 rasterizedByBuild = lazyAtlas.DynamicGlyphs->Rasterized; // the fallback and ellipsis glyphs are looked up by Build()
+
+    int x, y, w, h;
+    lazyAtlas.ClearTexDirtyRect();
+    CHECK(!lazyAtlas.GetTexDirtyRect(&x, &y, &w, &h));
+    for (ImWchar c: { 'A', 'g', '@' })
+    {
+        const ImFontGlyph* lazyGlyph = lazyFont->FindGlyph(c);
+        const ImFontGlyph* eagerGlyph = eagerFont->FindGlyph(c);
+        REQUIRE(lazyGlyph->Codepoint == (unsigned int)c);
+        CHECK(SameMetrics(lazyGlyph, eagerGlyph));
+        CHECK(GlyphPixels(lazyAtlas, lazyGlyph) == GlyphPixels(eagerAtlas, eagerGlyph));
+        // The glyph pixels are in the dirty rect
+        REQUIRE(lazyAtlas.GetTexDirtyRect(&x, &y, &w, &h));
+        CHECK(lazyGlyph->U0 * lazyAtlas.TexWidth >= (float)x);
+        CHECK(lazyGlyph->V0 * lazyAtlas.TexHeight >= (float)y);
+        CHECK(lazyGlyph->U1 * lazyAtlas.TexWidth <= (float)(x + w));
+        CHECK(lazyGlyph->V1 * lazyAtlas.TexHeight <= (float)(y + h));
+    }
+    // A glyph is rasterized once
+    lazyAtlas.ClearTexDirtyRect();
+    lazyFont->FindGlyph('A');
+    CHECK(!lazyAtlas.GetTexDirtyRect(&x, &y, &w, &h));
+    CHECK(lazyAtlas.DynamicGlyphs->Rasterized - rasterizedByBuild <= 3);
+}
+
+TEST_CASE("The least recently used glyphs are evicted, but not the glyphs used during the frame")
+{
+    ImFontAtlas atlas;
+    atlas.DynamicGlyphsCapacity = 1;
+    AddFont(&atlas, false); // ImGui draws its own texts (e.g. window titles) with the first font, which does not use the cells
+    ImFont* font = AddFont(&atlas, true);
+    REQUIRE(atlas.Build());
+    ImFontAtlas eagerAtlas;
+    ImFont* eagerFont = AddFont(&eagerAtlas, false);
+    REQUIRE(eagerAtlas.Build());
+
+    ImGui::CreateContext(&atlas);
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(640.f, 480.f);
+    io.DeltaTime = 1.f / 60.f;
+
+    const ImFontDynamicGlyphs& dynamicGlyphs = *atlas.DynamicGlyphs;
+    const int nbCells = dynamicGlyphs.Cells.Size; // one row of cells
+    std::vector<ImWchar> codepoints = VisibleCodepoints(eagerFont);
+    REQUIRE((int)codepoints.size() > nbCells + 2);
+
+    // More glyphs than cells in one frame: the last ones are not displayed, but keep their metrics
+    ImGui::NewFrame();
+    for (int i = 0; i < nbCells; ++i)
+        font->FindGlyph(codepoints[i]);
+    const ImFontGlyph* hidden = font->FindGlyph(codepoints[nbCells]);
+    CHECK(!hidden->Visible);
+    CHECK(hidden->AdvanceX == eagerFont->FindGlyph(codepoints[nbCells])->AdvanceX);
+    CHECK(dynamicGlyphs.NotRasterized >= 1);
+    ImGui::EndFrame();
+
+    // During the next frames, the glyphs not displayed anymore are evicted
+    const ImU64 evictedBefore = dynamicGlyphs.Evicted;
+    std::vector<ImWchar> secondHalf(codepoints.begin() + nbCells / 2, codepoints.begin() + nbCells / 2 + nbCells);
+    RunFrame(secondHalf, font);
+    CHECK(dynamicGlyphs.Evicted - evictedBefore == (ImU64)(nbCells / 2));
+    ImGui::NewFrame();
+    for (ImWchar c: secondHalf)
+    {
+        const ImFontGlyph* glyph = font->FindGlyph(c);
+        CHECK(glyph->Visible);
+        CHECK(GlyphPixels(atlas, glyph) == GlyphPixels(eagerAtlas, eagerFont->FindGlyph(c)));
+    }
+    // An evicted glyph is rasterized again, in place of the least recently used one
+    const ImFontGlyph* first = font->FindGlyph(codepoints[0]);
+    CHECK(!first->Visible); // all the cells were used during this frame
+    ImGui::EndFrame();
+    ImGui::NewFrame();
+    first = font->FindGlyph(codepoints[0]);
+    CHECK(first->Visible);
+    CHECK(GlyphPixels(atlas, first) == GlyphPixels(eagerAtlas, eagerFont->FindGlyph(codepoints[0])));
+    ImGui::EndFrame();
+
+    ImGui::DestroyContext();
+}
@@ -0,0 +1,115 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "hello_imgui/internal/font_atlas_cache.h"
+#include "imgui.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace HelloImGui::Internal;
+
+namespace
+{
+    const std::string CacheFilename = (std::filesystem::temp_directory_path() / "FontAtlasCache_test.cache").string();
+
+    void AddFonts(ImFontAtlas* atlas, float fontSize)
+    {
+        ImFontConfig config;
+        config.SizePixels = fontSize;
+        atlas->AddFontDefault(&config);
+        config.SizePixels = fontSize * 2.f;
+        atlas->AddFontDefault(&config);
+    }
+
+    bool SameGlyphs(const ImFont* a, const ImFont* b)
+    {
+        return a->Glyphs.Size == b->Glyphs.Size
+            && memcmp(a->Glyphs.Data, b->Glyphs.Data, (size_t)a->Glyphs.Size * sizeof(ImFontGlyph)) == 0
+            && a->IndexAdvanceX.Size == b->IndexAdvanceX.Size
+            && memcmp(a->IndexAdvanceX.Data, b->IndexAdvanceX.Data, (size_t)a->IndexAdvanceX.Size * sizeof(float)) == 0
+            && a->FontSize == b->FontSize && a->Ascent == b->Ascent && a->Descent == b->Descent
+            && a->FallbackAdvanceX == b->FallbackAdvanceX && a->EllipsisChar == b->EllipsisChar;
+    }
+
+    bool SamePixels(ImFontAtlas* a, ImFontAtlas* b)
+    {
+        unsigned char *pixelsA, *pixelsB;
+        int wA, hA, wB, hB;
+        a->GetTexDataAsRGBA32(&pixelsA, &wA, &hA);
+        b->GetTexDataAsRGBA32(&pixelsB, &wB, &hB);
+        return wA == wB && hA == hB && memcmp(pixelsA, pixelsB, (size_t)wA * (size_t)hA * 4) == 0;
+    }
+}
+
+TEST_CASE("A font atlas restored from the cache is identical to a built one")
+{
+    std::remove(CacheFilename.c_str());
+
+    ImFontAtlas built;
+    AddFonts(&built, 13.f);
+    uint64_t key = FontAtlasCacheKey(&built); // Build() adds custom rects, which change the key afterwards
+    REQUIRE(BuildFontAtlas_WithCache(&built, CacheFilename)); // cache miss: builds and saves
+    REQUIRE(std::filesystem::exists(CacheFilename));
+
+    ImFontAtlas restored;
+    AddFonts(&restored, 13.f);
+    CHECK(FontAtlasCacheKey(&restored) == key);
+    REQUIRE(BuildFontAtlas_WithCache(&restored, CacheFilename));
+    CHECK(restored.IsBuilt());
+    CHECK(SamePixels(&restored, &built));
+    REQUIRE(restored.Fonts.Size == built.Fonts.Size);
+    for (int i = 0; i < built.Fonts.Size; ++i)
+        CHECK(SameGlyphs(restored.Fonts[i], built.Fonts[i]));
+    CHECK(memcmp(&restored.TexUvLines, &built.TexUvLines, sizeof(built.TexUvLines)) == 0);
+    ImFontAtlasCustomRect* mouseCursorsRect = restored.GetCustomRectByIndex(restored.PackIdMouseCursors);
+    CHECK(mouseCursorsRect->X == built.GetCustomRectByIndex(built.PackIdMouseCursors)->X);
+    CHECK(mouseCursorsRect->Y == built.GetCustomRectByIndex(built.PackIdMouseCursors)->Y);
+
+    std::remove(CacheFilename.c_str());
+}
+
+TEST_CASE("The font atlas cache key depends on the font sizes and configs")
+{
+    ImFontAtlas a, b, c;
+    AddFonts(&a, 13.f);
+    AddFonts(&b, 13.f * 1.5f); // as with another DPI
+    AddFonts(&c, 13.f);
+    c.ConfigData[0].OversampleH = 1;
+    CHECK(FontAtlasCacheKey(&a) != FontAtlasCacheKey(&b));
+    CHECK(FontAtlasCacheKey(&a) != FontAtlasCacheKey(&c));
+
+    ImFontAtlas empty; // nothing to cache
+    CHECK(FontAtlasCacheKey(&empty) == 0);
+}
+
+TEST_CASE("A corrupted or outdated cache file leads to a regular build")
+{
+    ImFontAtlas reference;
+    AddFonts(&reference, 13.f);
+    REQUIRE(reference.Build());
+
+    {
+        std::ofstream ofs(CacheFilename, std::ios::binary);
+        ofs << "not a font atlas cache";
+    }
+    ImFontAtlas fromCorrupted;
+    AddFonts(&fromCorrupted, 13.f);
+    REQUIRE(BuildFontAtlas_WithCache(&fromCorrupted, CacheFilename));
+    CHECK(SamePixels(&fromCorrupted, &reference));
+
+    // The file was replaced by a valid cache: truncate it
+    std::filesystem::resize_file(CacheFilename, std::filesystem::file_size(CacheFilename) / 2);
+    ImFontAtlas fromTruncated;
+    AddFonts(&fromTruncated, 13.f);
+    REQUIRE(BuildFontAtlas_WithCache(&fromTruncated, CacheFilename));
+    CHECK(SamePixels(&fromTruncated, &reference));
+    for (int i = 0; i < reference.Fonts.Size; ++i)
+        CHECK(SameGlyphs(fromTruncated.Fonts[i], reference.Fonts[i]));
+
+    std::remove(CacheFilename.c_str());
+}
@@ -11,3 +11,81 @@ TEST_CASE("Test FindExampleAppsCode")
     std::unordered_map<std::string, SourceCode> apps = FindExampleAppsCode();
     CHECK_GE(apps.size(), 13);
 }
+
+namespace
+{
+    // A source being edited, which records its changes as a TextEditor would
+    struct EditedSource
+    {
+        std::vector<std::string> lines;
+        std::vector<LinesChange> changes;
+
+        void replaceLines(int line, int nbLinesBefore, const std::vector<std::string>& newLines)
+        {
+            lines.erase(lines.begin() + line, lines.begin() + line + nbLinesBefore);
+            lines.insert(lines.begin() + line, newLines.begin(), newLines.end());
+            changes.push_back({ line, nbLinesBefore, (int)newLines.size() });
+        }
+
+        std::string text() const { return fplus::join(std::string("\n"), lines); }
+    };
+
+    std::string showTags(const LinesWithTags& linesWithTags)
+    {
+        std::string r;
+        for (const auto& t: linesWithTags)
+            r += std::to_string(t.lineNumber) + " " + t.tag + " " + std::to_string(t.level) + " " + t._original_tag_full + "\n";
+        return r;
+    }
+}
+
+TEST_CASE("UpdateImGuiDemoCodeLines gives the same tags as a full parse")
+{
+    EditedSource source;
+    source.lines = {
+        "void ShowDemo()",
+        "{",
+        "    IMGUI_DEMO_MARKER(\"Widgets/Basic\");",
+        "    ImGui::Button(\"A\");",
+        "    IMGUI_DEMO_MARKER(\"Widgets/Trees\");",
+        "    ImGui::TreeNode(\"B\");",
+        "    IMGUI_DEMO_MARKER(\"Layout\");",
+        "    ImGui::Text(\"C\");",
+        "}",
+    };
+    LinesWithTags tags = findImGuiDemoCodeLines(source.text());
+    REQUIRE(tags.size() == 4); // with the added "Widgets" header
+
+    auto getLine = [&source](int lineNumber) { return source.lines[lineNumber]; };
+    auto update = [&] {
+        UpdateImGuiDemoCodeLines(tags, source.changes, (int)source.lines.size(), getLine);
+        source.changes.clear();
+        CHECK(showTags(tags) == showTags(findImGuiDemoCodeLines(source.text())));
+    };
+
+    // Lines added above the markers: they are shifted
+    source.replaceLines(1, 0, { "// a comment", "// another one" });
+    update();
+    CHECK(tags[1].lineNumber == 4);
+
+    // A marker is typed, character by character (one change per character, plus an incomplete marker)
+    source.replaceLines(6, 0, { "" });
+    for (std::string typed: { "    IMGUI_DEMO_MARKER(\"Widg", "    IMGUI_DEMO_MARKER(\"Widgets/Tables\");" })
+        source.replaceLines(6, 1, { typed });
+    update();
+    CHECK(tags.size() == 5);
+
+    // Several edits between two updates: a marker is removed, and lines are joined then split
+    source.replaceLines(4, 2, { "    ImGui::Button(\"A\");" });
+    source.replaceLines(0, 2, { "void ShowDemo() {" });
+    source.replaceLines(0, 1, { "void ShowDemo()", "{" });
+    source.replaceLines(8, 1, { "    IMGUI_DEMO_MARKER(\"Misc\");" });
+    update();
+    CHECK(tags.size() == 4);
+    CHECK(tags.back().tag == "Misc");
+
+    // The whole text is replaced
+    source.replaceLines(0, (int)source.lines.size(), { "IMGUI_DEMO_MARKER(\"Only\");" });
+    update();
+    CHECK(tags.size() == 1);
+}
@@ -0,0 +1,91 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "imgui.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+// These tests apply to the sorted ImGuiStorage, as well as to the hashed one (IMGUI_USE_HASHED_STORAGE)
+
+TEST_CASE("ImGuiStorage behaves like a map")
+{
+    ImGuiStorage storage;
+    std::map<ImGuiID, int> expected;
+    unsigned int random = 42;
+    for (int i = 0; i < 5000; ++i)
+    {
+        random = random * 1103515245 + 12345;
+        // Some small integer keys (e.g. PushID(int)), and some spread out keys
+        ImGuiID key = (i % 3 == 0) ? (random >> 20) % 300 : random;
+        storage.SetInt(key, i);
+        expected[key] = i;
+    }
+
+    CHECK(storage.Data.Size == (int)expected.size());
+    for (const auto& kv: expected)
+        CHECK(storage.GetInt(kv.first, -1) == kv.second);
+    CHECK(storage.GetInt(0xFFFFFFFF, -7) == -7);
+    CHECK(storage.GetVoidPtr(0xFFFFFFFF) == nullptr);
+
+    // Iterating Data gives each pair exactly once
+    std::vector<ImGuiID> keys;
+    for (const auto& pair: storage.Data)
+        keys.push_back(pair.key);
+    std::sort(keys.begin(), keys.end());
+    CHECK(std::adjacent_find(keys.begin(), keys.end()) == keys.end());
+
+    // BuildSortByKey() sorts Data, and lookups still work
+    storage.BuildSortByKey();
+    for (int i = 1; i < storage.Data.Size; ++i)
+        CHECK(storage.Data[i - 1].key < storage.Data[i].key);
+    for (const auto& kv: expected)
+        CHECK(storage.GetInt(kv.first, -1) == kv.second);
+
+    storage.SetAllInt(3);
+    for (const auto& kv: expected)
+        CHECK(storage.GetInt(kv.first, -1) == 3);
+
+    storage.Clear();
+    CHECK(storage.Data.Size == 0);
+    CHECK(storage.GetInt(expected.begin()->first, -1) == -1);
+}
+
+TEST_CASE("ImGuiStorage Get/Set of all types, and references")
+{
+    ImGuiStorage storage;
+    CHECK(storage.GetBool(1) == false);
+    storage.SetBool(1, true);
+    CHECK(storage.GetBool(1) == true);
+
+    storage.SetFloat(2, 1.5f);
+    CHECK(storage.GetFloat(2) == 1.5f);
+    CHECK(storage.GetFloat(3, 2.5f) == 2.5f);
+
+    int value = 0;
+    storage.SetVoidPtr(4, &value);
+    CHECK(storage.GetVoidPtr(4) == &value);
+
+    // Get***Ref() inserts the default value, and the reference writes into the storage
+    int* intRef = storage.GetIntRef(5, 10);
+    CHECK(*intRef == 10);
+    *intRef = 11;
+    CHECK(storage.GetInt(5) == 11);
+    CHECK(*storage.GetIntRef(5, 10) == 11);
+    *storage.GetFloatRef(6, 0.5f) += 1.f;
+    CHECK(storage.GetFloat(6) == 1.5f);
+    CHECK(*storage.GetVoidPtrRef(7, &value) == &value);
+    CHECK(storage.Data.Size == 6); // Get***() did not insert key 3
+}
+
+TEST_CASE("ImGuiStorage filled directly then sorted")
+{
+    // The "Advanced" usage of imgui.h: push pairs into Data, then sort once
+    ImGuiStorage storage;
+    for (int i = 100; i > 0; --i)
+        storage.Data.push_back(ImGuiStorage::ImGuiStoragePair((ImGuiID)i * 7919u, i));
+    storage.BuildSortByKey();
+    for (int i = 1; i <= 100; ++i)
+        CHECK(storage.GetInt((ImGuiID)i * 7919u, -1) == i);
+}
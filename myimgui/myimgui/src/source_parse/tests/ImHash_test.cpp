@@ -0,0 +1,76 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "imgui.h"
+#include "imgui_internal.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+    // The original ImHashStr: bitwise CRC32 (zlib polynomial), restarting from the seed at each "###"
+    ImGuiID referenceHashStr(const std::string& s, ImGuiID seed)
+    {
+        seed = ~seed;
+        ImU32 crc = seed;
+        for (size_t i = 0; i < s.size(); ++i)
+        {
+            if (s[i] == '#' && i + 2 < s.size() && s[i + 1] == '#' && s[i + 2] == '#')
+                crc = seed;
+            crc ^= (unsigned char)s[i];
+            for (int bit = 0; bit < 8; ++bit)
+                crc = (crc >> 1) ^ (0xEDB88320 & (0u - (crc & 1)));
+        }
+        return ~crc;
+    }
+
+    std::vector<std::string> makeLabels()
+    {
+        std::vector<std::string> r = { "", "#", "##", "###", "####", "Window", "label###id", "a###b###c", "caf\xC3\xA9##3" };
+        unsigned int random = 12345;
+        for (int i = 0; i < 300; ++i)
+        {
+            std::string s;
+            int length = i % 70;
+            for (int j = 0; j < length; ++j)
+            {
+                random = random * 1103515245 + 12345;
+                const char alphabet[] = "abcdefgh ##/_0123456789\xC3\xA9";
+                s += alphabet[(random >> 16) % (sizeof(alphabet) - 1)];
+            }
+            r.push_back(s);
+        }
+        return r;
+    }
+}
+
+TEST_CASE("ImHashStr and ImHashData give the same hashes with all backends")
+{
+    const ImHashBackend selectedBackend = ImHashGetBackend();
+    const ImGuiID seeds[] = { 0, 0x12345678, ImHashStr("Dear ImGui Manual") };
+    int nbBackends = 0;
+    for (ImHashBackend backend = 0; backend < ImHashBackend_COUNT; ++backend)
+    {
+        if (!ImHashSetBackend(backend))
+            continue;
+        ++nbBackends;
+        CAPTURE(ImHashGetBackendName(backend));
+        for (const auto& label: makeLabels())
+        {
+            for (ImGuiID seed: seeds)
+            {
+                CAPTURE(label);
+                ImGuiID expected = referenceHashStr(label, seed);
+                CHECK(ImHashStr(label.c_str(), label.size(), seed) == expected);
+                if (!label.empty())
+                    CHECK(ImHashStr(label.c_str(), 0, seed) == expected);
+                if (label.find("###") == std::string::npos)
+                    CHECK(ImHashData(label.data(), label.size(), seed) == expected);
+            }
+        }
+    }
+    CHECK(nbBackends >= 2); // at least Bytewise and SlicingBy8 (on little-endian CPUs)
+    ImHashSetBackend(selectedBackend);
+    CHECK(ImHashGetBackend() != ImHashBackend_Bytewise);
+}
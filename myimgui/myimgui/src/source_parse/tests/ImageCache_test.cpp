@@ -0,0 +1,157 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "hello_imgui/internal/image_cache.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+using HelloImGui::Internal::ImageCache;
+
+namespace
+{
+    struct FakeImage: public HelloImGui::ImageAbstract
+    {
+        ImTextureID TextureID() override { return (ImTextureID)this; }
+        void _impl_StoreTexture(int width, int height, unsigned char* image_data_rgba) override
+        {
+            pixels.assign(image_data_rgba, image_data_rgba + (size_t)width * (size_t)height * 4);
+        }
+        std::vector<unsigned char> pixels;
+    };
+
+    // Decodes "WxH" asset names into images filled with the first letter; "bad" fails
+    struct FakeDecoder
+    {
+        std::atomic<int> nbDecodes{0}, nbFreed{0}, nbCreated{0};
+        std::mutex mutex;
+        std::condition_variable condition;
+        int nbDecodedAsync = 0;
+
+        ImageCache::Functions Functions()
+        {
+            ImageCache::Functions functions;
+            functions.decode = [this](const std::string& assetPath) {
+                ++nbDecodes;
+                if (assetPath == "bad")
+                    throw std::runtime_error("cannot decode");
+                ImageCache::DecodedImage r;
+                r.width = 2;
+                r.height = 2;
+                r.rgba = (unsigned char*)malloc(16);
+                memset(r.rgba, assetPath[0], 16);
+                return r;
+            };
+            functions.freePixels = [this](unsigned char* rgba) { ++nbFreed; free(rgba); };
+            functions.createImage = [this] { ++nbCreated; return std::make_shared<FakeImage>(); };
+            functions.onDecodedAsync = [this] {
+                std::lock_guard<std::mutex> lock(mutex);
+                ++nbDecodedAsync;
+                condition.notify_all();
+            };
+            return functions;
+        }
+
+        void WaitForAsyncDecodes(int nb)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [&] { return nbDecodedAsync >= nb; });
+        }
+    };
+
+    const FakeImage* AsFake(const ImageCache::Lookup& lookup)
+    {
+        return static_cast<const FakeImage*>(lookup.image.get());
+    }
+}
+
+TEST_CASE("An image decoded asynchronously is stored at the start of the next frame")
+{
+    FakeDecoder decoder;
+    ImageCache cache(decoder.Functions());
+    CHECK(cache.Get("a", true).status == ImageCache::Status::Loading);
+    CHECK(cache.Get("bad", true).status == ImageCache::Status::Loading);
+    decoder.WaitForAsyncDecodes(2);
+
+    // The textures are created by the main thread only
+    CHECK(cache.Get("a", true).status == ImageCache::Status::Loading);
+    CHECK(decoder.nbCreated == 0);
+    int nbBeforeTextureChanges = 0;
+    CHECK(cache.OnFrameStart(0, [&] { ++nbBeforeTextureChanges; }));
+    CHECK(nbBeforeTextureChanges == 1);
+
+    auto lookup = cache.Get("a", true);
+    REQUIRE(lookup.status == ImageCache::Status::Ready);
+    CHECK(lookup.image->Width == 2);
+    CHECK(lookup.image->Height == 2);
+    CHECK(AsFake(lookup)->pixels == std::vector<unsigned char>(16, 'a'));
+    CHECK(decoder.nbFreed == 1);
+    CHECK(cache.Get("bad", true).status == ImageCache::Status::Failed);
+
+    // Nothing to do during the next frames
+    CHECK(!cache.OnFrameStart(0, [&] { ++nbBeforeTextureChanges; }));
+    CHECK(nbBeforeTextureChanges == 1);
+    CHECK(decoder.nbDecodes == 2);
+    ImageCache::Stats stats = cache.GetStats();
+    CHECK(stats.nbImages == 1);
+    CHECK(stats.usedBytes == 16);
+    CHECK(stats.nbPendingDecodes == 0);
+}
+
+TEST_CASE("A synchronous request waits for the asynchronous decoding of the same image")
+{
+    FakeDecoder decoder;
+    ImageCache cache(decoder.Functions());
+    for (const char* assetPath: { "a", "b", "c", "d" })
+        cache.Get(assetPath, true);
+    auto lookup = cache.Get("d", false);
+    REQUIRE(lookup.status == ImageCache::Status::Ready);
+    CHECK(AsFake(lookup)->pixels == std::vector<unsigned char>(16, 'd'));
+
+    // Each image is decoded and stored once
+    decoder.WaitForAsyncDecodes(3);
+    cache.OnFrameStart(0, nullptr);
+    CHECK(decoder.nbDecodes == 4);
+    CHECK(decoder.nbCreated == 4);
+    CHECK(decoder.nbFreed == 4);
+    CHECK(cache.Get("d", true).image == lookup.image);
+
+    CHECK_THROWS(cache.Get("bad", false));
+}
+
+TEST_CASE("The least recently used images are evicted, but not the images used during the last frame")
+{
+    FakeDecoder decoder;
+    ImageCache cache(decoder.Functions());
+    const size_t imageBytes = 16;
+    std::weak_ptr<HelloImGui::ImageAbstract> imageA = cache.Get("a", false).image;
+    cache.OnFrameStart(imageBytes * 2, nullptr);
+    cache.Get("b", false);
+    cache.OnFrameStart(imageBytes * 2, nullptr);
+    cache.Get("c", false);
+    cache.Get("d", false);
+
+    // c and d were used during the last frame, and exceed the budget on their own
+    int nbBeforeTextureChanges = 0;
+    CHECK(cache.OnFrameStart(imageBytes * 2, [&] { ++nbBeforeTextureChanges; }));
+    CHECK(nbBeforeTextureChanges == 1);
+    ImageCache::Stats stats = cache.GetStats();
+    CHECK(stats.nbEvictedImages == 2);
+    CHECK(stats.nbImages == 2);
+    CHECK(stats.usedBytes == imageBytes * 2);
+    CHECK(imageA.expired());
+
+    // An evicted image is decoded again
+    CHECK(cache.Get("c", false).status == ImageCache::Status::Ready);
+    CHECK(decoder.nbDecodes == 4);
+    CHECK(cache.Get("a", false).status == ImageCache::Status::Ready);
+    CHECK(decoder.nbDecodes == 5);
+    cache.OnFrameStart(imageBytes * 2, nullptr);
+    CHECK(cache.GetStats().nbEvictedImages == 3); // d
+    CHECK(cache.GetStats().usedBytes == imageBytes * 2);
+}
@@ -0,0 +1,116 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "hello_imgui/internal/log_ring_buffer.h"
+
+#include <atomic>
+#include <cstdarg>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using HelloImGui::LogLevel;
+using HelloImGui::Internal::LogRecord;
+using HelloImGui::Internal::LogRingBuffer;
+
+namespace
+{
+    bool Push(LogRingBuffer& buffer, LogLevel level, double timestamp, const char* format, ...)
+    {
+        va_list args;
+        va_start(args, format);
+        bool pushed = buffer.Push(level, timestamp, format, args);
+        va_end(args);
+        return pushed;
+    }
+
+    std::vector<std::string> DrainTexts(LogRingBuffer& buffer)
+    {
+        std::vector<std::string> texts;
+        buffer.Drain([&](const LogRecord& record) { texts.emplace_back(record.text, record.length); });
+        return texts;
+    }
+}
+
+TEST_CASE("The records are drained in order, with their level, timestamp, and formatted text")
+{
+    LogRingBuffer buffer(16);
+    const std::string longText(LogRingBuffer::InlineTextSize * 3, 'x'); // allocated by the producer
+    CHECK(Push(buffer, LogLevel::Info, 1.5, "Hello %s %d", "world", 42));
+    CHECK(Push(buffer, LogLevel::Error, 2.5, "%s!", longText.c_str()));
+    CHECK(Push(buffer, LogLevel::Debug, 3.5, ""));
+
+    std::vector<LogRecord> records;
+    std::vector<std::string> texts;
+    CHECK(buffer.Drain([&](const LogRecord& record) {
+        records.push_back(record);
+        texts.emplace_back(record.text, record.length);
+    }) == 3);
+    REQUIRE(records.size() == 3);
+    CHECK(records[0].level == LogLevel::Info);
+    CHECK(records[0].timestamp == 1.5);
+    CHECK(texts[0] == "Hello world 42");
+    CHECK(records[1].level == LogLevel::Error);
+    CHECK(texts[1] == longText + "!");
+    CHECK(records[2].timestamp == 3.5);
+    CHECK(texts[2].empty());
+
+    CHECK(buffer.Drain([](const LogRecord&) {}) == 0);
+}
+
+TEST_CASE("When the queue is full, the records are dropped and counted")
+{
+    LogRingBuffer buffer(5); // rounded up to 8
+    for (int lap = 0; lap < 3; ++lap)
+    {
+        for (int i = 0; i < 10; ++i)
+            CHECK(Push(buffer, LogLevel::Info, 0., "%d", i) == (i < 8));
+        std::vector<std::string> texts = DrainTexts(buffer);
+        REQUIRE(texts.size() == 8);
+        CHECK(texts.front() == "0");
+        CHECK(texts.back() == "7");
+    }
+    LogRingBuffer::Stats stats = buffer.GetStats();
+    CHECK(stats.nbPushed == 24);
+    CHECK(stats.nbDropped == 6);
+
+    // A record which was not drained is freed by the destructor
+    Push(buffer, LogLevel::Info, 0., "%s", std::string(LogRingBuffer::InlineTextSize, 'y').c_str());
+}
+
+TEST_CASE("Several threads push while the UI thread drains: no record is lost, each thread's records stay in order")
+{
+    const int nbThreads = 4, nbRecordsPerThread = 20000;
+    LogRingBuffer buffer(256);
+    std::atomic<int> nbRunning{nbThreads};
+    std::vector<std::thread> producers;
+    for (int t = 0; t < nbThreads; ++t)
+        producers.emplace_back([&, t] {
+            for (int i = 0; i < nbRecordsPerThread; ++i)
+                Push(buffer, LogLevel::Info, 0., "%d %d%s", t, i, (i % 100 == 0) ? std::string(200, '-').c_str() : "");
+            --nbRunning;
+        });
+
+    std::vector<int> lastIndex(nbThreads, -1);
+    size_t nbDrained = 0;
+    bool inOrder = true;
+    auto drain = [&] {
+        nbDrained += buffer.Drain([&](const LogRecord& record) {
+            int t = -1, i = -1;
+            sscanf(record.text, "%d %d", &t, &i);
+            inOrder = inOrder && (t >= 0 && t < nbThreads && i > lastIndex[(size_t)t]);
+            lastIndex[(size_t)t] = i;
+        });
+    };
+    while (nbRunning > 0)
+        drain();
+    for (auto& producer: producers)
+        producer.join();
+    drain();
+
+    CHECK(inOrder);
+    LogRingBuffer::Stats stats = buffer.GetStats();
+    CHECK(stats.nbPushed == nbDrained);
+    CHECK(stats.nbPushed + stats.nbDropped == (uint64_t)(nbThreads * nbRecordsPerThread));
+}
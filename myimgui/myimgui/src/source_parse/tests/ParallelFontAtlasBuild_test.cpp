@@ -0,0 +1,85 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "hello_imgui/internal/font_atlas_cache.h"
+#include "imgui.h"
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using HelloImGui::Internal::FontAtlasBuild_ParallelFor;
+
+namespace
+{
+    // Several sources, with oversampling and brightening
+    void AddFonts(ImFontAtlas* atlas)
+    {
+        ImFontConfig config;
+        atlas->AddFontDefault(&config);
+        config.SizePixels = 26.f;
+        config.OversampleH = 3;
+        config.OversampleV = 2;
+        config.RasterizerMultiply = 1.4f;
+        atlas->AddFontDefault(&config);
+        config.SizePixels = 40.f;
+        config.RasterizerMultiply = 1.f;
+        config.PixelSnapH = true;
+        atlas->AddFontDefault(&config);
+    }
+
+    int gNbParallelFor = 0;
+    void CountingParallelFor(void* userData, int nbJobs, void (*jobFunc)(void* jobData, int jobIndex), void* jobData)
+    {
+        ++gNbParallelFor;
+        FontAtlasBuild_ParallelFor(userData, nbJobs, jobFunc, jobData);
+    }
+
+    // Runs the jobs on 4 threads, in reverse order (FontAtlasBuild_ParallelFor uses one thread per core, there may be only one)
+    void ReverseThreadsParallelFor(void*, int nbJobs, void (*jobFunc)(void* jobData, int jobIndex), void* jobData)
+    {
+        std::atomic<int> nextJob{nbJobs - 1};
+        auto runJobs = [&] {
+            for (int i = nextJob--; i >= 0; i = nextJob--)
+                jobFunc(jobData, i);
+        };
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i)
+            threads.emplace_back(runJobs);
+        for (auto& thread: threads)
+            thread.join();
+    }
+
+    void CheckSameAtlas(const ImFontAtlas& a, const ImFontAtlas& b)
+    {
+        REQUIRE(a.TexWidth == b.TexWidth);
+        REQUIRE(a.TexHeight == b.TexHeight);
+        CHECK(memcmp(a.TexPixelsAlpha8, b.TexPixelsAlpha8, (size_t)a.TexWidth * (size_t)a.TexHeight) == 0);
+        REQUIRE(a.Fonts.Size == b.Fonts.Size);
+        for (int i = 0; i < a.Fonts.Size; ++i)
+        {
+            const ImFont* fontA = a.Fonts[i];
+            const ImFont* fontB = b.Fonts[i];
+            REQUIRE(fontA->Glyphs.Size == fontB->Glyphs.Size);
+            CHECK(memcmp(fontA->Glyphs.Data, fontB->Glyphs.Data, (size_t)fontA->Glyphs.Size * sizeof(ImFontGlyph)) == 0);
+        }
+    }
+}
+
+TEST_CASE("A font atlas rasterized in parallel is identical to a serial one")
+{
+    ImFontAtlas serial, parallel, reverseThreads;
+    AddFonts(&serial);
+    AddFonts(&parallel);
+    AddFonts(&reverseThreads);
+    parallel.BuildParallelForFn = CountingParallelFor;
+    reverseThreads.BuildParallelForFn = ReverseThreadsParallelFor;
+    REQUIRE(serial.Build());
+    REQUIRE(parallel.Build());
+    REQUIRE(reverseThreads.Build());
+    CHECK(gNbParallelFor == 1);
+
+    CheckSameAtlas(parallel, serial);
+    CheckSameAtlas(reverseThreads, serial);
+}
@@ -0,0 +1,129 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "hello_imgui/internal/clock_seconds.h"
+#include "hello_imgui/internal/redraw_requests.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace HelloImGui::Internal;
+
+namespace
+{
+    // Stands for the event queue of a window backend
+    struct EventQueue
+    {
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool hasEvent = false;
+
+        void PostEmptyEvent()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                hasEvent = true;
+            }
+            condition.notify_one();
+        }
+        // Returns false on timeout
+        bool WaitForEventTimeout(double timeoutSeconds)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            bool gotEvent = condition.wait_for(lock, std::chrono::duration<double>(timeoutSeconds), [this] { return hasEvent; });
+            hasEvent = false;
+            return gotEvent;
+        }
+    };
+}
+
+TEST_CASE("The earliest redraw request is kept until it is due")
+{
+    double now = ClockSeconds();
+    OnFrameStart_ForgetDueRedrawRequests(now + 1000.);
+    CHECK(NextRequestedRedrawTime() < 0.);
+
+    RequestRedrawAt(now + 2.);
+    RequestRedrawAt(now + 1.);
+    RequestRedrawAt(now + 1.);
+    RequestRedrawAt(now + 3.);
+    CHECK(NextRequestedRedrawTime() == now + 1.);
+
+    // A frame drawn before the first request is due does not satisfy it
+    OnFrameStart_ForgetDueRedrawRequests(now + 0.5);
+    CHECK(NextRequestedRedrawTime() == now + 1.);
+    // A late request does not hide the earlier ones
+    OnFrameStart_ForgetDueRedrawRequests(now + 1.5);
+    CHECK(NextRequestedRedrawTime() == now + 2.);
+    OnFrameStart_ForgetDueRedrawRequests(now + 3.);
+    CHECK(NextRequestedRedrawTime() < 0.);
+}
+
+TEST_CASE("An animation which requests its next frame at each frame is redrawn at fpsIdle once the events stop")
+{
+    const double fpsIdle = 9.;
+    double now = ClockSeconds();
+    OnFrameStart_ForgetDueRedrawRequests(now + 1000.);
+
+    // A frame, as drawn by the runner: the animation requests the next one
+    int nbFrames = 0;
+    auto drawFrame = [&](double frameTime) {
+        OnFrameStart_ForgetDueRedrawRequests(frameTime);
+        RequestRedrawAt(frameTime + 1. / fpsIdle);
+        ++nbFrames;
+    };
+
+    // 3 seconds of events (e.g. the mouse moves): a frame every 1/60s
+    for (int i = 0; i < 180; ++i)
+    {
+        now += 1. / 60.;
+        drawFrame(now);
+    }
+
+    // 10 seconds without events: the runner only wakes up for the requested redraws
+    nbFrames = 0;
+    const double idleEnd = now + 10.;
+    while (NextRequestedRedrawTime() >= 0. && NextRequestedRedrawTime() <= idleEnd)
+    {
+        double nextRedrawTime = NextRequestedRedrawTime();
+        // (the first one was requested during the burst, less than 1/fpsIdle ago)
+        if (nbFrames > 0)
+            CHECK(nextRedrawTime - now >= 1. / fpsIdle - 1e-9);
+        now = nextRedrawTime;
+        drawFrame(now);
+    }
+    CHECK(nbFrames >= 89);
+    CHECK(nbFrames <= 90);
+
+    OnFrameStart_ForgetDueRedrawRequests(now + 1000.);
+}
+
+TEST_CASE("A redraw requested by another thread wakes up a runner which waits without timeout")
+{
+    EventQueue eventQueue;
+    SetRedrawWakeFunction([&eventQueue] { eventQueue.PostEmptyEvent(); });
+    OnFrameStart_ForgetDueRedrawRequests(ClockSeconds() + 1000.);
+
+    double nextRedrawTime = BeginWaitForRedraw();
+    CHECK(nextRedrawTime < 0.);
+    std::thread job([] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        RequestRedrawAt(ClockSeconds());
+    });
+    CHECK(eventQueue.WaitForEventTimeout(60.)); // the runner would wait forever without the wake up
+    EndWaitForRedraw();
+    job.join();
+
+    double now = ClockSeconds();
+    CHECK(NextRequestedRedrawTime() >= 0.);
+    CHECK(NextRequestedRedrawTime() <= now);
+
+    // Outside of a wait, a request does not post events (which would wake the next wait)
+    OnFrameStart_ForgetDueRedrawRequests(now);
+    RequestRedrawAt(now);
+    CHECK(!eventQueue.WaitForEventTimeout(0.05));
+
+    SetRedrawWakeFunction(nullptr);
+}
@@ -0,0 +1,81 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "hello_imgui/internal/backend_impls/render_thread.h"
+#include "hello_imgui/internal/backend_impls/software_rasterizer.h"
+#include "imgui.h"
+
+#include <cstdint>
+#include <vector>
+
+using HelloImGui::RenderThread;
+using HelloImGui::SoftwareRasterizer;
+
+namespace
+{
+    const int Width = 640, Height = 480;
+    const ImVec4 ClearColor(0.1f, 0.2f, 0.3f, 1.f);
+
+    void Gui(int idxFrame)
+    {
+        ImGui::ShowDemoWindow();
+        ImGui::SetWindowPos("Dear ImGui Demo", ImVec2(20.f, 20.f));
+        ImGui::SetWindowSize("Dear ImGui Demo", ImVec2(560.f, 420.f));
+        ImGui::GetForegroundDrawList()->AddCircleFilled(
+            ImVec2(100.f + (float)idxFrame * 40.f, 300.f), 30.f, IM_COL32(255, 0, 0, 128));
+    }
+
+    void RenderFrame(SoftwareRasterizer& rasterizer, const ImDrawData* drawData, ImVec4 clearColor)
+    {
+        rasterizer.Resize((int)drawData->DisplaySize.x, (int)drawData->DisplaySize.y);
+        rasterizer.Clear(clearColor);
+        rasterizer.RenderDrawData(drawData);
+    }
+}
+
+TEST_CASE("Pipelined frames render like direct ones, while the next frame is being built")
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2((float)Width, (float)Height);
+    io.DeltaTime = 1.f / 60.f;
+
+    SoftwareRasterizer direct(1), pipelined(2);
+    direct.CreateFontsTexture(); // also used by pipelined
+
+    const int nbFrames = 8;
+    std::vector<std::vector<uint32_t>> directFrames, pipelinedFrames;
+    {
+        // Keeps the pixels of each pipelined frame, from the render thread
+        RenderThread renderThread([&](const ImDrawData* drawData, ImVec4 clearColor) {
+            RenderFrame(pipelined, drawData, clearColor);
+            pipelinedFrames.push_back(pipelined.Pixels());
+        });
+
+        for (int i = 0; i < nbFrames; ++i)
+        {
+            ImGui::NewFrame();
+            Gui(i);
+            ImGui::Render();
+            RenderFrame(direct, ImGui::GetDrawData(), ClearColor);
+            directFrames.push_back(direct.Pixels());
+            // The next frame is built while this one is rendered: it overwrites ImGui's draw data
+            renderThread.SubmitFrame(ImGui::GetDrawData(), ClearColor);
+        }
+        renderThread.WaitUntilIdle();
+
+        RenderThread::Stats stats = renderThread.GetStats();
+        CHECK(stats.nbFrames == nbFrames);
+        CHECK(stats.renderSeconds > 0.);
+    }
+
+    REQUIRE(pipelinedFrames.size() == directFrames.size());
+    for (size_t i = 0; i < directFrames.size(); ++i)
+        CHECK(pipelinedFrames[i] == directFrames[i]);
+    // The frames differ from each other (the circle moves)
+    CHECK(directFrames[0] != directFrames[1]);
+
+    direct.DestroyFontsTexture();
+    ImGui::DestroyContext();
+}
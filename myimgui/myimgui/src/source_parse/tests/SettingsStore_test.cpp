@@ -0,0 +1,187 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "hello_imgui/internal/settings_store.h"
+#include "imgui.h"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using HelloImGui::Internal::SettingsPart;
+using HelloImGui::Internal::SettingsStore;
+
+namespace
+{
+    std::string TestStoreFilename()
+    {
+        std::string filename = (std::filesystem::temp_directory_path() / "hello_imgui_settings_test.store").string();
+        std::filesystem::remove(filename);
+        return filename;
+    }
+
+    // Windows, a docked window, and a table: the ini text of ImGui's settings
+    std::string ImGuiIniOfFrames(int nbFrames, ImVec2 windowPos)
+    {
+        ImGui::CreateContext();
+        ImGuiIO& io = ImGui::GetIO();
+        io.IniFilename = nullptr;
+        io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
+        io.DisplaySize = ImVec2(1280.f, 800.f);
+        io.DeltaTime = 1.f / 60.f;
+        unsigned char* pixels; int width, height;
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+        for (int i = 0; i < nbFrames; ++i)
+        {
+            ImGui::NewFrame();
+            ImGuiID dockspaceId = ImGui::DockSpaceOverViewport();
+            ImGui::SetNextWindowPos(windowPos);
+            ImGui::Begin("Code");
+            ImGui::End();
+            ImGui::SetNextWindowDockID(dockspaceId, ImGuiCond_Always);
+            ImGui::Begin("Docked");
+            if (ImGui::BeginTable("Table", 3, ImGuiTableFlags_Resizable | ImGuiTableFlags_Reorderable | ImGuiTableFlags_Sortable))
+            {
+                ImGui::TableSetupColumn("Name");
+                ImGui::TableSetupColumn("Size");
+                ImGui::TableSetupColumn("Date");
+                ImGui::TableHeadersRow();
+                ImGui::EndTable();
+            }
+            ImGui::End();
+            ImGui::EndFrame();
+        }
+        std::string ini = ImGui::SaveIniSettingsToMemory();
+        ImGui::DestroyContext();
+        return ini;
+    }
+
+    // The ini text, after a load into ImGui
+    std::string ImGuiIniReloaded(const std::string& ini)
+    {
+        ImGui::CreateContext();
+        ImGui::GetIO().IniFilename = nullptr;
+        ImGui::GetIO().ConfigFlags |= ImGuiConfigFlags_DockingEnable;
+        ImGui::LoadIniSettingsFromMemory(ini.c_str());
+        std::string reloaded = ImGui::SaveIniSettingsToMemory();
+        ImGui::DestroyContext();
+        return reloaded;
+    }
+
+    void CheckSameParts(const std::vector<SettingsPart>& a, const std::vector<SettingsPart>& b)
+    {
+        REQUIRE(a.size() == b.size());
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            CHECK(a[i].Name == b[i].Name);
+            CHECK(a[i].Content == b[i].Content);
+        }
+    }
+
+    std::vector<SettingsPart> TestParts(const std::string& imguiIni)
+    {
+        return {
+            {"ImGui_Default", imguiIni},
+            {"AppWindow", "[AppWindow]\nWindowPosition=393,238\nWindowSize=971,691\n"},
+            // a user pref: text before the first section, and repeated section lines
+            {"MyPref", "text\n[x]\n1\n[x]\n\n[x]\n2"},
+            {"Empty", ""},
+        };
+    }
+}
+
+TEST_CASE("The settings parts round trip through the store, and through ImGui's ini format")
+{
+    const std::string filename = TestStoreFilename();
+    const std::string imguiIni = ImGuiIniOfFrames(3, ImVec2(100.f, 50.f));
+    REQUIRE(imguiIni.find("[Docking][Data]") != std::string::npos);
+    REQUIRE(imguiIni.find("[Table]") != std::string::npos);
+    const std::vector<SettingsPart> parts = TestParts(imguiIni);
+    {
+        SettingsStore store(filename);
+        CHECK(store.Parts().empty());
+        REQUIRE(store.Write(parts));
+        CheckSameParts(store.Parts(), parts);
+    }
+
+    SettingsStore reloaded(filename);
+    CheckSameParts(reloaded.Parts(), parts);
+    CHECK(ImGuiIniReloaded(reloaded.Parts()[0].Content) == ImGuiIniReloaded(imguiIni));
+    CHECK(reloaded.GetStats().fileBytes == reloaded.GetStats().liveBytes);
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("A write only appends the modified sections")
+{
+    const std::string filename = TestStoreFilename();
+    std::vector<SettingsPart> parts = TestParts(ImGuiIniOfFrames(3, ImVec2(100.f, 50.f)));
+    SettingsStore store(filename);
+    REQUIRE(store.Write(parts));
+    const size_t initialBytes = store.GetStats().fileBytes;
+
+    // Nothing changed
+    REQUIRE(store.Write(parts));
+    CHECK(store.GetStats().nbLastWrittenRecords == 0);
+    CHECK(store.GetStats().fileBytes == initialBytes);
+
+    // The "Code" window moved: only its section is written
+    std::string movedIni = ImGuiIniOfFrames(3, ImVec2(300.f, 60.f));
+    REQUIRE(movedIni != parts[0].Content);
+    parts[0].Content = movedIni;
+    REQUIRE(store.Write(parts));
+    CHECK(store.GetStats().nbLastWrittenRecords == 1);
+    CHECK(store.GetStats().fileBytes - initialBytes < 100);
+
+    // A removed part is deleted, a new one is added
+    parts.erase(parts.begin() + 2);
+    parts.push_back({"Layout_Default", "[Visibility]\nCode=true\n"});
+    REQUIRE(store.Write(parts));
+
+    SettingsStore reloaded(filename);
+    CheckSameParts(reloaded.Parts(), parts);
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("The store is compacted when the overwritten records take more room than the live ones")
+{
+    const std::string filename = TestStoreFilename();
+    std::vector<SettingsPart> parts = TestParts(ImGuiIniOfFrames(3, ImVec2(100.f, 50.f)));
+    SettingsStore store(filename, 0);
+    REQUIRE(store.Write(parts));
+    CHECK(store.GetStats().nbCompactions == 1); // the first write creates the file
+    for (int i = 0; i < 200; ++i)
+    {
+        parts[1].Content = "[AppWindow]\nWindowPosition=" + std::to_string(i) + ",238\nWindowSize=971,691\n" + std::string(200, 'x') + "\n";
+        REQUIRE(store.Write(parts));
+        CHECK(store.GetStats().fileBytes <= 2 * store.GetStats().liveBytes);
+    }
+    CHECK(store.GetStats().nbCompactions > 1);
+    CHECK(store.GetStats().nbCompactions < 100);
+    CHECK(!std::filesystem::exists(filename + ".tmp"));
+
+    SettingsStore reloaded(filename);
+    CheckSameParts(reloaded.Parts(), parts);
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("A truncated tail is ignored, and the file is rewritten at the next write")
+{
+    const std::string filename = TestStoreFilename();
+    std::vector<SettingsPart> parts = TestParts("");
+    const std::vector<SettingsPart> firstParts = parts;
+    {
+        SettingsStore store(filename);
+        REQUIRE(store.Write(parts));
+        parts[1].Content = "[AppWindow]\nWindowPosition=0,0\n";
+        REQUIRE(store.Write(parts));
+    }
+    // e.g. a crash during the last append
+    std::filesystem::resize_file(filename, std::filesystem::file_size(filename) - 3);
+
+    SettingsStore reloaded(filename);
+    CheckSameParts(reloaded.Parts(), firstParts);
+    REQUIRE(reloaded.Write(parts));
+    CHECK(reloaded.GetStats().nbCompactions == 1);
+    CheckSameParts(SettingsStore(filename).Parts(), parts);
+    std::filesystem::remove(filename);
+}
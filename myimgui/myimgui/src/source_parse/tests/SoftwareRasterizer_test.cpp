@@ -0,0 +1,222 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "hello_imgui/internal/backend_impls/software_rasterizer.h"
+#include "imgui.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using HelloImGui::SoftwareRasterizer;
+
+namespace
+{
+    const int Width = 640, Height = 480;
+
+    // A headless ImGui context, whose fonts texture is uploaded into a SoftwareRasterizer
+    struct HeadlessImGui
+    {
+        HeadlessImGui()
+        {
+            ImGui::CreateContext();
+            ImGuiIO& io = ImGui::GetIO();
+            io.IniFilename = nullptr;
+            io.DisplaySize = ImVec2((float)Width, (float)Height);
+            io.DeltaTime = 1.f / 60.f;
+        }
+        ~HeadlessImGui() { ImGui::DestroyContext(); }
+
+        template<typename GuiFunction>
+        void runFrames(GuiFunction gui, int nbFrames = 1)
+        {
+            for (int i = 0; i < nbFrames; ++i)
+            {
+                ImGui::NewFrame();
+                gui();
+                ImGui::Render();
+            }
+        }
+    };
+
+    uint32_t Rgba(uint32_t r, uint32_t g, uint32_t b, uint32_t a) { return r | (g << 8) | (b << 16) | (a << 24); }
+
+    uint32_t PixelAt(const SoftwareRasterizer& rasterizer, int x, int y)
+    {
+        return rasterizer.Pixels()[(size_t)y * (size_t)rasterizer.Width() + (size_t)x];
+    }
+
+    // Number of pixels whose channels differ by more than tolerance
+    size_t PixelDiff(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b, int tolerance = 0)
+    {
+        REQUIRE(a.size() == b.size());
+        size_t nbDiffs = 0;
+        for (size_t i = 0; i < a.size(); ++i)
+            for (int shift = 0; shift < 32; shift += 8)
+                if (std::abs((int)((a[i] >> shift) & 0xFF) - (int)((b[i] >> shift) & 0xFF)) > tolerance)
+                {
+                    ++nbDiffs;
+                    break;
+                }
+        return nbDiffs;
+    }
+
+    std::vector<uint32_t> Render(SoftwareRasterizer& rasterizer, ImVec4 clearColor = ImVec4(0.f, 0.f, 0.f, 1.f))
+    {
+        rasterizer.Resize(Width, Height);
+        rasterizer.Clear(clearColor);
+        rasterizer.RenderDrawData(ImGui::GetDrawData());
+        return rasterizer.Pixels();
+    }
+}
+
+TEST_CASE("SoftwareRasterizer fills rects, and blends them like ImGui's backends")
+{
+    HeadlessImGui headlessImGui;
+    SoftwareRasterizer rasterizer(1);
+    rasterizer.CreateFontsTexture();
+
+    headlessImGui.runFrames([] {
+        ImDrawList* drawList = ImGui::GetForegroundDrawList();
+        drawList->AddRectFilled(ImVec2(10.f, 10.f), ImVec2(110.f, 60.f), IM_COL32(255, 0, 0, 255));
+        drawList->AddRectFilled(ImVec2(60.f, 30.f), ImVec2(160.f, 90.f), IM_COL32(0, 0, 255, 128));
+    });
+    Render(rasterizer);
+
+    CHECK(rasterizer.LastFrameStats().nbTriangles == 4);
+    CHECK(PixelAt(rasterizer, 20, 20) == Rgba(255, 0, 0, 255));
+    CHECK(PixelAt(rasterizer, 5, 5) == Rgba(0, 0, 0, 255));
+    // The rect covers [10, 110) x [10, 60) exactly
+    CHECK(PixelAt(rasterizer, 10, 10) == Rgba(255, 0, 0, 255));
+    CHECK(PixelAt(rasterizer, 9, 10) == Rgba(0, 0, 0, 255));
+    CHECK(PixelAt(rasterizer, 59, 59) == Rgba(255, 0, 0, 255));
+    CHECK(PixelAt(rasterizer, 59, 60) == Rgba(0, 0, 0, 255));
+    // src * 128/255 + dst * 127/255
+    CHECK(PixelAt(rasterizer, 80, 40) == Rgba(127, 0, 128, 255));
+    CHECK(PixelAt(rasterizer, 130, 70) == Rgba(0, 0, 128, 255));
+
+    HelloImGui::ImageBuffer screenshot = rasterizer.ScreenshotRgb();
+    CHECK(screenshot.width == (size_t)Width);
+    CHECK(screenshot.height == (size_t)Height);
+    const uint8_t* rgb = &screenshot.bufferRgb[(20 * (size_t)Width + 20) * 3];
+    CHECK((rgb[0] == 255 && rgb[1] == 0 && rgb[2] == 0));
+
+    rasterizer.DestroyFontsTexture();
+}
+
+TEST_CASE("SoftwareRasterizer is watertight: a translucent mesh blends each of its pixels exactly once")
+{
+    HeadlessImGui headlessImGui;
+    SoftwareRasterizer rasterizer(4);
+    rasterizer.CreateFontsTexture();
+
+    // A grid whose inner vertices are jittered, and whose cells are split along random diagonals
+    const int nbCells = 12;
+    const ImVec2 origin(37.3f, 21.7f);
+    const float cellSize = 31.13f;
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> jitter(-0.45f * cellSize, 0.45f * cellSize);
+    std::vector<ImVec2> points;
+    for (int j = 0; j <= nbCells; ++j)
+        for (int i = 0; i <= nbCells; ++i)
+        {
+            ImVec2 p(origin.x + (float)i * cellSize, origin.y + (float)j * cellSize);
+            if (i > 0 && i < nbCells && j > 0 && j < nbCells)
+            {
+                p.x += jitter(rng);
+                p.y += jitter(rng);
+            }
+            points.push_back(p);
+        }
+    std::vector<bool> diagonals;
+    for (int k = 0; k < nbCells * nbCells; ++k)
+        diagonals.push_back(rng() % 2 == 0);
+
+    const ImU32 color = IM_COL32(255, 255, 255, 100);
+    headlessImGui.runFrames([&] {
+        ImDrawList* drawList = ImGui::GetForegroundDrawList();
+        drawList->PrimReserve(nbCells * nbCells * 6, (int)points.size());
+        ImVec2 uv = ImGui::GetIO().Fonts->TexUvWhitePixel;
+        ImDrawIdx baseIdx = (ImDrawIdx)drawList->_VtxCurrentIdx;
+        for (const ImVec2& p: points)
+            drawList->PrimWriteVtx(p, uv, color);
+        auto idx = [&](int i, int j) { return (ImDrawIdx)(baseIdx + j * (nbCells + 1) + i); };
+        for (int j = 0; j < nbCells; ++j)
+            for (int i = 0; i < nbCells; ++i)
+            {
+                ImDrawIdx a = idx(i, j), b = idx(i + 1, j), c = idx(i + 1, j + 1), d = idx(i, j + 1);
+                if (diagonals[(size_t)(j * nbCells + i)])
+                {
+                    drawList->PrimWriteIdx(a); drawList->PrimWriteIdx(b); drawList->PrimWriteIdx(c);
+                    drawList->PrimWriteIdx(a); drawList->PrimWriteIdx(c); drawList->PrimWriteIdx(d);
+                }
+                else
+                {
+                    drawList->PrimWriteIdx(a); drawList->PrimWriteIdx(b); drawList->PrimWriteIdx(d);
+                    drawList->PrimWriteIdx(b); drawList->PrimWriteIdx(c); drawList->PrimWriteIdx(d);
+                }
+            }
+    });
+    Render(rasterizer);
+
+    // Every pixel whose center is inside the outer rect was blended once: 255 * 100/255 over black
+    const uint32_t blendedOnce = Rgba(100, 100, 100, 255);
+    const float extent = (float)nbCells * cellSize;
+    size_t nbWrongPixels = 0, nbCoveredPixels = 0;
+    for (int y = 0; y < Height; ++y)
+        for (int x = 0; x < Width; ++x)
+        {
+            float cx = (float)x + 0.5f, cy = (float)y + 0.5f;
+            bool inside = cx > origin.x && cx < origin.x + extent && cy > origin.y && cy < origin.y + extent;
+            uint32_t expected = inside ? blendedOnce : Rgba(0, 0, 0, 255);
+            if (PixelAt(rasterizer, x, y) != expected)
+                ++nbWrongPixels;
+            if (inside)
+                ++nbCoveredPixels;
+        }
+    CHECK(nbCoveredPixels > 100000);
+    CHECK(nbWrongPixels == 0);
+
+    rasterizer.DestroyFontsTexture();
+}
+
+TEST_CASE("The demo window renders the same with one or several threads, and a pixel diff detects changes")
+{
+    HeadlessImGui headlessImGui;
+    SoftwareRasterizer singleThreaded(1), multiThreaded(8);
+    singleThreaded.CreateFontsTexture(); // also used by multiThreaded
+    REQUIRE(multiThreaded.NbThreads() == 8);
+
+    auto gui = [] {
+        ImGui::ShowDemoWindow();
+        // ShowDemoWindow sets its own initial position & size: move it into the display (applied at the next frame)
+        ImGui::SetWindowPos("Dear ImGui Demo", ImVec2(20.f, 20.f));
+        ImGui::SetWindowSize("Dear ImGui Demo", ImVec2(560.f, 420.f));
+    };
+    auto renderBoth = [&](std::vector<uint32_t>* singleThreadedPixels, std::vector<uint32_t>* multiThreadedPixels) {
+        headlessImGui.runFrames(gui, 3);
+        *singleThreadedPixels = Render(singleThreaded);
+        *multiThreadedPixels = Render(multiThreaded);
+    };
+
+    std::vector<uint32_t> reference, multiThreadedPixels;
+    renderBoth(&reference, &multiThreadedPixels);
+    CHECK(multiThreaded.LastFrameStats().nbTriangles > 300);
+    CHECK(PixelDiff(reference, multiThreadedPixels) == 0);
+
+    // Something was drawn (window background, text)
+    std::vector<uint32_t> blank(reference.size(), Rgba(0, 0, 0, 255));
+    CHECK(PixelDiff(reference, blank) > (size_t)(Width * Height / 2));
+
+    // Changing the text color changes (only) some pixels
+    ImGui::GetStyle().Colors[ImGuiCol_Text] = ImVec4(1.f, 0.f, 0.f, 1.f);
+    std::vector<uint32_t> redText, redTextMultiThreaded;
+    renderBoth(&redText, &redTextMultiThreaded);
+    CHECK(PixelDiff(redText, redTextMultiThreaded) == 0);
+    size_t nbChangedPixels = PixelDiff(reference, redText);
+    CHECK(nbChangedPixels > 1000);
+    CHECK(nbChangedPixels < (size_t)(Width * Height / 4));
+
+    singleThreaded.DestroyFontsTexture();
+}
@@ -0,0 +1,105 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "SourceCache.h"
+
+#include <memory>
+#include <string>
+
+namespace
+{
+    SourceCache::Entry makeEntry(const std::string& sourcePath, size_t nbBytes)
+    {
+        SourceCache::Entry entry;
+        entry.sourceFile.sourcePath = sourcePath;
+        entry.sourceFile.sourceCode = std::make_shared<const SourceParse::SourceCode>(nbBytes, 'x');
+        return entry;
+    }
+
+    // Memory size of an entry, as counted by the cache
+    size_t entryBytes(size_t nbBytes)
+    {
+        SourceCache cache("entryBytes");
+        cache.store(makeEntry("a.cpp", nbBytes));
+        return cache.currentBytes();
+    }
+
+    bool contains(SourceCache& cache, const std::string& sourcePath)
+    {
+        auto entry = cache.take(sourcePath);
+        if (entry)
+            cache.store(std::move(*entry));
+        return entry.has_value();
+    }
+}
+
+TEST_CASE("The source cache evicts the least recently used entries")
+{
+    const size_t bytes = entryBytes(1000);
+    REQUIRE(bytes >= 1000);
+    SourceCache cache("test", 3 * bytes);
+    cache.store(makeEntry("a.cpp", 1000));
+    cache.store(makeEntry("b.cpp", 1000));
+    cache.store(makeEntry("c.cpp", 1000));
+    CHECK(cache.currentBytes() == 3 * bytes);
+    CHECK(cache.nbEvictions() == 0);
+
+    // a.cpp is used again: b.cpp is now the oldest
+    auto a = cache.take("a.cpp");
+    REQUIRE(a.has_value());
+    CHECK(a->sourceFile.sourceCode->size() == 1000);
+    CHECK(cache.currentBytes() == 2 * bytes);
+    cache.store(std::move(*a));
+
+    cache.store(makeEntry("d.cpp", 1000));
+    CHECK(cache.nbEvictions() == 1);
+    CHECK(cache.currentBytes() == 3 * bytes);
+    CHECK(!contains(cache, "b.cpp"));
+    // (contains() makes each found entry the most recent: c.cpp, then a.cpp)
+    CHECK(contains(cache, "c.cpp"));
+    CHECK(contains(cache, "a.cpp"));
+    CHECK(contains(cache, "d.cpp"));
+
+    // Storing an entry again replaces it
+    cache.store(makeEntry("d.cpp", 1000));
+    CHECK(cache.currentBytes() == 3 * bytes);
+    CHECK(cache.nbEvictions() == 1);
+
+    CHECK(cache.nbHits() == 4);
+    CHECK(cache.nbMisses() == 1);
+}
+
+TEST_CASE("The source cache stays under its byte cap")
+{
+    const size_t bytes = entryBytes(1000);
+    SourceCache cache("test", 3 * bytes);
+    cache.store(makeEntry("a.cpp", 1000));
+    cache.store(makeEntry("b.cpp", 1000));
+    cache.store(makeEntry("c.cpp", 1000));
+
+    // Lowering the cap evicts the oldest entries
+    cache.setMaxBytes(2 * bytes - 1);
+    CHECK(cache.currentBytes() == bytes);
+    CHECK(cache.nbEvictions() == 2);
+    CHECK(contains(cache, "c.cpp"));
+
+    // A larger entry evicts as many entries as needed
+    cache.setMaxBytes(3 * bytes);
+    cache.store(makeEntry("b.cpp", 1000));
+    cache.store(makeEntry("big.cpp", 2000));
+    CHECK(cache.currentBytes() <= cache.maxBytes());
+    CHECK(cache.nbEvictions() == 3);
+    CHECK(!contains(cache, "c.cpp"));
+    CHECK(contains(cache, "b.cpp"));
+    CHECK(contains(cache, "big.cpp"));
+
+    // An entry larger than the cap is not kept, and does not evict the others
+    cache.store(makeEntry("huge.cpp", 10 * bytes));
+    CHECK(cache.nbEvictions() == 4);
+    CHECK(!contains(cache, "huge.cpp"));
+    CHECK(contains(cache, "b.cpp"));
+    CHECK(contains(cache, "big.cpp"));
+    CHECK(cache.currentBytes() <= cache.maxBytes());
+
+    CHECK(cache.nbMisses() == 2);
+}
@@ -0,0 +1,400 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "TextEditor.h"
+#include "imgui.h"
+
+#include <string>
+#include <vector>
+
+using Line = TextEditor::Line;
+using Glyph = TextEditor::Glyph;
+using PaletteIndex = TextEditor::PaletteIndex;
+
+namespace
+{
+    // A line "abcdefghij..." where the glyph i has the color i % 13, and flags depending on i
+    Line makeLine(int nbGlyphs)
+    {
+        Line line;
+        line.reserve(nbGlyphs);
+        for (int i = 0; i < nbGlyphs; ++i)
+        {
+            Glyph glyph((TextEditor::Char)('a' + i % 26), (PaletteIndex)(i % 13));
+            glyph.mComment = (i % 2 == 0);
+            glyph.mMultiLineComment = (i % 3 == 0);
+            glyph.mPreprocessor = (i % 5 == 0);
+            line.push_back(glyph);
+        }
+        return line;
+    }
+
+    std::string lineText(const Line& line)
+    {
+        return std::string((const char*)line.data(), line.size());
+    }
+
+    struct HeadlessEditor
+    {
+        TextEditor editor;
+
+        HeadlessEditor()
+        {
+            ImGui::CreateContext();
+            ImGuiIO& io = ImGui::GetIO();
+            io.IniFilename = nullptr;
+            io.DisplaySize = ImVec2(800.f, 600.f);
+            io.DeltaTime = 1.f / 60.f;
+            unsigned char *pixels;
+            int width, height;
+            io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+            // Click in the editor, to focus it
+            renderFrame();
+            io.AddMousePosEvent(200.f, 150.f);
+            io.AddMouseButtonEvent(0, true);
+            renderFrame();
+            io.AddMouseButtonEvent(0, false);
+            renderFrame();
+        }
+        ~HeadlessEditor() { ImGui::DestroyContext(); }
+
+        void renderFrame()
+        {
+            ImGui::NewFrame();
+            ImGui::SetNextWindowPos(ImVec2(0.f, 0.f));
+            ImGui::SetNextWindowSize(ImVec2(400.f, 300.f));
+            ImGui::Begin("Editor");
+            editor.Render("Code");
+            ImGui::End();
+            ImGui::Render();
+        }
+
+        void type(const char* text)
+        {
+            for (const char* c = text; *c != '\0'; ++c)
+            {
+                ImGui::GetIO().AddInputCharacter((unsigned int)*c);
+                renderFrame();
+            }
+        }
+    };
+
+    // Checks that line[lineIndex] is the glyph originalIndex of makeLine()
+    void checkGlyph(const Line& line, size_t lineIndex, int originalIndex)
+    {
+        Glyph glyph = line[lineIndex];
+        CHECK(glyph.mChar == (TextEditor::Char)('a' + originalIndex % 26));
+        CHECK(glyph.mColorIndex == (PaletteIndex)(originalIndex % 13));
+        CHECK(glyph.mComment == (originalIndex % 2 == 0));
+        CHECK(glyph.mMultiLineComment == (originalIndex % 3 == 0));
+        CHECK(glyph.mPreprocessor == (originalIndex % 5 == 0));
+    }
+}
+
+TEST_CASE("TextEditor::Line stores the glyphs and their metadata")
+{
+    Line line = makeLine(37);
+    REQUIRE(line.size() == 37);
+    for (int i = 0; i < 37; ++i)
+        checkGlyph(line, i, i);
+    CHECK(line.MemorySize() <= 37 * 2); // instead of 37 * sizeof(Glyph)
+
+    line.SetColorIndex(9, PaletteIndex::Keyword);
+    line.SetComment(9, true);
+    line.SetPreprocessor(9, false);
+    CHECK(line.GetColorIndex(9) == PaletteIndex::Keyword);
+    CHECK(line.IsComment(9));
+    CHECK(!line.IsPreprocessor(9));
+    // the neighbours are untouched
+    checkGlyph(line, 8, 8);
+    checkGlyph(line, 10, 10);
+}
+
+TEST_CASE("TextEditor::Line insert and erase move the metadata with the chars")
+{
+    Line line = makeLine(20);
+
+    line.erase(3, 12);
+    REQUIRE(line.size() == 11);
+    for (int i = 0; i < 3; ++i)
+        checkGlyph(line, i, i);
+    for (int i = 3; i < 11; ++i)
+        checkGlyph(line, i, i + 9);
+
+    line.insert(1, Glyph('#', PaletteIndex::Preprocessor));
+    CHECK(lineText(line) == "a#bcmnopqrst");
+    CHECK(line.GetColorIndex(1) == PaletteIndex::Preprocessor);
+    CHECK(!line.IsComment(1));
+    checkGlyph(line, 0, 0);
+    checkGlyph(line, 2, 1);
+    checkGlyph(line, 11, 19);
+
+    Line other = makeLine(20);
+    line.insert(2, other, 5, 15);
+    CHECK(lineText(line) == "a#fghijklmnobcmnopqrst");
+    for (int i = 0; i < 10; ++i)
+        checkGlyph(line, 2 + i, 5 + i);
+    checkGlyph(line, 12, 1);
+    checkGlyph(line, 21, 19);
+
+    line.erase(0, line.size());
+    CHECK(line.empty());
+}
+
+TEST_CASE("Editing the text of a TextEditor")
+{
+    // (GetText() ends each line with '\n', including the last one)
+    TextEditor editor;
+    editor.SetText("int a = 1;\nint b = 2;");
+    CHECK(editor.GetText() == "int a = 1;\nint b = 2;\n");
+    CHECK(editor.GetTextLines() == std::vector<std::string>{ "int a = 1;", "int b = 2;" });
+
+    editor.SetCursorPosition(TextEditor::Coordinates(0, 5));
+    editor.InsertText("bc\nint d");
+    CHECK(editor.GetText() == "int abc\nint d = 1;\nint b = 2;\n");
+
+    editor.SetSelection(TextEditor::Coordinates(1, 3), TextEditor::Coordinates(2, 3));
+    editor.Delete();
+    CHECK(editor.GetText() == "int abc\nint b = 2;\n");
+
+    editor.Undo();
+    CHECK(editor.GetText() == "int abc\nint d = 1;\nint b = 2;\n");
+    editor.Redo();
+    CHECK(editor.GetText() == "int abc\nint b = 2;\n");
+}
+
+TEST_CASE("Read-only editors share their text until one of them becomes writable")
+{
+    TextEditor editorA, editorB;
+    editorA.SetReadOnly(true);
+    editorB.SetReadOnly(true);
+    editorA.SetText("int a = 1;");
+    editorB.SetSharedLines(editorA.GetSharedLines());
+    CHECK(editorA.IsTextShared());
+    CHECK(editorB.GetSharedLines() == editorA.GetSharedLines());
+    CHECK(editorB.GetText() == "int a = 1;\n");
+
+    // Copy-on-write
+    editorB.SetReadOnly(false);
+    CHECK(!editorA.IsTextShared());
+    CHECK(!editorB.IsTextShared());
+    editorB.SetCursorPosition(TextEditor::Coordinates(0, 5));
+    editorB.InsertText("bc");
+    CHECK(editorB.GetText() == "int abc = 1;\n");
+    CHECK(editorA.GetText() == "int a = 1;\n");
+}
+
+TEST_CASE("An editor which shares the text of another one takes over its colorizer progress")
+{
+    HeadlessEditor headless;
+    TextEditor& owner = headless.editor;
+    owner.SetText("int a = 1; // one\n/* two */ int b = 2;");
+    CHECK(owner.IsColorizationPending());
+    for (int i = 0; i < 3; ++i)
+        headless.renderFrame();
+    REQUIRE(!owner.IsColorizationPending());
+
+    TextEditor editor;
+    editor.SetReadOnly(true);
+    editor.SetSharedLines(owner);
+    CHECK(editor.GetSharedLines() == owner.GetSharedLines());
+    CHECK(!editor.IsColorizationPending());
+
+    // Without the owner, the shared text is colorized again
+    TextEditor other;
+    other.SetReadOnly(true);
+    other.SetSharedLines(owner.GetSharedLines());
+    CHECK(other.IsColorizationPending());
+}
+
+TEST_CASE("Characters typed in a row are undone at once")
+{
+    HeadlessEditor headless;
+    TextEditor& editor = headless.editor;
+    editor.SetText("int a = 1;");
+    editor.SetCursorPosition(TextEditor::Coordinates(0, 5));
+    headless.type("bcd");
+    CHECK(editor.GetText() == "int abcd = 1;\n");
+
+    // Typing elsewhere starts a new edit
+    editor.SetCursorPosition(TextEditor::Coordinates(0, 0));
+    headless.type("//");
+    CHECK(editor.GetText() == "//int abcd = 1;\n");
+
+    editor.Undo();
+    CHECK(editor.GetText() == "int abcd = 1;\n");
+    editor.Undo();
+    CHECK(editor.GetText() == "int a = 1;\n");
+    CHECK(!editor.CanUndo());
+    editor.Redo(2);
+    CHECK(editor.GetText() == "//int abcd = 1;\n");
+
+    // Typing after an undo drops the edit which could be redone
+    editor.Undo();
+    editor.SetCursorPosition(TextEditor::Coordinates(0, 12));
+    headless.type("0");
+    CHECK(editor.GetText() == "int abcd = 10;\n");
+    CHECK(!editor.CanRedo());
+    editor.Undo(2);
+    CHECK(editor.GetText() == "int a = 1;\n");
+}
+
+TEST_CASE("The undo history is bounded by its memory budget")
+{
+    std::string text;
+    for (int i = 0; i < 200; ++i)
+        text += "A line of text which will be deleted: " + std::to_string(i) + "\n";
+    TextEditor editor;
+    editor.SetText(text);
+    const size_t budget = 4096;
+    editor.SetUndoMemoryBudget(budget);
+
+    // Delete the first line, 200 times
+    for (int i = 0; i < 200; ++i)
+    {
+        editor.SetSelection(TextEditor::Coordinates(0, 0), TextEditor::Coordinates(1, 0));
+        editor.Delete();
+        CHECK(editor.GetUndoMemorySize() <= budget);
+    }
+    CHECK(editor.GetText() == "\n");
+
+    // Only the latest deletions can be undone
+    int nbUndos = 0;
+    while (editor.CanUndo())
+    {
+        editor.Undo();
+        ++nbUndos;
+    }
+    CHECK(nbUndos > 10);
+    CHECK(nbUndos < 200);
+    CHECK(editor.GetTextLines()[0] == "A line of text which will be deleted: " + std::to_string(200 - nbUndos));
+    editor.Redo(nbUndos);
+    CHECK(editor.GetText() == "\n");
+}
+
+TEST_CASE("The lines changes reported by the editor cover its edits")
+{
+    TextEditor editor;
+    editor.SetText("int a = 1;\nint b = 2;\nint c = 3;\nint d = 4;");
+    editor.SetTrackLinesChanges(true);
+    const std::vector<std::string> linesBefore = editor.GetTextLines();
+
+    editor.SetCursorPosition(TextEditor::Coordinates(1, 5));
+    editor.InsertText("bb\nint bbb");
+    editor.SetSelection(TextEditor::Coordinates(2, 3), TextEditor::Coordinates(3, 3));
+    editor.Delete();
+    editor.SetCursorPosition(TextEditor::Coordinates(0, 10));
+    editor.Delete(); // joins lines 0 and 1
+    editor.Undo();
+
+    // Replay the changes on the lines before the edits: the lines which were not reported as changed
+    // shall be the same as in the editor
+    std::vector<std::string> replayed = linesBefore;
+    for (const auto& change: editor.GetLinesChanges())
+    {
+        REQUIRE(change.mLine + change.mLinesBefore <= (int)replayed.size());
+        replayed.erase(replayed.begin() + change.mLine, replayed.begin() + change.mLine + change.mLinesBefore);
+        replayed.insert(replayed.begin() + change.mLine, (size_t)change.mLinesAfter, std::string("(changed)"));
+    }
+    const std::vector<std::string> linesAfter = editor.GetTextLines();
+    REQUIRE(replayed.size() == linesAfter.size());
+    for (size_t i = 0; i < replayed.size(); ++i)
+        if (replayed[i] != "(changed)")
+            CHECK(replayed[i] == linesAfter[i]);
+    CHECK(linesAfter.back() == "int d = 4;");
+    CHECK(replayed.back() == "int d = 4;"); // the last line was not changed
+
+    editor.ClearLinesChanges();
+    editor.SetText("int e = 5;");
+    REQUIRE(editor.GetLinesChanges().size() == 1);
+    CHECK(editor.GetLinesChanges()[0].mLinesBefore == (int)linesAfter.size());
+    CHECK(editor.GetLinesChanges()[0].mLinesAfter == 1);
+}
+
+TEST_CASE("Breakpoints and error markers follow their lines")
+{
+    std::string text;
+    for (int i = 0; i < 10; ++i)
+        text += "int value_" + std::to_string(i) + ";\n";
+    TextEditor editor;
+    editor.SetText(text);
+    editor.SetBreakpoints({ 5, 8 }); // line numbers start at 1
+    editor.SetErrorMarkers({ { 9, "error" } });
+
+    editor.SetCursorPosition(TextEditor::Coordinates(1, 0));
+    editor.InsertText("// two\n// lines\n");
+    CHECK(editor.GetBreakpoints() == TextEditor::Breakpoints{ 7, 10 });
+    CHECK(editor.GetErrorMarkers() == TextEditor::ErrorMarkers{ { 11, "error" } });
+
+    // The line of a breakpoint is removed
+    editor.SetSelection(TextEditor::Coordinates(5, 0), TextEditor::Coordinates(7, 0));
+    editor.Delete();
+    CHECK(editor.GetBreakpoints() == TextEditor::Breakpoints{ 8 });
+    CHECK(editor.GetErrorMarkers() == TextEditor::ErrorMarkers{ { 9, "error" } });
+
+    // Setting new breakpoints keeps the error markers where they are
+    editor.SetBreakpoints({ 1 });
+    CHECK(editor.GetErrorMarkers() == TextEditor::ErrorMarkers{ { 9, "error" } });
+    editor.SetCursorPosition(TextEditor::Coordinates(3, 0));
+    editor.InsertText("\n");
+    CHECK(editor.GetBreakpoints() == TextEditor::Breakpoints{ 1 });
+    CHECK(editor.GetErrorMarkers() == TextEditor::ErrorMarkers{ { 10, "error" } });
+}
+
+TEST_CASE("Breakpoints stay on their lines after many random edits")
+{
+    std::string text;
+    for (int i = 0; i < 300; ++i)
+        text += "line " + std::to_string(i) + "\n";
+    TextEditor editor;
+    editor.SetText(text);
+    TextEditor::Breakpoints breakpoints;
+    for (int i = 1; i <= 300; i += 7)
+        breakpoints.insert(i);
+    editor.SetBreakpoints(breakpoints);
+    editor.SetTrackLinesChanges(true);
+
+    // Reference: the anchor of each line (-1 for the inserted lines), updated with the lines changes
+    std::vector<int> anchors;
+    for (int i = 0; i < editor.GetTotalLines(); ++i)
+        anchors.push_back(i);
+
+    unsigned int random = 12345;
+    auto nextRandom = [&random](int n) {
+        random = random * 1103515245u + 12345u;
+        return (int)((random >> 8) % (unsigned int)n);
+    };
+    for (int step = 0; step < 400; ++step)
+    {
+        int line = nextRandom(editor.GetTotalLines());
+        if (nextRandom(2) == 0)
+        {
+            editor.SetCursorPosition(TextEditor::Coordinates(line, nextRandom(4)));
+            editor.InsertText(nextRandom(2) == 0 ? "a\nb" : "\n\n\n");
+        }
+        else
+        {
+            int lastLine = std::min(line + nextRandom(4), editor.GetTotalLines() - 1);
+            editor.SetSelection(TextEditor::Coordinates(line, nextRandom(4)), TextEditor::Coordinates(lastLine, 2));
+            editor.Delete();
+        }
+
+        for (const auto& change: editor.GetLinesChanges())
+        {
+            if (change.mLinesBefore == 1 && change.mLinesAfter == 1)
+                continue; // modified in place
+            anchors.erase(anchors.begin() + change.mLine, anchors.begin() + change.mLine + change.mLinesBefore);
+            anchors.insert(anchors.begin() + change.mLine, (size_t)change.mLinesAfter, -1);
+        }
+        editor.ClearLinesChanges();
+    }
+
+    REQUIRE((int)anchors.size() == editor.GetTotalLines());
+    TextEditor::Breakpoints expected;
+    for (size_t i = 0; i < anchors.size(); ++i)
+        if (anchors[i] >= 0 && breakpoints.count(anchors[i] + 1) != 0)
+            expected.insert((int)i + 1);
+    CHECK(!expected.empty());
+    CHECK(editor.GetBreakpoints() == expected);
+}
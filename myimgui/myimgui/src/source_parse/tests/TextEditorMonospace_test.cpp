@@ -0,0 +1,215 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "TextEditor.h"
+#include "imgui.h"
+#include "imgui_internal.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+    void createHeadlessContext()
+    {
+        ImGui::CreateContext();
+        ImGuiIO& io = ImGui::GetIO();
+        io.IniFilename = nullptr;
+        io.DisplaySize = ImVec2(800.f, 600.f);
+        io.DeltaTime = 1.f / 60.f;
+        unsigned char *pixels;
+        int width, height;
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height); // the default font (ProggyClean) is monospace
+    }
+
+    // Renders an editor in a headless ImGui context, and returns the vertices of its child window
+    std::vector<ImDrawVert> renderEditorVertices(TextEditor& editor, bool monospaceMode, ImVec2 scroll = ImVec2(0.f, 0.f))
+    {
+        editor.SetMonospaceMode(monospaceMode);
+        std::vector<ImDrawVert> vertices;
+        for (int frame = 0; frame < 3; ++frame)
+        {
+            ImGui::NewFrame();
+            ImGui::SetNextWindowPos(ImVec2(0.f, 0.f));
+            ImGui::SetNextWindowSize(ImVec2(400.f, 300.f));
+            ImGui::Begin("Editor");
+            ImGui::SetNextWindowScroll(scroll); // applies to the editor's child window
+            editor.Render("Code");
+            ImGui::End();
+            // Keep the focus elsewhere, so that the (blinking) cursor is not drawn
+            ImGui::SetNextWindowFocus();
+            ImGui::Begin("Other");
+            ImGui::End();
+            ImGui::Render();
+        }
+        ImDrawData *drawData = ImGui::GetDrawData();
+        for (int i = 0; i < drawData->CmdListsCount; ++i)
+        {
+            const ImDrawList *drawList = drawData->CmdLists[i];
+            if (std::string(drawList->_OwnerName).find("Code") != std::string::npos)
+                vertices.assign(drawList->VtxBuffer.begin(), drawList->VtxBuffer.end());
+        }
+        return vertices;
+    }
+}
+
+TEST_CASE("TextEditor monospace mode renders like the generic text layout")
+{
+    createHeadlessContext();
+
+    TextEditor editor;
+    editor.SetLanguageDefinition(TextEditor::LanguageDefinition::CPlusPlus());
+    editor.SetText(
+        "#include <vector>\n"
+        "\tint  main() // a comment\n"
+        "{\n"
+        "\t\tconst char* s = \"caf\xC3\xA9 \t tabs\";\n"
+        "    return 0; /* a rather long line, that goes beyond the right border of the editor window */\n"
+        "}\n");
+    editor.SetSelection(TextEditor::Coordinates(1, 2), TextEditor::Coordinates(3, 6));
+
+    auto verticesGeneric = renderEditorVertices(editor, false);
+    auto verticesMonospace = renderEditorVertices(editor, true);
+
+    REQUIRE(!verticesGeneric.empty());
+    REQUIRE(verticesGeneric.size() == verticesMonospace.size());
+    for (size_t i = 0; i < verticesGeneric.size(); ++i)
+    {
+        const auto& a = verticesGeneric[i];
+        const auto& b = verticesMonospace[i];
+        CHECK(a.pos.x == doctest::Approx(b.pos.x));
+        CHECK(a.pos.y == doctest::Approx(b.pos.y));
+        CHECK(a.uv.x == doctest::Approx(b.uv.x));
+        CHECK(a.uv.y == doctest::Approx(b.uv.y));
+        CHECK(a.col == b.col);
+    }
+
+    ImGui::DestroyContext();
+}
+
+TEST_CASE("A scrolled TextEditor renders the same in monospace mode")
+{
+    createHeadlessContext();
+
+    TextEditor editor;
+    editor.SetLanguageDefinition(TextEditor::LanguageDefinition::CPlusPlus());
+    std::string text;
+    for (int i = 0; i < 100; ++i)
+        text += "\tint line_" + std::to_string(i) + " = " + std::to_string(i) + "; /* a line that goes beyond the right border of the editor window */\n";
+    editor.SetText(text);
+
+    const ImVec2 scroll(120.f, 500.f);
+    auto verticesGeneric = renderEditorVertices(editor, false, scroll);
+    auto verticesMonospace = renderEditorVertices(editor, true, scroll);
+    // Check that the scroll was applied
+    CHECK(ImGui::FindWindowByName("Editor")->DC.ChildWindows[0]->Scroll.y == doctest::Approx(scroll.y));
+    CHECK(ImGui::FindWindowByName("Editor")->DC.ChildWindows[0]->Scroll.x == doctest::Approx(scroll.x));
+
+    REQUIRE(!verticesGeneric.empty());
+    REQUIRE(verticesGeneric.size() == verticesMonospace.size());
+    for (size_t i = 0; i < verticesGeneric.size(); ++i)
+    {
+        const auto& a = verticesGeneric[i];
+        const auto& b = verticesMonospace[i];
+        CHECK(a.pos.x == doctest::Approx(b.pos.x));
+        CHECK(a.pos.y == doctest::Approx(b.pos.y));
+        CHECK(a.uv.x == doctest::Approx(b.uv.x));
+        CHECK(a.uv.y == doctest::Approx(b.uv.y));
+        CHECK(a.col == b.col);
+    }
+
+    ImGui::DestroyContext();
+}
+
+TEST_CASE("ImDrawList::AddTextRuns draws like one AddText per run")
+{
+    createHeadlessContext();
+    const char *text = "int main() { return 0; } caf\xC3\xA9, and a long run which goes past the right border of the window";
+    std::vector<ImDrawTextRun> runs = {
+        { ImVec2(10.3f, 20.7f), IM_COL32(255, 0, 0, 255), text, text + 10 },
+        { ImVec2(90.f, 20.7f), IM_COL32(0, 255, 0, 255), text + 11, text + 24 },
+        { ImVec2(10.f, 40.f), IM_COL32(0, 0, 255, 0), text, text + 24 },  // transparent: not drawn
+        { ImVec2(-30.f, 60.f), IM_COL32(0, 0, 255, 255), text + 25, text + strlen(text) },
+        { ImVec2(10.f, 900.f), IM_COL32(0, 0, 255, 255), text, text + 24 },  // below the clip rect
+    };
+
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(0.f, 0.f));
+    ImGui::SetNextWindowSize(ImVec2(300.f, 200.f));
+    ImGui::Begin("Runs");
+    ImDrawList *drawList = ImGui::GetWindowDrawList();
+
+    int vtxStart = drawList->VtxBuffer.Size;
+    for (const auto& run: runs)
+        drawList->AddText(run.Pos, run.Col, run.TextBegin, run.TextEnd);
+    std::vector<ImDrawVert> verticesAddText(drawList->VtxBuffer.begin() + vtxStart, drawList->VtxBuffer.end());
+
+    vtxStart = drawList->VtxBuffer.Size;
+    int idxStart = drawList->IdxBuffer.Size;
+    drawList->AddTextRuns(nullptr, 0.f, runs.data(), (int)runs.size());
+    std::vector<ImDrawVert> verticesAddTextRuns(drawList->VtxBuffer.begin() + vtxStart, drawList->VtxBuffer.end());
+    CHECK(drawList->IdxBuffer.Size - idxStart == (int)verticesAddTextRuns.size() / 4 * 6);
+    ImGui::End();
+    ImGui::Render();
+
+    REQUIRE(!verticesAddText.empty());
+    // AddTextRuns stops each run at the right of the clip rect, AddText continues up to the end of the line
+    REQUIRE(verticesAddTextRuns.size() <= verticesAddText.size());
+    size_t nbCompared = 0;
+    for (size_t i = 0, j = 0; i < verticesAddText.size() && j < verticesAddTextRuns.size(); ++i)
+    {
+        const auto& a = verticesAddText[i];
+        if (a.pos.x > 300.f) // clipped out
+            continue;
+        const auto& b = verticesAddTextRuns[j++];
+        CHECK(a.pos.x == b.pos.x);
+        CHECK(a.pos.y == b.pos.y);
+        CHECK(a.uv.x == b.uv.x);
+        CHECK(a.col == b.col);
+        ++nbCompared;
+    }
+    CHECK(nbCompared == verticesAddTextRuns.size());
+
+    ImGui::DestroyContext();
+}
+
+TEST_CASE("ImDrawList::AddTextRuns splits a run longer than a batch")
+{
+    createHeadlessContext();
+    std::string text;
+    for (int i = 0; i < 2000; ++i)
+        text += "abcdefghi\xC3\xA9"; // 20000 glyphs, with 2 bytes characters across the batch boundaries
+    ImDrawTextRun run = { ImVec2(0.f, 10.f), IM_COL32_WHITE, text.c_str(), text.c_str() + text.size() };
+
+    ImGui::NewFrame();
+    ImDrawList *drawList = ImGui::GetForegroundDrawList();
+    drawList->Flags |= ImDrawListFlags_AllowVtxOffset;
+    drawList->PushClipRect(ImVec2(0.f, 0.f), ImVec2(1e6f, 100.f));
+    int cmdStart = drawList->CmdBuffer.Size - 1;
+    drawList->AddTextRuns(nullptr, 0.f, &run, 1);
+    drawList->PopClipRect();
+
+    // Each batch stays within the reach of 16-bit indices: the glyphs, followed through
+    // the commands' vertex offsets, go from left to right
+    int nbGlyphs = 0;
+    float lastX = -1.f;
+    bool isLeftToRight = true;
+    for (int cmdIdx = cmdStart; cmdIdx < drawList->CmdBuffer.Size; ++cmdIdx)
+    {
+        const ImDrawCmd& cmd = drawList->CmdBuffer[cmdIdx];
+        for (unsigned int i = 0; i < cmd.ElemCount; i += 6)
+        {
+            const ImDrawVert& topLeft = drawList->VtxBuffer[(int)(cmd.VtxOffset + drawList->IdxBuffer[(int)(cmd.IdxOffset + i)])];
+            isLeftToRight = isLeftToRight && topLeft.pos.x > lastX;
+            lastX = topLeft.pos.x;
+            ++nbGlyphs;
+        }
+    }
+    CHECK(isLeftToRight);
+    CHECK(nbGlyphs == 20000);
+    CHECK(lastX == doctest::Approx(19999.f * ImGui::GetFont()->GetCharAdvance('a')).epsilon(0.01));
+    ImGui::EndFrame();
+
+    ImGui::DestroyContext();
+}
@@ -0,0 +1,94 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "imgui.h"
+#include "imgui_internal.h"
+
+#include <string>
+#include <vector>
+
+TEST_CASE("The text size cache returns the same sizes as CalcTextSizeA, and is cleared on atlas rebuild")
+{
+    ImFontAtlas atlas;
+    ImFont* font = atlas.AddFontDefault();
+    atlas.Build();
+
+    std::vector<std::string> texts = {
+        "short",  // below IM_FONT_TEXT_SIZE_CACHE_MIN_LENGTH: not cached
+        "A table of content entry##12",
+        "Two lines\nof text, the second one is longer",
+        "caf\xC3\xA9 and other UTF-8 text",
+    };
+    const float wrapWidths[] = { 0.f, 60.f };
+    std::vector<ImVec2> expectedSizes;
+    for (const auto& text: texts)
+        for (float wrapWidth: wrapWidths)
+            expectedSizes.push_back(font->CalcTextSizeA(13.f, FLT_MAX, wrapWidth, text.c_str()));
+    CHECK(atlas.TextSizeCache == nullptr);
+
+    atlas.TextSizeCacheCapacity = 4000; // rounded to 4096
+    for (int pass = 0; pass < 3; ++pass)
+    {
+        size_t i = 0;
+        for (const auto& text: texts)
+            for (float wrapWidth: wrapWidths)
+            {
+                const char* remaining = nullptr;
+                ImVec2 size = font->CalcTextSizeA(13.f, FLT_MAX, wrapWidth, text.c_str(), nullptr, &remaining);
+                CHECK(size.x == expectedSizes[i].x);
+                CHECK(size.y == expectedSizes[i].y);
+                CHECK(remaining == text.c_str() + text.size());
+                ++i;
+            }
+    }
+    REQUIRE(atlas.TextSizeCache != nullptr);
+    const ImFontTextSizeCache& cache = *atlas.TextSizeCache;
+    CHECK(cache.Entries.Size == 4096);
+    // 6 texts are cached, and measured 3 times (the cache is direct-mapped: 2 texts may share a slot and evict each other)
+    CHECK(cache.Hits + cache.Misses == 18);
+    CHECK(cache.Hits >= 8);
+
+    // Other font sizes are other entries
+    ImU64 misses = cache.Misses;
+    font->CalcTextSizeA(26.f, FLT_MAX, 0.f, texts[1].c_str());
+    CHECK(cache.Misses == misses + 1);
+
+    // Texts measured with a max width are not cached
+    font->CalcTextSizeA(13.f, 50.f, 0.f, texts[1].c_str());
+    CHECK(cache.Hits + cache.Misses == 19);
+
+    // Rebuilding the atlas clears the cache
+    font->CalcTextSizeA(13.f, FLT_MAX, 0.f, texts[1].c_str());
+    atlas.Build();
+    misses = cache.Misses;
+    font->CalcTextSizeA(13.f, FLT_MAX, 0.f, texts[1].c_str());
+    CHECK(cache.Misses == misses + 1);
+}
+
+TEST_CASE("Texts of the same length are not mixed up by the text size cache")
+{
+    ImFontAtlas atlas;
+    ImFont* font = atlas.AddFontDefault();
+    atlas.Build();
+
+    // 16 bytes texts, whose widths differ with the position of their line break (the default font is monospace)
+    std::vector<std::string> texts;
+    std::vector<ImVec2> expectedSizes;
+    for (int i = 0; i < 2000; ++i)
+    {
+        std::string text = "item " + std::to_string(1000000 + i) + "    ";
+        text[1 + i % 14] = '\n';
+        texts.push_back(text);
+        expectedSizes.push_back(font->CalcTextSizeA(13.f, FLT_MAX, 0.f, text.c_str()));
+    }
+
+    atlas.TextSizeCacheCapacity = 1024; // fewer slots than texts: they evict each other
+    for (int pass = 0; pass < 2; ++pass)
+        for (size_t i = 0; i < texts.size(); ++i)
+        {
+            ImVec2 size = font->CalcTextSizeA(13.f, FLT_MAX, 0.f, texts[i].c_str());
+            CHECK(size.x == expectedSizes[i].x);
+            CHECK(size.y == expectedSizes[i].y);
+        }
+    CHECK(atlas.TextSizeCache->Hits > 0);
+}